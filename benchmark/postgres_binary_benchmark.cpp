@@ -0,0 +1,320 @@
+// Microbenchmark of the binary COPY encoding and decoding kernels - runs without a Postgres server
+// For every type a stream is encoded in-memory with PostgresBinaryWriter and decoded again with the column decoders
+// used by the scanner, the time per value is reported as JSON
+//
+// Streams captured from a server can be replayed as well, e.g. recorded with
+//   psql -c "\copy (SELECT ...) TO 'capture.bin' WITH (FORMAT binary)"
+// or with COPY ... TO 'capture.bin' (FORMAT postgres_binary) in DuckDB, and decoded with
+//   postgres_binary_benchmark --input=capture.bin --types=INTEGER,VARCHAR,JSONB
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "postgres_binary_decoder.hpp"
+#include "postgres_binary_writer.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace duckdb;
+
+struct BinaryBenchmarkConfig {
+	idx_t rows = 1000000;
+	idx_t repetitions = 5;
+	//! A captured binary COPY stream (and the types of its columns) to decode instead of the generated streams
+	string input;
+	vector<string> input_types;
+	string output;
+};
+
+//! The types that are benchmarked - and the expressions that generate their values
+static const vector<pair<string, string>> BENCHMARK_TYPES = {
+    {"BOOLEAN", "i % 3 = 0"},
+    {"SMALLINT", "(i % 30000)::SMALLINT"},
+    {"INTEGER", "i::INTEGER"},
+    {"BIGINT", "i * 7919"},
+    {"DOUBLE", "i / 7.0"},
+    {"DECIMAL(18,2)", "(i * 1.37)::DECIMAL(18,2)"},
+    {"DECIMAL(38,10)", "(i * 3.1415926535)::DECIMAL(38,10)"},
+    {"VARCHAR", "md5(i::VARCHAR)"},
+    {"DATE", "DATE '2000-01-01' + (i % 10000)::INTEGER"},
+    {"TIMESTAMP", "TIMESTAMP '2000-01-01' + to_seconds(i)"},
+    {"INTERVAL", "to_seconds(i) + to_months(i % 12)"},
+    {"UUID", "uuid()"},
+    {"INTEGER[]", "[i::INTEGER, (i + 1)::INTEGER, (i + 2)::INTEGER]"},
+    {"VARCHAR[]", "[md5(i::VARCHAR), i::VARCHAR]"}};
+
+struct BinaryBenchmarkResult {
+	string type;
+	idx_t values = 0;
+	idx_t bytes = 0;
+	vector<double> encode_timings;
+	vector<double> decode_timings;
+};
+
+static double GetTime() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//! The stream split up into batches of (at most) STANDARD_VECTOR_SIZE rows - located once so that only the decoding
+//! of the values is measured
+struct LocatedStream {
+	vector<vector<PostgresColumnFields>> batches;
+	vector<idx_t> batch_sizes;
+	idx_t bytes = 0;
+};
+
+static LocatedStream LocateRows(data_ptr_t data, idx_t size, idx_t column_count) {
+	LocatedStream result;
+	result.bytes = size;
+	auto ptr = data;
+	auto end = data + size;
+	auto header_size = PostgresConversion::COPY_HEADER_LENGTH + 2 * sizeof(int32_t);
+	if (size < header_size || memcmp(ptr, PostgresConversion::COPY_HEADER, PostgresConversion::COPY_HEADER_LENGTH)) {
+		throw InvalidInputException("Not a binary COPY stream - expected the binary COPY header");
+	}
+	ptr += PostgresConversion::COPY_HEADER_LENGTH + sizeof(int32_t);
+	auto extension_length = PostgresBinaryReader::LoadInteger<uint32_t>(ptr);
+	ptr += sizeof(int32_t) + extension_length;
+	while (ptr + sizeof(int16_t) <= end) {
+		auto field_count = PostgresBinaryReader::LoadInteger<int16_t>(ptr);
+		ptr += sizeof(int16_t);
+		if (field_count < 0) {
+			break;
+		}
+		if (idx_t(field_count) != column_count) {
+			throw InvalidInputException("Expected %llu columns in the binary COPY stream but found %d", column_count,
+			                            field_count);
+		}
+		if (result.batches.empty() || result.batch_sizes.back() == STANDARD_VECTOR_SIZE) {
+			result.batches.emplace_back(column_count);
+			result.batch_sizes.push_back(0);
+		}
+		auto &fields = result.batches.back();
+		auto row_idx = result.batch_sizes.back()++;
+		for (idx_t c = 0; c < column_count; c++) {
+			if (ptr + sizeof(int32_t) > end) {
+				throw InvalidInputException("Truncated binary COPY stream");
+			}
+			auto value_len = PostgresBinaryReader::LoadInteger<int32_t>(ptr);
+			ptr += sizeof(int32_t);
+			fields[c].length[row_idx] = value_len;
+			if (value_len < 0) {
+				continue;
+			}
+			if (ptr + value_len > end) {
+				throw InvalidInputException("Truncated binary COPY stream");
+			}
+			fields[c].data[row_idx] = ptr;
+			ptr += value_len;
+		}
+	}
+	return result;
+}
+
+//! Decode all batches of the stream into vectors - returns the elapsed time
+static double DecodeStream(const LocatedStream &stream, const vector<PostgresColumnDecoder> &decoders,
+                           const vector<LogicalType> &types, vector<unique_ptr<DataChunk>> *decoded = nullptr) {
+	PostgresConnection connection;
+	PostgresBinaryReader reader(connection);
+	DataChunk chunk;
+	chunk.Initialize(Allocator::DefaultAllocator(), types);
+	double elapsed = 0;
+	for (idx_t b = 0; b < stream.batches.size(); b++) {
+		chunk.Reset();
+		auto count = stream.batch_sizes[b];
+		auto start = GetTime();
+		for (idx_t c = 0; c < decoders.size(); c++) {
+			decoders[c].Decode(reader, stream.batches[b][c], count, chunk.data[c]);
+		}
+		elapsed += GetTime() - start;
+		chunk.SetCardinality(count);
+		if (decoded) {
+			auto copy = make_uniq<DataChunk>();
+			copy->Initialize(Allocator::DefaultAllocator(), types);
+			chunk.Copy(*copy);
+			decoded->push_back(std::move(copy));
+		}
+	}
+	return elapsed;
+}
+
+static void VerifyRoundTrip(const vector<unique_ptr<DataChunk>> &source, const vector<unique_ptr<DataChunk>> &decoded,
+                            const string &type) {
+	if (source.size() != decoded.size()) {
+		throw InternalException("%s: decoded %llu chunks, expected %llu", type, decoded.size(), source.size());
+	}
+	for (idx_t i = 0; i < source.size(); i++) {
+		for (idx_t r = 0; r < source[i]->size(); r++) {
+			auto expected = source[i]->GetValue(0, r);
+			auto result = decoded[i]->GetValue(0, r);
+			if (!Value::NotDistinctFrom(expected, result)) {
+				throw InternalException("%s: decoded %s, expected %s", type, result.ToString(), expected.ToString());
+			}
+		}
+	}
+}
+
+static BinaryBenchmarkResult BenchmarkType(Connection &con, const BinaryBenchmarkConfig &config, const string &type,
+                                           const string &expression) {
+	BinaryBenchmarkResult result;
+	result.type = type;
+	auto query = StringUtil::Format("SELECT (%s)::%s FROM range(%llu) t(i)", expression, type, config.rows);
+	auto query_result = con.Query(query);
+	if (query_result->HasError()) {
+		throw IOException("Failed to generate values for %s: %s", type, query_result->GetError());
+	}
+	vector<unique_ptr<DataChunk>> chunks;
+	while (auto chunk = query_result->Fetch()) {
+		chunks.push_back(std::move(chunk));
+	}
+	auto logical_type = query_result->types[0];
+	result.values = config.rows;
+
+	// encode the values - the stream of the last repetition is decoded
+	unique_ptr<PostgresBinaryWriter> writer;
+	for (idx_t rep = 0; rep < config.repetitions; rep++) {
+		writer = make_uniq<PostgresBinaryWriter>();
+		writer->WriteHeader();
+		auto start = GetTime();
+		for (auto &chunk : chunks) {
+			writer->WriteChunk(*chunk);
+		}
+		result.encode_timings.push_back(GetTime() - start);
+		writer->WriteFooter();
+	}
+	auto stream = LocateRows(writer->stream.GetData(), writer->stream.GetPosition(), 1);
+	result.bytes = stream.bytes;
+
+	vector<PostgresColumnDecoder> decoders;
+	auto postgres_type = PostgresUtils::CreateEmptyPostgresType(logical_type);
+	decoders.push_back(PostgresColumnDecoder::Create(logical_type, postgres_type));
+	vector<LogicalType> types {logical_type};
+	vector<unique_ptr<DataChunk>> decoded;
+	DecodeStream(stream, decoders, types, &decoded);
+	VerifyRoundTrip(chunks, decoded, type);
+	for (idx_t rep = 0; rep < config.repetitions; rep++) {
+		result.decode_timings.push_back(DecodeStream(stream, decoders, types));
+	}
+	return result;
+}
+
+static BinaryBenchmarkResult BenchmarkInput(Connection &con, const BinaryBenchmarkConfig &config) {
+	vector<LogicalType> types;
+	vector<PostgresColumnDecoder> decoders;
+	for (auto &type_name : config.input_types) {
+		PostgresType postgres_type;
+		LogicalType type;
+		if (StringUtil::CIEquals(type_name, "JSONB")) {
+			type = LogicalType::VARCHAR;
+			postgres_type.info = PostgresTypeAnnotation::JSONB;
+		} else {
+			type = TransformStringToLogicalType(type_name, *con.context);
+			postgres_type = PostgresUtils::CreateEmptyPostgresType(type);
+		}
+		decoders.push_back(PostgresColumnDecoder::Create(type, postgres_type));
+		types.push_back(std::move(type));
+	}
+	std::ifstream in(config.input, std::ios::binary);
+	if (!in) {
+		throw IOException("Failed to open \"%s\"", config.input);
+	}
+	string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	auto stream = LocateRows(data_ptr_cast(&data[0]), data.size(), types.size());
+
+	BinaryBenchmarkResult result;
+	result.type = StringUtil::Join(config.input_types, ",");
+	for (auto &batch_size : stream.batch_sizes) {
+		result.values += batch_size * types.size();
+	}
+	result.bytes = stream.bytes;
+	for (idx_t rep = 0; rep < config.repetitions; rep++) {
+		result.decode_timings.push_back(DecodeStream(stream, decoders, types));
+	}
+	return result;
+}
+
+static double Minimum(const vector<double> &timings) {
+	double result = timings.empty() ? 0 : timings[0];
+	for (auto timing : timings) {
+		result = MinValue<double>(result, timing);
+	}
+	return result;
+}
+
+static string ToJSON(const vector<BinaryBenchmarkResult> &results) {
+	string json = "{\n  \"results\": [";
+	for (idx_t i = 0; i < results.size(); i++) {
+		auto &result = results[i];
+		json += i > 0 ? ",\n" : "\n";
+		json += "    {\"type\": \"" + result.type + "\"";
+		json += ", \"values\": " + to_string(result.values);
+		json += ", \"bytes\": " + to_string(result.bytes);
+		if (!result.encode_timings.empty()) {
+			json += ", \"encode_ns_per_value\": " + to_string(Minimum(result.encode_timings) * 1e9 / result.values);
+		}
+		json += ", \"decode_ns_per_value\": " + to_string(Minimum(result.decode_timings) * 1e9 / result.values);
+		json += "}";
+	}
+	json += "\n  ]\n}\n";
+	return json;
+}
+
+static BinaryBenchmarkConfig ParseArguments(int argc, char **argv) {
+	BinaryBenchmarkConfig config;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		auto pos = argument.find('=');
+		if (!StringUtil::StartsWith(argument, "--") || pos == string::npos) {
+			throw InvalidInputException("Usage: postgres_binary_benchmark [--rows=N] [--repetitions=N] "
+			                            "[--input=FILE --types=TYPE,...] [--output=FILE]");
+		}
+		auto key = argument.substr(2, pos - 2);
+		auto value = argument.substr(pos + 1);
+		if (key == "rows") {
+			config.rows = std::stoull(value);
+		} else if (key == "repetitions") {
+			config.repetitions = MaxValue<idx_t>(std::stoull(value), 1);
+		} else if (key == "input") {
+			config.input = value;
+		} else if (key == "types") {
+			config.input_types = StringUtil::Split(value, ',');
+		} else if (key == "output") {
+			config.output = value;
+		} else {
+			throw InvalidInputException("Unrecognized argument \"%s\"", argument);
+		}
+	}
+	if (!config.input.empty() && config.input_types.empty()) {
+		throw InvalidInputException("The types of the columns of the input have to be provided with --types");
+	}
+	return config;
+}
+
+int main(int argc, char **argv) {
+	try {
+		auto config = ParseArguments(argc, argv);
+		DuckDB db(nullptr);
+		Connection con(db);
+		vector<BinaryBenchmarkResult> results;
+		if (!config.input.empty()) {
+			results.push_back(BenchmarkInput(con, config));
+		} else {
+			for (auto &entry : BENCHMARK_TYPES) {
+				results.push_back(BenchmarkType(con, config, entry.first, entry.second));
+			}
+		}
+		auto json = ToJSON(results);
+		if (config.output.empty()) {
+			std::cout << json;
+		} else {
+			std::ofstream out(config.output);
+			out << json;
+		}
+	} catch (std::exception &ex) {
+		ErrorData error(ex);
+		std::cerr << error.Message() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,340 @@
+// Benchmark harness for the Postgres extension
+// Generates tables of a configurable width and type mix in a (local) Postgres database and measures the throughput
+// of scans, INSERT, UPDATE and DELETE and the latency of attaching the database - the results are emitted as JSON
+//
+// The database is expected to exist, e.g. created by create-postgres-tables.sh:
+//   postgres_scanner_benchmark --dsn="dbname=postgresscanner" --rows=1000000 --types=int,text,jsonb \
+//       --threads=1,4,16 --pages-per-task=1000,10000 --output=results.json
+#include "duckdb.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+using namespace duckdb;
+
+#ifndef POSTGRES_SCANNER_EXTENSION_PATH
+#define POSTGRES_SCANNER_EXTENSION_PATH ""
+#endif
+
+struct BenchmarkConfig {
+	string dsn = "dbname=postgresscanner";
+	string extension_path = POSTGRES_SCANNER_EXTENSION_PATH;
+	string output;
+	idx_t rows = 1000000;
+	//! The amount of columns of each of the types
+	idx_t width = 1;
+	vector<string> types = {"int", "numeric", "text", "jsonb", "array", "timestamp"};
+	vector<idx_t> threads = {1, 4, 16};
+	vector<idx_t> pages_per_task = {1000, 10000};
+	idx_t repetitions = 3;
+	idx_t attach_repetitions = 10;
+};
+
+struct BenchmarkResult {
+	string name;
+	idx_t threads = 0;
+	idx_t pages_per_task = 0;
+	idx_t rows = 0;
+	idx_t bytes = 0;
+	vector<double> timings;
+};
+
+static const char *const SCHEMA_NAME = "duckdb_benchmark";
+static const char *const SOURCE_TABLE = "source";
+static const char *const TARGET_TABLE = "target";
+
+static void PrintUsage() {
+	std::cerr << "Usage: postgres_scanner_benchmark [--dsn=DSN] [--extension=PATH] [--output=FILE] [--rows=N]\n"
+	             "       [--width=N] [--types=int,numeric,text,jsonb,array,timestamp] [--threads=1,4,16]\n"
+	             "       [--pages-per-task=1000,10000] [--repetitions=N] [--attach-repetitions=N]\n";
+}
+
+static vector<idx_t> ParseNumbers(const string &value) {
+	vector<idx_t> result;
+	for (auto &entry : StringUtil::Split(value, ',')) {
+		result.push_back(std::stoull(entry));
+	}
+	return result;
+}
+
+static BenchmarkConfig ParseArguments(int argc, char **argv) {
+	BenchmarkConfig config;
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		auto pos = argument.find('=');
+		if (!StringUtil::StartsWith(argument, "--") || pos == string::npos) {
+			PrintUsage();
+			throw InvalidInputException("Unrecognized argument \"%s\"", argument);
+		}
+		auto key = argument.substr(2, pos - 2);
+		auto value = argument.substr(pos + 1);
+		if (key == "dsn") {
+			config.dsn = value;
+		} else if (key == "extension") {
+			config.extension_path = value;
+		} else if (key == "output") {
+			config.output = value;
+		} else if (key == "rows") {
+			config.rows = std::stoull(value);
+		} else if (key == "width") {
+			config.width = std::stoull(value);
+		} else if (key == "types") {
+			config.types = StringUtil::Split(value, ',');
+		} else if (key == "threads") {
+			config.threads = ParseNumbers(value);
+		} else if (key == "pages-per-task") {
+			config.pages_per_task = ParseNumbers(value);
+		} else if (key == "repetitions") {
+			config.repetitions = std::stoull(value);
+		} else if (key == "attach-repetitions") {
+			config.attach_repetitions = std::stoull(value);
+		} else {
+			PrintUsage();
+			throw InvalidInputException("Unrecognized argument \"%s\"", argument);
+		}
+	}
+	if (config.extension_path.empty()) {
+		throw InvalidInputException("The path of the postgres_scanner extension has to be provided with --extension");
+	}
+	return config;
+}
+
+//! The expression that generates the values of a column of the given type in Postgres
+static string GetColumnExpression(const string &type, idx_t column_idx) {
+	auto offset = to_string(column_idx);
+	if (type == "int") {
+		return "(i + " + offset + ")::INTEGER";
+	} else if (type == "numeric") {
+		return "((i + " + offset + ") * 1.37)::NUMERIC(18, 2)";
+	} else if (type == "text") {
+		return "md5((i + " + offset + ")::TEXT)";
+	} else if (type == "jsonb") {
+		return "jsonb_build_object('id', i, 'name', md5((i + " + offset + ")::TEXT), 'tags', jsonb_build_array(i % 7))";
+	} else if (type == "array") {
+		return "ARRAY[i, i + " + offset + ", i * 2]::BIGINT[]";
+	} else if (type == "timestamp") {
+		return "TIMESTAMP '2000-01-01' + (i + " + offset + ") * INTERVAL '1 second'";
+	}
+	throw InvalidInputException("Unsupported column type \"%s\" - supported are int, numeric, text, jsonb, array and "
+	                            "timestamp",
+	                            type);
+}
+
+static unique_ptr<MaterializedQueryResult> Run(Connection &con, const string &query) {
+	auto result = con.Query(query);
+	if (result->HasError()) {
+		throw IOException("Benchmark query \"%s\" failed: %s", query, result->GetError());
+	}
+	return result;
+}
+
+static string PostgresExecute(const string &query) {
+	return "CALL postgres_execute('pg', " + KeywordHelper::WriteQuoted(query, '\'') + ")";
+}
+
+template <class FUNC>
+static double Time(FUNC &&func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+static void Attach(Connection &con, const BenchmarkConfig &config) {
+	Run(con, "ATTACH " + KeywordHelper::WriteQuoted(config.dsn, '\'') + " AS pg (TYPE POSTGRES)");
+}
+
+static vector<string> CreateSourceTable(Connection &con, const BenchmarkConfig &config) {
+	vector<string> columns;
+	vector<string> expressions;
+	for (auto &type : config.types) {
+		for (idx_t i = 0; i < config.width; i++) {
+			columns.push_back(StringUtil::Format("c_%s_%llu", type, i));
+			expressions.push_back(GetColumnExpression(type, i) + " AS " + columns.back());
+		}
+	}
+	auto source = StringUtil::Format("%s.%s", SCHEMA_NAME, SOURCE_TABLE);
+	Run(con, PostgresExecute(StringUtil::Format("CREATE SCHEMA IF NOT EXISTS %s", SCHEMA_NAME)));
+	Run(con, PostgresExecute("DROP TABLE IF EXISTS " + source));
+	Run(con, PostgresExecute(StringUtil::Format("CREATE TABLE %s AS SELECT %s FROM generate_series(1, %llu) i", source,
+	                                            StringUtil::Join(expressions, ", "), config.rows)));
+	// update the statistics so that the pages of the table are known when the scans are parallelized
+	Run(con, PostgresExecute("ANALYZE " + source));
+	Run(con, "CALL pg_clear_cache()");
+	return columns;
+}
+
+static idx_t GetTableSize(Connection &con, const string &table_name) {
+	auto query = StringUtil::Format("SELECT pg_relation_size('%s.%s')", SCHEMA_NAME, table_name);
+	auto result = Run(con, "SELECT * FROM postgres_query('pg', " + KeywordHelper::WriteQuoted(query, '\'') + ")");
+	return result->GetValue(0, 0).GetValue<idx_t>();
+}
+
+static void RunBenchmark(BenchmarkResult &result, idx_t repetitions, const std::function<void()> &setup,
+                         const std::function<void()> &benchmark) {
+	for (idx_t i = 0; i < repetitions; i++) {
+		if (setup) {
+			setup();
+		}
+		result.timings.push_back(Time(benchmark));
+	}
+}
+
+static double Median(vector<double> timings) {
+	if (timings.empty()) {
+		return 0;
+	}
+	std::sort(timings.begin(), timings.end());
+	auto middle = timings.size() / 2;
+	return timings.size() % 2 == 1 ? timings[middle] : (timings[middle - 1] + timings[middle]) / 2;
+}
+
+static string ToJSON(const BenchmarkConfig &config, const vector<BenchmarkResult> &results) {
+	string json = "{\n  \"rows\": " + to_string(config.rows) + ",\n  \"width\": " + to_string(config.width) +
+	              ",\n  \"types\": [";
+	for (idx_t i = 0; i < config.types.size(); i++) {
+		json += (i > 0 ? ", \"" : "\"") + config.types[i] + "\"";
+	}
+	json += "],\n  \"results\": [";
+	for (idx_t i = 0; i < results.size(); i++) {
+		auto &result = results[i];
+		auto median = Median(result.timings);
+		json += i > 0 ? ",\n" : "\n";
+		json += "    {\"name\": \"" + result.name + "\"";
+		json += ", \"threads\": " + to_string(result.threads);
+		json += ", \"pages_per_task\": " + to_string(result.pages_per_task);
+		json += ", \"rows\": " + to_string(result.rows);
+		json += ", \"median_seconds\": " + to_string(median);
+		if (result.rows > 0 && median > 0) {
+			json += ", \"rows_per_second\": " + to_string(double(result.rows) / median);
+		}
+		if (result.bytes > 0 && median > 0) {
+			json += ", \"mb_per_second\": " + to_string(double(result.bytes) / median / 1000000.0);
+		}
+		json += ", \"timings\": [";
+		for (idx_t t = 0; t < result.timings.size(); t++) {
+			json += (t > 0 ? ", " : "") + to_string(result.timings[t]);
+		}
+		json += "]}";
+	}
+	json += "\n  ]\n}\n";
+	return json;
+}
+
+static void RunBenchmarks(const BenchmarkConfig &config) {
+	DBConfig db_config;
+	db_config.options.allow_unsigned_extensions = true;
+	DuckDB db(nullptr, &db_config);
+	Connection con(db);
+	Run(con, "LOAD " + KeywordHelper::WriteQuoted(config.extension_path, '\''));
+	Attach(con, config);
+	// measure the extension - not the optimizations that avoid the transfer of data
+	Run(con, "SET pg_aggregate_pushdown=false");
+	Run(con, "SET pg_result_cache_size=0");
+
+	vector<BenchmarkResult> results;
+	auto columns = CreateSourceTable(con, config);
+	auto source = StringUtil::Format("pg.%s.%s", SCHEMA_NAME, SOURCE_TABLE);
+	auto target = StringUtil::Format("pg.%s.%s", SCHEMA_NAME, TARGET_TABLE);
+	auto source_size = GetTableSize(con, SOURCE_TABLE);
+
+	// catalog: the latency of attaching the database and loading its catalog
+	{
+		BenchmarkResult result;
+		result.name = "attach";
+		RunBenchmark(
+		    result, config.attach_repetitions, [&]() { Run(con, "DETACH pg"); },
+		    [&]() {
+			    Attach(con, config);
+			    Run(con, "SELECT COUNT(*) FROM duckdb_tables() WHERE database_name = 'pg'");
+		    });
+		results.push_back(std::move(result));
+	}
+
+	// scans: every column is decoded - but only an aggregate is returned
+	vector<string> aggregates;
+	for (auto &column : columns) {
+		aggregates.push_back("COUNT(" + column + ")");
+	}
+	auto scan_query = "SELECT " + StringUtil::Join(aggregates, ", ") + " FROM " + source;
+	for (auto threads : config.threads) {
+		for (auto pages_per_task : config.pages_per_task) {
+			Run(con, "SET threads=" + to_string(threads));
+			Run(con, "SET pg_pages_per_task=" + to_string(pages_per_task));
+			BenchmarkResult result;
+			result.name = "scan";
+			result.threads = threads;
+			result.pages_per_task = pages_per_task;
+			result.rows = config.rows;
+			result.bytes = source_size;
+			RunBenchmark(result, config.repetitions, nullptr, [&]() { Run(con, scan_query); });
+			results.push_back(std::move(result));
+		}
+	}
+	Run(con, "RESET pg_pages_per_task");
+
+	// modifications: the rows are inserted from a local copy, so that only the writes to Postgres are measured
+	Run(con, "CREATE OR REPLACE TEMPORARY TABLE benchmark_rows AS FROM " + source);
+	auto create_target =
+	    PostgresExecute(StringUtil::Format("DROP TABLE IF EXISTS %s.%s; CREATE TABLE %s.%s (LIKE %s.%s)", SCHEMA_NAME,
+	                                       TARGET_TABLE, SCHEMA_NAME, TARGET_TABLE, SCHEMA_NAME, SOURCE_TABLE));
+	auto fill_target = [&]() {
+		Run(con, create_target);
+		Run(con, "CALL pg_clear_cache()");
+		Run(con, "INSERT INTO " + target + " FROM benchmark_rows");
+	};
+	for (auto threads : config.threads) {
+		Run(con, "SET threads=" + to_string(threads));
+		BenchmarkResult insert_result;
+		insert_result.name = "insert";
+		insert_result.threads = threads;
+		insert_result.rows = config.rows;
+		insert_result.bytes = source_size;
+		RunBenchmark(
+		    insert_result, config.repetitions,
+		    [&]() {
+			    Run(con, create_target);
+			    Run(con, "CALL pg_clear_cache()");
+		    },
+		    [&]() { Run(con, "INSERT INTO " + target + " FROM benchmark_rows"); });
+		results.push_back(std::move(insert_result));
+
+		BenchmarkResult update_result;
+		update_result.name = "update";
+		update_result.threads = threads;
+		update_result.rows = config.rows;
+		auto update_query = StringUtil::Format("UPDATE %s SET %s = %s", target, columns[0], columns[0]);
+		RunBenchmark(update_result, config.repetitions, fill_target, [&]() { Run(con, update_query); });
+		results.push_back(std::move(update_result));
+
+		BenchmarkResult delete_result;
+		delete_result.name = "delete";
+		delete_result.threads = threads;
+		delete_result.rows = config.rows;
+		RunBenchmark(delete_result, config.repetitions, fill_target, [&]() { Run(con, "DELETE FROM " + target); });
+		results.push_back(std::move(delete_result));
+	}
+	Run(con, PostgresExecute(StringUtil::Format("DROP SCHEMA %s CASCADE", SCHEMA_NAME)));
+
+	auto json = ToJSON(config, results);
+	if (config.output.empty()) {
+		std::cout << json;
+	} else {
+		std::ofstream out(config.output);
+		out << json;
+	}
+}
+
+int main(int argc, char **argv) {
+	try {
+		RunBenchmarks(ParseArguments(argc, argv));
+	} catch (std::exception &ex) {
+		ErrorData error(ex);
+		std::cerr << error.Message() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,43 @@
+-- Server-side helper for receiving scans compressed (pg_copy_compression_function)
+--
+-- The function receives the query of a scan, and returns the binary COPY output of the query
+-- ("COPY (query) TO STDOUT (FORMAT binary)") compressed with zlib. The compressed stream can be split over any
+-- amount of bytea values - the values are decompressed as they arrive.
+--
+-- Install the function in the database, then enable it in DuckDB:
+--   SET pg_copy_compression_function='postgres_compressed_copy';
+
+CREATE OR REPLACE FUNCTION postgres_compressed_copy(query text) RETURNS SETOF bytea AS $$
+import struct
+import zlib
+
+# the amount of uncompressed data that is compressed into a single bytea value
+frame_size = 1024 * 1024
+compressor = zlib.compressobj(1)
+parts = [b'PGCOPY\n\xff\r\n\x00', struct.pack('>ii', 0, 0)]
+size = 0
+# record_send encodes a row as the column count followed by (type oid, length, value) for every column
+# the values have the same encoding as in the binary COPY format
+cursor = plpy.cursor('SELECT record_send(t) AS r FROM (' + query + ') t')
+while True:
+    rows = cursor.fetch(1000)
+    if not rows:
+        break
+    for row in rows:
+        record = row['r']
+        column_count = struct.unpack_from('>i', record, 0)[0]
+        parts.append(struct.pack('>h', column_count))
+        offset = 4
+        for _ in range(column_count):
+            length = struct.unpack_from('>i', record, offset + 4)[0]
+            end = offset + 8 + max(length, 0)
+            parts.append(record[offset + 4:end])
+            size += end - offset
+            offset = end
+        if size >= frame_size:
+            yield compressor.compress(b''.join(parts)) + compressor.flush(zlib.Z_SYNC_FLUSH)
+            parts = []
+            size = 0
+parts.append(struct.pack('>h', -1))
+yield compressor.compress(b''.join(parts)) + compressor.flush(zlib.Z_FINISH)
+$$ LANGUAGE plpython3u;
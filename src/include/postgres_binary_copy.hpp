@@ -32,6 +32,19 @@ public:
 	                                       GlobalFunctionData &gstate, LocalFunctionData &lstate);
 	static void PostgresBinaryWriteFinalize(ClientContext &context, FunctionData &bind_data,
 	                                        GlobalFunctionData &gstate);
+	static CopyFunctionExecutionMode PostgresBinaryWriteExecutionMode(bool preserve_insertion_order,
+	                                                                  bool supports_batch_index);
+	static idx_t PostgresBinaryWriteFileSize(GlobalFunctionData &gstate);
+};
+
+//! Reads files in the Postgres binary COPY format (e.g. written by COPY ... TO 'file' (FORMAT binary)) in parallel
+class PostgresBinaryReadFunction : public TableFunction {
+public:
+	PostgresBinaryReadFunction();
+
+	//! Bind COPY ... FROM 'file' (FORMAT postgres_binary) - the columns have the types of the target table
+	static unique_ptr<FunctionData> CopyFromBind(ClientContext &context, CopyInfo &info, vector<string> &expected_names,
+	                                             vector<LogicalType> &expected_types);
 };
 
 } // namespace duckdb
@@ -0,0 +1,507 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_binary_decoder.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/string_map_set.hpp"
+#include "postgres_binary_reader.hpp"
+
+namespace duckdb {
+struct PostgresColumnDecoder;
+
+typedef void (*postgres_decode_function_t)(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+                                           const PostgresColumnFields &fields, idx_t count, Vector &result);
+
+//! Maps the labels of an ENUM type to their index - the labels are owned by the type of the decoder
+struct PostgresEnumIndex {
+	string_map_t<uint32_t> labels;
+};
+
+//! The dictionary of the current batch of a column that is decoded into a dictionary vector
+struct PostgresStringDictionary {
+	//! The distinct strings of the batch - the keys point into the row buffers
+	string_map_t<sel_t> entries;
+};
+
+//! Decodes a column of a batch of rows located by PostgresBinaryReader::ReadRowFields into a vector
+//! The decode function is resolved once per scan, so decoding a batch does not have to dispatch on the type per value
+struct PostgresColumnDecoder {
+	LogicalType type;
+	PostgresType postgres_type;
+	postgres_decode_function_t decode = nullptr;
+	//! Whether or not the decoded strings point directly into the row buffers
+	bool references_row_buffers = false;
+	//! The label index of an ENUM column
+	shared_ptr<PostgresEnumIndex> enum_index;
+	//! The dictionary of a string column that is decoded into dictionary vectors
+	shared_ptr<PostgresStringDictionary> dictionary;
+
+public:
+	//! If dictionary is set, a string column is decoded into a dictionary vector per batch (unless the batch turns
+	//! out to have too many distinct values)
+	static PostgresColumnDecoder Create(const LogicalType &type, const PostgresType &postgres_type,
+	                                    bool zero_copy = false, bool dictionary = false);
+	//! Decoder for the ctid of a row, emitted as the row id of the scan
+	static PostgresColumnDecoder CreateCTID();
+
+	void Decode(PostgresBinaryReader &reader, const PostgresColumnFields &fields, idx_t count, Vector &result) const {
+		decode(reader, *this, fields, count, result);
+	}
+};
+
+struct PostgresDecoders {
+	static void VerifyLength(int32_t value_len, idx_t expected_len) {
+		if (idx_t(value_len) != expected_len) {
+			throw IOException("Postgres scanner - expected a value of %llu bytes but got %d bytes", expected_len,
+			                  value_len);
+		}
+	}
+
+	//! Decodes a fixed-width column in two passes: the raw big-endian values are first gathered from the row buffers
+	//! into a contiguous staging array, after which the byte-swap and the conversion (epoch adjustments and infinity
+	//! checks) are done in a single branch-free loop that the compiler can vectorize
+	template <class T, class OP>
+	static void DecodeFixed(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                        const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		D_ASSERT(count <= STANDARD_VECTOR_SIZE);
+		auto result_data = FlatVector::GetData<typename OP::RESULT_TYPE>(result);
+		auto &validity = FlatVector::Validity(result);
+		T staging[STANDARD_VECTOR_SIZE];
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				validity.SetInvalid(row_idx);
+				staging[row_idx] = T(0);
+				continue;
+			}
+			VerifyLength(value_len, sizeof(T));
+			staging[row_idx] = Load<T>(fields.data[row_idx]);
+		}
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			result_data[row_idx] = OP::Convert(PostgresBinaryReader::NetworkToHost<T>(staging[row_idx]));
+		}
+	}
+
+	template <class T>
+	struct IntegerOperator {
+		using RESULT_TYPE = T;
+		static inline T Convert(T input) {
+			return input;
+		}
+	};
+
+	struct BooleanOperator {
+		using RESULT_TYPE = bool;
+		static inline bool Convert(uint8_t input) {
+			return input > 0;
+		}
+	};
+
+	struct FloatOperator {
+		using RESULT_TYPE = float;
+		static inline float Convert(uint32_t input) {
+			return Load<float>(const_data_ptr_cast(&input));
+		}
+	};
+
+	struct DoubleOperator {
+		using RESULT_TYPE = double;
+		static inline double Convert(uint64_t input) {
+			return Load<double>(const_data_ptr_cast(&input));
+		}
+	};
+
+	struct DateOperator {
+		using RESULT_TYPE = date_t;
+		static inline date_t Convert(uint32_t input) {
+			return PostgresBinaryReader::ConvertDate(input);
+		}
+	};
+
+	struct TimeOperator {
+		using RESULT_TYPE = dtime_t;
+		static inline dtime_t Convert(uint64_t input) {
+			return dtime_t(input);
+		}
+	};
+
+	struct TimestampOperator {
+		using RESULT_TYPE = timestamp_t;
+		static inline timestamp_t Convert(uint64_t input) {
+			return PostgresBinaryReader::ConvertTimestamp(input);
+		}
+	};
+
+	static void DecodeCTID(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                       const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		// ctid in postgres are a composite type of (page_index, tuple_in_page)
+		// the page index is a 4-byte integer, the tuple_in_page a 2-byte integer
+		auto result_data = FlatVector::GetData<int64_t>(result);
+		auto &validity = FlatVector::Validity(result);
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				validity.SetInvalid(row_idx);
+				continue;
+			}
+			VerifyLength(value_len, sizeof(int32_t) + sizeof(int16_t));
+			auto value_ptr = fields.data[row_idx];
+			int64_t page_index = PostgresBinaryReader::LoadInteger<int32_t>(value_ptr);
+			int64_t row_in_page = PostgresBinaryReader::LoadInteger<int16_t>(value_ptr + sizeof(int32_t));
+			result_data[row_idx] = (page_index << 16LL) + row_in_page;
+		}
+	}
+
+	static void DecodeUUID(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                       const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		auto result_data = FlatVector::GetData<hugeint_t>(result);
+		auto &validity = FlatVector::Validity(result);
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				validity.SetInvalid(row_idx);
+				continue;
+			}
+			VerifyLength(value_len, 2 * sizeof(uint64_t));
+			auto value_ptr = fields.data[row_idx];
+			auto upper = PostgresBinaryReader::LoadInteger<uint64_t>(value_ptr);
+			result_data[row_idx].upper = upper ^ (int64_t(1) << 63);
+			result_data[row_idx].lower = PostgresBinaryReader::LoadInteger<uint64_t>(value_ptr + sizeof(uint64_t));
+		}
+	}
+
+	//! Locate the string of a string-like value - strips the version of JSONB and the padding of CHAR values
+	static inline void PrepareString(PostgresTypeAnnotation info, const char *&str, int32_t &value_len) {
+		if (info == PostgresTypeAnnotation::JSONB) {
+			if (value_len < 1) {
+				throw IOException("Postgres scanner - empty JSONB value");
+			}
+			auto version = uint8_t(str[0]);
+			if (version != 1) {
+				throw NotImplementedException("JSONB version number mismatch, expected 1, got %d", version);
+			}
+			str++;
+			value_len--;
+		} else if (info == PostgresTypeAnnotation::FIXED_LENGTH_CHAR) {
+			// CHAR column - remove trailing spaces
+			while (value_len > 0 && str[value_len - 1] == ' ') {
+				value_len--;
+			}
+		}
+	}
+
+	template <bool ZERO_COPY>
+	static void DecodeString(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                         const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		auto result_data = FlatVector::GetData<string_t>(result);
+		auto &validity = FlatVector::Validity(result);
+		auto info = decoder.postgres_type.info;
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				validity.SetInvalid(row_idx);
+				continue;
+			}
+			auto str = const_char_ptr_cast(fields.data[row_idx]);
+			PrepareString(info, str, value_len);
+			if (ZERO_COPY) {
+				result_data[row_idx] = string_t(str, uint32_t(value_len));
+			} else {
+				result_data[row_idx] = StringVector::AddStringOrBlob(result, str, value_len);
+			}
+		}
+	}
+
+	//! Decodes a string column into a dictionary vector - only the distinct strings of the batch are copied
+	//! If more than half of the values of the batch are distinct the batch is decoded into a flat vector instead
+	static void DecodeDictionaryString(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                                   const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		if (count == 0) {
+			return;
+		}
+		auto &entries = decoder.dictionary->entries;
+		entries.clear();
+		Vector dictionary(result.GetType(), count);
+		auto dictionary_data = FlatVector::GetData<string_t>(dictionary);
+		SelectionVector sel(count);
+		idx_t dictionary_size = 0;
+		idx_t null_entry = DConstants::INVALID_INDEX;
+		auto info = decoder.postgres_type.info;
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			if (2 * dictionary_size > count) {
+				DecodeString<false>(reader, decoder, fields, count, result);
+				return;
+			}
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				if (null_entry == DConstants::INVALID_INDEX) {
+					null_entry = dictionary_size++;
+					FlatVector::SetNull(dictionary, null_entry, true);
+				}
+				sel.set_index(row_idx, null_entry);
+				continue;
+			}
+			auto str = const_char_ptr_cast(fields.data[row_idx]);
+			PrepareString(info, str, value_len);
+			auto entry = entries.find(string_t(str, uint32_t(value_len)));
+			if (entry != entries.end()) {
+				sel.set_index(row_idx, entry->second);
+				continue;
+			}
+			auto index = sel_t(dictionary_size++);
+			dictionary_data[index] = StringVector::AddStringOrBlob(dictionary, str, value_len);
+			entries.insert(make_pair(string_t(str, uint32_t(value_len)), index));
+			sel.set_index(row_idx, index);
+		}
+		if (2 * dictionary_size > count) {
+			DecodeString<false>(reader, decoder, fields, count, result);
+			return;
+		}
+		result.Slice(dictionary, sel, count);
+	}
+
+	//! Decodes an ENUM column by looking up the labels in the label index of the decoder
+	template <class T>
+	static void DecodeEnum(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                       const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		auto result_data = FlatVector::GetData<T>(result);
+		auto &validity = FlatVector::Validity(result);
+		auto &labels = decoder.enum_index->labels;
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				validity.SetInvalid(row_idx);
+				continue;
+			}
+			auto label = string_t(const_char_ptr_cast(fields.data[row_idx]), uint32_t(value_len));
+			auto entry = labels.find(label);
+			if (entry == labels.end()) {
+				throw IOException("Could not map ENUM value %s", label.GetString());
+			}
+			result_data[row_idx] = T(entry->second);
+		}
+	}
+
+	static shared_ptr<PostgresEnumIndex> CreateEnumIndex(const LogicalType &type) {
+		auto result = make_shared<PostgresEnumIndex>();
+		auto enum_size = EnumType::GetSize(type);
+		auto labels = FlatVector::GetData<string_t>(EnumType::GetValuesInsertOrder(type));
+		for (idx_t i = 0; i < enum_size; i++) {
+			result->labels.insert(make_pair(labels[i], uint32_t(i)));
+		}
+		return result;
+	}
+
+	//! Decode a single NUMERIC value into the unscaled integer representation of a DECIMAL with the given scale
+	//! The length is validated once, after which the base-10000 digits are read without bounds checks
+	//! Returns false if the value cannot be represented exactly using this fast path
+	template <class T, class OP>
+	static bool TryDecodeDecimal(const_data_ptr_t value_ptr, int32_t value_len, int32_t scale, T &result) {
+		constexpr idx_t HEADER_SIZE = 4 * sizeof(uint16_t);
+		if (value_len < int32_t(HEADER_SIZE)) {
+			throw InvalidInputException("Need at least 8 bytes to read a Postgres decimal. Got %d", value_len);
+		}
+		auto ndigits = PostgresBinaryReader::LoadInteger<uint16_t>(value_ptr);
+		auto weight = PostgresBinaryReader::LoadInteger<int16_t>(value_ptr + sizeof(uint16_t));
+		auto sign = PostgresBinaryReader::LoadInteger<uint16_t>(value_ptr + 2 * sizeof(uint16_t));
+		if (sign != NUMERIC_POS && sign != NUMERIC_NEG) {
+			// NaN and infinity (or an invalid sign) - handled by the generic path
+			return false;
+		}
+		VerifyLength(value_len, HEADER_SIZE + ndigits * sizeof(uint16_t));
+		if (ndigits == 0) {
+			result = T(0);
+			return true;
+		}
+		auto digits = value_ptr + HEADER_SIZE;
+		// the amount of base-10000 digits after the decimal point required for the scale
+		// the last of these digits is partially used if the scale is not a multiple of DEC_DIGITS
+		int32_t fractional_ndigits = (scale + DEC_DIGITS - 1) / DEC_DIGITS;
+		int32_t correction = fractional_ndigits * DEC_DIGITS - scale;
+		int32_t last_position = int32_t(weight) - int32_t(ndigits) + 1;
+		if (last_position < -fractional_ndigits) {
+			// the value has more digits than the scale allows for - use the generic path
+			return false;
+		}
+		auto correction_power = int64_t(DecimalConversionInteger::GetPowerOfTen(correction));
+		// accumulate the first digits in an int64_t - four base-10000 digits always fit
+		idx_t digit_idx = 0;
+		int64_t small_result = 0;
+		for (; digit_idx < ndigits && digit_idx < 4; digit_idx++) {
+			int64_t digit = PostgresBinaryReader::LoadInteger<uint16_t>(digits + digit_idx * sizeof(uint16_t));
+			if (int32_t(weight) - int32_t(digit_idx) == -fractional_ndigits) {
+				small_result = small_result * (NBASE / correction_power) + digit / correction_power;
+			} else {
+				small_result = small_result * NBASE + digit;
+			}
+		}
+		T value = T(small_result);
+		for (; digit_idx < ndigits; digit_idx++) {
+			T digit = T(PostgresBinaryReader::LoadInteger<uint16_t>(digits + digit_idx * sizeof(uint16_t)));
+			if (int32_t(weight) - int32_t(digit_idx) == -fractional_ndigits) {
+				value = value * T(NBASE / correction_power) + digit / T(correction_power);
+			} else {
+				value = value * T(NBASE) + digit;
+			}
+		}
+		// trailing zero digits are not transmitted - compensate for them
+		int32_t missing_ndigits = last_position + fractional_ndigits;
+		if (missing_ndigits > 0) {
+			value *= OP::GetPowerOfTen(idx_t(missing_ndigits * DEC_DIGITS - correction));
+		}
+		result = sign == NUMERIC_NEG ? -value : value;
+		return true;
+	}
+
+	template <class T, class OP>
+	static void DecodeDecimal(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                          const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		auto result_data = FlatVector::GetData<T>(result);
+		auto &validity = FlatVector::Validity(result);
+		auto scale = int32_t(DecimalType::GetScale(decoder.type));
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				validity.SetInvalid(row_idx);
+				continue;
+			}
+			if (!TryDecodeDecimal<T, OP>(fields.data[row_idx], value_len, scale, result_data[row_idx])) {
+				reader.ReadField(decoder.type, decoder.postgres_type, fields.data[row_idx], value_len, result,
+				                 row_idx);
+			}
+		}
+	}
+
+	//! Fallback for types without a specialized decoder - goes through PostgresBinaryReader::ReadValueData
+	static void DecodeGeneric(PostgresBinaryReader &reader, const PostgresColumnDecoder &decoder,
+	                          const PostgresColumnFields &fields, idx_t count, Vector &result) {
+		for (idx_t row_idx = 0; row_idx < count; row_idx++) {
+			auto value_len = fields.length[row_idx];
+			if (value_len < 0) {
+				FlatVector::SetNull(result, row_idx, true);
+				continue;
+			}
+			reader.ReadField(decoder.type, decoder.postgres_type, fields.data[row_idx], value_len, result, row_idx);
+		}
+	}
+
+	//! Whether or not the binary representation of the type is (a prefixed) string that can be referenced directly
+	static bool DecodesAsString(const LogicalType &type, const PostgresType &postgres_type) {
+		if (type.id() != LogicalTypeId::VARCHAR && type.id() != LogicalTypeId::BLOB) {
+			return false;
+		}
+		switch (postgres_type.info) {
+		case PostgresTypeAnnotation::STANDARD:
+		case PostgresTypeAnnotation::CAST_TO_VARCHAR:
+		case PostgresTypeAnnotation::JSONB:
+		case PostgresTypeAnnotation::FIXED_LENGTH_CHAR:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static postgres_decode_function_t GetDecodeFunction(const LogicalType &type, const PostgresType &postgres_type,
+	                                                    bool zero_copy, bool dictionary) {
+		switch (type.id()) {
+		case LogicalTypeId::SMALLINT:
+			return DecodeFixed<int16_t, IntegerOperator<int16_t>>;
+		case LogicalTypeId::INTEGER:
+			return DecodeFixed<int32_t, IntegerOperator<int32_t>>;
+		case LogicalTypeId::UINTEGER:
+			return DecodeFixed<uint32_t, IntegerOperator<uint32_t>>;
+		case LogicalTypeId::BIGINT:
+			if (postgres_type.info == PostgresTypeAnnotation::CTID) {
+				return DecodeCTID;
+			}
+			return DecodeFixed<int64_t, IntegerOperator<int64_t>>;
+		case LogicalTypeId::BOOLEAN:
+			return DecodeFixed<uint8_t, BooleanOperator>;
+		case LogicalTypeId::FLOAT:
+			return DecodeFixed<uint32_t, FloatOperator>;
+		case LogicalTypeId::DOUBLE:
+			if (postgres_type.info == PostgresTypeAnnotation::NUMERIC_AS_DOUBLE) {
+				return DecodeGeneric;
+			}
+			return DecodeFixed<uint64_t, DoubleOperator>;
+		case LogicalTypeId::DATE:
+			return DecodeFixed<uint32_t, DateOperator>;
+		case LogicalTypeId::TIME:
+			return DecodeFixed<uint64_t, TimeOperator>;
+		case LogicalTypeId::TIMESTAMP:
+		case LogicalTypeId::TIMESTAMP_TZ:
+			return DecodeFixed<uint64_t, TimestampOperator>;
+		case LogicalTypeId::UUID:
+			return DecodeUUID;
+		case LogicalTypeId::DECIMAL:
+			switch (type.InternalType()) {
+			case PhysicalType::INT16:
+				return DecodeDecimal<int16_t, DecimalConversionInteger>;
+			case PhysicalType::INT32:
+				return DecodeDecimal<int32_t, DecimalConversionInteger>;
+			case PhysicalType::INT64:
+				return DecodeDecimal<int64_t, DecimalConversionInteger>;
+			case PhysicalType::INT128:
+				return DecodeDecimal<hugeint_t, DecimalConversionHugeint>;
+			default:
+				return DecodeGeneric;
+			}
+		case LogicalTypeId::VARCHAR:
+		case LogicalTypeId::BLOB:
+			if (!DecodesAsString(type, postgres_type)) {
+				return DecodeGeneric;
+			}
+			if (dictionary) {
+				return DecodeDictionaryString;
+			}
+			return zero_copy ? DecodeString<true> : DecodeString<false>;
+		case LogicalTypeId::ENUM:
+			switch (type.InternalType()) {
+			case PhysicalType::UINT8:
+				return DecodeEnum<uint8_t>;
+			case PhysicalType::UINT16:
+				return DecodeEnum<uint16_t>;
+			case PhysicalType::UINT32:
+				return DecodeEnum<uint32_t>;
+			default:
+				return DecodeGeneric;
+			}
+		default:
+			return DecodeGeneric;
+		}
+	}
+};
+
+inline PostgresColumnDecoder PostgresColumnDecoder::Create(const LogicalType &type, const PostgresType &postgres_type,
+                                                           bool zero_copy, bool dictionary) {
+	PostgresColumnDecoder result;
+	result.type = type;
+	result.postgres_type = postgres_type;
+	dictionary = dictionary && PostgresDecoders::DecodesAsString(type, postgres_type);
+	// the distinct strings of a dictionary are copied - so they never reference the row buffers
+	result.references_row_buffers = !dictionary && zero_copy && PostgresDecoders::DecodesAsString(type, postgres_type);
+	result.decode =
+	    PostgresDecoders::GetDecodeFunction(type, postgres_type, result.references_row_buffers, dictionary);
+	if (dictionary) {
+		result.dictionary = make_shared<PostgresStringDictionary>();
+	}
+	if (type.id() == LogicalTypeId::ENUM) {
+		// index the labels once - instead of looking up every value with EnumType::GetPos
+		result.enum_index = PostgresDecoders::CreateEnumIndex(result.type);
+	}
+	return result;
+}
+
+inline PostgresColumnDecoder PostgresColumnDecoder::CreateCTID() {
+	PostgresType ctid_type;
+	ctid_type.info = PostgresTypeAnnotation::CTID;
+	return Create(LogicalType::BIGINT, ctid_type);
+}
+
+} // namespace duckdb
@@ -11,21 +11,133 @@
 #include "duckdb.hpp"
 #include "duckdb/common/types/interval.hpp"
 #include "postgres_conversion.hpp"
+#include "postgres_copy_prefetcher.hpp"
+#include "postgres_copy_decompressor.hpp"
+#include "postgres_copy_data.h"
+#include "postgres_memory_budget.hpp"
+#include "postgres_row_arena.hpp"
+#include "postgres_result.hpp"
+#include "postgres_scan_statistics.hpp"
 
 namespace duckdb {
 
+//! The location of the values of a single column within a batch of rows read from a binary COPY stream
+struct PostgresColumnFields {
+	PostgresColumnFields() : data(STANDARD_VECTOR_SIZE), length(STANDARD_VECTOR_SIZE) {
+	}
+
+	//! Pointers to the start of every value within the (retained) row buffers
+	vector<data_ptr_t> data;
+	//! The length of every value, -1 signifies NULL
+	vector<int32_t> length;
+};
+
+//! Keeps row buffers and results received from libpq alive - attached to output vectors that reference them
+class PostgresRowBuffers : public VectorBuffer {
+public:
+	explicit PostgresRowBuffers(vector<data_ptr_t> buffers_p, vector<shared_ptr<PostgresResult>> results_p = {},
+	                            PostgresMemoryReservation reservation_p = PostgresMemoryReservation(),
+	                            postgres_free_buffer_t free_buffer_p = PQfreemem)
+	    : VectorBuffer(VectorBufferType::OPAQUE_BUFFER), buffers(std::move(buffers_p)), results(std::move(results_p)),
+	      reservation(std::move(reservation_p)), free_buffer(free_buffer_p) {
+	}
+	~PostgresRowBuffers() override {
+		for (auto &buffer : buffers) {
+			free_buffer(buffer);
+		}
+	}
+
+private:
+	vector<data_ptr_t> buffers;
+	vector<shared_ptr<PostgresResult>> results;
+	//! The memory accounted for the row buffers - released after the buffers have been freed
+	PostgresMemoryReservation reservation;
+	postgres_free_buffer_t free_buffer;
+};
+
 struct PostgresBinaryReader {
-	explicit PostgresBinaryReader(PostgresConnection &con_p) : con(con_p) {
+	explicit PostgresBinaryReader(PostgresConnection &con_p,
+	                              optional_ptr<PostgresCopyPrefetcher> prefetcher_p = nullptr,
+	                              optional_ptr<PostgresCopyDecompressor> decompressor_p = nullptr)
+	    : con(con_p), prefetcher(prefetcher_p), decompressor(decompressor_p) {
+		if (prefetcher) {
+			free_buffer = prefetcher->GetFreeFunction();
+		} else if (decompressor) {
+			free_buffer = PostgresCopyDecompressor::FreeMessage;
+		}
 	}
 	~PostgresBinaryReader() {
 		Reset();
+		ReleaseRows();
+	}
+
+	//! Called after the COPY has been started - starts receiving rows if prefetching is enabled
+	void BeginCopy() {
+		if (decompressor) {
+			decompressor->Reset();
+		}
+		if (prefetcher) {
+			prefetcher->Start();
+		}
 	}
 
 	bool Next() {
 		Reset();
+		idx_t start_time = collect_statistics ? PostgresScanStatistics::Now() : 0;
+		if (prefetcher) {
+			data_ptr_t new_buffer;
+			idx_t len;
+			auto has_next = prefetcher->Next(new_buffer, len);
+			if (collect_statistics) {
+				wait_time_ns += PostgresScanStatistics::Now() - start_time;
+				bytes_received += has_next ? len : 0;
+			}
+			if (!has_next) {
+				return false;
+			}
+			if (len < sizeof(int16_t)) {
+				free_buffer(new_buffer);
+				throw IOException("Unable to read binary COPY data from Postgres: message too short");
+			}
+			buffer = new_buffer;
+			buffer_ptr = buffer;
+			end = buffer + len;
+			ReserveRow(len);
+			return true;
+		}
+		if (decompressor) {
+			return NextDecompressed(start_time);
+		}
+		if (arena) {
+			// copy the row straight from the receive buffer of the connection into the arena - if it is there
+			const char *copy_data;
+			int copy_len = postgres_peek_copy_data(con.GetConn(), &copy_data);
+			if (copy_len > 0) {
+				auto row_len = idx_t(copy_len);
+				buffer = arena->Allocate(row_len);
+				memcpy(buffer, copy_data, row_len);
+				postgres_consume_copy_data(con.GetConn());
+				buffer_in_arena = true;
+				if (collect_statistics) {
+					wait_time_ns += PostgresScanStatistics::Now() - start_time;
+					bytes_received += row_len;
+				}
+				if (row_len < sizeof(int16_t)) {
+					throw IOException("Unable to read binary COPY data from Postgres: message too short");
+				}
+				buffer_ptr = buffer;
+				end = buffer + row_len;
+				ReserveRow(row_len);
+				return true;
+			}
+		}
 		char *out_buffer;
 		int len = PQgetCopyData(con.GetConn(), &out_buffer, 0);
 		auto new_buffer = data_ptr_cast(out_buffer);
+		if (collect_statistics) {
+			wait_time_ns += PostgresScanStatistics::Now() - start_time;
+			bytes_received += len > 0 ? idx_t(len) : 0;
+		}
 
 		// len -1 signals end
 		if (len == -1) {
@@ -41,20 +153,89 @@ struct PostgresBinaryReader {
 		buffer = new_buffer;
 		buffer_ptr = buffer;
 		end = buffer + len;
+		ReserveRow(idx_t(len));
+		return true;
+	}
+
+	//! Next for a compressed COPY - the messages of the compressed COPY are decompressed until a row is complete
+	bool NextDecompressed(idx_t start_time) {
+		data_ptr_t new_buffer;
+		idx_t len;
+		while (!decompressor->Next(new_buffer, len)) {
+			char *out_buffer;
+			int compressed_len = PQgetCopyData(con.GetConn(), &out_buffer, 0);
+			if (compressed_len == -1) {
+				return false;
+			}
+			if (!out_buffer || compressed_len < 0) {
+				throw IOException("Unable to read binary COPY data from Postgres: %s",
+				                  string(PQerrorMessage(con.GetConn())));
+			}
+			try {
+				decompressor->Decompress(const_data_ptr_cast(out_buffer), idx_t(compressed_len));
+			} catch (...) {
+				PQfreemem(out_buffer);
+				throw;
+			}
+			PQfreemem(out_buffer);
+		}
+		if (collect_statistics) {
+			wait_time_ns += PostgresScanStatistics::Now() - start_time;
+			bytes_received += len;
+		}
+		if (len < sizeof(int16_t)) {
+			free_buffer(new_buffer);
+			throw IOException("Unable to read binary COPY data from Postgres: message too short");
+		}
+		buffer = new_buffer;
+		buffer_ptr = buffer;
+		end = buffer + len;
+		ReserveRow(len);
 		return true;
 	}
 
 	void CheckResult() {
+		if (prefetcher) {
+			prefetcher->Finish();
+			return;
+		}
 		auto result = PQgetResult(con.GetConn());
 		if (!result || PQresultStatus(result) != PGRES_COMMAND_OK) {
 			throw std::runtime_error("Failed to execute COPY: " + string(PQresultErrorMessage(result)));
 		}
 	}
 
+	//! Consume the remainder of a COPY of which the trailer has been read - afterwards the next query can be sent
+	void FinishCopy() {
+		D_ASSERT(!prefetcher);
+		Reset();
+		auto conn = con.GetConn();
+		char *out_buffer;
+		int len;
+		while ((len = PQgetCopyData(conn, &out_buffer, 0)) >= 0) {
+			PQfreemem(out_buffer);
+		}
+		if (len == -2) {
+			throw IOException("Unable to read binary COPY data from Postgres: %s", string(PQerrorMessage(conn)));
+		}
+		string error;
+		PGresult *result;
+		while ((result = PQgetResult(conn)) != nullptr) {
+			if (PQresultStatus(result) != PGRES_COMMAND_OK && error.empty()) {
+				error = PQresultErrorMessage(result);
+			}
+			PQclear(result);
+		}
+		if (!error.empty()) {
+			throw std::runtime_error("Failed to execute COPY: " + error);
+		}
+	}
+
 	void Reset() {
-		if (buffer) {
-			PQfreemem(buffer);
+		if (buffer && !buffer_in_arena) {
+			free_buffer(buffer);
 		}
+		buffer_in_arena = false;
 		buffer = nullptr;
 		buffer_ptr = nullptr;
 		end = nullptr;
@@ -63,6 +244,92 @@ struct PostgresBinaryReader {
 		return buffer_ptr != nullptr;
 	}
 
+	//! Locate the values of the current row and store them in "fields" at position "row_idx"
+	//! The row buffer is retained until ReleaseRows is called so the values can be decoded later on
+	void ReadRowFields(vector<PostgresColumnFields> &fields, idx_t row_idx) {
+		for (auto &column : fields) {
+			auto value_len = ReadInteger<int32_t>();
+			column.length[row_idx] = value_len;
+			if (value_len < 0) {
+				continue;
+			}
+			if (buffer_ptr + value_len > end) {
+				throw IOException("Postgres scanner - out of buffer in ReadRowFields");
+			}
+			column.data[row_idx] = buffer_ptr;
+			buffer_ptr += value_len;
+		}
+		if (!buffer_in_arena) {
+			// rows in the arena are retained by the arena
+			retained_buffers.push_back(buffer);
+		}
+		buffer_in_arena = false;
+		buffer = nullptr;
+		buffer_ptr = nullptr;
+		end = nullptr;
+	}
+
+	//! Locate the values of a row of a result that was received in the binary format (see QueryBinary)
+	//! The result is retained until ReleaseRows is called so the values can be decoded later on
+	void ReadResultFields(const shared_ptr<PostgresResult> &result, idx_t row, vector<PostgresColumnFields> &fields,
+	                      idx_t row_idx) {
+		auto res = result->res;
+		for (idx_t col = 0; col < fields.size(); col++) {
+			auto &column = fields[col];
+			if (PQgetisnull(res, int(row), int(col))) {
+				column.length[row_idx] = -1;
+				continue;
+			}
+			column.length[row_idx] = PQgetlength(res, int(row), int(col));
+			column.data[row_idx] = data_ptr_cast(PQgetvalue(res, int(row), int(col)));
+		}
+		if (retained_results.empty() || retained_results.back() != result) {
+			retained_results.push_back(result);
+		}
+	}
+
+	//! Free all row buffers retained by ReadRowFields and ReadResultFields
+	void ReleaseRows() {
+		for (auto &retained_buffer : retained_buffers) {
+			free_buffer(retained_buffer);
+		}
+		retained_buffers.clear();
+		retained_results.clear();
+		if (arena) {
+			arena->Release();
+		}
+		if (reservation) {
+			reservation->Reset();
+		}
+		unreserved_bytes = 0;
+	}
+
+	//! Transfer ownership of the row buffers retained by ReadRowFields and ReadResultFields
+	buffer_ptr<VectorBuffer> TakeRows() {
+		if (arena) {
+			arena->TakeBlocks(retained_buffers);
+		}
+		auto result = make_buffer<PostgresRowBuffers>(std::move(retained_buffers), std::move(retained_results),
+		                                              reservation ? reservation->Split() : PostgresMemoryReservation(),
+		                                              free_buffer);
+		retained_buffers.clear();
+		retained_results.clear();
+		unreserved_bytes = 0;
+		return std::move(result);
+	}
+
+	//! Read a single (non-NULL) value located by ReadRowFields
+	void ReadField(const LogicalType &type, const PostgresType &postgres_type, data_ptr_t value_ptr,
+	               int32_t value_len, Vector &out_vec, idx_t output_offset) {
+		auto prev_buffer_ptr = buffer_ptr;
+		auto prev_end = end;
+		buffer_ptr = value_ptr;
+		end = value_ptr + value_len;
+		ReadValueData(type, postgres_type, value_len, out_vec, output_offset);
+		buffer_ptr = prev_buffer_ptr;
+		end = prev_end;
+	}
+
 	void CheckHeader() {
 		auto magic_len = PostgresConversion::COPY_HEADER_LENGTH;
 		auto flags_len = 8;
@@ -84,8 +351,13 @@ struct PostgresBinaryReader {
 
 public:
 	template <class T>
-	inline T ReadIntegerUnchecked() {
-		T val = Load<T>(buffer_ptr);
+	static inline T LoadInteger(const_data_ptr_t ptr) {
+		return NetworkToHost<T>(Load<T>(ptr));
+	}
+
+	//! Convert an integer from network byte order to host byte order
+	template <class T>
+	static inline T NetworkToHost(T val) {
 		if (sizeof(T) == sizeof(uint8_t)) {
 			// no need to flip single byte
 		} else if (sizeof(T) == sizeof(uint16_t)) {
@@ -97,6 +369,78 @@ public:
 		} else {
 			D_ASSERT(0);
 		}
+		return val;
+	}
+
+	//! Format a binary macaddr (6 bytes) or macaddr8 (8 bytes) value, e.g. 08:00:2b:01:02:03
+	static string FormatMacaddr(const_data_ptr_t data, idx_t len) {
+		static constexpr const char *HEX_DIGITS = "0123456789abcdef";
+		string result;
+		for (idx_t i = 0; i < len; i++) {
+			if (i > 0) {
+				result += ':';
+			}
+			result += HEX_DIGITS[data[i] >> 4];
+			result += HEX_DIGITS[data[i] & 0xF];
+		}
+		return result;
+	}
+
+	//! Format a binary inet or cidr value, which consists of the family, the netmask bits, the is_cidr flag, the
+	//! address length and the address
+	static string FormatInet(const_data_ptr_t data, idx_t len) {
+		if (len < 4 || len != idx_t(4 + data[3])) {
+			throw IOException("Postgres scanner - invalid inet value");
+		}
+		auto family = data[0];
+		auto bits = data[1];
+		auto is_cidr = data[2];
+		auto address_len = data[3];
+		int af;
+		idx_t max_bits;
+		if (family == POSTGRES_AF_INET && address_len == 4) {
+			af = AF_INET;
+			max_bits = 32;
+		} else if (family == POSTGRES_AF_INET6 && address_len == 16) {
+			af = AF_INET6;
+			max_bits = 128;
+		} else {
+			throw IOException("Postgres scanner - invalid inet address family %d", family);
+		}
+		char address[INET6_ADDRSTRLEN];
+		if (!inet_ntop(af, data + 4, address, sizeof(address))) {
+			throw IOException("Postgres scanner - failed to format inet value");
+		}
+		string result(address);
+		if (is_cidr || bits != max_bits) {
+			result += "/" + to_string(bits);
+		}
+		return result;
+	}
+
+	static inline date_t ConvertDate(uint32_t jd) {
+		if (jd == POSTGRES_DATE_INF) {
+			return date_t::infinity();
+		}
+		if (jd == POSTGRES_DATE_NINF) {
+			return date_t::ninfinity();
+		}
+		return date_t(jd + POSTGRES_EPOCH_JDATE - DUCKDB_EPOCH_DATE); // magic!
+	}
+
+	static inline timestamp_t ConvertTimestamp(uint64_t usec) {
+		if (usec == POSTGRES_INFINITY) {
+			return timestamp_t::infinity();
+		}
+		if (usec == POSTGRES_NINFINITY) {
+			return timestamp_t::ninfinity();
+		}
+		return timestamp_t(usec + (POSTGRES_EPOCH_TS - DUCKDB_EPOCH_TS));
+	}
+
+	template <class T>
+	inline T ReadIntegerUnchecked() {
+		T val = LoadInteger<T>(buffer_ptr);
 		buffer_ptr += sizeof(T);
 		return val;
 	}
@@ -129,14 +473,7 @@ public:
 	}
 
 	inline date_t ReadDate() {
-		auto jd = ReadInteger<uint32_t>();
-		if (jd == POSTGRES_DATE_INF) {
-			return date_t::infinity();
-		}
-		if (jd == POSTGRES_DATE_NINF) {
-			return date_t::ninfinity();
-		}
-		return date_t(jd + POSTGRES_EPOCH_JDATE - DUCKDB_EPOCH_DATE); // magic!
+		return ConvertDate(ReadInteger<uint32_t>());
 	}
 
 	inline dtime_t ReadTime() {
@@ -150,14 +487,7 @@ public:
 	}
 
 	inline timestamp_t ReadTimestamp() {
-		auto usec = ReadInteger<uint64_t>();
-		if (usec == POSTGRES_INFINITY) {
-			return timestamp_t::infinity();
-		}
-		if (usec == POSTGRES_NINFINITY) {
-			return timestamp_t::ninfinity();
-		}
-		return timestamp_t(usec + (POSTGRES_EPOCH_TS - DUCKDB_EPOCH_TS));
+		return ConvertTimestamp(ReadInteger<uint64_t>());
 	}
 
 	inline interval_t ReadInterval() {
@@ -301,6 +631,122 @@ public:
 		ListVector::SetListSize(out_vec, child_offset + element_count);
 	}
 
+	//! Read the elements of the innermost dimension of an array of a fixed-width type
+	//! The element lengths are validated in a first pass, after which all values are byte-swapped in a tight loop
+	template <class T, class DST>
+	void ReadFixedWidthElements(Vector &child_vec, idx_t child_offset, idx_t child_count) {
+		static_assert(sizeof(T) == sizeof(DST), "ReadFixedWidthElements requires types of the same width");
+		constexpr int32_t VALUE_SIZE = sizeof(T);
+		constexpr idx_t ELEMENT_SIZE = sizeof(int32_t) + sizeof(T);
+		idx_t null_count = 0;
+		auto ptr = buffer_ptr;
+		for (idx_t i = 0; i < child_count; i++) {
+			if (ptr + sizeof(int32_t) > end) {
+				throw IOException("Postgres scanner - out of buffer in ReadArray");
+			}
+			auto value_len = LoadInteger<int32_t>(ptr);
+			ptr += sizeof(int32_t);
+			if (value_len == -1) {
+				null_count++;
+				continue;
+			}
+			if (value_len != VALUE_SIZE) {
+				throw IOException("Postgres scanner - unexpected array element length %d (expected %d)", value_len,
+				                  VALUE_SIZE);
+			}
+			ptr += VALUE_SIZE;
+		}
+		if (ptr > end) {
+			throw IOException("Postgres scanner - out of buffer in ReadArray");
+		}
+		auto result = FlatVector::GetData<DST>(child_vec) + child_offset;
+		auto source = buffer_ptr;
+		if (null_count == 0) {
+			for (idx_t i = 0; i < child_count; i++) {
+				auto value = LoadInteger<T>(source + i * ELEMENT_SIZE + sizeof(int32_t));
+				result[i] = Load<DST>(const_data_ptr_cast(&value));
+			}
+		} else {
+			for (idx_t i = 0; i < child_count; i++) {
+				auto value_len = LoadInteger<int32_t>(source);
+				source += sizeof(int32_t);
+				if (value_len == -1) {
+					FlatVector::SetNull(child_vec, child_offset + i, true);
+					continue;
+				}
+				auto value = LoadInteger<T>(source);
+				result[i] = Load<DST>(const_data_ptr_cast(&value));
+				source += VALUE_SIZE;
+			}
+		}
+		buffer_ptr = ptr;
+	}
+
+	//! Read the innermost dimension of an array using ReadFixedWidthElements if the element type allows it
+	bool TryReadFixedWidthElements(const LogicalType &type, const PostgresType &postgres_type, Vector &child_vec,
+	                               idx_t child_offset, idx_t child_count) {
+		if (postgres_type.info != PostgresTypeAnnotation::STANDARD) {
+			return false;
+		}
+		switch (type.id()) {
+		case LogicalTypeId::SMALLINT:
+			ReadFixedWidthElements<uint16_t, int16_t>(child_vec, child_offset, child_count);
+			return true;
+		case LogicalTypeId::INTEGER:
+			ReadFixedWidthElements<uint32_t, int32_t>(child_vec, child_offset, child_count);
+			return true;
+		case LogicalTypeId::UINTEGER:
+			ReadFixedWidthElements<uint32_t, uint32_t>(child_vec, child_offset, child_count);
+			return true;
+		case LogicalTypeId::BIGINT:
+			ReadFixedWidthElements<uint64_t, int64_t>(child_vec, child_offset, child_count);
+			return true;
+		case LogicalTypeId::FLOAT:
+			ReadFixedWidthElements<uint32_t, float>(child_vec, child_offset, child_count);
+			return true;
+		case LogicalTypeId::DOUBLE:
+			ReadFixedWidthElements<uint64_t, double>(child_vec, child_offset, child_count);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	//! Read a pgvector value - the number of dimensions (int16), an unused int16, followed by the float4 elements
+	//! Fixed-size vectors are read into an ARRAY, in which all elements are stored in one contiguous child vector
+	void ReadPGVector(const LogicalType &type, int32_t value_len, Vector &out_vec, idx_t output_offset) {
+		auto dimensions = ReadInteger<uint16_t>();
+		ReadInteger<uint16_t>(); // unused
+		if (value_len != int32_t(sizeof(uint16_t) * 2 + dimensions * sizeof(float))) {
+			throw IOException("Postgres scanner - invalid length for vector with %d dimensions", dimensions);
+		}
+		if (buffer_ptr + dimensions * sizeof(float) > end) {
+			throw IOException("Postgres scanner - out of buffer in ReadPGVector");
+		}
+		float *result;
+		if (type.id() == LogicalTypeId::ARRAY) {
+			auto array_size = ArrayType::GetSize(type);
+			if (dimensions != array_size) {
+				throw InvalidInputException("Expected a vector with %llu dimensions, but this vector has %llu dimensions",
+				                            array_size, dimensions);
+			}
+			result = FlatVector::GetData<float>(ArrayVector::GetEntry(out_vec)) + output_offset * array_size;
+		} else {
+			auto &list_entry = FlatVector::GetData<list_entry_t>(out_vec)[output_offset];
+			auto child_offset = ListVector::GetListSize(out_vec);
+			ListVector::Reserve(out_vec, child_offset + dimensions);
+			list_entry.offset = child_offset;
+			list_entry.length = dimensions;
+			result = FlatVector::GetData<float>(ListVector::GetEntry(out_vec)) + child_offset;
+			ListVector::SetListSize(out_vec, child_offset + dimensions);
+		}
+		for (idx_t i = 0; i < dimensions; i++) {
+			auto value = LoadInteger<uint32_t>(buffer_ptr + i * sizeof(float));
+			result[i] = Load<float>(const_data_ptr_cast(&value));
+		}
+		buffer_ptr += dimensions * sizeof(float);
+	}
+
 	void ReadArray(const LogicalType &type, const PostgresType &postgres_type, Vector &out_vec, idx_t output_offset,
 	               uint32_t current_count, uint32_t dimensions[], uint32_t ndim) {
 		auto list_entries = FlatVector::GetData<list_entry_t>(out_vec);
@@ -322,7 +768,7 @@ public:
 		if (ndim > 1) {
 			// there are more dimensions to read - recurse into child list
 			ReadArray(child_type, child_pg_type, child_vec, child_offset, child_count, dimensions + 1, ndim - 1);
-		} else {
+		} else if (!TryReadFixedWidthElements(child_type, child_pg_type, child_vec, child_offset, child_count)) {
 			// this is the last level - read the actual values
 			for (idx_t child_idx = 0; child_idx < child_count; child_idx++) {
 				ReadValue(child_type, child_pg_type, child_vec, child_offset + child_idx);
@@ -337,6 +783,11 @@ public:
 			FlatVector::SetNull(out_vec, output_offset, true);
 			return;
 		}
+		ReadValueData(type, postgres_type, value_len, out_vec, output_offset);
+	}
+
+	void ReadValueData(const LogicalType &type, const PostgresType &postgres_type, int32_t value_len, Vector &out_vec,
+	                   idx_t output_offset) {
 		switch (type.id()) {
 		case LogicalTypeId::SMALLINT:
 			D_ASSERT(value_len == sizeof(int16_t));
@@ -378,6 +829,15 @@ public:
 
 		case LogicalTypeId::BLOB:
 		case LogicalTypeId::VARCHAR: {
+			if (postgres_type.info == PostgresTypeAnnotation::MACADDR ||
+			    postgres_type.info == PostgresTypeAnnotation::MACADDR8 ||
+			    postgres_type.info == PostgresTypeAnnotation::INET) {
+				auto data = const_data_ptr_cast(ReadString(value_len));
+				auto str = postgres_type.info == PostgresTypeAnnotation::INET ? FormatInet(data, value_len)
+				                                                              : FormatMacaddr(data, value_len);
+				FlatVector::GetData<string_t>(out_vec)[output_offset] = StringVector::AddString(out_vec, str);
+				break;
+			}
 			if (postgres_type.info == PostgresTypeAnnotation::JSONB) {
 				auto version = ReadInteger<uint8_t>();
 				value_len--;
@@ -490,6 +950,9 @@ public:
 				break;
 			}
 			switch (postgres_type.info) {
+			case PostgresTypeAnnotation::PGVECTOR:
+				ReadPGVector(type, value_len, out_vec, output_offset);
+				return;
 			case PostgresTypeAnnotation::GEOM_LINE:
 			case PostgresTypeAnnotation::GEOM_LINE_SEGMENT:
 			case PostgresTypeAnnotation::GEOM_BOX:
@@ -534,6 +997,13 @@ public:
 			ReadArray(type, postgres_type, out_vec, output_offset, 1, dimensions.get(), array_dim);
 			break;
 		}
+		case LogicalTypeId::ARRAY: {
+			if (postgres_type.info != PostgresTypeAnnotation::PGVECTOR) {
+				throw InternalException("Unsupported Type %s", type.ToString());
+			}
+			ReadPGVector(type, value_len, out_vec, output_offset);
+			break;
+		}
 		case LogicalTypeId::STRUCT: {
 			auto &child_entries = StructVector::GetEntries(out_vec);
 			if (postgres_type.info == PostgresTypeAnnotation::GEOM_POINT) {
@@ -559,11 +1029,50 @@ public:
 		}
 	}
 
+public:
+	//! Allocates the row buffers - instead of libpq allocating a buffer per row (if pg_copy_arena_buffers is enabled)
+	//! Rows are only read into the arena when prefetching and decompression are disabled
+	optional_ptr<PostgresRowArena> arena;
+	//! Accounts for the retained row buffers in the memory budget and the buffer manager (if pg_scan_memory_limit is
+	//! set) - the rows are reserved RESERVATION_UNIT bytes at a time
+	optional_ptr<PostgresMemoryReservation> reservation;
+	static constexpr const idx_t RESERVATION_UNIT = 256 * 1024;
+	//! Whether or not to measure the received data and the time spent waiting for it (pg_scan_statistics)
+	bool collect_statistics = false;
+	idx_t bytes_received = 0;
+	idx_t wait_time_ns = 0;
+
+private:
+	//! Account for a received row in the reservation (if any)
+	void ReserveRow(idx_t len) {
+		if (!reservation) {
+			return;
+		}
+		unreserved_bytes += len;
+		if (unreserved_bytes >= RESERVATION_UNIT) {
+			reservation->Grow(unreserved_bytes);
+			unreserved_bytes = 0;
+		}
+	}
+
 private:
 	data_ptr_t buffer = nullptr;
 	data_ptr_t buffer_ptr = nullptr;
 	data_ptr_t end = nullptr;
+	//! Whether or not the current buffer was allocated from the arena (instead of by libpq)
+	bool buffer_in_arena = false;
+	//! Row buffers retained by ReadRowFields
+	vector<data_ptr_t> retained_buffers;
+	//! Results retained by ReadResultFields
+	vector<shared_ptr<PostgresResult>> retained_results;
+	//! The bytes of the rows received since the reservation last grew
+	idx_t unreserved_bytes = 0;
 	PostgresConnection &con;
+	optional_ptr<PostgresCopyPrefetcher> prefetcher;
+	//! Decompresses the data of a compressed COPY (if any) - when prefetching this happens in the prefetcher instead
+	optional_ptr<PostgresCopyDecompressor> decompressor;
+	//! Frees the row buffers - decompressed rows are not allocated by libpq
+	postgres_free_buffer_t free_buffer = PQfreemem;
 };
 
 } // namespace duckdb
@@ -12,6 +12,7 @@
 #include "duckdb/common/types/interval.hpp"
 #include "duckdb/common/serializer/memory_stream.hpp"
 #include "postgres_conversion.hpp"
+#include "postgres_utils.hpp"
 
 namespace duckdb {
 
@@ -197,12 +198,29 @@ public:
 		}
 	}
 
+	//! Write a DuckDB row id of a Postgres table as a tid - (page_index, tuple_in_page)
+	void WriteCTID(row_t row_id) {
+		WriteRawInteger<int32_t>(sizeof(uint32_t) + sizeof(uint16_t));
+		WriteRawInteger<uint32_t>(uint32_t(row_id >> 16));
+		WriteRawInteger<uint16_t>(uint16_t(row_id & 0xFFFF));
+	}
+
 	void WriteVarchar(string_t value) {
 		WriteRawInteger<int32_t>(value.GetSize());
 		stream.WriteData(const_data_ptr_cast(value.GetData()), value.GetSize());
 	}
 
-	void WriteArray(Vector &col, idx_t r, const vector<uint32_t> &dimensions, idx_t depth, uint32_t count) {
+	//! Returns the oid that is written for an array element or a composite field
+	//! This is the oid of the Postgres type if it is known, or the oid matching the DuckDB type otherwise
+	static uint32_t GetElementOid(const LogicalType &type, optional_ptr<const PostgresType> postgres_type) {
+		if (postgres_type && postgres_type->oid != 0) {
+			return uint32_t(postgres_type->oid);
+		}
+		return PostgresUtils::ToPostgresOid(type);
+	}
+
+	void WriteArray(Vector &col, idx_t r, const vector<uint32_t> &dimensions, idx_t depth, uint32_t count,
+	                optional_ptr<const PostgresType> element_type) {
 		auto list_data = FlatVector::GetData<list_entry_t>(col);
 		auto &child_vector = ListVector::GetEntry(col);
 		for (idx_t i = 0; i < count; i++) {
@@ -214,9 +232,13 @@ public:
 			}
 			if (child_vector.GetType().id() == LogicalTypeId::LIST) {
 				// multidimensional array - recurse
-				WriteArray(child_vector, list_entry.offset, dimensions, depth + 1, list_entry.length);
-			} else {
+				WriteArray(child_vector, list_entry.offset, dimensions, depth + 1, list_entry.length, element_type);
+			} else if (element_type) {
 				// write the actual values
+				for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
+					WriteValue(child_vector, list_entry.offset + child_idx, *element_type);
+				}
+			} else {
 				for (idx_t child_idx = 0; child_idx < list_entry.length; child_idx++) {
 					WriteValue(child_vector, list_entry.offset + child_idx);
 				}
@@ -224,6 +246,91 @@ public:
 		}
 	}
 
+	//! Write a LIST as a (multidimensional) Postgres array - the element oid is taken from the Postgres type if given
+	void WriteList(Vector &col, idx_t r, optional_ptr<const PostgresType> postgres_type) {
+		// find the element type of the (possibly multidimensional) array
+		optional_ptr<const PostgresType> element_type;
+		if (postgres_type) {
+			element_type = postgres_type.get();
+			auto element_logical_type = &col.GetType();
+			while (element_logical_type->id() == LogicalTypeId::LIST && !element_type->children.empty()) {
+				element_type = &element_type->children[0];
+				element_logical_type = &ListType::GetChildType(*element_logical_type);
+			}
+			if (element_logical_type->id() == LogicalTypeId::LIST) {
+				// the Postgres type does not match the nesting of the list - ignore it
+				element_type = nullptr;
+			}
+		}
+		auto list_entry = FlatVector::GetData<list_entry_t>(col)[r];
+		auto value_oid = GetElementOid(ListType::GetChildType(col.GetType()), element_type);
+		if (list_entry.length == 0) {
+			// empty list
+			WriteRawInteger<int32_t>(sizeof(uint32_t) * 3);
+			WriteRawInteger<uint32_t>(0);
+			WriteRawInteger<uint32_t>(0);
+			WriteRawInteger<uint32_t>(value_oid);
+			return;
+		}
+		// compute how many dimensions we will write
+		vector<uint32_t> dimensions;
+		const_reference<Vector> current_vector = col;
+		idx_t current_position = r;
+		while (current_vector.get().GetType().id() == LogicalTypeId::LIST) {
+			auto current_entry = FlatVector::GetData<list_entry_t>(current_vector.get())[current_position];
+			dimensions.push_back(current_entry.length);
+			current_vector = ListVector::GetEntry(current_vector.get());
+			current_position = current_entry.offset;
+		}
+
+		// list header
+		// record the location of the field size in the stream
+		auto start_position = stream.GetPosition();
+		WriteRawInteger<int32_t>(0);                  // data size (nop for now)
+		WriteRawInteger<uint32_t>(dimensions.size()); // ndim
+		WriteRawInteger<uint32_t>(1);                 // has nulls
+		WriteRawInteger<uint32_t>(value_oid);         // value_oid
+		// write the dimensions of the arrays
+		for (auto &dim : dimensions) {
+			WriteRawInteger<uint32_t>(dim); // array length
+			WriteRawInteger<uint32_t>(1);   // index lower bounds
+		}
+		// now recursively write the actual values
+		WriteArray(col, r, dimensions, 0, 1, element_type);
+
+		// after writing all list elements update the field size
+		auto end_position = stream.GetPosition();
+		auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
+		Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+	}
+
+	//! Write a STRUCT as a Postgres composite - the field oids are taken from the Postgres type if given
+	void WriteStruct(Vector &col, idx_t r, optional_ptr<const PostgresType> postgres_type) {
+		auto &child_entries = StructVector::GetEntries(col);
+		if (postgres_type && postgres_type->children.size() != child_entries.size()) {
+			postgres_type = nullptr;
+		}
+
+		auto start_position = stream.GetPosition();
+		WriteRawInteger<int32_t>(0);                     // data size (nop for now)
+		WriteRawInteger<uint32_t>(child_entries.size()); // column count
+		for (idx_t c = 0; c < child_entries.size(); c++) {
+			auto &child = *child_entries[c];
+			if (postgres_type) {
+				auto &child_pg_type = postgres_type->children[c];
+				WriteRawInteger<uint32_t>(GetElementOid(child.GetType(), child_pg_type)); // value oid
+				WriteValue(child, r, child_pg_type);
+			} else {
+				WriteRawInteger<uint32_t>(GetElementOid(child.GetType(), nullptr)); // value oid
+				WriteValue(child, r);
+			}
+		}
+		auto end_position = stream.GetPosition();
+		// after writing all list elements update the field size
+		auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
+		Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+	}
+
 	void WriteValue(Vector &col, idx_t r) {
 		if (FlatVector::IsNull(col, r)) {
 			WriteNull();
@@ -338,73 +445,492 @@ public:
 			WriteVarchar(EnumType::GetString(type, pos));
 			break;
 		}
-		case LogicalTypeId::LIST: {
-			auto list_entry = FlatVector::GetData<list_entry_t>(col)[r];
-			auto value_oid = PostgresUtils::ToPostgresOid(ListType::GetChildType(type));
-			if (list_entry.length == 0) {
-				// empty list
-				WriteRawInteger<int32_t>(sizeof(uint32_t) * 3);
-				WriteRawInteger<uint32_t>(0);
-				WriteRawInteger<uint32_t>(0);
-				WriteRawInteger<uint32_t>(value_oid);
-				return;
+		case LogicalTypeId::LIST:
+			WriteList(col, r, nullptr);
+			break;
+		case LogicalTypeId::STRUCT:
+			WriteStruct(col, r, nullptr);
+			break;
+		default:
+			throw NotImplementedException("Type \"%s\" is not supported for Postgres binary copy", type);
+		}
+	}
+
+	void WriteJSONB(string_t value) {
+		// jsonb values are prefixed by a version number
+		WriteRawInteger<int32_t>(value.GetSize() + 1);
+		WriteRawInteger<uint8_t>(1);
+		stream.WriteData(const_data_ptr_cast(value.GetData()), value.GetSize());
+	}
+
+	//! Write a macaddr (6 bytes) or macaddr8 (8 bytes) value, e.g. 08:00:2b:01:02:03
+	void WriteMacaddr(string_t value, idx_t byte_count) {
+		auto data = value.GetData();
+		auto size = value.GetSize();
+		uint8_t bytes[8];
+		idx_t digit_count = 0;
+		for (idx_t i = 0; i < size; i++) {
+			auto c = data[i];
+			if (c == ':' || c == '-' || c == '.') {
+				continue;
+			}
+			uint8_t digit;
+			if (c >= '0' && c <= '9') {
+				digit = c - '0';
+			} else if (c >= 'a' && c <= 'f') {
+				digit = c - 'a' + 10;
+			} else if (c >= 'A' && c <= 'F') {
+				digit = c - 'A' + 10;
+			} else {
+				digit_count = 0;
+				break;
+			}
+			if (digit_count >= 16) {
+				digit_count = 0;
+				break;
+			}
+			bytes[digit_count / 2] = digit_count % 2 == 0 ? uint8_t(digit << 4) : uint8_t(bytes[digit_count / 2] | digit);
+			digit_count++;
+		}
+		if (byte_count == 8 && digit_count == 12) {
+			// 6-byte addresses are converted to the EUI-64 format by inserting FF:FE in the middle
+			memmove(bytes + 5, bytes + 3, 3);
+			bytes[3] = 0xFF;
+			bytes[4] = 0xFE;
+			digit_count = 16;
+		}
+		if (digit_count != byte_count * 2) {
+			throw InvalidInputException("invalid input syntax for type %s: \"%s\"",
+			                            byte_count == 8 ? "macaddr8" : "macaddr", value.GetString());
+		}
+		WriteRawInteger<int32_t>(int32_t(byte_count));
+		stream.WriteData(bytes, byte_count);
+	}
+
+	//! Write an inet or cidr value, e.g. 192.168.0.1/24 or ::1
+	void WriteInet(string_t value) {
+		auto str = value.GetString();
+		auto bits_pos = str.find('/');
+		auto address_str = str.substr(0, bits_pos);
+		bool is_ipv6 = address_str.find(':') != string::npos;
+		uint8_t address[16];
+		if (inet_pton(is_ipv6 ? AF_INET6 : AF_INET, address_str.c_str(), address) != 1) {
+			throw InvalidInputException("invalid input syntax for type inet: \"%s\"", str);
+		}
+		uint8_t address_len = is_ipv6 ? 16 : 4;
+		int32_t max_bits = address_len * 8;
+		int32_t bits = max_bits;
+		if (bits_pos != string::npos) {
+			auto bits_str = str.substr(bits_pos + 1);
+			if (bits_str.empty() || bits_str.size() > 3 ||
+			    bits_str.find_first_not_of("0123456789") != string::npos) {
+				throw InvalidInputException("invalid input syntax for type inet: \"%s\"", str);
 			}
-			// compute how many dimensions we will write
-			vector<uint32_t> dimensions;
-			const_reference<Vector> current_vector = col;
-			idx_t current_position = r;
-			while (current_vector.get().GetType().id() == LogicalTypeId::LIST) {
-				auto current_entry = FlatVector::GetData<list_entry_t>(current_vector.get())[current_position];
-				dimensions.push_back(current_entry.length);
-				current_vector = ListVector::GetEntry(current_vector.get());
-				current_position = current_entry.offset;
+			bits = std::stoi(bits_str);
+			if (bits > max_bits) {
+				throw InvalidInputException("invalid input syntax for type inet: \"%s\"", str);
 			}
+		}
+		WriteRawInteger<int32_t>(4 + address_len);
+		WriteRawInteger<uint8_t>(is_ipv6 ? POSTGRES_AF_INET6 : POSTGRES_AF_INET);
+		WriteRawInteger<uint8_t>(uint8_t(bits));
+		WriteRawInteger<uint8_t>(0); // is_cidr - ignored by the server
+		WriteRawInteger<uint8_t>(address_len);
+		stream.WriteData(address, address_len);
+	}
 
-			// list header
-			// record the location of the field size in the stream
-			auto start_position = stream.GetPosition();
-			WriteRawInteger<int32_t>(0);                  // data size (nop for now)
-			WriteRawInteger<uint32_t>(dimensions.size()); // ndim
-			WriteRawInteger<uint32_t>(1);                 // has nulls
-			WriteRawInteger<uint32_t>(value_oid);         // value_oid
-			// write the dimensions of the arrays
-			for (auto &dim : dimensions) {
-				WriteRawInteger<uint32_t>(dim); // array length
-				WriteRawInteger<uint32_t>(1);   // index lower bounds
+	//! Write a pgvector value from a (fixed-size) ARRAY or LIST of floats
+	void WritePGVector(Vector &col, idx_t r) {
+		auto &type = col.GetType();
+		optional_ptr<Vector> child;
+		idx_t offset;
+		idx_t dimensions;
+		if (type.id() == LogicalTypeId::ARRAY) {
+			dimensions = ArrayType::GetSize(type);
+			offset = r * dimensions;
+			child = &ArrayVector::GetEntry(col);
+		} else if (type.id() == LogicalTypeId::LIST) {
+			auto list_entry = FlatVector::GetData<list_entry_t>(col)[r];
+			dimensions = list_entry.length;
+			offset = list_entry.offset;
+			child = &ListVector::GetEntry(col);
+		} else {
+			throw InternalException("Unsupported type for WritePGVector");
+		}
+		if (child->GetType().id() != LogicalTypeId::FLOAT) {
+			throw InternalException("WritePGVector requires FLOAT elements");
+		}
+		if (dimensions > NumericLimits<uint16_t>::Maximum()) {
+			throw InvalidInputException("vector cannot have more than %d dimensions",
+			                            NumericLimits<uint16_t>::Maximum());
+		}
+		auto &validity = FlatVector::Validity(*child);
+		auto data = FlatVector::GetData<float>(*child);
+		WriteRawInteger<int32_t>(int32_t(sizeof(uint16_t) * 2 + dimensions * sizeof(float)));
+		WriteRawInteger<uint16_t>(uint16_t(dimensions));
+		WriteRawInteger<uint16_t>(0); // unused
+		for (idx_t i = 0; i < dimensions; i++) {
+			if (!validity.RowIsValid(offset + i)) {
+				throw InvalidInputException("vector cannot contain NULL elements");
 			}
-			// now recursively write the actual values
-			WriteArray(col, r, dimensions, 0, 1);
+			WriteRawInteger<uint32_t>(Load<uint32_t>(const_data_ptr_cast(data + offset + i)));
+		}
+	}
 
-			// after writing all list elements update the field size
-			auto end_position = stream.GetPosition();
-			auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
-			Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
+	//! Write a value to a column of the given Postgres type - handles types that are represented as VARCHAR in DuckDB
+	//! but have their own binary representation in Postgres, and nested types with their Postgres element types
+	void WriteValue(Vector &col, idx_t r, const PostgresType &postgres_type) {
+		if (FlatVector::IsNull(col, r)) {
+			WriteNull();
+			return;
+		}
+		if (postgres_type.info == PostgresTypeAnnotation::PGVECTOR) {
+			WritePGVector(col, r);
+			return;
+		}
+		switch (col.GetType().id()) {
+		case LogicalTypeId::LIST:
+			WriteList(col, r, postgres_type);
+			return;
+		case LogicalTypeId::STRUCT:
+			WriteStruct(col, r, postgres_type);
+			return;
+		case LogicalTypeId::VARCHAR:
+			if (postgres_type.info != PostgresTypeAnnotation::STANDARD) {
+				break;
+			}
+			WriteValue(col, r);
+			return;
+		default:
+			WriteValue(col, r);
+			return;
+		}
+		auto data = FlatVector::GetData<string_t>(col)[r];
+		switch (postgres_type.info) {
+		case PostgresTypeAnnotation::JSONB:
+			WriteJSONB(data);
+			break;
+		case PostgresTypeAnnotation::MACADDR:
+			WriteMacaddr(data, 6);
+			break;
+		case PostgresTypeAnnotation::MACADDR8:
+			WriteMacaddr(data, 8);
+			break;
+		case PostgresTypeAnnotation::INET:
+			WriteInet(data);
+			break;
+		default:
+			WriteValue(col, r);
 			break;
 		}
-		case LogicalTypeId::STRUCT: {
-			auto &child_entries = StructVector::GetEntries(col);
+	}
 
-			auto start_position = stream.GetPosition();
-			WriteRawInteger<int32_t>(0);                     // data size (nop for now)
-			WriteRawInteger<uint32_t>(child_entries.size()); // column count
-			for (auto &child : child_entries) {
-				auto value_oid = PostgresUtils::ToPostgresOid(child->GetType());
-				WriteRawInteger<uint32_t>(value_oid); // value oid
-				WriteValue(*child, r);
+	//! Write all rows of a chunk - optionally with the Postgres types of the target columns
+	//! If all column types have a known encoded size the chunk is written column-at-a-time - otherwise row-by-row
+	void WriteChunk(DataChunk &chunk, optional_ptr<const vector<PostgresType>> postgres_types = nullptr) {
+		chunk.Flatten();
+		if (chunk.size() == 0) {
+			return;
+		}
+		D_ASSERT(!postgres_types || postgres_types->size() == chunk.ColumnCount());
+		bool columnar = chunk.size() <= STANDARD_VECTOR_SIZE;
+		for (idx_t c = 0; c < chunk.ColumnCount() && columnar; c++) {
+			if (!SupportsColumnarWrite(chunk.data[c].GetType())) {
+				columnar = false;
 			}
-			auto end_position = stream.GetPosition();
-			// after writing all list elements update the field size
-			auto field_size = int32_t(end_position - start_position - sizeof(int32_t));
-			Store<int32_t>(GetInteger(field_size), stream.GetData() + start_position);
-			break;
+			if (postgres_types && (*postgres_types)[c].info != PostgresTypeAnnotation::STANDARD) {
+				columnar = false;
+			}
+		}
+		if (columnar) {
+			WriteColumns(chunk);
+		} else {
+			WriteRows(chunk, postgres_types);
+		}
+	}
+
+	void WriteRows(DataChunk &chunk, optional_ptr<const vector<PostgresType>> postgres_types = nullptr) {
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			BeginRow(chunk.ColumnCount());
+			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+				if (postgres_types) {
+					WriteValue(chunk.data[c], r, (*postgres_types)[c]);
+				} else {
+					WriteValue(chunk.data[c], r);
+				}
+			}
+			FinishRow();
 		}
+	}
+
+private:
+	//! Returns the encoded size of a non-NULL value of the given type, or 0 for variable-size strings
+	static idx_t GetFixedWidth(const LogicalType &type) {
+		switch (type.id()) {
+		case LogicalTypeId::BOOLEAN:
+			return sizeof(uint8_t);
+		case LogicalTypeId::SMALLINT:
+			return sizeof(int16_t);
+		case LogicalTypeId::INTEGER:
+		case LogicalTypeId::FLOAT:
+		case LogicalTypeId::DATE:
+			return sizeof(uint32_t);
+		case LogicalTypeId::BIGINT:
+		case LogicalTypeId::DOUBLE:
+		case LogicalTypeId::TIME:
+		case LogicalTypeId::TIMESTAMP:
+		case LogicalTypeId::TIMESTAMP_TZ:
+			return sizeof(uint64_t);
+		case LogicalTypeId::INTERVAL:
+			return sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint32_t);
+		case LogicalTypeId::UUID:
+			return sizeof(uint64_t) * 2;
 		default:
-			throw NotImplementedException("Type \"%s\" is not supported for Postgres binary copy", type);
+			return 0;
+		}
+	}
+
+	static bool SupportsColumnarWrite(const LogicalType &type) {
+		switch (type.id()) {
+		case LogicalTypeId::VARCHAR:
+		case LogicalTypeId::BLOB:
+			return true;
+		default:
+			return GetFixedWidth(type) > 0;
+		}
+	}
+
+	struct IdentityOperator {
+		template <class T>
+		static inline T Convert(T input) {
+			return input;
+		}
+	};
+
+	struct BooleanOperator {
+		static inline uint8_t Convert(bool input) {
+			return input ? 1 : 0;
+		}
+	};
+
+	struct FloatOperator {
+		static inline uint32_t Convert(float input) {
+			return Load<uint32_t>(const_data_ptr_cast(&input));
+		}
+	};
+
+	struct DoubleOperator {
+		static inline uint64_t Convert(double input) {
+			return Load<uint64_t>(const_data_ptr_cast(&input));
+		}
+	};
+
+	struct DateOperator {
+		static inline uint32_t Convert(date_t input) {
+			return DuckDBDateToPostgres(input);
+		}
+	};
+
+	struct TimeOperator {
+		static inline uint64_t Convert(dtime_t input) {
+			return uint64_t(input.micros);
+		}
+	};
+
+	struct TimestampOperator {
+		static inline uint64_t Convert(timestamp_t input) {
+			return DuckDBTimestampToPostgres(input);
+		}
+	};
+
+	//! Write a fixed-width column - the values are converted and byte-swapped in a tight loop over a contiguous
+	//! staging buffer first, after which they are scattered into the rows
+	template <class SRC, class DST, class OP>
+	void WriteFixedColumn(Vector &col, idx_t count, data_ptr_t target, idx_t cursors[]) {
+		auto source_data = FlatVector::GetData<SRC>(col);
+		auto &validity = FlatVector::Validity(col);
+		DST staging[STANDARD_VECTOR_SIZE];
+		if (validity.AllValid()) {
+			for (idx_t r = 0; r < count; r++) {
+				staging[r] = GetInteger<DST>(OP::Convert(source_data[r]));
+			}
+		} else {
+			for (idx_t r = 0; r < count; r++) {
+				staging[r] = validity.RowIsValid(r) ? GetInteger<DST>(OP::Convert(source_data[r])) : DST(0);
+			}
+		}
+		auto value_length = GetInteger<int32_t>(int32_t(sizeof(DST)));
+		auto null_length = GetInteger<int32_t>(-1);
+		for (idx_t r = 0; r < count; r++) {
+			auto row_ptr = target + cursors[r];
+			if (!validity.RowIsValid(r)) {
+				Store<int32_t>(null_length, row_ptr);
+				cursors[r] += sizeof(int32_t);
+				continue;
+			}
+			Store<int32_t>(value_length, row_ptr);
+			Store<DST>(staging[r], row_ptr + sizeof(int32_t));
+			cursors[r] += sizeof(int32_t) + sizeof(DST);
+		}
+	}
+
+	void WriteStringColumn(Vector &col, idx_t count, data_ptr_t target, idx_t cursors[]) {
+		auto source_data = FlatVector::GetData<string_t>(col);
+		auto &validity = FlatVector::Validity(col);
+		for (idx_t r = 0; r < count; r++) {
+			auto row_ptr = target + cursors[r];
+			if (!validity.RowIsValid(r)) {
+				Store<int32_t>(GetInteger<int32_t>(-1), row_ptr);
+				cursors[r] += sizeof(int32_t);
+				continue;
+			}
+			auto size = source_data[r].GetSize();
+			Store<int32_t>(GetInteger<int32_t>(int32_t(size)), row_ptr);
+			memcpy(row_ptr + sizeof(int32_t), source_data[r].GetData(), size);
+			cursors[r] += sizeof(int32_t) + size;
+		}
+	}
+
+	void WriteIntervalColumn(Vector &col, idx_t count, data_ptr_t target, idx_t cursors[]) {
+		auto source_data = FlatVector::GetData<interval_t>(col);
+		auto &validity = FlatVector::Validity(col);
+		auto value_length = GetInteger<int32_t>(int32_t(GetFixedWidth(LogicalType::INTERVAL)));
+		for (idx_t r = 0; r < count; r++) {
+			auto row_ptr = target + cursors[r];
+			if (!validity.RowIsValid(r)) {
+				Store<int32_t>(GetInteger<int32_t>(-1), row_ptr);
+				cursors[r] += sizeof(int32_t);
+				continue;
+			}
+			Store<int32_t>(value_length, row_ptr);
+			Store<uint64_t>(GetInteger<uint64_t>(source_data[r].micros), row_ptr + sizeof(int32_t));
+			Store<uint32_t>(GetInteger<uint32_t>(source_data[r].days), row_ptr + sizeof(int32_t) + sizeof(uint64_t));
+			Store<uint32_t>(GetInteger<uint32_t>(source_data[r].months),
+			                row_ptr + sizeof(int32_t) + sizeof(uint64_t) + sizeof(uint32_t));
+			cursors[r] += sizeof(int32_t) + GetFixedWidth(LogicalType::INTERVAL);
+		}
+	}
+
+	void WriteUUIDColumn(Vector &col, idx_t count, data_ptr_t target, idx_t cursors[]) {
+		auto source_data = FlatVector::GetData<hugeint_t>(col);
+		auto &validity = FlatVector::Validity(col);
+		auto value_length = GetInteger<int32_t>(int32_t(sizeof(uint64_t) * 2));
+		for (idx_t r = 0; r < count; r++) {
+			auto row_ptr = target + cursors[r];
+			if (!validity.RowIsValid(r)) {
+				Store<int32_t>(GetInteger<int32_t>(-1), row_ptr);
+				cursors[r] += sizeof(int32_t);
+				continue;
+			}
+			Store<int32_t>(value_length, row_ptr);
+			Store<uint64_t>(GetInteger<uint64_t>(uint64_t(source_data[r].upper) ^ (uint64_t(1) << 63)),
+			                row_ptr + sizeof(int32_t));
+			Store<uint64_t>(GetInteger<uint64_t>(source_data[r].lower), row_ptr + sizeof(int32_t) + sizeof(uint64_t));
+			cursors[r] += sizeof(int32_t) + sizeof(uint64_t) * 2;
+		}
+	}
+
+	void WriteColumn(Vector &col, idx_t count, data_ptr_t target, idx_t cursors[]) {
+		switch (col.GetType().id()) {
+		case LogicalTypeId::BOOLEAN:
+			WriteFixedColumn<bool, uint8_t, BooleanOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::SMALLINT:
+			WriteFixedColumn<int16_t, int16_t, IdentityOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::INTEGER:
+			WriteFixedColumn<int32_t, int32_t, IdentityOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::BIGINT:
+			WriteFixedColumn<int64_t, int64_t, IdentityOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::FLOAT:
+			WriteFixedColumn<float, uint32_t, FloatOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::DOUBLE:
+			WriteFixedColumn<double, uint64_t, DoubleOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::DATE:
+			WriteFixedColumn<date_t, uint32_t, DateOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::TIME:
+			WriteFixedColumn<dtime_t, uint64_t, TimeOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::TIMESTAMP:
+		case LogicalTypeId::TIMESTAMP_TZ:
+			WriteFixedColumn<timestamp_t, uint64_t, TimestampOperator>(col, count, target, cursors);
+			break;
+		case LogicalTypeId::INTERVAL:
+			WriteIntervalColumn(col, count, target, cursors);
+			break;
+		case LogicalTypeId::UUID:
+			WriteUUIDColumn(col, count, target, cursors);
+			break;
+		case LogicalTypeId::VARCHAR:
+		case LogicalTypeId::BLOB:
+			WriteStringColumn(col, count, target, cursors);
+			break;
+		default:
+			throw InternalException("Unsupported type for PostgresBinaryWriter::WriteColumn");
 		}
 	}
 
+	void WriteColumns(DataChunk &chunk) {
+		auto count = chunk.size();
+		auto column_count = chunk.ColumnCount();
+		// compute the encoded size of every row from the validity masks and the string lengths
+		idx_t row_sizes[STANDARD_VECTOR_SIZE];
+		idx_t base_size = sizeof(int16_t) + column_count * sizeof(int32_t);
+		for (idx_t c = 0; c < column_count; c++) {
+			base_size += GetFixedWidth(chunk.data[c].GetType());
+		}
+		for (idx_t r = 0; r < count; r++) {
+			row_sizes[r] = base_size;
+		}
+		for (idx_t c = 0; c < column_count; c++) {
+			auto &col = chunk.data[c];
+			auto &validity = FlatVector::Validity(col);
+			auto fixed_width = GetFixedWidth(col.GetType());
+			if (fixed_width == 0) {
+				auto strings = FlatVector::GetData<string_t>(col);
+				for (idx_t r = 0; r < count; r++) {
+					row_sizes[r] += validity.RowIsValid(r) ? strings[r].GetSize() : 0;
+				}
+			} else if (!validity.AllValid()) {
+				for (idx_t r = 0; r < count; r++) {
+					row_sizes[r] -= validity.RowIsValid(r) ? 0 : fixed_width;
+				}
+			}
+		}
+		// compute the row offsets, and size the buffer once for the entire chunk
+		idx_t cursors[STANDARD_VECTOR_SIZE];
+		idx_t total_size = 0;
+		for (idx_t r = 0; r < count; r++) {
+			cursors[r] = total_size;
+			total_size += row_sizes[r];
+		}
+		if (chunk_buffer.size() < total_size) {
+			chunk_buffer.resize(total_size);
+		}
+		auto target = chunk_buffer.data();
+		// write the field counts, followed by the columns
+		auto field_count = GetInteger<int16_t>(int16_t(column_count));
+		for (idx_t r = 0; r < count; r++) {
+			Store<int16_t>(field_count, target + cursors[r]);
+			cursors[r] += sizeof(int16_t);
+		}
+		for (idx_t c = 0; c < column_count; c++) {
+			WriteColumn(chunk.data[c], count, target, cursors);
+		}
+		stream.WriteData(target, total_size);
+	}
+
 public:
 	MemoryStream stream;
+
+private:
+	//! Buffer used to encode a chunk column-at-a-time
+	vector<data_t> chunk_buffer;
 };
 
 } // namespace duckdb
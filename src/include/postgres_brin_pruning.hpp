@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_brin_pruning.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "postgres_connection.hpp"
+
+namespace duckdb {
+struct PostgresBindData;
+class TableFilter;
+class TableFilterSet;
+
+//! A range of pages [start, end) of a table
+struct PostgresPageRange {
+	PostgresPageRange(idx_t start, idx_t end) : start(start), end(end) {
+	}
+
+	idx_t start;
+	idx_t end;
+};
+
+//! Determines the pages of a table that cannot contain rows that match the pushed-down filters of a scan - based on the
+//! summaries of the minmax BRIN indexes of the table (pg_brin_pruning)
+//! Reading the summaries requires the pageinspect extension and superuser privileges - without them nothing is pruned
+class PostgresBrinPruning {
+public:
+	//! The (sorted, disjoint) page ranges that can be skipped by the scan. The last page of the table is never
+	//! skipped, so that the open-ended last task of the scan still reads the pages added after its size was determined
+	static vector<PostgresPageRange> GetPrunedRanges(PostgresConnection &connection, const PostgresBindData &bind_data,
+	                                                 const vector<column_t> &column_ids, TableFilterSet &filters);
+	//! Whether or not a filter can be satisfied by the values between min and max (inclusive) - or by NULL values if
+	//! min is NULL (the values are all NULL) or has_nulls is set. The type has to have numeric statistics
+	static bool FilterMightMatch(TableFilter &filter, const LogicalType &type, const Value &min, const Value &max,
+	                             bool has_nulls);
+};
+
+} // namespace duckdb
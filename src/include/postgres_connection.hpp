@@ -26,14 +26,45 @@ struct OwnedPostgresConnection {
 	~OwnedPostgresConnection();
 
 	PGconn *connection;
+	//! The time at which the connection was opened
+	timestamp_t creation_time;
+	//! The names of the statements prepared on this connection - keyed by the SQL and the parameter types
+	//! Statements that have been executed only once have an empty name (they are not prepared yet)
+	unordered_map<string, string> prepared_statements;
+	idx_t prepared_statement_count = 0;
+	//! Set if prepared statements cannot be used on this connection - e.g. behind a pooler (PgBouncer in transaction
+	//! mode) that switches the server connection between transactions. Statements are then always sent as-is
+	bool prepared_statements_disabled = false;
+	//! The version of the server and whether or not the server is in recovery - determined once per connection
+	bool version_cached = false;
+	PostgresVersion version;
+	bool recovery_cached = false;
+	bool in_recovery = false;
+};
+
+//! A statement that is sent as part of a pipeline (see PostgresConnection::ExecutePipeline)
+struct PostgresPipelineStatement {
+	PostgresPipelineStatement(string query_p, vector<Value> parameters_p = vector<Value>(), bool binary_result = false)
+	    : query(std::move(query_p)), parameters(std::move(parameters_p)), binary_result(binary_result) {
+	}
+
+	//! A single statement - possibly with parameters ($1, $2, ...)
+	string query;
+	vector<Value> parameters;
+	//! Whether or not the result is received in the binary format (see PostgresConnection::QueryBinary)
+	bool binary_result;
 };
 
 struct PostgresCopyState {
 	PostgresCopyFormat format = PostgresCopyFormat::AUTO;
+	//! The Postgres types of the copied columns - if empty the types are derived from the DuckDB types
+	vector<PostgresType> postgres_types;
 };
 
 class PostgresConnection {
 public:
+	static constexpr const idx_t DEFAULT_PREPARED_STATEMENT_CACHE_SIZE = 0;
+
 	explicit PostgresConnection(shared_ptr<OwnedPostgresConnection> connection = nullptr);
 	~PostgresConnection();
 	// disable copy constructors
@@ -48,13 +79,42 @@ public:
 	void Execute(const string &query);
 	unique_ptr<PostgresResult> TryQuery(const string &query, optional_ptr<string> error_message = nullptr);
 	unique_ptr<PostgresResult> Query(const string &query);
+	//! Execute a query and receive the result in the binary format - the values have the same encoding as binary COPY
+	unique_ptr<PostgresResult> QueryBinary(const string &query);
+	//! Execute a query with parameters ($1, $2, ...) - the parameters are sent in the binary format where possible
+	//! The statement is prepared once per connection and reused as long as the prepared statement cache has space
+	//! Statements that are not expected to be executed again should not use the prepared statement cache
+	unique_ptr<PostgresResult> TryQueryWithParameters(const string &query, const vector<Value> &parameters,
+	                                                  optional_ptr<string> error_message = nullptr,
+	                                                  bool use_statement_cache = true);
+	unique_ptr<PostgresResult> QueryWithParameters(const string &query, const vector<Value> &parameters,
+	                                               bool use_statement_cache = true);
+	//! Execute a query with parameters and receive the result in the binary format (see QueryBinary)
+	unique_ptr<PostgresResult> QueryBinaryWithParameters(const string &query, const vector<Value> &parameters);
+	//! Prepare a query with parameters (as an unnamed statement) and describe its result columns
+	//! The parameters are given the same types as when the query is executed with TryQueryWithParameters
+	unique_ptr<PostgresResult> TryDescribeQuery(const string &query, const vector<Value> &parameters,
+	                                            string &error_message);
+
+	//! Obtain the estimated amount of rows and the estimated width of a row of the result of a query from Postgres
+	bool TryGetQueryEstimate(const string &query, double &rows, double &width);
 
 	//! Submits a set of queries to be executed in the connection.
 	vector<unique_ptr<PostgresResult>> ExecuteQueries(const string &queries);
+	//! Send a set of statements in a single round trip using the pipeline mode of libpq - and return one result per
+	//! statement. Unlike ExecuteQueries the statements can have parameters and binary results
+	//! The statements after a failing statement are not executed - the error of the failing statement is thrown
+	vector<unique_ptr<PostgresResult>> ExecutePipeline(const vector<PostgresPipelineStatement> &statements);
 
 	PostgresVersion GetPostgresVersion();
+	//! Export the snapshot of the current transaction so that other connections can attach to it - returns an empty
+	//! string if the server is in recovery or the snapshot could not be exported
+	string TryExportSnapshot(PostgresVersion version);
 
-	vector<IndexInfo> GetIndexInfo(const string &table_name);
+	//! The unique indexes (without predicate or expressions) of a table - the column sets hold the indexes of the
+	//! columns in the given list of column names
+	vector<IndexInfo> GetIndexInfo(const string &schema_name, const string &table_name,
+	                               const vector<string> &column_names);
 
 	void BeginCopyTo(ClientContext &context, PostgresCopyState &state, PostgresCopyFormat format,
 	                 const string &schema_name, const string &table_name, const vector<string> &column_names);
@@ -62,12 +122,25 @@ public:
 	void CopyData(PostgresBinaryWriter &writer);
 	void CopyData(PostgresTextWriter &writer);
 	void CopyChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk, DataChunk &varchar_chunk);
+	//! Cast all columns of a chunk to their textual Postgres representation - used for the text COPY format
+	static void CastChunkToPostgresVarchar(ClientContext &context, DataChunk &chunk, DataChunk &varchar_chunk,
+	                                       optional_ptr<const vector<PostgresType>> postgres_types = nullptr);
 	void FinishCopyTo(PostgresCopyState &state);
 
 	void BeginCopyFrom(PostgresBinaryReader &reader, const string &query);
+	//! Send the query of a COPY without waiting for it - used to start the next COPY while the rows of the previous
+	//! one are still being processed. The COPY is started with FinishCopyFrom
+	void SendCopyFrom(const string &query);
+	void FinishCopyFrom(PostgresBinaryReader &reader, const string &query);
+	//! Stop a COPY (or any other query) that is still running on the connection, e.g. of a scan that stopped early
+	//! If cancel is set the query is cancelled on the server, otherwise its remaining rows are received and discarded
+	//! Returns true if a query was running - a cancelled query aborts the transaction of the connection
+	bool AbortCopyFrom(bool cancel);
 
 	bool IsOpen();
 	void Close();
+	//! Re-establish a broken connection (PQreset) - the state kept about the server connection is cleared
+	void Reset();
 
 	shared_ptr<OwnedPostgresConnection> GetConnection() {
 		return connection;
@@ -85,9 +158,16 @@ public:
 
 	static void DebugSetPrintQueries(bool print);
 	static bool DebugPrintQueries();
+	//! Set the maximum amount of statements that are prepared per connection (0 to disable)
+	static void SetPreparedStatementCacheSize(idx_t size);
 
 private:
 	PGresult *PQExecute(const string &query);
+	unique_ptr<PostgresResult> TryQueryWithParametersInternal(const string &query, const vector<Value> &parameters,
+	                                                          optional_ptr<string> error_message,
+	                                                          bool use_statement_cache, int result_format);
+	//! Forget the prepared statements and send all later statements as-is
+	void DisablePreparedStatements();
 
 	shared_ptr<OwnedPostgresConnection> connection;
 	string dsn;
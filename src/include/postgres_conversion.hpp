@@ -15,11 +15,20 @@
 #include <arpa/inet.h>
 // htonll is not available on Linux it seems
 #ifndef ntohll
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// use the builtin so the compiler can vectorize loops of byte swaps
+#define ntohll(x) __builtin_bswap64((uint64_t)(x))
+#else
 #define ntohll(x) ((((uint64_t)ntohl(x & 0xFFFFFFFF)) << 32) + ntohl(x >> 32))
 #endif
+#endif
 #ifndef htonll
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define htonll(x) __builtin_bswap64((uint64_t)(x))
+#else
 #define htonll(x) ((((uint64_t)htonl(x)) << 32) + htonl((x) >> 32))
 #endif
+#endif
 
 #define POSTGRES_EPOCH_JDATE 2451545 /* == date2j(2000, 1, 1) */
 #define DUCKDB_EPOCH_DATE    2440588
@@ -32,6 +41,10 @@
 #define POSTGRES_INFINITY    9223372036854775807ULL
 #define POSTGRES_NINFINITY   9223372036854775808ULL
 
+// address families as sent in the binary representation of inet/cidr values
+#define POSTGRES_AF_INET  2
+#define POSTGRES_AF_INET6 3
+
 #define NBASE      10000
 #define DEC_DIGITS 4 /* decimal digits per NBASE digit */
 
@@ -0,0 +1,27 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_copy_data.h
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <libpq-fe.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Peek at the next CopyData message of a COPY ... TO STDOUT - if it has been received completely already.
+//! Returns the length of the data and points "data" into the receive buffer of the connection, or 0 if there is no
+//! complete CopyData message in the receive buffer (in which case PQgetCopyData has to be used instead).
+//! The data remains valid until the message is consumed, or until any other libpq function is called
+int postgres_peek_copy_data(PGconn *conn, const char **data);
+//! Consume the CopyData message returned by postgres_peek_copy_data
+void postgres_consume_copy_data(PGconn *conn);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_copy_decompressor.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+
+#include <deque>
+
+namespace duckdb {
+struct PostgresInflateState;
+
+//! Decompresses the output of a compressed COPY (see pg_copy_compression_function). The compressed COPY returns a
+//! single bytea column - the concatenated values of which are the zlib-compressed binary COPY output of the query.
+//! The decompressed data is split into the messages an uncompressed COPY consists of: the header together with the
+//! first row, a message per row and the trailer
+class PostgresCopyDecompressor {
+public:
+	PostgresCopyDecompressor();
+	~PostgresCopyDecompressor();
+
+public:
+	//! Prepare for decompressing a new COPY
+	void Reset();
+	//! Decompress a message of the compressed COPY - returns false if this was the final message
+	bool Decompress(const_data_ptr_t data, idx_t len);
+	//! Fetch the next decompressed message (which has to be freed with FreeMessage) - returns false if there is none
+	bool Next(data_ptr_t &buffer, idx_t &len);
+	//! Free a message returned by Next - these are not allocated by libpq, so they cannot be freed with PQfreemem
+	static void FreeMessage(void *message);
+
+private:
+	void Inflate(const_data_ptr_t data, idx_t len);
+	//! Split the decompressed data into messages - for as far as the messages are complete
+	void SplitMessages();
+	//! Get the length of the row (or trailer) at the given offset of the decompressed data - if it is complete
+	bool TryGetRowLength(idx_t offset, idx_t &len, bool &is_trailer);
+	void FreeMessages();
+
+	unique_ptr<PostgresInflateState> inflate_state;
+	//! Whether or not the header of the compressed COPY has been read
+	bool read_compressed_header = false;
+	//! Whether or not the header of the decompressed COPY has been read
+	bool read_header = false;
+	//! Whether or not the trailer of the decompressed COPY has been read
+	bool read_trailer = false;
+	//! Decompressed data that has not been split into messages yet
+	vector<data_t> pending;
+	idx_t pending_size = 0;
+	std::deque<std::pair<data_ptr_t, idx_t>> messages;
+};
+
+} // namespace duckdb
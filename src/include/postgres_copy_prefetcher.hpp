@@ -0,0 +1,70 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_copy_prefetcher.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/mutex.hpp"
+#include <libpq-fe.h>
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace duckdb {
+class PostgresCopyDecompressor;
+
+//! Frees a row buffer - PQfreemem for buffers allocated by libpq
+typedef void (*postgres_free_buffer_t)(void *buffer);
+
+//! Receives the row messages of a COPY ... TO STDOUT in a background thread using non-blocking libpq calls,
+//! and stores them in a bounded ring of row buffers. This allows receiving data from the network to overlap with
+//! decoding the data in ScanChunk
+class PostgresCopyPrefetcher {
+public:
+	static constexpr const idx_t DEFAULT_CAPACITY = 4 * STANDARD_VECTOR_SIZE;
+	//! The maximum size of the buffered rows - so that a ring of large rows (e.g. of large JSON documents) stays
+	//! bounded in size as well
+	static constexpr const idx_t MAX_BUFFERED_BYTES = 16 * 1024 * 1024;
+
+	explicit PostgresCopyPrefetcher(PGconn *conn, idx_t capacity = DEFAULT_CAPACITY,
+	                                optional_ptr<PostgresCopyDecompressor> decompressor = nullptr);
+	~PostgresCopyPrefetcher();
+
+public:
+	//! Start receiving rows - the COPY must be in progress on the connection
+	void Start();
+	//! Fetch the next row buffer (which has to be freed with the function returned by GetFreeFunction) - returns
+	//! false at the end of the COPY
+	bool Next(data_ptr_t &buffer, idx_t &len);
+	//! The function that frees the row buffers - rows decompressed by the prefetcher are not allocated by libpq
+	postgres_free_buffer_t GetFreeFunction() const;
+	//! Wait for the receiver to finish and verify the result of the COPY
+	void Finish();
+
+private:
+	void ReceiveRows();
+	void Stop();
+
+	PGconn *conn;
+	idx_t capacity;
+	//! Decompresses the data of a compressed COPY on the receiving thread (if any)
+	optional_ptr<PostgresCopyDecompressor> decompressor;
+	mutex lock;
+	std::condition_variable rows_available;
+	std::condition_variable space_available;
+	std::deque<std::pair<data_ptr_t, idx_t>> rows;
+	//! The total size of the buffered rows
+	idx_t buffered_bytes = 0;
+	bool finished = false;
+	bool stopped = false;
+	string error;
+	std::thread receiver;
+};
+
+} // namespace duckdb
@@ -0,0 +1,56 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_extension_state.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/main/client_context_state.hpp"
+#include "postgres_scan_statistics.hpp"
+
+namespace duckdb {
+
+//! State of the Postgres extension per client context
+class PostgresExtensionState : public ClientContextState {
+public:
+	static constexpr const char *STATE_NAME = "postgres_extension";
+	//! The amount of (most recent) scans for which statistics are kept
+	static constexpr const idx_t MAX_SCAN_STATISTICS = 100;
+
+	static void Register(ClientContext &context);
+	static optional_ptr<PostgresExtensionState> Get(ClientContext &context);
+
+	//! Record a table of an attached Postgres database that was bound in the current query
+	void AddBoundTable(const string &catalog_name, const string &schema_name, const string &table_name);
+	//! Register the statistics of a scan - assigns the id of the scan
+	void AddScanStatistics(shared_ptr<PostgresScanStatistics> statistics);
+	//! The statistics of the most recent scans - most recent first
+	vector<shared_ptr<PostgresScanStatistics>> GetScanStatistics();
+
+public:
+	void QueryBegin(ClientContext &context) override;
+	bool CanRequestRebind() override {
+		return true;
+	}
+	RebindQueryInfo OnPlanningError(ClientContext &context, SQLStatement &statement, ErrorData &error) override;
+
+private:
+	struct BoundTable {
+		string catalog_name;
+		string schema_name;
+		string table_name;
+	};
+
+	mutex lock;
+	//! The Postgres tables bound in the current query - their catalog entries are reloaded when binding fails
+	vector<BoundTable> bound_tables;
+	vector<shared_ptr<PostgresScanStatistics>> scan_statistics;
+	idx_t next_scan_id = 0;
+};
+
+} // namespace duckdb
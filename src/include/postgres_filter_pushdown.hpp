@@ -11,18 +11,58 @@
 #include "duckdb/planner/table_filter.hpp"
 #include "duckdb/planner/filter/conjunction_filter.hpp"
 #include "duckdb/planner/filter/constant_filter.hpp"
+#include "duckdb/planner/expression.hpp"
+#include "postgres_utils.hpp"
 
 namespace duckdb {
 
+//! The columns of a Postgres scan that expressions are pushed into
+struct PostgresPushdownColumns {
+	PostgresPushdownColumns(idx_t table_index, const vector<column_t> &column_ids, const vector<string> &names,
+	                        const vector<PostgresType> &postgres_types)
+	    : table_index(table_index), column_ids(column_ids), names(names), postgres_types(postgres_types) {
+	}
+
+	//! The table index of the LogicalGet - column references of the scan are bound to this index
+	idx_t table_index;
+	const vector<column_t> &column_ids;
+	const vector<string> &names;
+	const vector<PostgresType> &postgres_types;
+	//! If set, column references are qualified with this alias
+	string alias;
+	//! If not empty, the alias of every column (by column id) - overrides the alias
+	vector<string> column_aliases;
+};
+
 class PostgresFilterPushdown {
 public:
 	static string TransformFilters(const vector<column_t> &column_ids, optional_ptr<TableFilterSet> filters,
-	                               const vector<string> &names);
+	                               const vector<string> &names, const vector<PostgresType> &postgres_types);
+	//! Translate a (boolean) expression over the columns of a Postgres scan into a Postgres predicate
+	//! Returns false if the expression - or any part of it - cannot be evaluated by Postgres with the same semantics
+	static bool TryTransformExpression(const Expression &expr, const PostgresPushdownColumns &columns,
+	                                   string &result);
+	//! Translate a comparison between two translated expressions of the given type - byte_order indicates that
+	//! Postgres already compares the strings in the C collation
+	static bool TryTransformComparison(ExpressionType type, const LogicalType &input_type, const string &left,
+	                                   const string &right, string &result, bool byte_order = false);
+	//! Translate an aggregate over the columns of a Postgres scan into a Postgres aggregate
+	//! result_type is set to the type the result of the Postgres aggregate is read as - which can differ from the
+	//! return type of the aggregate in DuckDB (e.g. SUM(INTEGER) is a BIGINT in Postgres, but a HUGEINT in DuckDB)
+	static bool TryTransformAggregate(const Expression &expr, const PostgresPushdownColumns &columns, string &result,
+	                                  LogicalType &result_type);
 
 private:
-	static string TransformFilter(string &column_name, TableFilter &filter);
+	static string TransformFilter(string &column_name, const PostgresType &postgres_type, TableFilter &filter);
 	static string TransformComparision(ExpressionType type);
-	static string CreateExpression(string &column_name, vector<unique_ptr<TableFilter>> &filters, string op);
+	//! Render a constant as a typed Postgres literal
+	static string TransformConstant(const Value &constant);
+	//! Render a column so that it is compared in the same representation that DuckDB reads it in
+	static string TransformColumn(const string &column_name, const PostgresType &postgres_type);
+	static bool TryTransformFunction(const Expression &expr, const PostgresPushdownColumns &columns, string &result);
+	static bool TryTransformCast(const Expression &expr, const PostgresPushdownColumns &columns, string &result);
+	static string CreateExpression(string &column_name, const PostgresType &postgres_type,
+	                               vector<unique_ptr<TableFilter>> &filters, string op);
 };
 
 } // namespace duckdb
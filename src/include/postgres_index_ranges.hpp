@@ -0,0 +1,32 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_index_ranges.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "postgres_connection.hpp"
+
+namespace duckdb {
+struct PostgresBindData;
+class TableFilterSet;
+
+//! Splits a scan with a selective filter on the leading column of a btree index into ranges of that column
+//! (pg_index_range_scan) - so that every task can use an index scan, instead of reading a ctid range of the heap
+//! The boundaries of the ranges are taken from the histogram bounds of the column in pg_stats
+class PostgresIndexRanges {
+public:
+	//! The maximum fraction of the rows of the table that the filters may select for the scan to be split on an index
+	static constexpr const double MAX_SELECTIVITY = 0.05;
+
+	//! The predicates that select one range of the key each (at most max_ranges) - together they select all rows that
+	//! can match the filters. Empty if the scan should not be split on an index
+	static vector<string> GetKeyRanges(PostgresConnection &connection, const PostgresBindData &bind_data,
+	                                   const vector<column_t> &column_ids, TableFilterSet &filters, idx_t max_ranges);
+};
+
+} // namespace duckdb
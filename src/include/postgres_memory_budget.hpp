@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_memory_budget.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <condition_variable>
+
+namespace duckdb {
+class BufferManager;
+
+//! The amount of bytes of received rows that the scans of a database should hold at once (pg_scan_memory_limit)
+//! Shared by all scans of the database - this is a soft limit: a scan pauses reading once the budget is exhausted,
+//! until rows are released or MAX_THROTTLE_MS has passed. Rows can be retained by the operators after the scan (e.g.
+//! as zero-copy strings held by a hash table), which are only released once the scan continues - blocking until the
+//! budget is freed could then wait forever. The held rows always count toward the (hard) memory_limit of DuckDB
+class PostgresMemoryBudget : public ObjectCacheEntry {
+public:
+	static constexpr const char *CACHE_KEY = "postgres_scan_memory_budget";
+	//! The maximum time a scan is paused for before it continues reading regardless
+	static constexpr const idx_t MAX_THROTTLE_MS = 1000;
+
+	//! The budget of the database of the context - nullptr if pg_scan_memory_limit is not set
+	static shared_ptr<PostgresMemoryBudget> Get(ClientContext &context);
+
+	//! Pause until the budget is no longer exhausted - or MAX_THROTTLE_MS has passed
+	void Throttle();
+	//! Whether or not the rows held by the scans exceed the budget
+	bool Exhausted();
+	void Acquire(idx_t size);
+	void Release(idx_t size);
+
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	static string ObjectType() {
+		return "postgres_memory_budget";
+	}
+
+private:
+	//! The lock and the signal that the waiting scans are woken up with when rows are released
+	mutex lock;
+	std::condition_variable released;
+	atomic<idx_t> limit {0};
+	atomic<idx_t> used {0};
+};
+
+//! The bytes of received rows held by a scan - accounted in the memory budget and in the buffer manager of DuckDB,
+//! so that they count toward the memory_limit. Released when the reservation is destroyed
+class PostgresMemoryReservation {
+public:
+	PostgresMemoryReservation() {
+	}
+	PostgresMemoryReservation(shared_ptr<PostgresMemoryBudget> budget, BufferManager &buffer_manager)
+	    : budget(std::move(budget)), buffer_manager(&buffer_manager) {
+	}
+	~PostgresMemoryReservation() {
+		Reset();
+	}
+	PostgresMemoryReservation(const PostgresMemoryReservation &) = delete;
+	PostgresMemoryReservation &operator=(const PostgresMemoryReservation &) = delete;
+	PostgresMemoryReservation(PostgresMemoryReservation &&other) noexcept;
+	PostgresMemoryReservation &operator=(PostgresMemoryReservation &&other) noexcept;
+
+public:
+	//! Account for size more bytes - throws if the buffer manager cannot make room for them
+	void Grow(idx_t size);
+	//! Release all bytes
+	void Reset();
+	//! Move the bytes accounted so far to a new reservation (e.g. together with the row buffers they belong to)
+	PostgresMemoryReservation Split();
+	//! Whether or not the rows held by all scans of the database exceed the budget
+	bool BudgetExhausted() {
+		return budget && budget->Exhausted();
+	}
+	void Throttle() {
+		if (budget) {
+			budget->Throttle();
+		}
+	}
+
+private:
+	shared_ptr<PostgresMemoryBudget> budget;
+	optional_ptr<BufferManager> buffer_manager;
+	idx_t size = 0;
+};
+
+} // namespace duckdb
@@ -35,6 +35,9 @@ public:
 	int64_t GetInt64(idx_t row, idx_t col) {
 		return atoll(GetValueInternal(row, col));
 	}
+	double GetDouble(idx_t row, idx_t col) {
+		return atof(GetValueInternal(row, col));
+	}
 	bool GetBool(idx_t row, idx_t col) {
 		return strcmp(GetValueInternal(row, col), "t") == 0;
 	}
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_row_arena.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+
+namespace duckdb {
+
+//! Allocates the row buffers of a binary COPY from large blocks, instead of allocating a buffer per row
+//! (see pg_copy_arena_buffers). The blocks are freed with PQfreemem - like the row buffers allocated by libpq - so
+//! they can be retained by PostgresRowBuffers
+class PostgresRowArena {
+public:
+	static constexpr const idx_t BLOCK_SIZE = 1 << 20;
+
+	PostgresRowArena() {
+	}
+	~PostgresRowArena() {
+		for (auto &block : blocks) {
+			free(block.data);
+		}
+	}
+	PostgresRowArena(const PostgresRowArena &) = delete;
+	PostgresRowArena &operator=(const PostgresRowArena &) = delete;
+
+public:
+	//! Allocate a buffer for a row - the buffer stays valid until Release is called (or the blocks are taken)
+	data_ptr_t Allocate(idx_t size) {
+		if (blocks.empty() || offset + size > blocks.back().size) {
+			auto block_size = MaxValue<idx_t>(BLOCK_SIZE, size);
+			auto data = data_ptr_cast(malloc(block_size));
+			if (!data) {
+				throw OutOfMemoryException("Failed to allocate a row buffer of %llu bytes", block_size);
+			}
+			blocks.push_back(ArenaBlock {data, block_size});
+			offset = 0;
+		}
+		auto result = blocks.back().data + offset;
+		offset += size;
+		return result;
+	}
+
+	//! Release all rows - the first block is kept for rows allocated afterwards
+	void Release() {
+		for (idx_t i = 1; i < blocks.size(); i++) {
+			free(blocks[i].data);
+		}
+		if (blocks.size() > 1) {
+			blocks.erase(blocks.begin() + 1, blocks.end());
+		}
+		offset = 0;
+	}
+
+	//! Take ownership of the blocks that hold the rows allocated so far - they have to be freed with PQfreemem
+	void TakeBlocks(vector<data_ptr_t> &result) {
+		for (auto &block : blocks) {
+			result.push_back(block.data);
+		}
+		blocks.clear();
+		offset = 0;
+	}
+
+private:
+	struct ArenaBlock {
+		data_ptr_t data;
+		idx_t size;
+	};
+
+	vector<ArenaBlock> blocks;
+	//! The offset within the last block
+	idx_t offset = 0;
+};
+
+} // namespace duckdb
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_scan_statistics.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/function/table_function.hpp"
+#include <chrono>
+
+namespace duckdb {
+
+//! Counters of a single Postgres scan - collected if pg_scan_statistics is enabled and shown by postgres_scan_stats()
+//! The threads of the scan collect their counters locally and add them once per chunk
+struct PostgresScanStatistics {
+	explicit PostgresScanStatistics(string source_p) : source(std::move(source_p)) {
+	}
+
+	//! The id of the scan within the client context
+	idx_t scan_id = 0;
+	//! Either the scanned table or the query that is scanned
+	string source;
+	atomic<idx_t> rows {0};
+	//! The size of the COPY messages or binary results received from Postgres
+	atomic<idx_t> bytes {0};
+	//! The time spent waiting for data from Postgres (e.g. blocked in PQgetCopyData)
+	atomic<idx_t> wait_time_ns {0};
+	//! The time spent obtaining (and setting up) the connections of the scan
+	atomic<idx_t> connection_time_ns {0};
+	atomic<idx_t> task_count {0};
+	//! The total and the maximum duration of the tasks (e.g. ctid ranges) of the scan
+	atomic<idx_t> task_time_ns {0};
+	atomic<idx_t> max_task_time_ns {0};
+
+	void AddDecodeTime(const string &type, idx_t time_ns);
+	void AddTask(idx_t time_ns);
+	//! The total time spent decoding values - per column type
+	unordered_map<string, idx_t> GetDecodeTimes();
+
+	static idx_t Now() {
+		return idx_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		                 std::chrono::steady_clock::now().time_since_epoch())
+		                 .count());
+	}
+
+private:
+	mutex lock;
+	unordered_map<string, idx_t> decode_time_ns;
+};
+
+class PostgresScanStatsFunction : public TableFunction {
+public:
+	PostgresScanStatsFunction();
+};
+
+} // namespace duckdb
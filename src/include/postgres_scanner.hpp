@@ -18,22 +18,60 @@ class PostgresCatalog;
 struct PostgresLocalState;
 struct PostgresGlobalState;
 class PostgresTransaction;
+class PostgresRuntimeFilter;
 
 struct PostgresBindData : public FunctionData {
 	static constexpr const idx_t DEFAULT_PAGES_PER_TASK = 1000;
+	static constexpr const idx_t DEFAULT_CURSOR_FETCH_SIZE = 10000;
 
 	PostgresVersion version;
 	string schema_name;
 	string table_name;
 	string sql;
+	//! The parameters ($1, $2, ...) of the query of postgres_query - a query with parameters is read through a cursor
+	//! because COPY does not accept parameters
+	vector<Value> parameters;
 	idx_t pages_approx = 0;
 
 	vector<PostgresType> postgres_types;
 	vector<string> names;
 	vector<LogicalType> types;
+	//! The statistics Postgres gathered about the columns of the table - empty if unknown
+	vector<PostgresColumnStatistics> column_statistics;
+	//! The density of the table when it was last analyzed (reltuples / relpages) - 0 if unknown
+	double rows_per_page = 0;
+	//! The number of rows of the table when it was last analyzed - negative if unknown
+	double approx_num_rows = -1;
 
 	idx_t pages_per_task = DEFAULT_PAGES_PER_TASK;
+	//! The target duration of a task in milliseconds (pg_task_target_ms) - if set, the amount of pages per task is
+	//! adapted to the throughput of the finished tasks of the scan. 0 if disabled
+	idx_t task_target_ms = 0;
+	//! The maximum amount of threads of a scan with adaptive tasks - the threads of DuckDB and the connection limit
+	idx_t adaptive_max_threads = 1;
 	string dsn;
+	//! An exported snapshot that the scan imports (the snapshot parameter of postgres_scan) - empty if the scan takes
+	//! its own snapshot
+	string snapshot;
+	//! If not empty, the scan is split into one task per filter - every filter selects a disjoint part of the rows
+	vector<string> partition_filters;
+	//! Predicates of the query that the optimizer pushed into the generated SQL (in addition to the table filters)
+	vector<string> pushdown_predicates;
+	//! The ORDER BY and LIMIT clause that the optimizer pushed into the generated SQL - if set, the scan is performed
+	//! by a single task
+	string limit_clause;
+	//! The expressions that are selected instead of the columns with the same index - e.g. the keys extracted from a
+	//! JSON column that the optimizer pushed into the generated SQL. An empty expression selects the column itself
+	vector<string> column_expressions;
+	//! Filters on the join keys of the build side of joins with this scan - applied once the build side is complete
+	vector<shared_ptr<PostgresRuntimeFilter>> runtime_filters;
+	//! The relkind of the scanned relation in pg_class
+	char relation_kind = 'r';
+	//! If not empty, the leaf partitions of the (partitioned) table are scanned instead of the table itself
+	vector<PostgresLeafPartition> leaf_partitions;
+	//! The DSNs of the worker nodes that store the leaf partitions - if the leaf partitions are the shards of a
+	//! distributed (Citus) table that are read from the worker nodes directly (pg_citus_shard_scan)
+	vector<string> worker_nodes;
 
 	bool requires_materialization = true;
 	bool can_use_main_thread = true;
@@ -43,6 +81,15 @@ struct PostgresBindData : public FunctionData {
 
 public:
 	void SetTablePages(idx_t approx_num_pages);
+	//! Set the number of rows and pages of the table at the time it was last analyzed (reltuples and relpages)
+	void SetApproxNumRows(double approx_num_rows, idx_t analyzed_pages);
+	void SetPartitionFilters(vector<string> filters);
+	void SetLeafPartitions(vector<PostgresLeafPartition> partitions);
+	void SetLimitClause(string clause);
+	//! Add a column that selects the given expression - returns the index of the column
+	idx_t AddColumnExpression(string name, LogicalType type, string expression);
+	//! The SQL that selects the column with the given index (without the conversions of the scan)
+	string GetColumnSQL(column_t column_id) const;
 
 	void SetCatalog(PostgresCatalog &catalog);
 	optional_ptr<PostgresCatalog> GetCatalog() const {
@@ -69,8 +116,14 @@ class PostgresScanFunction : public TableFunction {
 public:
 	PostgresScanFunction();
 
+	//! approx_num_pages is the size of the relation on disk - if a connection is provided it is used to look up the
+	//! leaf partitions of partitioned tables and the shards of distributed tables
 	static void PrepareBind(PostgresVersion version, ClientContext &context, PostgresBindData &bind,
-	                        idx_t approx_num_pages);
+	                        idx_t approx_num_pages, optional_ptr<PostgresConnection> connection = nullptr);
+	//! Convert the statistics Postgres gathered about a column into DuckDB statistics - returns nullptr if unknown
+	static unique_ptr<BaseStatistics> GetColumnStatistics(const LogicalType &type,
+	                                                      const PostgresColumnStatistics &statistics,
+	                                                      double approx_num_rows);
 };
 
 class PostgresScanFunctionFilterPushdown : public TableFunction {
@@ -86,6 +139,11 @@ public:
 	static void ClearPostgresCaches(ClientContext &context);
 };
 
+class PostgresConnectionPoolInfoFunction : public TableFunction {
+public:
+	PostgresConnectionPoolInfoFunction();
+};
+
 class PostgresQueryFunction : public TableFunction {
 public:
 	PostgresQueryFunction();
@@ -96,4 +154,39 @@ public:
 	PostgresExecuteFunction();
 };
 
+//! Keeps a DuckDB table in sync with a Postgres table - the first call copies the table, every later call applies
+//! the changes received through a logical replication slot since the previous call
+class PostgresMirrorFunction : public TableFunction {
+public:
+	PostgresMirrorFunction();
+};
+
+struct PostgresLookupBindData : public TableFunctionData {
+	string schema_name;
+	string table_name;
+	//! The (Postgres) names of the columns of the table
+	vector<string> names;
+	vector<LogicalType> types;
+	vector<PostgresType> postgres_types;
+	//! The query that looks up the rows of a batch of keys - the keys are passed as a textual array in $1
+	string sql;
+	bool read_only = true;
+
+	void SetCatalog(PostgresCatalog &catalog) {
+		pg_catalog = &catalog;
+	}
+	optional_ptr<PostgresCatalog> GetCatalog() const {
+		return pg_catalog;
+	}
+
+private:
+	optional_ptr<PostgresCatalog> pg_catalog;
+};
+
+//! Looks up the rows of a Postgres table that match the keys of its input - one query per chunk of keys
+class PostgresLookupFunction : public TableFunction {
+public:
+	PostgresLookupFunction();
+};
+
 } // namespace duckdb
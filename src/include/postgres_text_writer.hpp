@@ -21,56 +21,78 @@ public:
 		stream.WriteData(const_data_ptr_cast("\b"), 1);
 	}
 
-	void WriteCharInternal(char c) {
-		stream.WriteData(const_data_ptr_cast(&c), 1);
-	}
-
-	void WriteChar(char c) {
+	//! The character that follows the backslash when the given character is escaped - or '\0' if the character is
+	//! written as-is
+	static inline char GetEscapeCharacter(char c) {
 		switch (c) {
 		case '\n':
-			WriteCharInternal('\\');
-			WriteCharInternal('n');
-			break;
+			return 'n';
 		case '\r':
-			WriteCharInternal('\\');
-			WriteCharInternal('r');
-			break;
+			return 'r';
 		case '\b':
-			WriteCharInternal('\\');
-			WriteCharInternal('b');
-			break;
+			return 'b';
 		case '\f':
-			WriteCharInternal('\\');
-			WriteCharInternal('f');
-			break;
+			return 'f';
 		case '\t':
-			WriteCharInternal('\\');
-			WriteCharInternal('t');
-			break;
+			return 't';
 		case '\v':
-			WriteCharInternal('\\');
-			WriteCharInternal('v');
-			break;
+			return 'v';
 		case '\\':
-			WriteCharInternal('\\');
-			WriteCharInternal('\\');
-			break;
+			return '\\';
 		case '"':
-			WriteCharInternal('\\');
-			WriteCharInternal('"');
-			break;
+			return '"';
 		default:
-			WriteCharInternal(c);
-			break;
+			return '\0';
+		}
+	}
+
+	//! Whether or not any of the bytes of the word might have to be escaped - i.e. is a control character (< 0x20), a
+	//! backslash or a double quote
+	static inline bool MightRequireEscape(uint64_t word) {
+		constexpr uint64_t ONES = 0x0101010101010101ULL;
+		constexpr uint64_t HIGH_BITS = 0x8080808080808080ULL;
+		auto backslashes = word ^ (ONES * uint64_t('\\'));
+		auto quotes = word ^ (ONES * uint64_t('"'));
+		// a byte is smaller than n if subtracting n from it sets its high bit, while it was not set before - the xor
+		// turns the backslashes and quotes into zero bytes
+		auto control = (word - ONES * 0x20) & ~word;
+		auto zero_backslash = (backslashes - ONES) & ~backslashes;
+		auto zero_quote = (quotes - ONES) & ~quotes;
+		return ((control | zero_backslash | zero_quote) & HIGH_BITS) != 0;
+	}
+
+	void WriteChar(char c) {
+		auto escape = GetEscapeCharacter(c);
+		if (escape == '\0') {
+			stream.WriteData(const_data_ptr_cast(&c), 1);
+			return;
 		}
+		const char escaped[] = {'\\', escape};
+		stream.WriteData(const_data_ptr_cast(escaped), 2);
 	}
 
+	//! Write a string - the runs of characters that do not have to be escaped are found a word at a time, and are
+	//! written at once
 	void WriteVarchar(string_t value) {
 		auto size = value.GetSize();
 		auto data = value.GetData();
-		for (idx_t c = 0; c < size; c++) {
-			WriteChar(data[c]);
+		idx_t run_start = 0;
+		idx_t pos = 0;
+		while (pos < size) {
+			auto word_end = pos + sizeof(uint64_t);
+			if (word_end <= size && !MightRequireEscape(Load<uint64_t>(const_data_ptr_cast(data + pos)))) {
+				pos = word_end;
+				continue;
+			}
+			if (GetEscapeCharacter(data[pos]) == '\0') {
+				pos++;
+				continue;
+			}
+			stream.WriteData(const_data_ptr_cast(data + run_start), pos - run_start);
+			WriteChar(data[pos]);
+			run_start = ++pos;
 		}
+		stream.WriteData(const_data_ptr_cast(data + run_start), size - run_start);
 	}
 
 	void WriteValue(Vector &col, idx_t r) {
@@ -96,6 +118,19 @@ public:
 		stream.WriteData(const_data_ptr_cast("\\.\n"), 3);
 	}
 
+	//! Write all rows of a chunk of VARCHAR columns
+	void WriteChunk(DataChunk &varchar_chunk) {
+		for (idx_t r = 0; r < varchar_chunk.size(); r++) {
+			for (idx_t c = 0; c < varchar_chunk.ColumnCount(); c++) {
+				if (c > 0) {
+					WriteSeparator();
+				}
+				WriteValue(varchar_chunk.data[c], r);
+			}
+			FinishRow();
+		}
+	}
+
 public:
 	MemoryStream stream;
 };
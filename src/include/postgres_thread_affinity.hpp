@@ -0,0 +1,50 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// postgres_thread_affinity.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace duckdb {
+
+//! Pins the thread that works on a scan to the CPUs of a single NUMA node (see pg_scan_thread_affinity). Memory is
+//! allocated on the node of the thread that first touches it - so receive buffers and decoded vectors then end up on
+//! the same node as the thread that decodes them. The thread stays pinned until the scan state releases it - when the
+//! scan of the thread is finished, or when the scan continues on another thread of the scheduler. The original
+//! affinity of every thread is tracked once, so that scans that take over a pinned thread never restore the affinity
+//! of another scan. Only supported on Linux - elsewhere pinning is a no-op
+class PostgresThreadAffinity {
+public:
+	PostgresThreadAffinity() = default;
+	~PostgresThreadAffinity();
+	PostgresThreadAffinity(const PostgresThreadAffinity &) = delete;
+	PostgresThreadAffinity &operator=(const PostgresThreadAffinity &) = delete;
+
+public:
+	//! Pin the current thread to the CPUs of the given node - DConstants::INVALID_INDEX leaves the thread as-is. This
+	//! is free if the current thread is already pinned by this object - the thread pinned before is released otherwise
+	void Pin(idx_t node);
+	//! Restore the original affinity of the pinned thread - unless another scan has pinned the thread since
+	void Release();
+
+	//! The amount of NUMA nodes that have CPUs (1 if unknown)
+	static idx_t NodeCount();
+
+private:
+#ifdef __linux__
+	pthread_t thread;
+#endif
+	bool pinned = false;
+};
+
+} // namespace duckdb
@@ -35,20 +35,50 @@ enum class PostgresTypeAnnotation {
 	GEOM_BOX,
 	GEOM_PATH,
 	GEOM_POLYGON,
-	GEOM_CIRCLE
+	GEOM_CIRCLE,
+	MACADDR,
+	MACADDR8,
+	INET,
+	PGVECTOR
 };
 
 struct PostgresType {
 	idx_t oid = 0;
 	PostgresTypeAnnotation info = PostgresTypeAnnotation::STANDARD;
 	vector<PostgresType> children;
+	//! Whether or not the strings of the column are ordered byte-wise in Postgres (the C or POSIX collation)
+	bool byte_order_collation = false;
+};
+
+//! The statistics Postgres gathered about a column (in pg_stats) - only available after the table is analyzed
+struct PostgresColumnStatistics {
+	bool has_statistics = false;
+	//! The fraction of NULL values
+	double null_fraction = 0;
+	//! The number of distinct values - if negative, the number of distinct values divided by the number of rows
+	double distinct_count = 0;
+	//! The average width in bytes of the values
+	idx_t average_width = 0;
 };
 
 enum class PostgresCopyFormat { AUTO = 0, BINARY = 1, TEXT = 2 };
 
+//! A leaf partition of a partitioned table - the leaf partitions are scanned separately
+struct PostgresLeafPartition {
+	string schema_name;
+	string table_name;
+	idx_t pages_approx = 0;
+	//! The node that stores the partition (an index into PostgresBindData::worker_nodes) - only used for the shards of
+	//! a distributed (Citus) table that are read from the worker nodes directly
+	idx_t worker_node = 0;
+};
+
 class PostgresUtils {
 public:
 	static PGconn *PGConnect(const string &dsn);
+	//! The DSN that connects to the given host and port - with the other parameters (user, database, ...) of dsn
+	//! Returns an empty string if dsn cannot be parsed
+	static string GetNodeDSN(const string &dsn, const string &host, int32_t port);
 
 	static LogicalType ToPostgresType(const LogicalType &input);
 	static LogicalType TypeToLogicalType(optional_ptr<PostgresTransaction> transaction,
@@ -56,6 +86,8 @@ public:
 	                                     PostgresType &postgres_type);
 	static string TypeToString(const LogicalType &input);
 	static string PostgresOidToName(uint32_t oid);
+	//! Returns the oid of a built-in Postgres type, or 0 if the type is not a known built-in type
+	static uint32_t PostgresNameToOid(const string &type_name);
 	static uint32_t ToPostgresOid(const LogicalType &input);
 	static bool SupportedPostgresOid(const LogicalType &input);
 	static LogicalType RemoveAlias(const LogicalType &type);
@@ -13,18 +13,32 @@
 #include "postgres_connection.hpp"
 #include "storage/postgres_schema_set.hpp"
 #include "storage/postgres_connection_pool.hpp"
+#include "storage/postgres_result_cache.hpp"
 
 namespace duckdb {
 class PostgresCatalog;
 class PostgresSchemaEntry;
 
+//! The result columns of a query of postgres_query
+struct PostgresQueryDescription {
+	vector<string> names;
+	vector<LogicalType> types;
+	vector<PostgresType> postgres_types;
+};
+
 class PostgresCatalog : public Catalog {
 public:
-	explicit PostgresCatalog(AttachedDatabase &db_p, const string &path, AccessMode access_mode);
+	//! The maximum amount of query descriptions that are cached - the cache is cleared when it is full
+	static constexpr const idx_t MAX_QUERY_DESCRIPTIONS = 1000;
+
+	explicit PostgresCatalog(AttachedDatabase &db_p, const string &path, AccessMode access_mode,
+	                         vector<string> replica_paths = vector<string>());
 	~PostgresCatalog();
 
 	string path;
 	AccessMode access_mode;
+	//! The DSNs of the read replicas that table scans are spread over (the REPLICAS option of ATTACH)
+	vector<string> replica_paths;
 
 public:
 	void Initialize(bool load_builtin) override;
@@ -70,7 +84,30 @@ public:
 		return connection_pool;
 	}
 
+	//! The connection pools of the read replicas - in the order of replica_paths
+	const vector<unique_ptr<PostgresConnectionPool>> &GetReplicaPools() {
+		return replica_pools;
+	}
+	//! Get a connection to a read replica that lags at most max_lag_ms behind the primary (0 to not check the lag)
+	//! The replicas are used in turn - returns false if none of them is available. Scans get their replica through
+	//! PostgresTransaction::TryGetReplicaConnection, so that all scans of a transaction use the same replica
+	bool TryGetReplicaConnection(idx_t max_lag_ms, PostgresPoolConnection &result,
+	                             optional_ptr<PostgresConnectionPool> &pool);
+	//! The connection pool of a worker node of a Citus cluster (pg_citus_shard_scan) - created on first use
+	PostgresConnectionPool &GetWorkerPool(const string &dsn);
+
+	PostgresResultCache &GetResultCache() {
+		return result_cache;
+	}
+
 	void ClearCache();
+	//! Clear the cached catalog entry (and cached scan results) of a single table
+	void ClearTableCache(ClientContext &context, const string &schema_name, const string &table_name);
+
+	//! Look up the cached result columns of a query of postgres_query - keyed by the SQL and the parameter types
+	bool TryGetQueryDescription(const string &key, PostgresQueryDescription &result);
+	void AddQueryDescription(const string &key, PostgresQueryDescription description);
+	void ClearQueryDescriptions();
 
 	//! Whether or not this catalog should search a specific type with the standard priority
 	CatalogLookupBehavior CatalogTypeLookupRule(CatalogType type) const override {
@@ -93,6 +130,13 @@ private:
 	PostgresVersion version;
 	PostgresSchemaSet schemas;
 	PostgresConnectionPool connection_pool;
+	vector<unique_ptr<PostgresConnectionPool>> replica_pools;
+	atomic<idx_t> next_replica;
+	mutex worker_pool_lock;
+	unordered_map<string, unique_ptr<PostgresConnectionPool>> worker_pools;
+	PostgresResultCache result_cache;
+	mutex query_description_lock;
+	unordered_map<string, PostgresQueryDescription> query_descriptions;
 };
 
 } // namespace duckdb
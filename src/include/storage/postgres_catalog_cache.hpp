@@ -0,0 +1,38 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_catalog_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "postgres_result.hpp"
+
+namespace duckdb {
+
+//! Persists the results of the queries that load the catalog of an attached database in a local file, so that the
+//! catalog does not have to be loaded from Postgres again after a restart
+//! The file is keyed on the connection string and the catalog queries. The cached results are only used if a
+//! fingerprint of the system catalogs (a hash of the xmin of every row of the relevant pg_catalog tables) still
+//! matches the fingerprint at the time the results were stored - any DDL changes the fingerprint
+//! The sizes and statistics of the tables (relpages, reltuples, pg_relation_size, pg_stats) change without changing
+//! the fingerprint - tables loaded from the cache reload them when they are first used (see RefreshStatistics)
+class PostgresCatalogCache {
+public:
+	//! Returns the path of the cache file - or an empty string if the catalog cache is disabled
+	static string GetCachePath(ClientContext &context, const string &dsn, const string &catalog_query);
+	//! The query that computes the fingerprint of the system catalogs
+	static string GetFingerprintQuery();
+
+	//! Read the cached results - returns an empty list if the file is missing, invalid or has a different fingerprint
+	static vector<unique_ptr<PostgresResult>> Read(FileSystem &fs, const string &path, const string &fingerprint);
+	//! Write the results to the cache file - failures to write the cache are ignored
+	static void Write(FileSystem &fs, const string &path, const string &fingerprint,
+	                  const vector<unique_ptr<PostgresResult>> &results);
+};
+
+} // namespace duckdb
@@ -27,10 +27,14 @@ public:
 	void Scan(ClientContext &context, const std::function<void(CatalogEntry &)> &callback);
 	virtual optional_ptr<CatalogEntry> CreateEntry(unique_ptr<CatalogEntry> entry);
 	void ClearEntries();
+	//! Remove a single entry - the entry is reloaded from Postgres the next time it is looked up
+	void ClearEntry(const string &name);
 	virtual bool SupportReload() const {
 		return false;
 	}
 	virtual optional_ptr<CatalogEntry> ReloadEntry(ClientContext &context, const string &name);
+	//! Load the entries (if they have not been loaded yet)
+	void TryLoadEntries(ClientContext &context);
 
 protected:
 	virtual void LoadEntries(ClientContext &context) = 0;
@@ -39,7 +43,9 @@ protected:
 	virtual bool HasInternalDependencies() const {
 		return false;
 	}
-	void TryLoadEntries(ClientContext &context);
+	//! Called before scanning all entries - catalog sets that load entries lazily load the remaining entries here
+	virtual void LoadAllEntries(ClientContext &context) {
+	}
 
 protected:
 	Catalog &catalog;
@@ -74,6 +80,8 @@ struct PostgresResultSlice {
 	shared_ptr<PostgresResult> result;
 	idx_t start;
 	idx_t end;
+	//! Whether or not the rows were read from the on-disk catalog cache - their sizes and statistics can be outdated
+	bool from_cache = false;
 };
 
 } // namespace duckdb
@@ -8,11 +8,15 @@
 
 #pragma once
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/common.hpp"
 #include "duckdb/common/mutex.hpp"
 #include "duckdb/common/optional_ptr.hpp"
 #include "postgres_connection.hpp"
 
+#include <condition_variable>
+#include <thread>
+
 namespace duckdb {
 class PostgresCatalog;
 class PostgresConnectionPool;
@@ -37,31 +41,121 @@ private:
 	PostgresConnection connection;
 };
 
+struct PostgresCachedConnection {
+	PostgresConnection connection;
+	//! The time at which the connection was returned to the pool
+	timestamp_t idle_since;
+};
+
+//! A snapshot of the state and the counters of a connection pool (shown by postgres_connection_pool_info())
+struct PostgresConnectionPoolInfo {
+	idx_t active_connections = 0;
+	idx_t idle_connections = 0;
+	idx_t maximum_connections = 0;
+	//! The amount of connections opened, the amount of times a cached connection was handed out and the amount of
+	//! times a broken connection was reset
+	idx_t total_opens = 0;
+	idx_t total_reuses = 0;
+	idx_t total_resets = 0;
+	//! The amount of times a connection could not be obtained because all connection slots were in use - i.e. a scan
+	//! or insert ran with fewer threads than planned
+	idx_t exhausted_count = 0;
+};
+
+//! A scan that shares the connection slots of the pool with the other concurrently running scans
+//! (pg_scan_connection_sharing) - freed slots go to the scan that is furthest behind
+struct PostgresScanConnectionShare {
+	//! The (approximate) amount of tasks of the scan that have not been handed out yet
+	atomic<idx_t> remaining_tasks {0};
+	//! The amount of connections held by the threads of the scan (protected by the lock of the pool)
+	idx_t active_connections = 0;
+	//! The amount of threads of the scan that are waiting for a connection (protected by the lock of the pool)
+	idx_t waiting_threads = 0;
+};
+
 class PostgresConnectionPool {
 public:
 	static constexpr const idx_t DEFAULT_MAX_CONNECTIONS = 64;
+	//! How long a thread of a scan that shares the connection slots waits for a slot to be handed over
+	static constexpr const idx_t DEFAULT_SCAN_CONNECTION_WAIT_MS = 1000;
 
-	PostgresConnectionPool(PostgresCatalog &postgres_catalog, idx_t maximum_connections = DEFAULT_MAX_CONNECTIONS);
+	//! The pool opens connections to the DSN of the catalog - unless a different DSN (e.g. of a replica) is given
+	PostgresConnectionPool(PostgresCatalog &postgres_catalog, idx_t maximum_connections = DEFAULT_MAX_CONNECTIONS,
+	                       string dsn = string());
+	~PostgresConnectionPool();
 
 public:
-	bool TryGetConnection(PostgresPoolConnection &connection);
+	//! Get a connection if a connection slot is free - or becomes free within wait_ms
+	bool TryGetConnection(PostgresPoolConnection &connection, idx_t wait_ms = 0);
 	PostgresPoolConnection GetConnection();
 	//! Always returns a connection - even if the connection slots are exhausted
 	PostgresPoolConnection ForceGetConnection();
 	void ReturnConnection(PostgresConnection connection);
 	void SetMaximumConnections(idx_t new_max);
+	//! Keep (at least) the given amount of idle connections open - connections are opened in the background
+	void SetMinimumIdleConnections(idx_t new_min);
+	//! Close cached connections that have been idle for longer than the given amount of seconds (0 to disable)
+	void SetIdleTimeout(idx_t seconds);
+	//! Close connections that have been open for longer than the given amount of seconds (0 to disable)
+	void SetMaximumLifetime(idx_t seconds);
+	PostgresConnectionPoolInfo GetInfo();
+
+	//! Register a scan that shares the connection slots with the other registered scans
+	void RegisterScan(const shared_ptr<PostgresScanConnectionShare> &scan);
+	//! Get a connection for a thread of a registered scan - if all slots are in use this waits (up to wait_ms) for a
+	//! slot to be freed. A freed slot goes to the waiting scan with the most remaining tasks per connection.
+	bool TryGetScanConnection(PostgresScanConnectionShare &scan, PostgresPoolConnection &result, idx_t wait_ms);
+	//! Called after a thread of a registered scan has returned its connection
+	void ReleaseScanConnection(PostgresScanConnectionShare &scan);
+	//! Whether or not a thread of the scan should give up its connection to a waiting scan that is further behind
+	bool ShouldYieldConnection(PostgresScanConnectionShare &scan);
 
 	static void PostgresSetConnectionCache(ClientContext &context, SetScope scope, Value &parameter);
 
 private:
 	PostgresCatalog &postgres_catalog;
+	string dsn;
 	mutex connection_lock;
 	idx_t active_connections;
 	idx_t maximum_connections;
-	vector<PostgresConnection> connection_cache;
+	vector<PostgresCachedConnection> connection_cache;
+	//! The minimum amount of idle connections kept open by the background thread
+	idx_t minimum_idle_connections;
+	//! The amount of connections currently being opened by the background thread
+	idx_t opening_connections;
+	//! The idle timeout and maximum lifetime of connections in seconds (0 if disabled)
+	idx_t idle_timeout;
+	idx_t maximum_lifetime;
+	//! Returned connections that need to be reset before they can be used again
+	vector<PostgresConnection> reset_queue;
+	//! The background thread that opens and resets connections outside of the query path
+	std::thread background_thread;
+	std::condition_variable background_signal;
+	bool shutdown;
+	//! Counters of the pool (see PostgresConnectionPoolInfo)
+	idx_t total_opens;
+	idx_t total_reuses;
+	idx_t total_resets;
+	idx_t exhausted_count;
+	//! The scans that share the connection slots, and the signal used to wake up their waiting threads
+	vector<weak_ptr<PostgresScanConnectionShare>> scans;
+	std::condition_variable scan_signal;
 
 private:
-	PostgresPoolConnection GetConnectionInternal();
+	void ReturnConnectionInternal(PostgresConnection connection);
+	//! The waiting scan that should receive the next free slot (requires the lock to be held)
+	optional_ptr<PostgresScanConnectionShare> GetNeediestScan(optional_ptr<PostgresScanConnectionShare> exclude);
+	//! Reserve a connection slot - returns a cached connection if there is one (requires the lock to be held)
+	bool ReserveConnection(PostgresConnection &result);
+	const string &GetDSN() const;
+	//! Open a new connection for a reserved slot - does not require the lock to be held
+	PostgresPoolConnection OpenConnection();
+	bool ExceedsLifetime(PostgresConnection &connection, timestamp_t now) const;
+	//! Remove cached connections that exceed the idle timeout or the maximum lifetime (requires the lock to be held)
+	void EvictConnections(vector<PostgresConnection> &evicted);
+	bool BackgroundThreadActive() const;
+	void StartBackgroundThread();
+	void BackgroundThreadMain();
 };
 
 } // namespace duckdb
@@ -28,6 +28,20 @@ public:
 	unique_ptr<BoundCreateTableInfo> info;
 	//! column_index_map
 	physical_index_vector_t<idx_t> column_index_map;
+	//! Whether or not every thread inserts using its own connection (outside of the transaction) - only if the
+	//! insertion order does not need to be preserved, or for a bulk load
+	bool parallel_insert = false;
+	//! Whether or not the insertion order needs to be preserved
+	bool preserve_insertion_order = true;
+	//! Whether or not the threads encode their chunks in parallel before sending them over the transaction connection
+	//! (pg_parallel_encoding) - only if the insertion order does not need to be preserved
+	bool parallel_encoding = false;
+	//! CREATE TABLE AS only - load the data into an UNLOGGED staging table in parallel, which is swapped in for the
+	//! target table when the load has finished
+	bool bulk_load = false;
+	//! INSERT ... ON CONFLICT only - the rows are copied into a temporary table, which is merged into the table with
+	//! a single INSERT ... SELECT with this ON CONFLICT clause
+	string on_conflict_clause;
 
 public:
 	// Source interface
@@ -40,7 +54,9 @@ public:
 public:
 	// Sink interface
 	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
 	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
+	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
 	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
 	                          OperatorSinkFinalizeInput &input) const override;
 
@@ -49,7 +65,9 @@ public:
 	}
 
 	bool ParallelSink() const override {
-		return false;
+		// the threads insert over their own connections if the insertion order does not need to be preserved (or
+		// for a bulk load into a new table)
+		return parallel_insert || (parallel_encoding && !preserve_insertion_order);
 	}
 
 	string GetName() const override;
@@ -14,6 +14,11 @@ namespace duckdb {
 
 class PostgresOptimizer {
 public:
+	//! Aggregates over smaller tables are computed in DuckDB
+	static constexpr const idx_t DEFAULT_AGGREGATE_PUSHDOWN_ROWS = 10000;
+	//! Beyond this many rows that pass the filter, the wide columns are fetched for a range of ctids
+	static constexpr const idx_t DEFAULT_LATE_MATERIALIZATION_ROWS = 100000;
+
 	static void Optimize(ClientContext &context, OptimizerExtensionInfo *info, unique_ptr<LogicalOperator> &plan);
 };
 
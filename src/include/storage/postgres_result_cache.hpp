@@ -0,0 +1,65 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_result_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/common/types/timestamp.hpp"
+#include "postgres_connection.hpp"
+
+#include <list>
+
+namespace duckdb {
+
+//! Caches the materialized results of scans over tables of an attached Postgres database
+//! Results are keyed on the table, the projected columns and the pushed-down filters. An entry is invalidated when it
+//! is older than the configured TTL, when the table is modified through the attached database, or when the freshness
+//! probe of the table no longer matches the probe at the time the result was cached. The probe is best-effort - so a
+//! result can be stale for up to the TTL after a modification by another connection
+class PostgresResultCache {
+public:
+	//! Look up a cached result - returns nullptr if there is no valid result for the key
+	shared_ptr<ColumnDataCollection> Lookup(const string &key, const string &freshness, idx_t ttl_seconds);
+	//! Cache a result - evicts the least recently used results so that the cache stays within "capacity" bytes
+	void Insert(const string &key, string table_key, string freshness, shared_ptr<ColumnDataCollection> result,
+	            idx_t capacity);
+	//! Invalidate all results of the given table
+	void Invalidate(const string &table_key);
+	//! Invalidate all results
+	void Clear();
+
+	static string GetTableKey(const string &schema_name, const string &table_name);
+	//! Obtain a token that changes when the contents of the table change - or an empty string if the table cannot
+	//! be probed (e.g. for views, foreign tables and partitioned tables). The token is based on the table statistics,
+	//! which Postgres updates asynchronously - so a modification is not necessarily reflected immediately
+	static string GetFreshness(PostgresConnection &connection, const string &schema_name, const string &table_name,
+	                           char relation_kind);
+
+private:
+	struct CacheEntry {
+		string table_key;
+		string freshness;
+		timestamp_t created;
+		shared_ptr<ColumnDataCollection> result;
+		idx_t size;
+		//! The position of the key in the LRU list
+		std::list<string>::iterator lru_position;
+	};
+
+	void EraseEntry(unordered_map<string, CacheEntry>::iterator entry);
+
+	mutex lock;
+	unordered_map<string, CacheEntry> entries;
+	//! The keys of the cached results - the most recently used result is at the front
+	std::list<string> lru;
+	idx_t total_size = 0;
+};
+
+} // namespace duckdb
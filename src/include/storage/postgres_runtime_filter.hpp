@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// storage/postgres_runtime_filter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/types/vector.hpp"
+#include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/planner/operator/logical_extension_operator.hpp"
+
+namespace duckdb {
+
+//! The join keys of the build side of a hash join with a Postgres scan as probe side
+//! The keys are collected while the build side is executed - once the build side has finished the keys are added to
+//! the query that the scan sends to Postgres, either as a set of distinct keys or as a range of keys
+class PostgresRuntimeFilter {
+public:
+	//! Beyond this many distinct keys the filter falls back to a BETWEEN range
+	static constexpr const idx_t DEFAULT_MAX_KEYS = 1000;
+	//! Build sides that are estimated to be larger than this are not collected
+	static constexpr const idx_t MAX_BUILD_ROWS = 1000000;
+
+	PostgresRuntimeFilter(string column_name, idx_t max_keys);
+
+	//! Creates a filter on the ctid of the rows - the keys are the row ids as emitted by the scan
+	static shared_ptr<PostgresRuntimeFilter> CreateCTIDFilter(idx_t max_keys);
+
+	//! Clear the collected keys - called when the build side (re-)starts executing
+	void Reset();
+	//! Add the (integer) keys of a chunk of the build side
+	void AddKeys(Vector &keys, idx_t count);
+	//! Mark the keys as complete - the filter is only applied afterwards
+	void Finish();
+	//! Returns the predicate to add to the query sent to Postgres - or an empty string if the keys are not complete
+	string GetPredicate() const;
+
+private:
+	template <class T>
+	void AddKeysInternal(Vector &keys, idx_t count);
+	string FormatKey(int64_t key) const;
+
+	mutable mutex lock;
+	//! The (quoted) name of the column of the Postgres scan
+	string column_name;
+	idx_t max_keys;
+	//! Whether or not the keys are row ids that have to be rendered as ctids
+	bool ctid = false;
+	bool finished = false;
+	bool has_keys = false;
+	int64_t min_key = 0;
+	int64_t max_key = 0;
+	//! The distinct keys - cleared once there are more than max_keys distinct keys
+	unordered_set<int64_t> distinct_keys;
+	bool too_many_keys = false;
+};
+
+//! Collects the join keys of the build side of a join into a PostgresRuntimeFilter
+class LogicalPostgresRuntimeFilter : public LogicalExtensionOperator {
+public:
+	LogicalPostgresRuntimeFilter(shared_ptr<PostgresRuntimeFilter> filter, idx_t key_index,
+	                             unique_ptr<LogicalOperator> child);
+
+	shared_ptr<PostgresRuntimeFilter> filter;
+	//! The column of the child that holds the join keys
+	idx_t key_index;
+
+public:
+	unique_ptr<PhysicalOperator> CreatePlan(ClientContext &context, PhysicalPlanGenerator &generator) override;
+	vector<ColumnBinding> GetColumnBindings() override;
+	string GetName() const override;
+	string GetExtensionName() const override;
+
+protected:
+	void ResolveTypes() override;
+};
+
+//! Materializes the build side of a join while collecting its join keys, and passes on the rows afterwards
+class PhysicalPostgresRuntimeFilter : public PhysicalOperator {
+public:
+	PhysicalPostgresRuntimeFilter(vector<LogicalType> types, shared_ptr<PostgresRuntimeFilter> filter,
+	                              idx_t key_index, idx_t estimated_cardinality);
+
+	shared_ptr<PostgresRuntimeFilter> filter;
+	idx_t key_index;
+
+public:
+	// Source interface
+	unique_ptr<GlobalSourceState> GetGlobalSourceState(ClientContext &context) const override;
+	SourceResultType GetData(ExecutionContext &context, DataChunk &chunk, OperatorSourceInput &input) const override;
+
+	bool IsSource() const override {
+		return true;
+	}
+
+public:
+	// Sink interface
+	unique_ptr<GlobalSinkState> GetGlobalSinkState(ClientContext &context) const override;
+	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) const override;
+	SinkResultType Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const override;
+	SinkCombineResultType Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const override;
+	SinkFinalizeType Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+	                          OperatorSinkFinalizeInput &input) const override;
+
+	bool IsSink() const override {
+		return true;
+	}
+
+	bool ParallelSink() const override {
+		return true;
+	}
+
+	string GetName() const override;
+	string ParamsToString() const override;
+};
+
+} // namespace duckdb
@@ -21,7 +21,7 @@ public:
 	PostgresSchemaEntry(Catalog &catalog, CreateSchemaInfo &info);
 	PostgresSchemaEntry(Catalog &catalog, CreateSchemaInfo &info, unique_ptr<PostgresResultSlice> tables,
 	                    unique_ptr<PostgresResultSlice> enums, unique_ptr<PostgresResultSlice> composite_types,
-	                    unique_ptr<PostgresResultSlice> indexes);
+	                    unique_ptr<PostgresResultSlice> indexes, bool lazy_tables = false);
 
 public:
 	optional_ptr<CatalogEntry> CreateTable(CatalogTransaction transaction, BoundCreateTableInfo &info) override;
@@ -45,6 +45,10 @@ public:
 	optional_ptr<CatalogEntry> GetEntry(CatalogTransaction transaction, CatalogType type, const string &name) override;
 
 	static bool SchemaIsInternal(const string &name);
+	//! Drop the cached entry of a table, so that it is reloaded the next time it is used
+	void InvalidateTable(const string &table_name);
+	//! Build the entries of the tables of the schema (if they have not been built yet)
+	void LoadTables(ClientContext &context);
 
 private:
 	void AlterTable(PostgresTransaction &transaction, RenameTableInfo &info);
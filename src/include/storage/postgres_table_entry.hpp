@@ -35,7 +35,18 @@ struct PostgresTableInfo {
 	unique_ptr<CreateTableInfo> create_info;
 	vector<PostgresType> postgres_types;
 	vector<string> postgres_names;
+	vector<PostgresColumnStatistics> column_statistics;
 	idx_t approx_num_pages = 0;
+	//! The pages the relation consumed on disk when it was loaded - unlike approx_num_pages (relpages) this does not
+	//! depend on the table having been vacuumed or analyzed recently
+	idx_t relation_pages = 0;
+	//! The approximate number of rows (reltuples) - negative if the table has not been analyzed
+	double approx_num_rows = -1;
+	//! The relkind of the relation in pg_class ('r' = table, 'v' = view, 'p' = partitioned table, ...)
+	char relation_kind = 'r';
+	//! Whether or not the sizes and statistics have to be reloaded on first use (if the table was loaded from the
+	//! catalog cache)
+	bool refresh_statistics = false;
 };
 
 class PostgresTableEntry : public TableCatalogEntry {
@@ -55,6 +66,13 @@ public:
 
 	//! Get the copy format (text or binary) that should be used when writing data to this table
 	PostgresCopyFormat GetCopyFormat(ClientContext &context);
+	//! Get the copy format that should be used when writing data for only the given subset of columns
+	PostgresCopyFormat GetCopyFormat(ClientContext &context, const vector<PhysicalIndex> &column_indexes);
+	//! Invalidate the cached scan results of this table - called after the table has been modified
+	void InvalidateCachedResults();
+	//! Reload the sizes and statistics of the table if it was loaded from the catalog cache - VACUUM, ANALYZE and
+	//! loading data change them without changing the fingerprint of the cache
+	void RefreshStatistics(ClientContext &context);
 
 public:
 	//! Postgres type annotations
@@ -63,8 +81,20 @@ public:
 	//! We track these separately because of case sensitivity - Postgres allows e.g. the columns "ID" and "id" together
 	//! We would in this case remap them to "ID" and "id:1", while postgres_names store the original names
 	vector<string> postgres_names;
+	//! The statistics Postgres gathered about the columns (empty if unknown)
+	vector<PostgresColumnStatistics> column_statistics;
 	//! The approximate number of pages a table consumes in Postgres
 	idx_t approx_num_pages;
+	//! The pages the table consumes on disk - the size the ctid ranges of a scan are based on
+	idx_t relation_pages;
+	//! The approximate number of rows of the table when it was last analyzed - negative if unknown
+	double approx_num_rows;
+	//! The relkind of the relation in pg_class
+	char relation_kind;
+
+private:
+	atomic<bool> refresh_statistics;
+	mutex refresh_lock;
 };
 
 } // namespace duckdb
@@ -19,23 +19,44 @@ class PostgresSchemaEntry;
 
 class PostgresTableSet : public PostgresInSchemaSet {
 public:
-	explicit PostgresTableSet(PostgresSchemaEntry &schema, unique_ptr<PostgresResultSlice> tables = nullptr);
+	//! If lazy is set, "tables" holds the names of the tables only, and the columns of a table are loaded on first use
+	explicit PostgresTableSet(PostgresSchemaEntry &schema, unique_ptr<PostgresResultSlice> tables = nullptr,
+	                          bool lazy = false);
 
 public:
 	optional_ptr<CatalogEntry> CreateTable(ClientContext &context, BoundCreateTableInfo &info);
+	//! Get the CREATE TABLE statement for the given table - converts the column types to the Postgres types
+	static string GetCreateTableSQL(CreateTableInfo &info, bool unlogged = false);
 
 	static unique_ptr<PostgresTableInfo> GetTableInfo(PostgresTransaction &transaction, PostgresSchemaEntry &schema,
 	                                                  const string &table_name);
 	static unique_ptr<PostgresTableInfo> GetTableInfo(PostgresConnection &connection, const string &schema_name,
 	                                                  const string &table_name);
+	//! Get the leaf partitions of a partitioned table, sorted by size (largest first)
+	static vector<PostgresLeafPartition> GetLeafPartitions(PostgresConnection &connection, const string &schema_name,
+	                                                       const string &table_name);
+	//! Get the shards of a distributed (Citus) table - with the nodes that store them, sorted by node and by size
+	//! (largest first). worker_nodes receives the DSNs of the nodes, derived from the DSN of the coordinator. Returns
+	//! nothing if the table is not distributed, or if not every shard can be located
+	static vector<PostgresLeafPartition> GetDistributedShards(PostgresConnection &connection, const string &schema_name,
+	                                                          const string &table_name, const string &dsn,
+	                                                          vector<string> &worker_nodes);
 	optional_ptr<CatalogEntry> ReloadEntry(ClientContext &context, const string &table_name) override;
 
 	void AlterTable(ClientContext &context, AlterTableInfo &info);
 
+	//! The query to load a single table - with the schema name and the table name as parameters
+	static string GetTableInfoQuery();
 	static string GetInitializeQuery(const string &schema = string(), const string &table = string());
+	//! Load the tables of the schemas with (oid % partition_count = partition) - so that the initialize query can be
+	//! split over several connections
+	static string GetPartitionQuery(idx_t partition, idx_t partition_count);
+	//! Query the names of the tables only - used when the catalog is loaded lazily
+	static string GetTableNamesQuery(const string &schema = string());
 
 protected:
 	void LoadEntries(ClientContext &context) override;
+	void LoadAllEntries(ClientContext &context) override;
 	bool SupportReload() const override {
 		return true;
 	}
@@ -48,11 +69,17 @@ protected:
 	static void AddColumn(optional_ptr<PostgresTransaction> transaction, optional_ptr<PostgresSchemaEntry> schema,
 	                      PostgresResult &result, idx_t row, PostgresTableInfo &table_info);
 	static void AddConstraint(PostgresResult &result, idx_t row, PostgresTableInfo &table_info);
+	static char GetRelationKind(PostgresResult &result, idx_t row);
+	//! The pages the relation consumes on disk (pg_relation_size / block_size) - relpages if the size is not known
+	static idx_t GetRelationPages(PostgresResult &result, idx_t row, idx_t approx_num_pages);
+	static double GetApproxNumRows(PostgresResult &result, idx_t row);
 	static void AddColumnOrConstraint(optional_ptr<PostgresTransaction> transaction,
 	                                  optional_ptr<PostgresSchemaEntry> schema, PostgresResult &result, idx_t row,
 	                                  PostgresTableInfo &table_info);
 
-	void CreateEntries(PostgresTransaction &transaction, PostgresResult &result, idx_t start, idx_t end);
+	//! If from_cache is set the sizes and statistics of the tables are refreshed when the tables are first used
+	void CreateEntries(PostgresTransaction &transaction, PostgresResult &result, idx_t start, idx_t end,
+	                   bool from_cache = false);
 
 private:
 	string GetAlterTablePrefix(ClientContext &context, const string &name);
@@ -61,6 +88,14 @@ private:
 
 protected:
 	unique_ptr<PostgresResultSlice> table_result;
+	//! Whether or not the columns of the tables are loaded on first use of a table
+	bool lazy;
+	mutex lazy_lock;
+	//! The names of the tables in the schema (if loaded lazily) - used for case insensitive lookups
+	unordered_set<string> table_names;
+	case_insensitive_map_t<string> table_name_map;
+	//! Whether or not all tables have been loaded (if loaded lazily)
+	bool all_loaded = false;
 };
 
 } // namespace duckdb
@@ -31,17 +31,52 @@ public:
 	PostgresConnection &GetConnection();
 	string GetDSN();
 	unique_ptr<PostgresResult> Query(const string &query);
+	unique_ptr<PostgresResult> QueryWithParameters(const string &query, const vector<Value> &parameters);
 	vector<unique_ptr<PostgresResult>> ExecuteQueries(const string &queries);
+	//! Create a temporary table with the columns of the given query, that is dropped when the transaction ends, and
+	//! return its (unique) name - used to stream the data of an UPDATE, DELETE or upsert into through COPY
+	string CreateTemporaryTable(const string &prefix, const string &query);
 	static PostgresTransaction &Get(ClientContext &context, Catalog &catalog);
 
+	//! The snapshot of this transaction that the threads of parallel scans attach to - exported once per transaction
+	//! Returns an empty string if the snapshot cannot be exported (e.g. because the server is in recovery)
+	string GetScanSnapshot(PostgresVersion version);
+	//! Get a connection of an earlier scan of this transaction that is already attached to the scan snapshot
+	bool TryGetScanConnection(PostgresPoolConnection &result);
+	//! Keep the connection of a thread of a scan for the later scans of this transaction - the connection has to be
+	//! attached to the scan snapshot. Connections that are still running a query are returned to the pool instead
+	void ReturnScanConnection(PostgresPoolConnection connection);
+	//! Get a connection to the read replica the scans of this transaction run on - the replica is chosen by the first
+	//! scan, so that all scans of the transaction see the same replica. Returns false if the scans run on the primary,
+	//! or if the connection slots of the replica stay exhausted (see pg_connection_limit)
+	bool TryGetReplicaConnection(idx_t max_lag_ms, PostgresPoolConnection &result,
+	                             optional_ptr<PostgresConnectionPool> &pool);
+	//! Drop the given (already committed) table if the transaction is rolled back - e.g. the staging table of a bulk
+	//! load, which is renamed to the target table within the transaction
+	void DropTableOnRollback(string qualified_name);
+
 private:
+	PostgresCatalog &postgres_catalog;
 	PostgresPoolConnection connection;
 	PostgresTransactionState transaction_state;
 	AccessMode access_mode;
+	//! The exported scan snapshot (if any) and the idle connections that are attached to it
+	mutex scan_lock;
+	bool scan_snapshot_exported = false;
+	string scan_snapshot;
+	vector<PostgresPoolConnection> scan_connections;
+	//! The read replica the scans of this transaction run on (if any) - chosen by the first scan
+	mutex replica_lock;
+	bool replica_chosen = false;
+	optional_ptr<PostgresConnectionPool> replica_pool;
+	//! The tables that are dropped if the transaction is rolled back
+	vector<string> rollback_drops;
 
 private:
 	//! Retrieves the connection **without** starting a transaction if none is active
 	PostgresConnection &GetConnectionRaw();
+	//! End the transactions of the scan connections and return them to the pool
+	void ReleaseScanConnections();
 };
 
 } // namespace duckdb
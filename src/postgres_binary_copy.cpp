@@ -5,7 +5,11 @@
 
 namespace duckdb {
 
+//! The amount of encoded data a thread buffers before it is written to the file
+static constexpr const idx_t LOCAL_BUFFER_SIZE = 1 << 20;
+
 PostgresBinaryCopyFunction::PostgresBinaryCopyFunction() : CopyFunction("postgres_binary") {
+	extension = "bin";
 
 	copy_to_bind = PostgresBinaryWriteBind;
 	copy_to_initialize_global = PostgresBinaryWriteInitializeGlobal;
@@ -13,32 +17,31 @@ PostgresBinaryCopyFunction::PostgresBinaryCopyFunction() : CopyFunction("postgre
 	copy_to_sink = PostgresBinaryWriteSink;
 	copy_to_combine = PostgresBinaryWriteCombine;
 	copy_to_finalize = PostgresBinaryWriteFinalize;
+	execution_mode = PostgresBinaryWriteExecutionMode;
+	file_size_bytes = PostgresBinaryWriteFileSize;
+
+	copy_from_bind = PostgresBinaryReadFunction::CopyFromBind;
+	copy_from_function = PostgresBinaryReadFunction();
 }
 
 struct PostgresBinaryCopyGlobalState : public GlobalFunctionData {
+	mutex lock;
 	unique_ptr<BufferedFileWriter> file_writer;
 
+	//! Write the rows encoded by a thread to the file
 	void Flush(PostgresBinaryWriter &writer) {
+		lock_guard<mutex> guard(lock);
 		file_writer->WriteData(writer.stream.GetData(), writer.stream.GetPosition());
 	}
 
-	void WriteHeader() {
-		PostgresBinaryWriter writer;
-		writer.WriteHeader();
-		Flush(writer);
+	idx_t FileSize() {
+		lock_guard<mutex> guard(lock);
+		return file_writer->GetTotalWritten();
 	}
 
-	void WriteChunk(DataChunk &chunk) {
-		chunk.Flatten();
+	void WriteHeader() {
 		PostgresBinaryWriter writer;
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			writer.BeginRow(chunk.ColumnCount());
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				auto &col = chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
-		}
+		writer.WriteHeader();
 		Flush(writer);
 	}
 
@@ -53,6 +56,20 @@ struct PostgresBinaryCopyGlobalState : public GlobalFunctionData {
 	}
 };
 
+//! The rows are encoded by every thread into its own buffer - the buffer only holds whole rows, so it can be written
+//! to any of the files when the output is split up into multiple files
+struct PostgresBinaryCopyLocalState : public LocalFunctionData {
+	PostgresBinaryWriter writer;
+
+	void Flush(PostgresBinaryCopyGlobalState &gstate) {
+		if (writer.stream.GetPosition() == 0) {
+			return;
+		}
+		gstate.Flush(writer);
+		writer.stream.Rewind();
+	}
+};
+
 struct PostgresBinaryWriteBindData : public TableFunctionData {};
 
 unique_ptr<FunctionData> PostgresBinaryCopyFunction::PostgresBinaryWriteBind(ClientContext &context,
@@ -75,18 +92,36 @@ PostgresBinaryCopyFunction::PostgresBinaryWriteInitializeGlobal(ClientContext &c
 
 unique_ptr<LocalFunctionData>
 PostgresBinaryCopyFunction::PostgresBinaryWriteInitializeLocal(ExecutionContext &context, FunctionData &bind_data_p) {
-	return make_uniq<LocalFunctionData>();
+	return make_uniq<PostgresBinaryCopyLocalState>();
 }
 
 void PostgresBinaryCopyFunction::PostgresBinaryWriteSink(ExecutionContext &context, FunctionData &bind_data_p,
-                                                         GlobalFunctionData &gstate_p, LocalFunctionData &lstate,
+                                                         GlobalFunctionData &gstate_p, LocalFunctionData &lstate_p,
                                                          DataChunk &input) {
 	auto &gstate = gstate_p.Cast<PostgresBinaryCopyGlobalState>();
-	gstate.WriteChunk(input);
+	auto &lstate = lstate_p.Cast<PostgresBinaryCopyLocalState>();
+	// encode the chunk outside of the lock - so that threads only serialize on writing the encoded data
+	lstate.writer.WriteChunk(input);
+	if (lstate.writer.stream.GetPosition() >= LOCAL_BUFFER_SIZE) {
+		lstate.Flush(gstate);
+	}
 }
 
 void PostgresBinaryCopyFunction::PostgresBinaryWriteCombine(ExecutionContext &context, FunctionData &bind_data,
                                                             GlobalFunctionData &gstate, LocalFunctionData &lstate) {
+	// write the rows that are still buffered by this thread
+	lstate.Cast<PostgresBinaryCopyLocalState>().Flush(gstate.Cast<PostgresBinaryCopyGlobalState>());
+}
+
+CopyFunctionExecutionMode PostgresBinaryCopyFunction::PostgresBinaryWriteExecutionMode(bool preserve_insertion_order,
+                                                                                       bool supports_batch_index) {
+	// the buffers of the threads are written in arbitrary order
+	return preserve_insertion_order ? CopyFunctionExecutionMode::REGULAR_COPY_TO_FILE
+	                                : CopyFunctionExecutionMode::PARALLEL_COPY_TO_FILE;
+}
+
+idx_t PostgresBinaryCopyFunction::PostgresBinaryWriteFileSize(GlobalFunctionData &gstate) {
+	return gstate.Cast<PostgresBinaryCopyGlobalState>().FileSize();
 }
 
 void PostgresBinaryCopyFunction::PostgresBinaryWriteFinalize(ClientContext &context, FunctionData &bind_data,
@@ -0,0 +1,329 @@
+#include "postgres_binary_copy.hpp"
+#include "postgres_binary_decoder.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/parser/parsed_data/copy_info.hpp"
+
+namespace duckdb {
+
+//! Bit 16 of the flags of the header signals that the rows include an OID field
+static constexpr const uint32_t COPY_FLAG_HAS_OIDS = 1 << 16;
+//! The size of the reads of the index pass
+static constexpr const idx_t INDEX_BUFFER_SIZE = 1 << 20;
+
+struct PostgresBinaryReadBindData : public TableFunctionData {
+	//! The files to read - the path can be a glob pattern, e.g. for the files written with PER_THREAD_OUTPUT
+	vector<string> files;
+	vector<string> names;
+	vector<LogicalType> types;
+	vector<PostgresType> postgres_types;
+};
+
+//! A batch of (at most STANDARD_VECTOR_SIZE) consecutive rows of one of the files
+struct PostgresBinaryFileBatch {
+	idx_t file_idx;
+	idx_t offset;
+	idx_t size;
+	idx_t row_count;
+	//! The index of the first row of the batch over all files
+	idx_t row_offset;
+};
+
+struct PostgresBinaryReadGlobalState : public GlobalTableFunctionState {
+	mutex lock;
+	vector<PostgresBinaryFileBatch> batches;
+	idx_t next_batch = 0;
+	idx_t max_threads = 1;
+
+	idx_t MaxThreads() const override {
+		return max_threads;
+	}
+};
+
+struct PostgresBinaryReadLocalState : public LocalTableFunctionState {
+	unique_ptr<FileHandle> handle;
+	idx_t file_idx = DConstants::INVALID_INDEX;
+	vector<column_t> column_ids;
+	vector<PostgresColumnDecoder> decoders;
+	vector<PostgresColumnFields> fields;
+	unsafe_unique_array<data_t> buffer;
+	idx_t buffer_capacity = 0;
+	idx_t batch_idx = 0;
+};
+
+//! Reads the integers of the row and field headers of the file sequentially - without reading the values
+struct PostgresBinaryFileIndexer {
+	PostgresBinaryFileIndexer(FileHandle &handle_p, idx_t file_size_p)
+	    : handle(handle_p), file_size(file_size_p), buffer(make_unsafe_uniq_array<data_t>(INDEX_BUFFER_SIZE)) {
+	}
+
+	FileHandle &handle;
+	idx_t file_size;
+	unsafe_unique_array<data_t> buffer;
+	idx_t buffer_start = 0;
+	idx_t buffer_size = 0;
+	idx_t position = 0;
+
+	bool Finished() const {
+		return position >= file_size;
+	}
+
+	template <class T>
+	T ReadInteger() {
+		if (position < buffer_start || position + sizeof(T) > buffer_start + buffer_size) {
+			auto read_size = MinValue<idx_t>(INDEX_BUFFER_SIZE, file_size - MinValue<idx_t>(position, file_size));
+			if (read_size < sizeof(T)) {
+				throw InvalidInputException("read_postgres_binary: file \"%s\" is truncated", handle.path);
+			}
+			handle.Read(buffer.get(), read_size, position);
+			buffer_start = position;
+			buffer_size = read_size;
+		}
+		auto result = PostgresBinaryReader::LoadInteger<T>(buffer.get() + (position - buffer_start));
+		position += sizeof(T);
+		return result;
+	}
+
+	void Skip(idx_t bytes) {
+		position += bytes;
+		if (position > file_size) {
+			throw InvalidInputException("read_postgres_binary: file \"%s\" is truncated", handle.path);
+		}
+	}
+};
+
+static void ReadHeader(PostgresBinaryFileIndexer &indexer) {
+	char signature[PostgresConversion::COPY_HEADER_LENGTH];
+	if (indexer.file_size < PostgresConversion::COPY_HEADER_LENGTH + 2 * sizeof(uint32_t)) {
+		throw InvalidInputException("read_postgres_binary: file \"%s\" is not a Postgres binary COPY file",
+		                            indexer.handle.path);
+	}
+	indexer.handle.Read(signature, PostgresConversion::COPY_HEADER_LENGTH, 0);
+	if (memcmp(signature, PostgresConversion::COPY_HEADER, PostgresConversion::COPY_HEADER_LENGTH) != 0) {
+		throw InvalidInputException("read_postgres_binary: file \"%s\" is not a Postgres binary COPY file",
+		                            indexer.handle.path);
+	}
+	indexer.Skip(PostgresConversion::COPY_HEADER_LENGTH);
+	auto flags = indexer.ReadInteger<uint32_t>();
+	if (flags & COPY_FLAG_HAS_OIDS) {
+		throw NotImplementedException("read_postgres_binary: files that include OIDs are not supported");
+	}
+	auto extension_length = indexer.ReadInteger<uint32_t>();
+	indexer.Skip(extension_length);
+}
+
+//! Walk over the rows of the file and record where every batch of rows starts - so that the batches can be read and
+//! decoded by different threads
+static void IndexFile(FileHandle &handle, idx_t file_idx, idx_t column_count, idx_t &row_offset,
+                      vector<PostgresBinaryFileBatch> &batches) {
+	PostgresBinaryFileIndexer indexer(handle, handle.GetFileSize());
+	ReadHeader(indexer);
+	auto first_batch = batches.size();
+	while (!indexer.Finished()) {
+		auto row_start = indexer.position;
+		auto field_count = indexer.ReadInteger<int16_t>();
+		if (field_count == -1) {
+			// the trailer of the file
+			break;
+		}
+		if (field_count < 0 || idx_t(field_count) != column_count) {
+			throw InvalidInputException("read_postgres_binary: expected rows of %llu columns in file \"%s\", but "
+			                            "found a row of %d columns",
+			                            column_count, handle.path, field_count);
+		}
+		for (idx_t c = 0; c < column_count; c++) {
+			auto value_len = indexer.ReadInteger<int32_t>();
+			if (value_len > 0) {
+				indexer.Skip(idx_t(value_len));
+			}
+		}
+		if (batches.size() == first_batch || batches.back().row_count == STANDARD_VECTOR_SIZE) {
+			batches.push_back(PostgresBinaryFileBatch {file_idx, row_start, 0, 0, row_offset});
+		}
+		auto &batch = batches.back();
+		batch.size = indexer.position - batch.offset;
+		batch.row_count++;
+		row_offset++;
+	}
+}
+
+static vector<string> GlobFiles(ClientContext &context, const string &path) {
+	auto &fs = FileSystem::GetFileSystem(context);
+	return fs.GlobFiles(path, context, FileGlobOptions::DISALLOW_EMPTY);
+}
+
+static void ParseColumns(ClientContext &context, const Value &columns, PostgresBinaryReadBindData &bind_data) {
+	if (columns.type().id() != LogicalTypeId::STRUCT) {
+		throw BinderException("read_postgres_binary: \"columns\" requires a struct, e.g. {'id': 'INTEGER'}");
+	}
+	auto &children = StructValue::GetChildren(columns);
+	for (idx_t i = 0; i < children.size(); i++) {
+		auto &child = children[i];
+		if (child.type().id() != LogicalTypeId::VARCHAR || child.IsNull()) {
+			throw BinderException("read_postgres_binary: the types of the columns have to be provided as strings");
+		}
+		auto type_name = StringValue::Get(child);
+		PostgresType postgres_type;
+		LogicalType type;
+		if (StringUtil::CIEquals(type_name, "JSONB")) {
+			// binary jsonb values are prefixed with a version number
+			type = LogicalType::VARCHAR;
+			postgres_type.info = PostgresTypeAnnotation::JSONB;
+		} else {
+			type = TransformStringToLogicalType(type_name, context);
+			postgres_type = PostgresUtils::CreateEmptyPostgresType(type);
+		}
+		bind_data.names.push_back(StructType::GetChildName(columns.type(), i));
+		bind_data.types.push_back(std::move(type));
+		bind_data.postgres_types.push_back(std::move(postgres_type));
+	}
+	if (bind_data.names.empty()) {
+		throw BinderException("read_postgres_binary: \"columns\" requires at least one column");
+	}
+}
+
+static unique_ptr<FunctionData> PostgresBinaryReadBind(ClientContext &context, TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<PostgresBinaryReadBindData>();
+	result->files = GlobFiles(context, input.inputs[0].GetValue<string>());
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "columns") {
+			ParseColumns(context, kv.second, *result);
+		}
+	}
+	if (result->names.empty()) {
+		// the binary format does not include the types of the columns
+		throw BinderException("read_postgres_binary requires the columns of the file and their types, e.g. "
+		                      "read_postgres_binary('file.bin', columns={'id': 'INTEGER', 'name': 'VARCHAR'})");
+	}
+	names = result->names;
+	return_types = result->types;
+	return std::move(result);
+}
+
+unique_ptr<FunctionData> PostgresBinaryReadFunction::CopyFromBind(ClientContext &context, CopyInfo &info,
+                                                                  vector<string> &expected_names,
+                                                                  vector<LogicalType> &expected_types) {
+	auto result = make_uniq<PostgresBinaryReadBindData>();
+	result->files = GlobFiles(context, info.file_path);
+	result->names = expected_names;
+	result->types = expected_types;
+	for (auto &type : expected_types) {
+		result->postgres_types.push_back(PostgresUtils::CreateEmptyPostgresType(type));
+	}
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> PostgresBinaryReadInitGlobal(ClientContext &context,
+                                                                        TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PostgresBinaryReadBindData>();
+	auto result = make_uniq<PostgresBinaryReadGlobalState>();
+	auto &fs = FileSystem::GetFileSystem(context);
+	idx_t row_offset = 0;
+	for (idx_t file_idx = 0; file_idx < bind_data.files.size(); file_idx++) {
+		auto handle = fs.OpenFile(bind_data.files[file_idx], FileFlags::FILE_FLAGS_READ);
+		IndexFile(*handle, file_idx, bind_data.types.size(), row_offset, result->batches);
+	}
+	result->max_threads = MaxValue<idx_t>(result->batches.size(), 1);
+	return std::move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> PostgresBinaryReadInitLocal(ExecutionContext &context,
+                                                                      TableFunctionInitInput &input,
+                                                                      GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<PostgresBinaryReadBindData>();
+	auto result = make_uniq<PostgresBinaryReadLocalState>();
+	result->column_ids = input.column_ids;
+	for (auto &column_id : result->column_ids) {
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			// the row number is emitted as row id
+			result->decoders.emplace_back();
+			continue;
+		}
+		result->decoders.push_back(
+		    PostgresColumnDecoder::Create(bind_data.types[column_id], bind_data.postgres_types[column_id]));
+	}
+	result->fields.resize(bind_data.types.size());
+	return std::move(result);
+}
+
+//! Locate the values of the rows of a batch that was read into the buffer
+static void LocateBatch(PostgresBinaryReadLocalState &lstate, const PostgresBinaryFileBatch &batch) {
+	auto ptr = lstate.buffer.get();
+	auto end = ptr + batch.size;
+	for (idx_t row_idx = 0; row_idx < batch.row_count; row_idx++) {
+		ptr += sizeof(int16_t);
+		for (auto &column : lstate.fields) {
+			if (ptr + sizeof(int32_t) > end) {
+				throw InvalidInputException("read_postgres_binary: file \"%s\" was modified while reading",
+				                            lstate.handle->path);
+			}
+			auto value_len = PostgresBinaryReader::LoadInteger<int32_t>(ptr);
+			ptr += sizeof(int32_t);
+			column.length[row_idx] = value_len;
+			if (value_len < 0) {
+				continue;
+			}
+			if (ptr + value_len > end) {
+				throw InvalidInputException("read_postgres_binary: file \"%s\" was modified while reading",
+				                            lstate.handle->path);
+			}
+			column.data[row_idx] = ptr;
+			ptr += value_len;
+		}
+	}
+}
+
+static void PostgresBinaryReadFunctionExecute(ClientContext &context, TableFunctionInput &data_p,
+                                              DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PostgresBinaryReadBindData>();
+	auto &gstate = data_p.global_state->Cast<PostgresBinaryReadGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PostgresBinaryReadLocalState>();
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		if (gstate.next_batch >= gstate.batches.size()) {
+			return;
+		}
+		lstate.batch_idx = gstate.next_batch++;
+	}
+	auto &batch = gstate.batches[lstate.batch_idx];
+	if (batch.file_idx != lstate.file_idx) {
+		auto &fs = FileSystem::GetFileSystem(context);
+		lstate.handle = fs.OpenFile(bind_data.files[batch.file_idx], FileFlags::FILE_FLAGS_READ);
+		lstate.file_idx = batch.file_idx;
+	}
+	if (batch.size > lstate.buffer_capacity) {
+		lstate.buffer = make_unsafe_uniq_array<data_t>(batch.size);
+		lstate.buffer_capacity = batch.size;
+	}
+	lstate.handle->Read(lstate.buffer.get(), batch.size, batch.offset);
+	LocateBatch(lstate, batch);
+
+	PostgresConnection connection;
+	PostgresBinaryReader reader(connection);
+	for (idx_t c = 0; c < lstate.column_ids.size(); c++) {
+		auto column_id = lstate.column_ids[c];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			output.data[c].Sequence(int64_t(batch.row_offset), 1, batch.row_count);
+			continue;
+		}
+		lstate.decoders[c].Decode(reader, lstate.fields[column_id], batch.row_count, output.data[c]);
+	}
+	output.SetCardinality(batch.row_count);
+}
+
+static idx_t PostgresBinaryReadBatchIndex(ClientContext &context, const FunctionData *bind_data_p,
+                                          LocalTableFunctionState *local_state_p,
+                                          GlobalTableFunctionState *global_state) {
+	return local_state_p->Cast<PostgresBinaryReadLocalState>().batch_idx;
+}
+
+PostgresBinaryReadFunction::PostgresBinaryReadFunction()
+    : TableFunction("read_postgres_binary", {LogicalType::VARCHAR}, PostgresBinaryReadFunctionExecute,
+                    PostgresBinaryReadBind, PostgresBinaryReadInitGlobal, PostgresBinaryReadInitLocal) {
+	named_parameters["columns"] = LogicalType::ANY;
+	projection_pushdown = true;
+	get_batch_index = PostgresBinaryReadBatchIndex;
+}
+
+} // namespace duckdb
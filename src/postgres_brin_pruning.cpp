@@ -0,0 +1,181 @@
+#include "postgres_brin_pruning.hpp"
+#include "postgres_scanner.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/numeric_stats.hpp"
+
+namespace duckdb {
+
+//! A filtered column of the scan that is summarized by a BRIN index
+struct PostgresBrinColumn {
+	LogicalType type;
+	reference<TableFilter> filter;
+};
+
+//! Parse the summary of a minmax opclass - "{min .. max}"
+static bool ParseMinMax(const string &summary, const LogicalType &type, Value &min, Value &max) {
+	if (summary.size() < 2 || summary.front() != '{' || summary.back() != '}') {
+		return false;
+	}
+	auto inner = summary.substr(1, summary.size() - 2);
+	auto separator = inner.find(" .. ");
+	if (separator == string::npos) {
+		return false;
+	}
+	min = Value(inner.substr(0, separator));
+	max = Value(inner.substr(separator + 4));
+	return min.DefaultTryCastAs(type) && max.DefaultTryCastAs(type);
+}
+
+bool PostgresBrinPruning::FilterMightMatch(TableFilter &filter, const LogicalType &type, const Value &min,
+                                           const Value &max, bool has_nulls) {
+	auto stats = BaseStatistics::CreateEmpty(type);
+	if (!min.IsNull()) {
+		NumericStats::SetMin(stats, min);
+		NumericStats::SetMax(stats, max);
+		stats.SetHasNoNull();
+	}
+	if (min.IsNull() || has_nulls) {
+		stats.SetHasNull();
+	}
+	return filter.CheckStatistics(stats) != FilterPropagateResult::FILTER_ALWAYS_FALSE;
+}
+
+//! Whether or not the filter can be satisfied by any row of a page range with the given summary
+static bool RangeMightMatch(const PostgresBrinColumn &column, bool all_nulls, bool has_nulls, const string &summary) {
+	Value min, max;
+	if (!all_nulls && !ParseMinMax(summary, column.type, min, max)) {
+		return true;
+	}
+	return PostgresBrinPruning::FilterMightMatch(column.filter.get(), column.type, min, max, has_nulls);
+}
+
+static void PruneIndex(PostgresConnection &connection, const string &index_name,
+                       const unordered_map<idx_t, vector<PostgresBrinColumn>> &columns, idx_t pages_approx,
+                       vector<PostgresPageRange> &result) {
+	vector<string> attnums;
+	for (auto &entry : columns) {
+		attnums.push_back(to_string(entry.first));
+	}
+	auto index_literal = KeywordHelper::WriteQuoted(index_name, '\'');
+	// only the regular pages of the index hold summaries - the offset keeps Postgres from evaluating brin_page_items
+	// on the meta and revmap pages. Placeholders of ranges that are being summarized are not complete yet
+	auto query = StringUtil::Format(
+	    R"(
+SELECT (SELECT pagesperrange FROM brin_metapage_info(get_raw_page(%s, 0))), r.blknum, r.attnum, r.allnulls,
+    r.hasnulls, r.value
+FROM (
+    SELECT blkno
+    FROM generate_series(1, (pg_relation_size(%s::regclass) / current_setting('block_size')::BIGINT)::INT - 1) blkno
+    WHERE brin_page_type(get_raw_page(%s, blkno)) = 'regular'
+    OFFSET 0
+) pages, LATERAL brin_page_items(get_raw_page(%s, pages.blkno), %s::regclass) r
+WHERE NOT r.placeholder AND r.attnum IN (%s)
+ORDER BY r.blknum
+)",
+	    index_literal, index_literal, index_literal, index_literal, index_literal, StringUtil::Join(attnums, ", "));
+	auto summaries = connection.TryQuery(query);
+	if (!summaries) {
+		return;
+	}
+	for (idx_t row = 0; row < summaries->Count(); row++) {
+		auto pages_per_range = idx_t(summaries->GetInt64(row, 0));
+		auto start = idx_t(summaries->GetInt64(row, 1));
+		auto entry = columns.find(idx_t(summaries->GetInt64(row, 2)));
+		if (entry == columns.end() || start + 1 >= pages_approx) {
+			continue;
+		}
+		auto all_nulls = summaries->GetBool(row, 3);
+		auto has_nulls = summaries->GetBool(row, 4);
+		auto summary = summaries->IsNull(row, 5) ? string() : summaries->GetString(row, 5);
+		for (auto &column : entry->second) {
+			if (!RangeMightMatch(column, all_nulls, has_nulls, summary)) {
+				result.emplace_back(start, MinValue<idx_t>(start + pages_per_range, pages_approx - 1));
+				break;
+			}
+		}
+	}
+}
+
+vector<PostgresPageRange> PostgresBrinPruning::GetPrunedRanges(PostgresConnection &connection,
+                                                               const PostgresBindData &bind_data,
+                                                               const vector<column_t> &column_ids,
+                                                               TableFilterSet &filters) {
+	vector<PostgresPageRange> result;
+	// the filtered columns for which the zonemap of DuckDB can be checked
+	unordered_map<string, vector<pair<LogicalType, reference<TableFilter>>>> filtered_columns;
+	for (auto &entry : filters.filters) {
+		auto column_id = column_ids[entry.first];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID ||
+		    (column_id < bind_data.column_expressions.size() && !bind_data.column_expressions[column_id].empty())) {
+			continue;
+		}
+		auto &type = bind_data.types[column_id];
+		// the summaries are compared through the zonemaps of numeric statistics - types whose order differs between
+		// Postgres and DuckDB are skipped
+		if (type.id() == LogicalTypeId::ENUM || type.id() == LogicalTypeId::UUID ||
+		    BaseStatistics::CreateEmpty(type).GetStatsType() != StatisticsType::NUMERIC_STATS) {
+			continue;
+		}
+		filtered_columns[bind_data.names[column_id]].emplace_back(type, *entry.second);
+	}
+	if (filtered_columns.empty()) {
+		return result;
+	}
+	auto table_name = KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+	                  KeywordHelper::WriteQuoted(bind_data.table_name, '"');
+	// the minmax BRIN indexes of the table - if their summaries can be read
+	auto indexes = connection.TryQuery(StringUtil::Format(
+	    R"(
+SELECT i.indexrelid::regclass::text, k.position, a.attname
+FROM pg_index i
+JOIN pg_class ic ON ic.oid = i.indexrelid
+JOIN pg_am am ON am.oid = ic.relam
+CROSS JOIN LATERAL unnest(i.indkey::int2[], i.indclass::oid[]) WITH ORDINALITY AS k(attnum, opclass, position)
+JOIN pg_opclass oc ON oc.oid = k.opclass
+JOIN pg_attribute a ON a.attrelid = i.indrelid AND a.attnum = k.attnum
+WHERE i.indrelid = %s::regclass AND am.amname = 'brin' AND oc.opcname LIKE '%%\_minmax\_ops'
+AND EXISTS (SELECT 1 FROM pg_extension WHERE extname = 'pageinspect')
+AND (SELECT rolsuper FROM pg_roles WHERE rolname = current_user)
+ORDER BY 1, 2
+)",
+	    KeywordHelper::WriteQuoted(table_name, '\'')));
+	if (!indexes) {
+		return result;
+	}
+	for (idx_t row = 0; row < indexes->Count();) {
+		auto index_name = indexes->GetString(row, 0);
+		unordered_map<idx_t, vector<PostgresBrinColumn>> columns;
+		for (; row < indexes->Count() && indexes->GetString(row, 0) == index_name; row++) {
+			auto entry = filtered_columns.find(indexes->GetString(row, 2));
+			if (entry == filtered_columns.end()) {
+				continue;
+			}
+			auto index_attnum = idx_t(indexes->GetInt64(row, 1));
+			for (auto &filter : entry->second) {
+				columns[index_attnum].push_back(PostgresBrinColumn {filter.first, filter.second});
+			}
+		}
+		if (!columns.empty()) {
+			PruneIndex(connection, index_name, columns, bind_data.pages_approx, result);
+		}
+	}
+	if (result.empty()) {
+		return result;
+	}
+	// merge the overlapping and adjacent ranges (of different indexes)
+	std::sort(result.begin(), result.end(),
+	          [](const PostgresPageRange &a, const PostgresPageRange &b) { return a.start < b.start; });
+	vector<PostgresPageRange> merged;
+	for (auto &range : result) {
+		if (!merged.empty() && range.start <= merged.back().end) {
+			merged.back().end = MaxValue<idx_t>(merged.back().end, range.end);
+		} else {
+			merged.push_back(range);
+		}
+	}
+	return merged;
+}
+
+} // namespace duckdb
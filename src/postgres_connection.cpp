@@ -1,14 +1,20 @@
 #include "duckdb/storage/table_storage_info.hpp"
 #include "duckdb/parser/column_list.hpp"
 #include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "postgres_connection.hpp"
+#include "postgres_binary_writer.hpp"
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/common/types/uuid.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 
 namespace duckdb {
 
 static bool debug_postgres_print_queries = false;
+static atomic<idx_t> prepared_statement_cache_size {PostgresConnection::DEFAULT_PREPARED_STATEMENT_CACHE_SIZE};
 
-OwnedPostgresConnection::OwnedPostgresConnection(PGconn *conn) : connection(conn) {
+OwnedPostgresConnection::OwnedPostgresConnection(PGconn *conn)
+    : connection(conn), creation_time(Timestamp::GetCurrentTimestamp()) {
 }
 
 OwnedPostgresConnection::~OwnedPostgresConnection() {
@@ -86,6 +92,244 @@ unique_ptr<PostgresResult> PostgresConnection::Query(const string &query) {
 	return result;
 }
 
+unique_ptr<PostgresResult> PostgresConnection::QueryBinary(const string &query) {
+	if (PostgresConnection::DebugPrintQueries()) {
+		Printer::Print(query + "\n");
+	}
+	auto result = PQexecParams(GetConn(), query.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+	if (ResultHasError(result)) {
+		auto error = "Failed to execute query \"" + query + "\": " + string(PQresultErrorMessage(result));
+		PQclear(result);
+		throw std::runtime_error(error);
+	}
+	return make_uniq<PostgresResult>(result);
+}
+
+//! A parameter of a query in the format that is sent to Postgres
+struct PostgresParameter {
+	uint32_t type_oid = 0;
+	int format = 0;
+	bool is_null = false;
+	string data;
+};
+
+static PostgresParameter EncodeParameter(const Value &value) {
+	PostgresParameter result;
+	switch (value.type().id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIME:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::INTERVAL:
+	case LogicalTypeId::UUID: {
+		result.type_oid = PostgresUtils::ToPostgresOid(value.type());
+		if (value.IsNull()) {
+			result.is_null = true;
+			break;
+		}
+		// encode the value as it would be encoded in a binary COPY - and strip the length prefix
+		Vector value_vector(value.type(), 1);
+		value_vector.SetValue(0, value);
+		PostgresBinaryWriter writer;
+		writer.WriteValue(value_vector, 0);
+		auto data = const_char_ptr_cast(writer.stream.GetData());
+		result.data = string(data + sizeof(int32_t), writer.stream.GetPosition() - sizeof(int32_t));
+		result.format = 1;
+		break;
+	}
+	default:
+		// other types are sent as text - their type is inferred by Postgres
+		result.is_null = value.IsNull();
+		if (!result.is_null) {
+			result.data = value.ToString();
+		}
+		break;
+	}
+	return result;
+}
+
+//! The parameters of a query in the layout expected by PQexecParams
+struct PostgresParameters {
+	explicit PostgresParameters(const vector<Value> &parameters) {
+		for (auto &parameter : parameters) {
+			encoded.push_back(EncodeParameter(parameter));
+		}
+		for (auto &parameter : encoded) {
+			types.push_back(parameter.type_oid);
+			values.push_back(parameter.is_null ? nullptr : parameter.data.c_str());
+			lengths.push_back(int(parameter.data.size()));
+			formats.push_back(parameter.format);
+		}
+	}
+
+	vector<PostgresParameter> encoded;
+	vector<Oid> types;
+	vector<const char *> values;
+	vector<int> lengths;
+	vector<int> formats;
+};
+
+unique_ptr<PostgresResult> PostgresConnection::TryQueryWithParameters(const string &query,
+                                                                      const vector<Value> &parameters,
+                                                                      optional_ptr<string> error_message,
+                                                                      bool use_statement_cache) {
+	return TryQueryWithParametersInternal(query, parameters, error_message, use_statement_cache, 0);
+}
+
+unique_ptr<PostgresResult> PostgresConnection::QueryBinaryWithParameters(const string &query,
+                                                                         const vector<Value> &parameters) {
+	string error_msg;
+	auto result = TryQueryWithParametersInternal(query, parameters, &error_msg, true, 1);
+	if (!result) {
+		throw std::runtime_error(error_msg);
+	}
+	return result;
+}
+
+unique_ptr<PostgresResult> PostgresConnection::TryQueryWithParametersInternal(const string &query,
+                                                                              const vector<Value> &parameters,
+                                                                              optional_ptr<string> error_message,
+                                                                              bool use_statement_cache,
+                                                                              int result_format) {
+	if (PostgresConnection::DebugPrintQueries()) {
+		Printer::Print(query + "\n");
+	}
+	PostgresParameters encoded(parameters);
+	string statement_key = query;
+	for (auto &type : encoded.types) {
+		statement_key += "\n" + to_string(type);
+	}
+	auto &types = encoded.types;
+	auto &values = encoded.values;
+	auto &lengths = encoded.lengths;
+	auto &formats = encoded.formats;
+	auto param_count = int(parameters.size());
+	auto conn = GetConn();
+	auto &prepared_statements = connection->prepared_statements;
+	PGresult *result;
+	use_statement_cache = use_statement_cache && !connection->prepared_statements_disabled;
+	auto entry = use_statement_cache ? prepared_statements.find(statement_key) : prepared_statements.end();
+	if (entry == prepared_statements.end()) {
+		// the first execution of a statement is sent as-is - we only prepare statements that are executed again
+		if (use_statement_cache && prepared_statements.size() < prepared_statement_cache_size) {
+			prepared_statements.insert(make_pair(std::move(statement_key), string()));
+		}
+	} else if (entry->second.empty()) {
+		// prepare the statement so that later executions can skip parsing and planning
+		auto statement_name = "duckdb_statement_" + to_string(connection->prepared_statement_count++);
+		auto prepare_result = PQprepare(conn, statement_name.c_str(), query.c_str(), param_count, types.data());
+		if (ResultHasError(prepare_result)) {
+			if (PQtransactionStatus(conn) != PQTRANS_IDLE) {
+				// the failure aborted the transaction - we cannot fall back to sending the statement as-is
+				if (error_message) {
+					*error_message = "Failed to prepare query \"" + query +
+					                 "\": " + string(PQresultErrorMessage(prepare_result));
+				}
+				PQclear(prepare_result);
+				return nullptr;
+			}
+			// e.g. the name is taken on a server connection shared through a pooler - stop preparing statements
+			DisablePreparedStatements();
+			entry = prepared_statements.end();
+		} else {
+			entry->second = std::move(statement_name);
+		}
+		PQclear(prepare_result);
+	}
+	if (entry != prepared_statements.end() && !entry->second.empty()) {
+		result = PQexecPrepared(conn, entry->second.c_str(), param_count, values.data(), lengths.data(),
+		                        formats.data(), result_format);
+		if (result && PQresultStatus(result) == PGRES_FATAL_ERROR && PQtransactionStatus(conn) == PQTRANS_IDLE) {
+			auto sql_state = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+			if (sql_state && string(sql_state) == "26000") {
+				// invalid_sql_statement_name: the statement does not exist on the server connection we ended up on
+				// (e.g. behind a pooler) - stop preparing statements and send the statement as-is
+				PQclear(result);
+				DisablePreparedStatements();
+				result = PQexecParams(conn, query.c_str(), param_count, types.data(), values.data(),
+				                      lengths.data(), formats.data(), result_format);
+			}
+		}
+	} else {
+		result = PQexecParams(conn, query.c_str(), param_count, types.data(), values.data(), lengths.data(),
+		                      formats.data(), result_format);
+	}
+	if (ResultHasError(result)) {
+		if (error_message) {
+			*error_message = "Failed to execute query \"" + query + "\": " + string(PQresultErrorMessage(result));
+		}
+		PQclear(result);
+		return nullptr;
+	}
+	return make_uniq<PostgresResult>(result);
+}
+
+unique_ptr<PostgresResult> PostgresConnection::QueryWithParameters(const string &query,
+                                                                   const vector<Value> &parameters,
+                                                                   bool use_statement_cache) {
+	string error_msg;
+	auto result = TryQueryWithParameters(query, parameters, &error_msg, use_statement_cache);
+	if (!result) {
+		throw std::runtime_error(error_msg);
+	}
+	return result;
+}
+
+unique_ptr<PostgresResult> PostgresConnection::TryDescribeQuery(const string &query, const vector<Value> &parameters,
+                                                                string &error_message) {
+	if (PostgresConnection::DebugPrintQueries()) {
+		Printer::Print(query + "\n");
+	}
+	vector<Oid> types;
+	for (auto &parameter : parameters) {
+		types.push_back(EncodeParameter(parameter).type_oid);
+	}
+	auto conn = GetConn();
+	auto prepared = PQprepare(conn, "", query.c_str(), int(types.size()), types.empty() ? nullptr : types.data());
+	PostgresResult prepared_wrapper(prepared);
+	if (!prepared) {
+		error_message = "Failed to prepare query \"" + query + "\" (no result returned): " + PQerrorMessage(conn);
+		return nullptr;
+	}
+	if (PQresultStatus(prepared) != PGRES_COMMAND_OK) {
+		error_message = "Failed to prepare query \"" + query + "\": " + PQresultErrorMessage(prepared);
+		return nullptr;
+	}
+	auto describe_prepared = PQdescribePrepared(conn, "");
+	if (!describe_prepared || PQresultStatus(describe_prepared) != PGRES_COMMAND_OK) {
+		auto extended_err = describe_prepared ? PQresultErrorMessage(describe_prepared) : PQerrorMessage(conn);
+		error_message = "Failed to describe prepared statement: " + string(extended_err);
+		PQclear(describe_prepared);
+		return nullptr;
+	}
+	return make_uniq<PostgresResult>(describe_prepared);
+}
+
+void PostgresConnection::DisablePreparedStatements() {
+	connection->prepared_statements.clear();
+	connection->prepared_statements_disabled = true;
+}
+
+void PostgresConnection::Reset() {
+	PQreset(GetConn());
+	// a new server connection was established - the statements prepared on the previous one are gone
+	connection->prepared_statements.clear();
+	connection->version_cached = false;
+	connection->recovery_cached = false;
+}
+
+void PostgresConnection::SetPreparedStatementCacheSize(idx_t size) {
+	prepared_statement_cache_size = size;
+}
+
 void PostgresConnection::Execute(const string &query) {
 	Query(query);
 }
@@ -117,7 +361,94 @@ vector<unique_ptr<PostgresResult>> PostgresConnection::ExecuteQueries(const stri
 	return results;
 }
 
+vector<unique_ptr<PostgresResult>>
+PostgresConnection::ExecutePipeline(const vector<PostgresPipelineStatement> &statements) {
+	vector<unique_ptr<PostgresResult>> results;
+	auto conn = GetConn();
+	if (statements.size() <= 1 || !PQenterPipelineMode(conn)) {
+		// nothing to batch - or the connection cannot enter pipeline mode: execute the statements one by one
+		for (auto &statement : statements) {
+			if (statement.binary_result) {
+				results.push_back(QueryBinaryWithParameters(statement.query, statement.parameters));
+			} else {
+				results.push_back(QueryWithParameters(statement.query, statement.parameters));
+			}
+		}
+		return results;
+	}
+	string error;
+	idx_t sent_count = 0;
+	for (auto &statement : statements) {
+		if (PostgresConnection::DebugPrintQueries()) {
+			Printer::Print(statement.query + "\n");
+		}
+		PostgresParameters encoded(statement.parameters);
+		if (!PQsendQueryParams(conn, statement.query.c_str(), int(encoded.types.size()), encoded.types.data(),
+		                       encoded.values.data(), encoded.lengths.data(), encoded.formats.data(),
+		                       statement.binary_result ? 1 : 0)) {
+			error = "Failed to execute query \"" + statement.query + "\": " + string(PQerrorMessage(conn));
+			break;
+		}
+		sent_count++;
+	}
+	// the sync point ends the pipeline - Postgres only starts executing the statements once it is flushed
+	bool synced = PQpipelineSync(conn);
+	if (!synced && error.empty()) {
+		error = "Failed to execute pipeline: " + string(PQerrorMessage(conn));
+	}
+	// every statement produces its result(s) followed by a nullptr - after a failure the remaining statements are
+	// aborted (PGRES_PIPELINE_ABORTED)
+	for (idx_t i = 0; i < sent_count; i++) {
+		unique_ptr<PostgresResult> result;
+		while (auto res = PQgetResult(conn)) {
+			if (result) {
+				PQclear(res);
+				continue;
+			}
+			result = make_uniq<PostgresResult>(res);
+			if (ResultHasError(res) && error.empty()) {
+				error = "Failed to execute query \"" + statements[i].query +
+				        "\": " + string(PQresultErrorMessage(res));
+			}
+		}
+		if (!result && error.empty()) {
+			error = "Failed to execute query \"" + statements[i].query + "\": " + string(PQerrorMessage(conn));
+		}
+		results.push_back(std::move(result));
+	}
+	if (synced) {
+		auto sync_result = PQgetResult(conn);
+		PQclear(sync_result);
+	}
+	PQexitPipelineMode(conn);
+	if (!error.empty()) {
+		throw std::runtime_error(error);
+	}
+	return results;
+}
+
+bool PostgresConnection::TryGetQueryEstimate(const string &query, double &rows, double &width) {
+	auto result = TryQuery("EXPLAIN (FORMAT JSON) " + query);
+	if (!result) {
+		return false;
+	}
+	auto plan = result->GetString(0, 0);
+	// the first estimate in the plan is the estimate of the top-most node
+	auto get_estimate = [&](const string &key, double &estimate) {
+		auto pos = plan.find("\"" + key + "\":");
+		if (pos == string::npos) {
+			return false;
+		}
+		estimate = std::strtod(plan.c_str() + pos + key.size() + 3, nullptr);
+		return true;
+	};
+	return get_estimate("Plan Rows", rows) && get_estimate("Plan Width", width);
+}
+
 PostgresVersion PostgresConnection::GetPostgresVersion() {
+	if (connection && connection->version_cached) {
+		return connection->version;
+	}
 	auto result = TryQuery("SELECT version(), (SELECT COUNT(*) FROM pg_settings WHERE name LIKE 'rds%')");
 	if (!result) {
 		PostgresVersion version;
@@ -128,9 +459,36 @@ PostgresVersion PostgresConnection::GetPostgresVersion() {
 	if (result->GetInt64(0, 1) > 0) {
 		version.type_v = PostgresInstanceType::AURORA;
 	}
+	connection->version = version;
+	connection->version_cached = true;
 	return version;
 }
 
+string PostgresConnection::TryExportSnapshot(PostgresVersion version) {
+	if (connection && connection->recovery_cached) {
+		// the recovery state is known - only the snapshot has to be exported
+		if (connection->in_recovery) {
+			return string();
+		}
+		auto result = TryQuery("SELECT pg_export_snapshot()");
+		return result ? result->GetString(0, 0) : string();
+	}
+	// pg_stat_wal_receiver was introduced in PostgreSQL 9.6
+	bool has_wal_receiver = !(version < PostgresVersion(9, 6, 0));
+	auto result = TryQuery(has_wal_receiver ? "SELECT pg_is_in_recovery(), pg_export_snapshot(), (select count(*) "
+	                                          "from pg_stat_wal_receiver)"
+	                                        : "SELECT pg_is_in_recovery(), pg_export_snapshot()");
+	if (!result) {
+		return string();
+	}
+	connection->in_recovery = result->GetBool(0, 0) || (has_wal_receiver && result->GetInt64(0, 2) > 0);
+	connection->recovery_cached = true;
+	if (connection->in_recovery) {
+		return string();
+	}
+	return result->GetString(0, 1);
+}
+
 bool PostgresConnection::IsOpen() {
 	return connection.get();
 }
@@ -142,8 +500,37 @@ void PostgresConnection::Close() {
 	connection = nullptr;
 }
 
-vector<IndexInfo> PostgresConnection::GetIndexInfo(const string &table_name) {
-	return vector<IndexInfo>();
+vector<IndexInfo> PostgresConnection::GetIndexInfo(const string &schema_name, const string &table_name,
+                                                   const vector<string> &column_names) {
+	auto relation = KeywordHelper::WriteQuoted(schema_name, '"') + "." + KeywordHelper::WriteQuoted(table_name, '"');
+	auto result = Query(StringUtil::Format(R"(
+SELECT i.indexrelid, i.indisprimary, a.attname
+FROM pg_index i JOIN pg_attribute a ON a.attrelid = i.indrelid AND a.attnum = ANY(i.indkey)
+WHERE i.indrelid = %s::regclass AND i.indisunique AND i.indpred IS NULL AND i.indexprs IS NULL
+ORDER BY i.indexrelid
+)",
+	                                       KeywordHelper::WriteQuoted(relation)));
+	vector<IndexInfo> indexes;
+	string current_index;
+	for (idx_t row = 0; row < result->Count(); row++) {
+		auto index_oid = result->GetString(row, 0);
+		if (index_oid != current_index) {
+			current_index = index_oid;
+			IndexInfo info;
+			info.is_unique = true;
+			info.is_primary = result->GetBool(row, 1);
+			info.is_foreign = false;
+			indexes.push_back(std::move(info));
+		}
+		auto column_name = result->GetString(row, 2);
+		for (idx_t col = 0; col < column_names.size(); col++) {
+			if (column_names[col] == column_name) {
+				indexes.back().column_set.insert(col);
+				break;
+			}
+		}
+	}
+	return indexes;
 }
 
 void PostgresConnection::DebugSetPrintQueries(bool print) {
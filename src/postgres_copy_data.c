@@ -0,0 +1,44 @@
+/*
+ * Reads CopyData messages straight from the receive buffer of a libpq connection. PQgetCopyData allocates a buffer
+ * for every message it returns - this allows copying the data into buffers managed by the caller instead.
+ */
+#include "postgres_fe.h"
+
+#include "libpq-int.h"
+#include "port/pg_bswap.h"
+#include "postgres_copy_data.h"
+
+/* the message type and the message length */
+#define COPY_DATA_HEADER_SIZE 5
+
+static uint32 get_message_length(PGconn *conn)
+{
+	uint32 length;
+
+	memcpy(&length, conn->inBuffer + conn->inStart + 1, sizeof(uint32));
+	return pg_ntoh32(length);
+}
+
+int postgres_peek_copy_data(PGconn *conn, const char **data)
+{
+	int available;
+	uint32 length;
+
+	/* leave anything but plain COPY data (and tracing) to libpq */
+	if (conn->asyncStatus != PGASYNC_COPY_OUT || conn->Pfdebug)
+		return 0;
+	available = conn->inEnd - conn->inStart;
+	if (available < COPY_DATA_HEADER_SIZE || conn->inBuffer[conn->inStart] != 'd')
+		return 0;
+	/* the length includes itself, but not the message type */
+	length = get_message_length(conn);
+	if (length <= sizeof(uint32) || (uint32)(available - 1) < length)
+		return 0;
+	*data = conn->inBuffer + conn->inStart + COPY_DATA_HEADER_SIZE;
+	return (int)(length - sizeof(uint32));
+}
+
+void postgres_consume_copy_data(PGconn *conn)
+{
+	conn->inStart += 1 + get_message_length(conn);
+}
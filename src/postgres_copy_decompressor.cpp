@@ -0,0 +1,230 @@
+#include "postgres_copy_decompressor.hpp"
+#include "postgres_binary_reader.hpp"
+#include "postgres_conversion.hpp"
+#include "miniz.hpp"
+
+#include <libpq-fe.h>
+
+namespace duckdb {
+
+//! The amount by which the buffer of decompressed data grows when it is full
+static constexpr const idx_t INFLATE_BUFFER_SIZE = 1 << 16;
+//! The magic, the flags field and the header extension length
+static constexpr const idx_t COPY_HEADER_SIZE = PostgresConversion::COPY_HEADER_LENGTH + 2 * sizeof(int32_t);
+
+struct PostgresInflateState {
+	duckdb_miniz::mz_stream stream;
+	bool initialized = false;
+	bool finished = false;
+};
+
+PostgresCopyDecompressor::PostgresCopyDecompressor() : inflate_state(make_uniq<PostgresInflateState>()) {
+}
+
+PostgresCopyDecompressor::~PostgresCopyDecompressor() {
+	Reset();
+}
+
+void PostgresCopyDecompressor::FreeMessage(void *message) {
+	free(message);
+}
+
+void PostgresCopyDecompressor::FreeMessages() {
+	for (auto &message : messages) {
+		FreeMessage(message.first);
+	}
+	messages.clear();
+}
+
+void PostgresCopyDecompressor::Reset() {
+	FreeMessages();
+	if (inflate_state->initialized) {
+		duckdb_miniz::mz_inflateEnd(&inflate_state->stream);
+		inflate_state->initialized = false;
+	}
+	inflate_state->finished = false;
+	read_compressed_header = false;
+	read_header = false;
+	read_trailer = false;
+	pending_size = 0;
+}
+
+static void CheckCopyHeader(const_data_ptr_t data, idx_t len, idx_t &header_len) {
+	if (len < COPY_HEADER_SIZE) {
+		throw IOException("Unable to read compressed COPY data from Postgres: invalid header");
+	}
+	if (memcmp(data, PostgresConversion::COPY_HEADER, PostgresConversion::COPY_HEADER_LENGTH) != 0) {
+		throw IOException("Expected Postgres binary COPY header, got something else");
+	}
+	auto extension_len = PostgresBinaryReader::LoadInteger<int32_t>(data + COPY_HEADER_SIZE - sizeof(int32_t));
+	if (extension_len < 0) {
+		throw IOException("Unable to read compressed COPY data from Postgres: invalid header");
+	}
+	header_len = COPY_HEADER_SIZE + idx_t(extension_len);
+}
+
+bool PostgresCopyDecompressor::Decompress(const_data_ptr_t data, idx_t len) {
+	auto end = data + len;
+	if (!read_compressed_header) {
+		idx_t header_len;
+		CheckCopyHeader(data, len, header_len);
+		if (header_len > len) {
+			throw IOException("Unable to read compressed COPY data from Postgres: invalid header");
+		}
+		data += header_len;
+		read_compressed_header = true;
+	}
+	while (data < end) {
+		if (data + sizeof(int16_t) > end) {
+			throw IOException("Unable to read compressed COPY data from Postgres: message too short");
+		}
+		auto field_count = PostgresBinaryReader::LoadInteger<int16_t>(data);
+		data += sizeof(int16_t);
+		if (field_count == -1) {
+			// the trailer of the compressed COPY
+			if (!read_trailer) {
+				throw IOException("Unable to read compressed COPY data from Postgres: the compressed data ended "
+				                  "before the end of the COPY");
+			}
+			return false;
+		}
+		if (field_count != 1) {
+			throw IOException("Unable to read compressed COPY data from Postgres: expected a single bytea column, "
+			                  "but got %d columns",
+			                  field_count);
+		}
+		if (data + sizeof(int32_t) > end) {
+			throw IOException("Unable to read compressed COPY data from Postgres: message too short");
+		}
+		auto frame_len = PostgresBinaryReader::LoadInteger<int32_t>(data);
+		data += sizeof(int32_t);
+		if (frame_len < 0) {
+			// NULL - skip
+			continue;
+		}
+		if (data + frame_len > end) {
+			throw IOException("Unable to read compressed COPY data from Postgres: message too short");
+		}
+		Inflate(data, idx_t(frame_len));
+		data += frame_len;
+	}
+	SplitMessages();
+	return true;
+}
+
+void PostgresCopyDecompressor::Inflate(const_data_ptr_t data, idx_t len) {
+	auto &state = *inflate_state;
+	if (!state.initialized) {
+		memset(&state.stream, 0, sizeof(duckdb_miniz::mz_stream));
+		if (duckdb_miniz::mz_inflateInit(&state.stream) != duckdb_miniz::MZ_OK) {
+			throw InternalException("Failed to initialize the decompression of COPY data");
+		}
+		state.initialized = true;
+	}
+	if (state.finished) {
+		// anything following the end of the compressed stream is ignored
+		return;
+	}
+	state.stream.next_in = data;
+	state.stream.avail_in = len;
+	while (true) {
+		if (pending.size() - pending_size < INFLATE_BUFFER_SIZE) {
+			pending.resize(pending_size + INFLATE_BUFFER_SIZE);
+		}
+		idx_t available = pending.size() - pending_size;
+		state.stream.next_out = pending.data() + pending_size;
+		state.stream.avail_out = available;
+		auto res = duckdb_miniz::mz_inflate(&state.stream, duckdb_miniz::MZ_NO_FLUSH);
+		pending_size += available - state.stream.avail_out;
+		if (res == duckdb_miniz::MZ_STREAM_END) {
+			state.finished = true;
+			break;
+		}
+		if (res == duckdb_miniz::MZ_BUF_ERROR) {
+			// no progress is possible without more input
+			break;
+		}
+		if (res != duckdb_miniz::MZ_OK) {
+			throw IOException("Failed to decompress COPY data from Postgres: %s", duckdb_miniz::mz_error(res));
+		}
+		if (state.stream.avail_in == 0 && state.stream.avail_out > 0) {
+			break;
+		}
+	}
+}
+
+bool PostgresCopyDecompressor::TryGetRowLength(idx_t offset, idx_t &len, bool &is_trailer) {
+	auto start = pending.data() + offset;
+	auto end = pending.data() + pending_size;
+	auto ptr = start;
+	if (ptr + sizeof(int16_t) > end) {
+		return false;
+	}
+	auto field_count = PostgresBinaryReader::LoadInteger<int16_t>(ptr);
+	ptr += sizeof(int16_t);
+	is_trailer = field_count == -1;
+	for (int16_t field_idx = 0; field_idx < field_count; field_idx++) {
+		if (ptr + sizeof(int32_t) > end) {
+			return false;
+		}
+		auto value_len = PostgresBinaryReader::LoadInteger<int32_t>(ptr);
+		ptr += sizeof(int32_t);
+		if (value_len > 0) {
+			if (idx_t(end - ptr) < idx_t(value_len)) {
+				return false;
+			}
+			ptr += value_len;
+		}
+	}
+	len = ptr - start;
+	return true;
+}
+
+void PostgresCopyDecompressor::SplitMessages() {
+	idx_t offset = 0;
+	while (!read_trailer) {
+		// the header is sent together with the first row
+		idx_t header_len = 0;
+		if (!read_header) {
+			if (pending_size < COPY_HEADER_SIZE) {
+				break;
+			}
+			CheckCopyHeader(pending.data(), pending_size, header_len);
+			if (header_len > pending_size) {
+				break;
+			}
+		}
+		idx_t row_len;
+		bool is_trailer;
+		if (!TryGetRowLength(offset + header_len, row_len, is_trailer)) {
+			break;
+		}
+		auto message_len = header_len + row_len;
+		auto message = data_ptr_cast(malloc(message_len));
+		if (!message) {
+			throw OutOfMemoryException("Failed to allocate a row buffer for the decompressed COPY data");
+		}
+		memcpy(message, pending.data() + offset, message_len);
+		messages.emplace_back(message, message_len);
+		offset += message_len;
+		read_header = true;
+		read_trailer = is_trailer;
+	}
+	if (offset > 0) {
+		// keep the incomplete message (if any) at the start of the buffer
+		memmove(pending.data(), pending.data() + offset, pending_size - offset);
+		pending_size -= offset;
+	}
+}
+
+bool PostgresCopyDecompressor::Next(data_ptr_t &buffer, idx_t &len) {
+	if (messages.empty()) {
+		return false;
+	}
+	buffer = messages.front().first;
+	len = messages.front().second;
+	messages.pop_front();
+	return true;
+}
+
+} // namespace duckdb
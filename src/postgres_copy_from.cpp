@@ -8,8 +8,74 @@ void PostgresConnection::BeginCopyFrom(PostgresBinaryReader &reader, const strin
 	if (!result || PQresultStatus(result) != PGRES_COPY_OUT) {
 		throw std::runtime_error("Failed to prepare COPY \"" + query + "\": " + string(PQresultErrorMessage(result)));
 	}
+	reader.BeginCopy();
 	reader.Next();
 	reader.CheckHeader();
 }
 
+void PostgresConnection::SendCopyFrom(const string &query) {
+	if (PostgresConnection::DebugPrintQueries()) {
+		Printer::Print(query + "\n");
+	}
+	if (!PQsendQuery(GetConn(), query.c_str())) {
+		throw std::runtime_error("Failed to prepare COPY \"" + query + "\": " + string(PQerrorMessage(GetConn())));
+	}
+}
+
+void PostgresConnection::FinishCopyFrom(PostgresBinaryReader &reader, const string &query) {
+	auto result = PQgetResult(GetConn());
+	if (!result || PQresultStatus(result) != PGRES_COPY_OUT) {
+		string error = result ? PQresultErrorMessage(result) : PQerrorMessage(GetConn());
+		PQclear(result);
+		// consume the remaining results so that the connection can be used again
+		while ((result = PQgetResult(GetConn())) != nullptr) {
+			PQclear(result);
+		}
+		throw std::runtime_error("Failed to prepare COPY \"" + query + "\": " + error);
+	}
+	PQclear(result);
+	reader.BeginCopy();
+	reader.Next();
+	reader.CheckHeader();
+}
+
+bool PostgresConnection::AbortCopyFrom(bool cancel) {
+	auto conn = GetConn();
+	if (PQstatus(conn) != CONNECTION_OK || PQtransactionStatus(conn) != PQTRANS_ACTIVE) {
+		return false;
+	}
+	if (cancel) {
+		// the server stops sending rows as soon as it notices the cancel request
+		auto cancel_request = PQgetCancel(conn);
+		if (cancel_request) {
+			char error_buffer[256];
+			PQcancel(cancel_request, error_buffer, sizeof(error_buffer));
+			PQfreeCancel(cancel_request);
+		}
+	}
+	// discard everything the server sent before it stopped - the final result (the error of the cancelled query)
+	// leaves the connection ready for the next query
+	while (true) {
+		auto result = PQgetResult(conn);
+		if (!result) {
+			break;
+		}
+		auto status = PQresultStatus(result);
+		PQclear(result);
+		if (status != PGRES_COPY_OUT) {
+			continue;
+		}
+		char *buffer;
+		int len;
+		while ((len = PQgetCopyData(conn, &buffer, 0)) > 0) {
+			PQfreemem(buffer);
+		}
+		if (len == -2) {
+			// the connection is broken
+			break;
+		}
+	}
+	return true;
+}
+
 } // namespace duckdb
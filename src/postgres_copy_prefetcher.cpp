@@ -0,0 +1,180 @@
+#include "postgres_copy_prefetcher.hpp"
+#include "postgres_copy_decompressor.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+namespace duckdb {
+
+PostgresCopyPrefetcher::PostgresCopyPrefetcher(PGconn *conn_p, idx_t capacity_p,
+                                               optional_ptr<PostgresCopyDecompressor> decompressor_p)
+    : conn(conn_p), capacity(capacity_p), decompressor(decompressor_p) {
+}
+
+PostgresCopyPrefetcher::~PostgresCopyPrefetcher() {
+	Stop();
+}
+
+void PostgresCopyPrefetcher::Start() {
+	// the previous COPY must have completed before we can start receiving a new one
+	Finish();
+	if (decompressor) {
+		decompressor->Reset();
+	}
+	finished = false;
+	stopped = false;
+	error = string();
+	receiver = std::thread(&PostgresCopyPrefetcher::ReceiveRows, this);
+}
+
+void PostgresCopyPrefetcher::Stop() {
+	{
+		lock_guard<mutex> guard(lock);
+		stopped = true;
+	}
+	space_available.notify_all();
+	if (receiver.joinable()) {
+		receiver.join();
+	}
+	auto free_row = GetFreeFunction();
+	for (auto &row : rows) {
+		free_row(row.first);
+	}
+	rows.clear();
+	buffered_bytes = 0;
+}
+
+void PostgresCopyPrefetcher::Finish() {
+	if (receiver.joinable()) {
+		receiver.join();
+	}
+	if (!error.empty()) {
+		auto error_message = std::move(error);
+		error = string();
+		throw IOException("Unable to read binary COPY data from Postgres: %s", error_message);
+	}
+}
+
+postgres_free_buffer_t PostgresCopyPrefetcher::GetFreeFunction() const {
+	return decompressor ? PostgresCopyDecompressor::FreeMessage : PQfreemem;
+}
+
+bool PostgresCopyPrefetcher::Next(data_ptr_t &buffer, idx_t &len) {
+	std::unique_lock<mutex> guard(lock);
+	rows_available.wait(guard, [&] { return !rows.empty() || finished; });
+	if (rows.empty()) {
+		if (!error.empty()) {
+			// the error is reported once - Finish (e.g. during cleanup) does not throw it again
+			auto error_message = std::move(error);
+			error = string();
+			throw IOException("Unable to read binary COPY data from Postgres: %s", error_message);
+		}
+		return false;
+	}
+	buffer = rows.front().first;
+	len = rows.front().second;
+	rows.pop_front();
+	buffered_bytes -= len;
+	guard.unlock();
+	space_available.notify_one();
+	return true;
+}
+
+static bool WaitForSocket(PGconn *conn) {
+	auto socket = PQsocket(conn);
+	if (socket < 0) {
+		return false;
+	}
+	// poll instead of select - select cannot wait on sockets with a descriptor of FD_SETSIZE or higher
+	pollfd input;
+	input.fd = socket;
+	input.events = POLLIN;
+	input.revents = 0;
+	// wake up regularly so that we can notice the scan being stopped
+	static constexpr int TIMEOUT_MS = 100;
+#ifdef _WIN32
+	return WSAPoll(&input, 1, TIMEOUT_MS) >= 0;
+#else
+	return poll(&input, 1, TIMEOUT_MS) >= 0;
+#endif
+}
+
+void PostgresCopyPrefetcher::ReceiveRows() {
+	string receive_error;
+	while (true) {
+		{
+			std::unique_lock<mutex> guard(lock);
+			// at least one row is always buffered - however large it is
+			space_available.wait(guard, [&] {
+				return (rows.size() < capacity && buffered_bytes < MAX_BUFFERED_BYTES) || rows.empty() || stopped;
+			});
+			if (stopped) {
+				return;
+			}
+		}
+		char *out_buffer = nullptr;
+		int len = PQgetCopyData(conn, &out_buffer, 1);
+		if (len > 0 && decompressor) {
+			// decompress the data here so that the scanning thread only has to decode the rows
+			try {
+				decompressor->Decompress(const_data_ptr_cast(out_buffer), idx_t(len));
+			} catch (std::exception &ex) {
+				PQfreemem(out_buffer);
+				receive_error = ex.what();
+				break;
+			}
+			PQfreemem(out_buffer);
+			{
+				lock_guard<mutex> guard(lock);
+				data_ptr_t row;
+				idx_t row_len;
+				while (decompressor->Next(row, row_len)) {
+					rows.emplace_back(row, row_len);
+					buffered_bytes += row_len;
+				}
+			}
+			rows_available.notify_one();
+			continue;
+		}
+		if (len > 0) {
+			{
+				lock_guard<mutex> guard(lock);
+				rows.emplace_back(data_ptr_cast(out_buffer), idx_t(len));
+				buffered_bytes += idx_t(len);
+			}
+			rows_available.notify_one();
+			continue;
+		}
+		if (len == 0) {
+			// no complete row available yet - wait for more data to arrive on the socket
+			if (!WaitForSocket(conn) || !PQconsumeInput(conn)) {
+				receive_error = string(PQerrorMessage(conn));
+				break;
+			}
+			continue;
+		}
+		if (len == -1) {
+			// the COPY has finished - fetch the final result
+			auto result = PQgetResult(conn);
+			if (!result || PQresultStatus(result) != PGRES_COMMAND_OK) {
+				receive_error = "Failed to execute COPY: " + string(PQresultErrorMessage(result));
+			}
+			PQclear(result);
+			break;
+		}
+		// len -2 is error
+		receive_error = string(PQerrorMessage(conn));
+		break;
+	}
+	{
+		lock_guard<mutex> guard(lock);
+		error = std::move(receive_error);
+		finished = true;
+	}
+	rows_available.notify_all();
+}
+
+} // namespace duckdb
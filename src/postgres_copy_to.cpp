@@ -225,50 +225,57 @@ void CastToPostgresVarchar(ClientContext &context, Vector &input, Vector &result
 	}
 }
 
+void PostgresConnection::CastChunkToPostgresVarchar(ClientContext &context, DataChunk &chunk, DataChunk &varchar_chunk,
+                                                    optional_ptr<const vector<PostgresType>> postgres_types) {
+	// cast columns to varchar
+	if (varchar_chunk.ColumnCount() == 0) {
+		// not initialized yet
+		vector<LogicalType> varchar_types;
+		for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+			varchar_types.push_back(LogicalType::VARCHAR);
+		}
+		varchar_chunk.Initialize(Allocator::DefaultAllocator(), varchar_types);
+	}
+	D_ASSERT(chunk.ColumnCount() == varchar_chunk.ColumnCount());
+	varchar_chunk.Reset();
+	// for text format cast to varchar first
+	for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
+		if (postgres_types && (*postgres_types)[c].info == PostgresTypeAnnotation::PGVECTOR) {
+			// pgvector uses the same [x, y, z] format as DuckDB lists and arrays
+			VectorOperations::Cast(context, chunk.data[c], varchar_chunk.data[c], chunk.size());
+			continue;
+		}
+		if (chunk.data[c].GetType().id() == LogicalTypeId::VARCHAR) {
+			// strings are escaped while they are written - they do not have to be copied first
+			varchar_chunk.data[c].Reference(chunk.data[c]);
+			continue;
+		}
+		CastToPostgresVarchar(context, chunk.data[c], varchar_chunk.data[c], chunk.size());
+	}
+	varchar_chunk.SetCardinality(chunk.size());
+}
+
 void PostgresConnection::CopyChunk(ClientContext &context, PostgresCopyState &state, DataChunk &chunk,
                                    DataChunk &varchar_chunk) {
 	chunk.Flatten();
 
 	if (state.format == PostgresCopyFormat::BINARY) {
 		PostgresBinaryWriter writer;
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			writer.BeginRow(chunk.ColumnCount());
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				auto &col = chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
+		if (state.postgres_types.empty()) {
+			writer.WriteChunk(chunk);
+		} else {
+			writer.WriteChunk(chunk, &state.postgres_types);
 		}
 		CopyData(writer);
 	} else if (state.format == PostgresCopyFormat::TEXT) {
-		// cast columns to varchar
-		if (varchar_chunk.ColumnCount() == 0) {
-			// not initialized yet
-			vector<LogicalType> varchar_types;
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				varchar_types.push_back(LogicalType::VARCHAR);
-			}
-			varchar_chunk.Initialize(Allocator::DefaultAllocator(), varchar_types);
-		}
-		D_ASSERT(chunk.ColumnCount() == varchar_chunk.ColumnCount());
-		// for text format cast to varchar first
-		for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-			CastToPostgresVarchar(context, chunk.data[c], varchar_chunk.data[c], chunk.size());
+		if (state.postgres_types.empty()) {
+			CastChunkToPostgresVarchar(context, chunk, varchar_chunk);
+		} else {
+			CastChunkToPostgresVarchar(context, chunk, varchar_chunk, &state.postgres_types);
 		}
-		varchar_chunk.SetCardinality(chunk.size());
 
 		PostgresTextWriter writer;
-		for (idx_t r = 0; r < chunk.size(); r++) {
-			for (idx_t c = 0; c < chunk.ColumnCount(); c++) {
-				if (c > 0) {
-					writer.WriteSeparator();
-				}
-				D_ASSERT(varchar_chunk.data[c].GetType().id() == LogicalTypeId::VARCHAR);
-				auto &col = varchar_chunk.data[c];
-				writer.WriteValue(col, r);
-			}
-			writer.FinishRow();
-		}
+		writer.WriteChunk(varchar_chunk);
 		CopyData(writer);
 	}
 }
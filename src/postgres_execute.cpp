@@ -46,6 +46,9 @@ static void PGExecuteFunction(ClientContext &context, TableFunctionInput &data_p
 	}
 	auto &transaction = Transaction::Get(context, data.pg_catalog).Cast<PostgresTransaction>();
 	transaction.ExecuteQueries(data.query);
+	// the query might have modified any table - or changed the result columns of queries
+	data.pg_catalog.GetResultCache().Clear();
+	data.pg_catalog.ClearQueryDescriptions();
 	data.finished = true;
 }
 
@@ -5,6 +5,7 @@
 #include "postgres_storage.hpp"
 #include "postgres_scanner_extension.hpp"
 #include "postgres_binary_copy.hpp"
+#include "postgres_extension_state.hpp"
 
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
@@ -13,6 +14,7 @@
 #include "duckdb/main/attached_database.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_optimizer.hpp"
+#include "storage/postgres_runtime_filter.hpp"
 #include "duckdb/planner/extension_callback.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_context_state.hpp"
@@ -21,39 +23,17 @@
 
 using namespace duckdb;
 
-class PostgresExtensionState : public ClientContextState {
-public:
-	bool CanRequestRebind() override {
-		return true;
-	}
-	RebindQueryInfo OnPlanningError(ClientContext &context, SQLStatement &statement, ErrorData &error) override {
-		if (error.Type() != ExceptionType::BINDER) {
-			return RebindQueryInfo::DO_NOT_REBIND;
-		}
-		auto &extra_info = error.ExtraInfo();
-		auto entry = extra_info.find("error_subtype");
-		if (entry == extra_info.end()) {
-			return RebindQueryInfo::DO_NOT_REBIND;
-		}
-		if (entry->second != "COLUMN_NOT_FOUND") {
-			return RebindQueryInfo::DO_NOT_REBIND;
-		}
-		// clear caches and rebind
-		PostgresClearCacheFunction::ClearPostgresCaches(context);
-		return RebindQueryInfo::ATTEMPT_TO_REBIND;
-	}
-};
-
 class PostgresExtensionCallback : public ExtensionCallback {
 public:
 	void OnConnectionOpened(ClientContext &context) override {
-		context.registered_state.insert(make_pair("postgres_extension", make_shared<PostgresExtensionState>()));
+		PostgresExtensionState::Register(context);
 	}
 };
 
-static void SetPostgresConnectionLimit(ClientContext &context, SetScope scope, Value &parameter) {
+static void SetPostgresPoolOption(ClientContext &context, SetScope scope, Value &parameter, const string &name,
+                                  void (PostgresConnectionPool::*set_option)(idx_t)) {
 	if (scope == SetScope::LOCAL) {
-		throw InvalidInputException("pg_connection_limit can only be set globally");
+		throw InvalidInputException("%s can only be set globally", name);
 	}
 	auto databases = DatabaseManager::Get(context).GetDatabases(context);
 	for (auto &db_ref : databases) {
@@ -62,16 +42,44 @@ static void SetPostgresConnectionLimit(ClientContext &context, SetScope scope, V
 		if (catalog.GetCatalogType() != "postgres") {
 			continue;
 		}
-		catalog.Cast<PostgresCatalog>().GetConnectionPool().SetMaximumConnections(UBigIntValue::Get(parameter));
+		auto &postgres_catalog = catalog.Cast<PostgresCatalog>();
+		auto &pool = postgres_catalog.GetConnectionPool();
+		(pool.*set_option)(UBigIntValue::Get(parameter));
+		for (auto &replica_pool : postgres_catalog.GetReplicaPools()) {
+			(replica_pool.get()->*set_option)(UBigIntValue::Get(parameter));
+		}
 	}
 	auto &config = DBConfig::GetConfig(context);
-	config.SetOption("pg_connection_limit", parameter);
+	config.SetOption(name, parameter);
+}
+
+static void SetPostgresConnectionLimit(ClientContext &context, SetScope scope, Value &parameter) {
+	SetPostgresPoolOption(context, scope, parameter, "pg_connection_limit",
+	                      &PostgresConnectionPool::SetMaximumConnections);
+}
+
+static void SetPostgresPoolMinIdleConnections(ClientContext &context, SetScope scope, Value &parameter) {
+	SetPostgresPoolOption(context, scope, parameter, "pg_pool_min_idle_connections",
+	                      &PostgresConnectionPool::SetMinimumIdleConnections);
+}
+
+static void SetPostgresPoolIdleTimeout(ClientContext &context, SetScope scope, Value &parameter) {
+	SetPostgresPoolOption(context, scope, parameter, "pg_pool_idle_timeout", &PostgresConnectionPool::SetIdleTimeout);
+}
+
+static void SetPostgresPoolMaxLifetime(ClientContext &context, SetScope scope, Value &parameter) {
+	SetPostgresPoolOption(context, scope, parameter, "pg_pool_max_lifetime",
+	                      &PostgresConnectionPool::SetMaximumLifetime);
 }
 
 static void SetPostgresDebugQueryPrint(ClientContext &context, SetScope scope, Value &parameter) {
 	PostgresConnection::DebugSetPrintQueries(BooleanValue::Get(parameter));
 }
 
+static void SetPostgresPreparedStatementCacheSize(ClientContext &context, SetScope scope, Value &parameter) {
+	PostgresConnection::SetPreparedStatementCacheSize(UBigIntValue::Get(parameter));
+}
+
 static void LoadInternal(DatabaseInstance &db) {
 	PostgresScanFunction postgres_fun;
 	ExtensionUtil::RegisterFunction(db, postgres_fun);
@@ -91,9 +99,24 @@ static void LoadInternal(DatabaseInstance &db) {
 	PostgresExecuteFunction execute_func;
 	ExtensionUtil::RegisterFunction(db, execute_func);
 
+	PostgresLookupFunction lookup_func;
+	ExtensionUtil::RegisterFunction(db, lookup_func);
+
+	PostgresMirrorFunction mirror_func;
+	ExtensionUtil::RegisterFunction(db, mirror_func);
+
+	PostgresConnectionPoolInfoFunction pool_info_func;
+	ExtensionUtil::RegisterFunction(db, pool_info_func);
+
+	PostgresScanStatsFunction scan_stats_func;
+	ExtensionUtil::RegisterFunction(db, scan_stats_func);
+
 	PostgresBinaryCopyFunction binary_copy;
 	ExtensionUtil::RegisterFunction(db, binary_copy);
 
+	PostgresBinaryReadFunction binary_read;
+	ExtensionUtil::RegisterFunction(db, binary_read);
+
 	auto &config = DBConfig::GetConfig(db);
 	config.storage_extensions["postgres_scanner"] = make_uniq<PostgresStorageExtension>();
 
@@ -103,17 +126,181 @@ static void LoadInternal(DatabaseInstance &db) {
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
 	config.AddExtensionOption("pg_pages_per_task", "The amount of pages per task", LogicalType::UBIGINT,
 	                          Value::UBIGINT(PostgresBindData::DEFAULT_PAGES_PER_TASK));
+	config.AddExtensionOption("pg_task_target_ms",
+	                          "The target duration of a scan task in milliseconds - if set, the amount of pages per task "
+	                          "is adapted to the throughput of the scan (pg_pages_per_task is the initial maximum)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0));
+	config.AddExtensionOption("pg_scan_statistics",
+	                          "Whether or not to collect statistics of Postgres scans (shown by postgres_scan_stats())",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_use_cursor_scan",
+	                          "Whether or not to read data through a cursor (DECLARE/FETCH) with binary results instead "
+	                          "of COPY - for servers or roles that do not support COPY",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_cursor_fetch_size", "The amount of rows fetched at a time when using cursor scans",
+	                          LogicalType::UBIGINT, Value::UBIGINT(PostgresBindData::DEFAULT_CURSOR_FETCH_SIZE));
 	config.AddExtensionOption("pg_connection_limit", "The maximum amount of concurrent Postgres connections",
 	                          LogicalType::UBIGINT, Value::UBIGINT(PostgresConnectionPool::DEFAULT_MAX_CONNECTIONS),
 	                          SetPostgresConnectionLimit);
+	config.AddExtensionOption("pg_replica_max_lag_ms",
+	                          "The maximum replication lag in milliseconds of a read replica that scans are sent to - "
+	                          "if all replicas lag further behind the scan uses the primary (0 to not check the lag)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(10000));
+	config.AddExtensionOption("pg_scan_connection_sharing",
+	                          "Whether or not concurrent scans share the connection slots fairly - connections freed by "
+	                          "a scan go to the scan with the most remaining work per connection",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_pool_min_idle_connections",
+	                          "The minimum amount of idle Postgres connections that are kept open in the background",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0), SetPostgresPoolMinIdleConnections);
+	config.AddExtensionOption("pg_pool_idle_timeout",
+	                          "Close cached Postgres connections that have been idle for this many seconds (0 to disable)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0), SetPostgresPoolIdleTimeout);
+	config.AddExtensionOption("pg_pool_max_lifetime",
+	                          "Close Postgres connections that have been open for this many seconds (0 to disable)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0), SetPostgresPoolMaxLifetime);
 	config.AddExtensionOption(
 	    "pg_array_as_varchar", "Read Postgres arrays as varchar - enables reading mixed dimensional arrays",
 	    LogicalType::BOOLEAN, Value::BOOLEAN(false), PostgresClearCacheFunction::ClearCacheOnSetting);
+	config.AddExtensionOption("pg_lazy_catalog_loading",
+	                          "Whether or not to only load the names of the tables of attached databases up-front, and "
+	                          "load the columns of a table when it is first used",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false),
+	                          PostgresClearCacheFunction::ClearCacheOnSetting);
+	config.AddExtensionOption("pg_catalog_load_threads",
+	                          "The amount of connections over which the catalog of an attached database is loaded, and "
+	                          "of threads that build the table entries (1 to load the catalog sequentially)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(1));
+	config.AddExtensionOption("pg_catalog_cache_directory",
+	                          "Directory in which the catalogs of attached databases are cached across restarts "
+	                          "(empty to disable). Cached catalogs are validated against a fingerprint of the system catalogs",
+	                          LogicalType::VARCHAR, Value(""));
 	config.AddExtensionOption("pg_connection_cache", "Whether or not to use the connection cache", LogicalType::BOOLEAN,
 	                          Value::BOOLEAN(true), PostgresConnectionPool::PostgresSetConnectionCache);
 	config.AddExtensionOption("pg_experimental_filter_pushdown",
-	                          "Whether or not to use filter pushdown (currently experimental)", LogicalType::BOOLEAN,
-	                          Value::BOOLEAN(false));
+	                          "Whether or not to push filters of scans over attached tables into the queries sent to "
+	                          "Postgres",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_aggregate_pushdown",
+	                          "Whether or not to run aggregates (and GROUP BY) over attached tables in Postgres",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_aggregate_pushdown_min_rows",
+	                          "The estimated amount of rows a table needs to have for aggregates over the table to be "
+	                          "run in Postgres",
+	                          LogicalType::UBIGINT, Value::UBIGINT(PostgresOptimizer::DEFAULT_AGGREGATE_PUSHDOWN_ROWS));
+	config.AddExtensionOption("pg_join_pushdown",
+	                          "Whether or not to run joins between tables of the same attached Postgres database in "
+	                          "Postgres when Postgres estimates that this reduces the amount of transferred data - the "
+	                          "estimates are obtained with an EXPLAIN of each candidate join while planning",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_limit_pushdown",
+	                          "Whether or not to push LIMIT and ORDER BY ... LIMIT over attached tables into the queries "
+	                          "sent to Postgres",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_json_extract_pushdown",
+	                          "Whether or not to extract the keys of JSON and JSONB columns that are projected with ->> "
+	                          "in Postgres, so that only the keys are transferred instead of the whole documents",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_late_materialization",
+	                          "Whether or not to scan attached tables in two phases below filters that are evaluated "
+	                          "in DuckDB: first the filtered columns, then the wide columns of the matching rows by "
+	                          "ctid",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_late_materialization_max_rows",
+	                          "The maximum amount of ctids of matching rows that are sent to Postgres - beyond this "
+	                          "the wide columns are fetched for the range of the ctids",
+	                          LogicalType::UBIGINT,
+	                          Value::UBIGINT(PostgresOptimizer::DEFAULT_LATE_MATERIALIZATION_ROWS));
+	config.AddExtensionOption("pg_runtime_filter_pushdown",
+	                          "Whether or not to filter scans over attached tables on the join keys of the build side "
+	                          "of hash joins, once the build side has been computed - the build side is materialized "
+	                          "while its keys are collected",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_runtime_filter_max_keys",
+	                          "The maximum amount of distinct join keys that are sent to Postgres - beyond this the "
+	                          "scan is filtered on the range of the join keys",
+	                          LogicalType::UBIGINT, Value::UBIGINT(PostgresRuntimeFilter::DEFAULT_MAX_KEYS));
+	config.AddExtensionOption("pg_parallel_insert",
+	                          "Whether or not to insert data in parallel using a separate connection per thread (outside "
+	                          "of explicit transactions, and only if preserve_insertion_order is disabled). Data "
+	                          "inserted by other connections is committed independently of the insert - if the insert "
+	                          "fails, the rows of the other threads remain",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_parallel_encoding",
+	                          "Whether or not the threads of an insert encode their rows in parallel, and only send them "
+	                          "over the transaction connection one at a time (only if preserve_insertion_order is "
+	                          "disabled)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_bulk_load",
+	                          "Whether or not CREATE TABLE AS loads the data in parallel into an UNLOGGED staging "
+	                          "table, which replaces the target table (SET LOGGED + RENAME) when the load has finished "
+	                          "(outside of explicit transactions)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_async_copy_prefetch",
+	                          "Whether or not to receive COPY data in a background thread while decoding",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_scan_thread_affinity",
+	                          "Whether or not to pin the threads of a scan to the CPUs of a NUMA node - the threads are "
+	                          "distributed over the nodes round-robin (Linux only)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_index_range_scan",
+	                          "Whether or not to split a scan with a selective filter on the leading column of a btree "
+	                          "index into ranges of that column (instead of ctid ranges), so every task can use the index",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_citus_shard_scan",
+	                          "Whether or not to read the shards of a distributed Citus table from the worker nodes "
+	                          "directly instead of through the coordinator (outside of explicit transactions only)",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_brin_pruning",
+	                          "Whether or not to skip the pages of a table that the BRIN (minmax) indexes of the table "
+	                          "rule out for the filters of a scan - requires the pageinspect extension and a superuser",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_reuse_scan_connections",
+	                          "Whether or not the connections of the threads of a parallel scan are kept open in the "
+	                          "snapshot of the transaction, so that the later scans of the transaction can reuse them",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption("pg_copy_lookahead",
+	                          "Whether or not to send the COPY of the next task of a scan as soon as the current one has "
+	                          "been received, so that the query runs in Postgres while the last rows are processed",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_copy_arena_buffers",
+	                          "Whether or not to copy received rows straight from the receive buffer of the connection "
+	                          "into large reusable buffers, instead of allocating a buffer per row",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_copy_compression_function",
+	                          "The server-side function used to receive scans compressed - the function receives the "
+	                          "query and returns its binary COPY output as zlib-compressed bytea values (see "
+	                          "scripts/postgres_compressed_copy.sql). Empty to receive scans uncompressed",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption("pg_zero_copy_strings",
+	                          "Whether or not to reference VARCHAR and BLOB values directly in the received COPY buffers",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_dictionary_strings",
+	                          "Whether or not to emit low-cardinality VARCHAR columns as dictionary vectors - a batch "
+	                          "with too many distinct values is emitted as a flat vector",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(false));
+	config.AddExtensionOption("pg_scan_memory_limit",
+	                          "The size in bytes of the received rows the scans of the database should hold at once (0 "
+	                          "to disable). This is a soft limit - scans pause reading for up to a second once it is "
+	                          "exceeded. The held rows count toward the memory_limit, which is enforced",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0));
+	config.AddExtensionOption("pg_result_cache_size",
+	                          "The maximum size in bytes of the cache of scan results of attached Postgres tables (0 "
+	                          "to disable). Results are only cached for scans outside of explicit transactions, and can "
+	                          "be stale for up to pg_result_cache_ttl seconds",
+	                          LogicalType::UBIGINT, Value::UBIGINT(0));
+	config.AddExtensionOption("pg_result_cache_ttl",
+	                          "Expire cached scan results after this many seconds (0 to disable the result cache). "
+	                          "Modifications by other connections are detected on a best-effort basis only, through "
+	                          "the asynchronously updated table statistics",
+	                          LogicalType::UBIGINT, Value::UBIGINT(60));
+	config.AddExtensionOption("pg_prepared_statement_cache_size",
+	                          "The maximum amount of statements (e.g. catalog lookups) that are prepared per Postgres "
+	                          "connection and reused across executions (0 to disable). Not supported behind poolers that "
+	                          "switch server connections between transactions (e.g. PgBouncer in transaction mode)",
+	                          LogicalType::UBIGINT,
+	                          Value::UBIGINT(PostgresConnection::DEFAULT_PREPARED_STATEMENT_CACHE_SIZE),
+	                          SetPostgresPreparedStatementCacheSize);
 	config.AddExtensionOption("pg_debug_show_queries", "DEBUG SETTING: print all queries sent to Postgres to stdout",
 	                          LogicalType::BOOLEAN, Value::BOOLEAN(false), SetPostgresDebugQueryPrint);
 
@@ -123,7 +310,7 @@ static void LoadInternal(DatabaseInstance &db) {
 
 	config.extension_callbacks.push_back(make_uniq<PostgresExtensionCallback>());
 	for (auto &connection : ConnectionManager::Get(db).GetConnectionList()) {
-		connection->registered_state.insert(make_pair("postgres_extension", make_shared<PostgresExtensionState>()));
+		PostgresExtensionState::Register(*connection);
 	}
 }
 
@@ -0,0 +1,88 @@
+#include "postgres_extension_state.hpp"
+#include "duckdb/common/error_data.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "storage/postgres_catalog.hpp"
+
+namespace duckdb {
+
+void PostgresExtensionState::Register(ClientContext &context) {
+	context.registered_state.insert(make_pair(STATE_NAME, make_shared<PostgresExtensionState>()));
+}
+
+optional_ptr<PostgresExtensionState> PostgresExtensionState::Get(ClientContext &context) {
+	auto entry = context.registered_state.find(STATE_NAME);
+	if (entry == context.registered_state.end()) {
+		return nullptr;
+	}
+	return &static_cast<PostgresExtensionState &>(*entry->second);
+}
+
+void PostgresExtensionState::AddBoundTable(const string &catalog_name, const string &schema_name,
+                                           const string &table_name) {
+	lock_guard<mutex> guard(lock);
+	bound_tables.push_back(BoundTable {catalog_name, schema_name, table_name});
+}
+
+void PostgresExtensionState::AddScanStatistics(shared_ptr<PostgresScanStatistics> statistics) {
+	lock_guard<mutex> guard(lock);
+	statistics->scan_id = next_scan_id++;
+	if (scan_statistics.size() >= MAX_SCAN_STATISTICS) {
+		scan_statistics.erase(scan_statistics.begin());
+	}
+	scan_statistics.push_back(std::move(statistics));
+}
+
+vector<shared_ptr<PostgresScanStatistics>> PostgresExtensionState::GetScanStatistics() {
+	lock_guard<mutex> guard(lock);
+	return vector<shared_ptr<PostgresScanStatistics>>(scan_statistics.rbegin(), scan_statistics.rend());
+}
+
+void PostgresExtensionState::QueryBegin(ClientContext &context) {
+	lock_guard<mutex> guard(lock);
+	bound_tables.clear();
+}
+
+RebindQueryInfo PostgresExtensionState::OnPlanningError(ClientContext &context, SQLStatement &statement,
+                                                        ErrorData &error) {
+	if (error.Type() != ExceptionType::BINDER) {
+		return RebindQueryInfo::DO_NOT_REBIND;
+	}
+	auto &extra_info = error.ExtraInfo();
+	auto entry = extra_info.find("error_subtype");
+	if (entry == extra_info.end()) {
+		return RebindQueryInfo::DO_NOT_REBIND;
+	}
+	if (entry->second != "COLUMN_NOT_FOUND") {
+		return RebindQueryInfo::DO_NOT_REBIND;
+	}
+	vector<BoundTable> tables;
+	{
+		lock_guard<mutex> guard(lock);
+		tables = std::move(bound_tables);
+		bound_tables.clear();
+	}
+	// only the Postgres tables that were bound by the failing query can have stale columns - reload only those
+	// entries instead of clearing the catalogs of all attached databases
+	bool cleared_entries = false;
+	for (auto &table : tables) {
+		auto db = DatabaseManager::Get(context).GetDatabase(context, table.catalog_name);
+		if (!db) {
+			continue;
+		}
+		auto &catalog = db->GetCatalog();
+		if (catalog.GetCatalogType() != "postgres") {
+			continue;
+		}
+		catalog.Cast<PostgresCatalog>().ClearTableCache(context, table.schema_name, table.table_name);
+		cleared_entries = true;
+	}
+	if (!cleared_entries) {
+		// the column is not missing from a Postgres table - rebinding would not change anything
+		return RebindQueryInfo::DO_NOT_REBIND;
+	}
+	return RebindQueryInfo::ATTEMPT_TO_REBIND;
+}
+
+} // namespace duckdb
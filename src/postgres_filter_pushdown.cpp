@@ -2,14 +2,17 @@
 #include "duckdb/parser/keyword_helper.hpp"
 #include "duckdb/planner/filter/struct_filter.hpp"
 #include "duckdb/common/enum_util.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/planner/expression/list.hpp"
 
 namespace duckdb {
 
-string PostgresFilterPushdown::CreateExpression(string &column_name, vector<unique_ptr<TableFilter>> &filters,
-                                                string op) {
+string PostgresFilterPushdown::CreateExpression(string &column_name, const PostgresType &postgres_type,
+                                                vector<unique_ptr<TableFilter>> &filters, string op) {
 	vector<string> filter_entries;
 	for (auto &filter : filters) {
-		filter_entries.push_back(TransformFilter(column_name, *filter));
+		filter_entries.push_back(TransformFilter(column_name, postgres_type, *filter));
 	}
 	return "(" + StringUtil::Join(filter_entries, " " + op + " ") + ")";
 }
@@ -33,7 +36,107 @@ string PostgresFilterPushdown::TransformComparision(ExpressionType type) {
 	}
 }
 
-string PostgresFilterPushdown::TransformFilter(string &column_name, TableFilter &filter) {
+string PostgresFilterPushdown::TransformConstant(const Value &constant) {
+	if (constant.IsNull()) {
+		return "NULL";
+	}
+	// constants are rendered as literals of the matching Postgres type - untyped literals are resolved by Postgres
+	// based on the other side of the comparison, which can lead to a different interpretation of the value
+	auto &type = constant.type();
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+		return BooleanValue::Get(constant) ? "TRUE" : "FALSE";
+	case LogicalTypeId::TINYINT:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::UTINYINT:
+	case LogicalTypeId::USMALLINT:
+	case LogicalTypeId::UINTEGER:
+		// integer literals - Postgres picks int4 or int8 which can be compared with all integer types in an index
+		return "(" + constant.ToString() + ")";
+	case LogicalTypeId::UBIGINT:
+	case LogicalTypeId::HUGEINT:
+	case LogicalTypeId::UHUGEINT:
+	case LogicalTypeId::DECIMAL:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::NUMERIC";
+	case LogicalTypeId::FLOAT:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::REAL";
+	case LogicalTypeId::DOUBLE:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::DOUBLE PRECISION";
+	case LogicalTypeId::DATE:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::DATE";
+	case LogicalTypeId::TIME:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::TIME";
+	case LogicalTypeId::TIME_TZ:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::TIMETZ";
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_MS:
+	case LogicalTypeId::TIMESTAMP_NS:
+	case LogicalTypeId::TIMESTAMP_SEC:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::TIMESTAMP";
+	case LogicalTypeId::TIMESTAMP_TZ:
+		// the string representation of a TIMESTAMP WITH TIME ZONE value includes the (UTC) offset
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::TIMESTAMPTZ";
+	case LogicalTypeId::INTERVAL:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::INTERVAL";
+	case LogicalTypeId::UUID:
+		return KeywordHelper::WriteQuoted(constant.ToString()) + "::UUID";
+	case LogicalTypeId::BLOB: {
+		// use the hex format - the escaped format of DuckDB is not understood by Postgres
+		auto &str = StringValue::Get(constant);
+		string result = "'\\x";
+		for (auto c : str) {
+			result += StringUtil::Format("%02x", static_cast<uint8_t>(c));
+		}
+		result += "'::BYTEA";
+		return result;
+	}
+	default:
+		// strings (and everything else) are rendered as untyped literals - so that the literal takes the type of
+		// the column, which allows Postgres to use indexes on e.g. VARCHAR(N) or enum columns
+		return KeywordHelper::WriteQuoted(constant.ToString());
+	}
+}
+
+//! Range comparisons of strings in DuckDB are byte-wise, while Postgres uses the collation of the column - unless the
+//! column already uses the C collation, the comparison is done in the C collation (which prevents the use of indexes)
+static string GetCollation(ExpressionType comparison_type, const LogicalType &type, bool byte_order) {
+	if (type.id() != LogicalTypeId::VARCHAR || byte_order) {
+		return string();
+	}
+	switch (comparison_type) {
+	case ExpressionType::COMPARE_LESSTHAN:
+	case ExpressionType::COMPARE_GREATERTHAN:
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		return " COLLATE \"C\"";
+	default:
+		return string();
+	}
+}
+
+string PostgresFilterPushdown::TransformColumn(const string &column_name, const PostgresType &postgres_type) {
+	// filters have to be evaluated on the values as they are read by DuckDB
+	switch (postgres_type.info) {
+	case PostgresTypeAnnotation::CAST_TO_VARCHAR:
+		return column_name + "::VARCHAR";
+	case PostgresTypeAnnotation::NUMERIC_AS_DOUBLE:
+		return column_name + "::DOUBLE PRECISION";
+	case PostgresTypeAnnotation::FIXED_LENGTH_CHAR:
+		// the cast to TEXT removes the trailing spaces
+	case PostgresTypeAnnotation::JSONB:
+	case PostgresTypeAnnotation::MACADDR:
+	case PostgresTypeAnnotation::MACADDR8:
+	case PostgresTypeAnnotation::INET:
+		return column_name + "::TEXT";
+	default:
+		return column_name;
+	}
+}
+
+string PostgresFilterPushdown::TransformFilter(string &column_name, const PostgresType &postgres_type,
+                                               TableFilter &filter) {
 	switch (filter.filter_type) {
 	case TableFilterType::IS_NULL:
 		return column_name + " IS NULL";
@@ -41,31 +144,557 @@ string PostgresFilterPushdown::TransformFilter(string &column_name, TableFilter
 		return column_name + " IS NOT NULL";
 	case TableFilterType::CONJUNCTION_AND: {
 		auto &conjunction_filter = (ConjunctionAndFilter &)filter;
-		return CreateExpression(column_name, conjunction_filter.child_filters, "AND");
+		return CreateExpression(column_name, postgres_type, conjunction_filter.child_filters, "AND");
 	}
 	case TableFilterType::CONJUNCTION_OR: {
 		auto &conjunction_filter = (ConjunctionAndFilter &)filter;
-		return CreateExpression(column_name, conjunction_filter.child_filters, "OR");
+		return CreateExpression(column_name, postgres_type, conjunction_filter.child_filters, "OR");
 	}
 	case TableFilterType::CONSTANT_COMPARISON: {
 		auto &constant_filter = (ConstantFilter &)filter;
-		auto constant_string = KeywordHelper::WriteQuoted(constant_filter.constant.ToString());
-		auto operator_string = TransformComparision(constant_filter.comparison_type);
-		return StringUtil::Format("%s %s %s", column_name, operator_string, constant_string);
+		auto column = TransformColumn(column_name, postgres_type);
+		auto constant = constant_filter.constant;
+		auto comparison_type = constant_filter.comparison_type;
+		if (constant.type().id() == LogicalTypeId::TIMESTAMP_NS && !constant.IsNull()) {
+			// Postgres rounds a literal to microseconds, which is the precision of its timestamps - a constant in
+			// between two microseconds is truncated, and the comparison adjusted so that it matches the same values
+			auto nanos = constant.GetValueUnsafe<int64_t>();
+			auto remainder = nanos % Interval::NANOS_PER_MICRO;
+			if (remainder != 0) {
+				auto micros = nanos / Interval::NANOS_PER_MICRO - (remainder < 0 ? 1 : 0);
+				constant = Value::TIMESTAMP(timestamp_t(micros));
+				switch (comparison_type) {
+				case ExpressionType::COMPARE_EQUAL:
+					return "FALSE";
+				case ExpressionType::COMPARE_NOTEQUAL:
+					return column + " IS NOT NULL";
+				case ExpressionType::COMPARE_GREATERTHAN:
+				case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+					comparison_type = ExpressionType::COMPARE_GREATERTHAN;
+					break;
+				default:
+					comparison_type = ExpressionType::COMPARE_LESSTHANOREQUALTO;
+					break;
+				}
+			}
+		}
+		auto constant_string = TransformConstant(constant);
+		auto operator_string = TransformComparision(comparison_type);
+		// a column that is cast has the default collation
+		auto byte_order =
+		    postgres_type.byte_order_collation && postgres_type.info == PostgresTypeAnnotation::STANDARD;
+		auto collation = GetCollation(comparison_type, constant.type(), byte_order);
+		return StringUtil::Format("%s %s %s%s", column, operator_string, constant_string, collation);
 	}
 	case TableFilterType::STRUCT_EXTRACT: {
 		auto &struct_filter = filter.Cast<StructFilter>();
-		auto child_name = KeywordHelper::WriteQuoted(struct_filter.child_name, '\"');
-		auto new_name = "(" + column_name + ")." + child_name;
-		return TransformFilter(new_name, *struct_filter.child_filter);
+		PostgresType child_type;
+		if (struct_filter.child_idx < postgres_type.children.size()) {
+			child_type = postgres_type.children[struct_filter.child_idx];
+		}
+		string new_name;
+		if (postgres_type.info == PostgresTypeAnnotation::GEOM_POINT) {
+			// the coordinates of a point are accessed using subscripts
+			new_name = StringUtil::Format("(%s)[%llu]", column_name, struct_filter.child_idx);
+		} else {
+			auto child_name = KeywordHelper::WriteQuoted(struct_filter.child_name, '\"');
+			new_name = "(" + column_name + ")." + child_name;
+		}
+		return TransformFilter(new_name, child_type, *struct_filter.child_filter);
 	}
 	default:
 		throw InternalException("Unsupported table filter type");
 	}
 }
 
+static bool IsPushdownType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::BOOLEAN:
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+	case LogicalTypeId::FLOAT:
+	case LogicalTypeId::DOUBLE:
+	case LogicalTypeId::DECIMAL:
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::DATE:
+	case LogicalTypeId::TIMESTAMP:
+	case LogicalTypeId::TIMESTAMP_TZ:
+	case LogicalTypeId::UUID:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool IsDateOrTimestamp(const LogicalType &type) {
+	return type.id() == LogicalTypeId::DATE || type.id() == LogicalTypeId::TIMESTAMP;
+}
+
+//! Returns the name of the part of a date_trunc or date_part call in Postgres, or an empty string if the part is
+//! not supported (or behaves differently in Postgres)
+static string GetPostgresDatePart(const string &part, bool truncate) {
+	static const case_insensitive_map_t<string> extract_parts {
+	    {"year", "year"},   {"month", "month"},     {"day", "day"},         {"dayofmonth", "day"},
+	    {"quarter", "quarter"}, {"decade", "decade"}, {"hour", "hour"},     {"minute", "minute"},
+	    {"week", "week"},   {"weekofyear", "week"}, {"dow", "dow"},         {"dayofweek", "dow"},
+	    {"isodow", "isodow"}, {"doy", "doy"},       {"dayofyear", "doy"},   {"isoyear", "isoyear"}};
+	static const case_insensitive_map_t<string> truncate_parts {
+	    {"year", "year"}, {"quarter", "quarter"}, {"month", "month"},   {"week", "week"},
+	    {"day", "day"},   {"hour", "hour"},       {"minute", "minute"}, {"second", "second"}};
+	auto &parts = truncate ? truncate_parts : extract_parts;
+	auto entry = parts.find(part);
+	if (entry == parts.end()) {
+		return string();
+	}
+	return entry->second;
+}
+
+//! Escape the wildcards of a string that is used in a LIKE pattern with ESCAPE '!'
+static string EscapeLikePattern(const string &str) {
+	string result;
+	for (auto c : str) {
+		if (c == '!' || c == '%' || c == '_') {
+			result += '!';
+		}
+		result += c;
+	}
+	return result;
+}
+
+bool PostgresFilterPushdown::TryTransformFunction(const Expression &expr, const PostgresPushdownColumns &columns,
+                                                  string &result) {
+	auto &func = expr.Cast<BoundFunctionExpression>();
+	auto &name = func.function.name;
+	auto &children = func.children;
+	vector<string> args;
+	for (auto &child : children) {
+		string arg;
+		if (!TryTransformExpression(*child, columns, arg)) {
+			return false;
+		}
+		args.push_back(std::move(arg));
+	}
+	// DuckDB has no default escape character in LIKE - while Postgres uses the backslash
+	if (name == "~~" || name == "!~~" || name == "~~*" || name == "!~~*") {
+		if (args.size() != 2) {
+			return false;
+		}
+		auto negated = name[0] == '!';
+		auto op = name.back() == '*' ? "ILIKE" : "LIKE";
+		result = StringUtil::Format("(%s %s%s %s ESCAPE '')", args[0], negated ? "NOT " : "", op, args[1]);
+		return true;
+	}
+	if (name == "like_escape" || name == "not_like_escape" || name == "ilike_escape" || name == "not_ilike_escape") {
+		if (args.size() != 3) {
+			return false;
+		}
+		auto negated = StringUtil::StartsWith(name, "not_");
+		auto op = StringUtil::Contains(name, "ilike") ? "ILIKE" : "LIKE";
+		result = StringUtil::Format("(%s %s%s %s ESCAPE %s)", args[0], negated ? "NOT " : "", op, args[1], args[2]);
+		return true;
+	}
+	// the optimizer rewrites LIKE 'abc%', LIKE '%abc' and LIKE '%abc%' - turn them back into LIKE so that
+	// Postgres can use (prefix) indexes
+	if (name == "prefix" || name == "starts_with" || name == "suffix" || name == "ends_with" || name == "contains") {
+		if (args.size() != 2 || children[1]->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return false;
+		}
+		auto &constant = children[1]->Cast<BoundConstantExpression>().value;
+		if (constant.IsNull() || constant.type().id() != LogicalTypeId::VARCHAR) {
+			return false;
+		}
+		auto pattern = EscapeLikePattern(StringValue::Get(constant));
+		auto match_start = name == "prefix" || name == "starts_with";
+		auto match_end = name == "suffix" || name == "ends_with";
+		if (!match_start) {
+			pattern = "%" + pattern;
+		}
+		if (!match_end) {
+			pattern += "%";
+		}
+		result = StringUtil::Format("(%s LIKE %s ESCAPE '!')", args[0], TransformConstant(Value(pattern)));
+		return true;
+	}
+	// date_trunc and date_part are evaluated on timestamps without time zone - the result of these functions on
+	// a TIMESTAMP WITH TIME ZONE depends on the time zone setting, which can differ between DuckDB and Postgres
+	if (name == "date_trunc" || name == "datetrunc" || name == "date_part" || name == "datepart") {
+		if (args.size() != 2 || children[0]->GetExpressionClass() != ExpressionClass::BOUND_CONSTANT ||
+		    !IsDateOrTimestamp(children[1]->return_type)) {
+			return false;
+		}
+		auto &constant = children[0]->Cast<BoundConstantExpression>().value;
+		if (constant.IsNull() || constant.type().id() != LogicalTypeId::VARCHAR) {
+			return false;
+		}
+		auto truncate = StringUtil::Contains(name, "trunc");
+		auto part = GetPostgresDatePart(StringValue::Get(constant), truncate);
+		if (part.empty()) {
+			return false;
+		}
+		if (truncate) {
+			result = StringUtil::Format("date_trunc('%s', (%s)::TIMESTAMP)", part, args[1]);
+			if (expr.return_type.id() == LogicalTypeId::DATE) {
+				result = "(" + result + ")::DATE";
+			}
+		} else {
+			result = StringUtil::Format("EXTRACT(%s FROM (%s)::TIMESTAMP)::BIGINT", part, args[1]);
+		}
+		return true;
+	}
+	// year(x), month(x), ...
+	if (args.size() == 1 && IsDateOrTimestamp(children[0]->return_type) &&
+	    expr.return_type.id() == LogicalTypeId::BIGINT) {
+		auto part = GetPostgresDatePart(name, false);
+		if (part.empty()) {
+			return false;
+		}
+		result = StringUtil::Format("EXTRACT(%s FROM (%s)::TIMESTAMP)::BIGINT", part, args[0]);
+		return true;
+	}
+	return false;
+}
+
+bool PostgresFilterPushdown::TryTransformCast(const Expression &expr, const PostgresPushdownColumns &columns,
+                                              string &result) {
+	auto &cast = expr.Cast<BoundCastExpression>();
+	if (cast.try_cast) {
+		return false;
+	}
+	// only push down the widening casts the binder inserts for comparisons between different types
+	auto &source = cast.child->return_type;
+	auto &target = cast.return_type;
+	string target_name;
+	switch (source.id()) {
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		switch (target.id()) {
+		case LogicalTypeId::INTEGER:
+			if (source.id() == LogicalTypeId::BIGINT) {
+				return false;
+			}
+			target_name = "INTEGER";
+			break;
+		case LogicalTypeId::BIGINT:
+			target_name = "BIGINT";
+			break;
+		case LogicalTypeId::DOUBLE:
+			target_name = "DOUBLE PRECISION";
+			break;
+		case LogicalTypeId::DECIMAL:
+			target_name =
+			    StringUtil::Format("NUMERIC(%d,%d)", DecimalType::GetWidth(target), DecimalType::GetScale(target));
+			break;
+		default:
+			return false;
+		}
+		break;
+	case LogicalTypeId::FLOAT:
+		if (target.id() != LogicalTypeId::DOUBLE) {
+			return false;
+		}
+		target_name = "DOUBLE PRECISION";
+		break;
+	case LogicalTypeId::DATE:
+		if (target.id() != LogicalTypeId::TIMESTAMP) {
+			return false;
+		}
+		target_name = "TIMESTAMP";
+		break;
+	default:
+		return false;
+	}
+	string child;
+	if (!TryTransformExpression(*cast.child, columns, child)) {
+		return false;
+	}
+	result = StringUtil::Format("(%s)::%s", child, target_name);
+	return true;
+}
+
+//! Whether or not the expression is a column of the scan with the C collation
+static bool IsByteOrderColumn(const Expression &expr, const PostgresPushdownColumns &columns) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &colref = expr.Cast<BoundColumnRefExpression>();
+	if (colref.depth > 0 || colref.binding.table_index != columns.table_index ||
+	    colref.binding.column_index >= columns.column_ids.size()) {
+		return false;
+	}
+	auto column_id = columns.column_ids[colref.binding.column_index];
+	return column_id != COLUMN_IDENTIFIER_ROW_ID && columns.postgres_types[column_id].byte_order_collation;
+}
+
+//! Whether or not Postgres compares the two operands in the C collation - one of them is a column with the C
+//! collation, and the other one is either a constant (which takes on the collation of the column) or also such a column
+static bool HasByteOrderCollation(const Expression &left, const Expression &right,
+                                  const PostgresPushdownColumns &columns) {
+	auto left_column = IsByteOrderColumn(left, columns);
+	auto right_column = IsByteOrderColumn(right, columns);
+	auto left_constant = left.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT;
+	auto right_constant = right.GetExpressionClass() == ExpressionClass::BOUND_CONSTANT;
+	return (left_column && (right_column || right_constant)) || (left_constant && right_column);
+}
+
+bool PostgresFilterPushdown::TryTransformComparison(ExpressionType type, const LogicalType &input_type,
+                                                    const string &left, const string &right, string &result,
+                                                    bool byte_order) {
+	string op;
+	switch (type) {
+	case ExpressionType::COMPARE_EQUAL:
+	case ExpressionType::COMPARE_NOTEQUAL:
+	case ExpressionType::COMPARE_LESSTHAN:
+	case ExpressionType::COMPARE_GREATERTHAN:
+	case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+	case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+		op = TransformComparision(type);
+		break;
+	case ExpressionType::COMPARE_DISTINCT_FROM:
+		op = "IS DISTINCT FROM";
+		break;
+	case ExpressionType::COMPARE_NOT_DISTINCT_FROM:
+		op = "IS NOT DISTINCT FROM";
+		break;
+	default:
+		return false;
+	}
+	auto collation = GetCollation(type, input_type, byte_order);
+	result = StringUtil::Format("(%s %s %s%s)", left, op, right, collation);
+	return true;
+}
+
+bool PostgresFilterPushdown::TryTransformExpression(const Expression &expr, const PostgresPushdownColumns &columns,
+                                                    string &result) {
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COLUMN_REF: {
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		if (colref.depth > 0 || colref.binding.table_index != columns.table_index ||
+		    colref.binding.column_index >= columns.column_ids.size()) {
+			return false;
+		}
+		auto column_id = columns.column_ids[colref.binding.column_index];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			return false;
+		}
+		// columns that are converted while reading them (e.g. cast to VARCHAR) compare differently in Postgres
+		if (columns.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD ||
+		    !IsPushdownType(colref.return_type)) {
+			return false;
+		}
+		result = KeywordHelper::WriteQuoted(columns.names[column_id], '"');
+		if (!columns.column_aliases.empty()) {
+			result = columns.column_aliases[column_id] + "." + result;
+		} else if (!columns.alias.empty()) {
+			result = columns.alias + "." + result;
+		}
+		return true;
+	}
+	case ExpressionClass::BOUND_CONSTANT: {
+		auto &constant = expr.Cast<BoundConstantExpression>().value;
+		if (!IsPushdownType(constant.type())) {
+			return false;
+		}
+		result = TransformConstant(constant);
+		return true;
+	}
+	case ExpressionClass::BOUND_COMPARISON: {
+		auto &comparison = expr.Cast<BoundComparisonExpression>();
+		string left, right;
+		if (!TryTransformExpression(*comparison.left, columns, left) ||
+		    !TryTransformExpression(*comparison.right, columns, right)) {
+			return false;
+		}
+		return TryTransformComparison(comparison.type, comparison.left->return_type, left, right, result,
+		                              HasByteOrderCollation(*comparison.left, *comparison.right, columns));
+	}
+	case ExpressionClass::BOUND_CONJUNCTION: {
+		auto &conjunction = expr.Cast<BoundConjunctionExpression>();
+		auto op = conjunction.type == ExpressionType::CONJUNCTION_AND ? " AND " : " OR ";
+		vector<string> children;
+		for (auto &child : conjunction.children) {
+			string child_str;
+			if (!TryTransformExpression(*child, columns, child_str)) {
+				return false;
+			}
+			children.push_back(std::move(child_str));
+		}
+		result = "(" + StringUtil::Join(children, op) + ")";
+		return true;
+	}
+	case ExpressionClass::BOUND_OPERATOR: {
+		auto &op = expr.Cast<BoundOperatorExpression>();
+		vector<string> children;
+		for (auto &child : op.children) {
+			string child_str;
+			if (!TryTransformExpression(*child, columns, child_str)) {
+				return false;
+			}
+			children.push_back(std::move(child_str));
+		}
+		switch (op.type) {
+		case ExpressionType::OPERATOR_IS_NULL:
+			result = "(" + children[0] + " IS NULL)";
+			return true;
+		case ExpressionType::OPERATOR_IS_NOT_NULL:
+			result = "(" + children[0] + " IS NOT NULL)";
+			return true;
+		case ExpressionType::OPERATOR_NOT:
+			result = "(NOT " + children[0] + ")";
+			return true;
+		case ExpressionType::COMPARE_IN:
+		case ExpressionType::COMPARE_NOT_IN: {
+			auto input = std::move(children[0]);
+			children.erase(children.begin());
+			auto op_str = op.type == ExpressionType::COMPARE_IN ? "IN" : "NOT IN";
+			result = StringUtil::Format("(%s %s (%s))", input, op_str, StringUtil::Join(children, ", "));
+			return true;
+		}
+		default:
+			return false;
+		}
+	}
+	case ExpressionClass::BOUND_BETWEEN: {
+		auto &between = expr.Cast<BoundBetweenExpression>();
+		string input, lower, upper;
+		if (!TryTransformExpression(*between.input, columns, input) ||
+		    !TryTransformExpression(*between.lower, columns, lower) ||
+		    !TryTransformExpression(*between.upper, columns, upper)) {
+			return false;
+		}
+		auto lower_collation = GetCollation(ExpressionType::COMPARE_LESSTHAN, between.input->return_type,
+		                                    HasByteOrderCollation(*between.input, *between.lower, columns));
+		auto upper_collation = GetCollation(ExpressionType::COMPARE_LESSTHAN, between.input->return_type,
+		                                    HasByteOrderCollation(*between.input, *between.upper, columns));
+		result = StringUtil::Format("(%s %s %s%s AND %s %s %s%s)", input, between.lower_inclusive ? ">=" : ">",
+		                            lower, lower_collation, input, between.upper_inclusive ? "<=" : "<", upper,
+		                            upper_collation);
+		return true;
+	}
+	case ExpressionClass::BOUND_FUNCTION:
+		return TryTransformFunction(expr, columns, result);
+	case ExpressionClass::BOUND_CAST:
+		return TryTransformCast(expr, columns, result);
+	default:
+		return false;
+	}
+}
+
+bool PostgresFilterPushdown::TryTransformAggregate(const Expression &expr, const PostgresPushdownColumns &columns,
+                                                   string &result, LogicalType &result_type) {
+	if (expr.GetExpressionClass() != ExpressionClass::BOUND_AGGREGATE) {
+		return false;
+	}
+	auto &aggr = expr.Cast<BoundAggregateExpression>();
+	if (aggr.filter || (aggr.order_bys && !aggr.order_bys->orders.empty())) {
+		return false;
+	}
+	auto &name = aggr.function.name;
+	if (name == "count_star") {
+		result = "count(*)";
+		result_type = LogicalType::BIGINT;
+		return true;
+	}
+	if (aggr.children.size() != 1) {
+		return false;
+	}
+	string arg;
+	if (!TryTransformExpression(*aggr.children[0], columns, arg)) {
+		return false;
+	}
+	auto distinct = aggr.IsDistinct() ? "DISTINCT " : "";
+	auto &input_type = aggr.children[0]->return_type;
+	if (name == "count") {
+		result = StringUtil::Format("count(%s%s)", distinct, arg);
+		result_type = LogicalType::BIGINT;
+		return true;
+	}
+	if (name == "sum" || name == "sum_no_overflow") {
+		switch (input_type.id()) {
+		case LogicalTypeId::SMALLINT:
+		case LogicalTypeId::INTEGER:
+			result = StringUtil::Format("sum(%s%s)", distinct, arg);
+			result_type = LogicalType::BIGINT;
+			return true;
+		case LogicalTypeId::BIGINT:
+			result = StringUtil::Format("sum(%s%s)::NUMERIC(38,0)", distinct, arg);
+			result_type = LogicalType::DECIMAL(38, 0);
+			return true;
+		case LogicalTypeId::DECIMAL: {
+			auto scale = DecimalType::GetScale(input_type);
+			result = StringUtil::Format("sum(%s%s)::NUMERIC(38,%d)", distinct, arg, scale);
+			result_type = LogicalType::DECIMAL(38, scale);
+			return true;
+		}
+		case LogicalTypeId::FLOAT:
+		case LogicalTypeId::DOUBLE:
+			result = StringUtil::Format("sum(%s(%s)::DOUBLE PRECISION)", distinct, arg);
+			result_type = LogicalType::DOUBLE;
+			return true;
+		default:
+			return false;
+		}
+	}
+	if (name == "avg") {
+		switch (input_type.id()) {
+		case LogicalTypeId::SMALLINT:
+		case LogicalTypeId::INTEGER:
+		case LogicalTypeId::BIGINT:
+		case LogicalTypeId::DECIMAL:
+		case LogicalTypeId::FLOAT:
+		case LogicalTypeId::DOUBLE:
+			result = StringUtil::Format("avg(%s%s)::DOUBLE PRECISION", distinct, arg);
+			result_type = LogicalType::DOUBLE;
+			return true;
+		default:
+			return false;
+		}
+	}
+	if (name == "min" || name == "max") {
+		switch (input_type.id()) {
+		case LogicalTypeId::SMALLINT:
+		case LogicalTypeId::INTEGER:
+		case LogicalTypeId::BIGINT:
+		case LogicalTypeId::FLOAT:
+		case LogicalTypeId::DOUBLE:
+		case LogicalTypeId::DATE:
+		case LogicalTypeId::TIMESTAMP:
+		case LogicalTypeId::TIMESTAMP_TZ:
+			result = StringUtil::Format("%s(%s)", name, arg);
+			break;
+		case LogicalTypeId::DECIMAL:
+			// the result is read with the scale of the value - make sure it matches the scale of the column
+			result = StringUtil::Format("%s(%s)::NUMERIC(%d,%d)", name, arg, DecimalType::GetWidth(input_type),
+			                            DecimalType::GetScale(input_type));
+			break;
+		case LogicalTypeId::VARCHAR:
+			if (IsByteOrderColumn(*aggr.children[0], columns)) {
+				result = StringUtil::Format("%s(%s)", name, arg);
+			} else {
+				result = StringUtil::Format("%s(%s COLLATE \"C\")", name, arg);
+			}
+			break;
+		default:
+			return false;
+		}
+		result_type = input_type;
+		return true;
+	}
+	if (name == "bool_and" || name == "bool_or") {
+		if (input_type.id() != LogicalTypeId::BOOLEAN) {
+			return false;
+		}
+		result = StringUtil::Format("%s(%s)", name, arg);
+		result_type = LogicalType::BOOLEAN;
+		return true;
+	}
+	return false;
+}
+
 string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_ids,
-                                                optional_ptr<TableFilterSet> filters, const vector<string> &names) {
+                                                optional_ptr<TableFilterSet> filters, const vector<string> &names,
+                                                const vector<PostgresType> &postgres_types) {
 	if (!filters || filters->filters.empty()) {
 		// no filters
 		return string();
@@ -75,10 +704,11 @@ string PostgresFilterPushdown::TransformFilters(const vector<column_t> &column_i
 		if (!result.empty()) {
 			result += " AND ";
 		}
-		auto column_name = KeywordHelper::WriteQuoted(names[column_ids[entry.first]], '"');
+		auto column_id = column_ids[entry.first];
+		auto column_name = KeywordHelper::WriteQuoted(names[column_id], '"');
 		auto &filter = *entry.second;
 
-		result += TransformFilter(column_name, filter);
+		result += TransformFilter(column_name, postgres_types[column_id], filter);
 	}
 	return result;
 }
@@ -0,0 +1,167 @@
+#include "postgres_index_ranges.hpp"
+#include "postgres_brin_pruning.hpp"
+#include "postgres_filter_pushdown.hpp"
+#include "postgres_scanner.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "duckdb/planner/filter/conjunction_filter.hpp"
+#include "duckdb/planner/table_filter.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+
+namespace duckdb {
+
+//! A filtered column that leads a btree index - and the histogram bounds of the column
+struct PostgresIndexKey {
+	column_t column_id;
+	reference<TableFilter> filter;
+	vector<string> bounds;
+};
+
+//! Whether or not a filter only consists of comparisons with constants - i.e. it never selects NULL values
+static bool IsComparisonFilter(TableFilter &filter) {
+	switch (filter.filter_type) {
+	case TableFilterType::CONSTANT_COMPARISON:
+		return true;
+	case TableFilterType::CONJUNCTION_AND: {
+		auto &conjunction_filter = (ConjunctionAndFilter &)filter;
+		for (auto &child : conjunction_filter.child_filters) {
+			if (!IsComparisonFilter(*child)) {
+				return false;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+//! The buckets of the histogram that can hold values matching the filter - bucket 0 holds the values below the first
+//! bound, bucket i the values in [bounds[i - 1], bounds[i]) and the last bucket the values from the last bound
+//! The outer buckets are always kept, as the histogram does not tell how far they extend
+static vector<idx_t> GetMatchingBuckets(const PostgresBindData &bind_data, PostgresIndexKey &key) {
+	auto bucket_count = key.bounds.size() + 1;
+	vector<idx_t> result;
+	auto &type = bind_data.types[key.column_id];
+	vector<Value> bounds;
+	if (type.id() != LogicalTypeId::ENUM && type.id() != LogicalTypeId::UUID &&
+	    BaseStatistics::CreateEmpty(type).GetStatsType() == StatisticsType::NUMERIC_STATS) {
+		for (auto &bound : key.bounds) {
+			Value value(bound);
+			if (!value.DefaultTryCastAs(type)) {
+				bounds.clear();
+				break;
+			}
+			bounds.push_back(std::move(value));
+		}
+	}
+	for (idx_t bucket = 0; bucket < bucket_count; bucket++) {
+		if (bucket == 0 || bucket + 1 == bucket_count || bounds.empty() ||
+		    PostgresBrinPruning::FilterMightMatch(key.filter.get(), type, bounds[bucket - 1], bounds[bucket], false)) {
+			result.push_back(bucket);
+		}
+	}
+	return result;
+}
+
+vector<string> PostgresIndexRanges::GetKeyRanges(PostgresConnection &connection, const PostgresBindData &bind_data,
+                                                 const vector<column_t> &column_ids, TableFilterSet &filters,
+                                                 idx_t max_ranges) {
+	vector<string> result;
+	if (max_ranges == 0 || bind_data.approx_num_rows <= 0) {
+		return result;
+	}
+	// the filtered columns that are read as-is - and whose filters never select NULL values, so that the ranges do
+	// not have to include NULL keys
+	unordered_map<string, PostgresIndexKey> keys;
+	vector<string> key_names;
+	for (auto &entry : filters.filters) {
+		auto column_id = column_ids[entry.first];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID ||
+		    (column_id < bind_data.column_expressions.size() && !bind_data.column_expressions[column_id].empty())) {
+			continue;
+		}
+		auto info = bind_data.postgres_types[column_id].info;
+		if ((info != PostgresTypeAnnotation::STANDARD && info != PostgresTypeAnnotation::NUMERIC_AS_DOUBLE) ||
+		    !IsComparisonFilter(*entry.second)) {
+			continue;
+		}
+		auto &name = bind_data.names[column_id];
+		keys.emplace(name, PostgresIndexKey {column_id, *entry.second, vector<string>()});
+		key_names.push_back(KeywordHelper::WriteQuoted(name, '\''));
+	}
+	if (keys.empty()) {
+		return result;
+	}
+	auto table_name = KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+	                  KeywordHelper::WriteQuoted(bind_data.table_name, '"');
+	// an index scan only pays off if the filters select a small part of the table
+	auto filter_sql = PostgresFilterPushdown::TransformFilters(column_ids, &filters, bind_data.names,
+	                                                           bind_data.postgres_types);
+	double rows, width;
+	if (filter_sql.empty() ||
+	    !connection.TryGetQueryEstimate("SELECT 1 FROM " + table_name + " WHERE " + filter_sql, rows, width) ||
+	    rows > bind_data.approx_num_rows * MAX_SELECTIVITY) {
+		return result;
+	}
+	// the histogram bounds of the columns that lead a btree index (without predicate)
+	auto bounds = connection.TryQuery(StringUtil::Format(
+	    R"(
+SELECT DISTINCT ON (a.attname, b.position) a.attname, b.bound
+FROM pg_index i
+JOIN pg_class ic ON ic.oid = i.indexrelid
+JOIN pg_am am ON am.oid = ic.relam
+JOIN pg_attribute a ON a.attrelid = i.indrelid AND a.attnum = i.indkey[0]
+JOIN pg_stats s ON s.schemaname = %s AND s.tablename = %s AND s.attname = a.attname AND NOT s.inherited
+CROSS JOIN LATERAL unnest(s.histogram_bounds::TEXT::TEXT[]) WITH ORDINALITY AS b(bound, position)
+WHERE i.indrelid = %s::regclass AND am.amname = 'btree' AND i.indpred IS NULL AND a.attname IN (%s)
+ORDER BY a.attname, b.position
+)",
+	    KeywordHelper::WriteQuoted(bind_data.schema_name, '\''), KeywordHelper::WriteQuoted(bind_data.table_name, '\''),
+	    KeywordHelper::WriteQuoted(table_name, '\''), StringUtil::Join(key_names, ", ")));
+	if (!bounds || bounds->Count() == 0) {
+		return result;
+	}
+	for (idx_t row = 0; row < bounds->Count(); row++) {
+		keys.find(bounds->GetString(row, 0))->second.bounds.push_back(bounds->GetString(row, 1));
+	}
+	// split on the key for which the histogram rules out the largest fraction of the buckets
+	optional_ptr<PostgresIndexKey> split_key;
+	vector<idx_t> split_buckets;
+	double split_fraction = 2;
+	for (auto &entry : keys) {
+		auto &key = entry.second;
+		if (key.bounds.empty()) {
+			continue;
+		}
+		auto buckets = GetMatchingBuckets(bind_data, key);
+		auto fraction = double(buckets.size()) / double(key.bounds.size() + 1);
+		if (fraction < split_fraction) {
+			split_key = &key;
+			split_buckets = std::move(buckets);
+			split_fraction = fraction;
+		}
+	}
+	if (!split_key) {
+		return result;
+	}
+	// every range covers a consecutive run of the matching buckets - the buckets in between that cannot match are
+	// excluded by the filters themselves, Postgres intersects the bounds of the range with those of the filters
+	auto column_name = KeywordHelper::WriteQuoted(bind_data.names[split_key->column_id], '"');
+	auto &key_bounds = split_key->bounds;
+	auto range_count = MinValue<idx_t>(max_ranges, split_buckets.size());
+	for (idx_t range = 0; range < range_count; range++) {
+		auto first_bucket = split_buckets[range * split_buckets.size() / range_count];
+		auto last_bucket = split_buckets[(range + 1) * split_buckets.size() / range_count - 1];
+		vector<string> conditions;
+		if (first_bucket > 0) {
+			conditions.push_back(column_name + " >= " + KeywordHelper::WriteQuoted(key_bounds[first_bucket - 1], '\''));
+		}
+		if (last_bucket < key_bounds.size()) {
+			conditions.push_back(column_name + " < " + KeywordHelper::WriteQuoted(key_bounds[last_bucket], '\''));
+		}
+		result.push_back(conditions.empty() ? "TRUE" : StringUtil::Join(conditions, " AND "));
+	}
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,251 @@
+#include "duckdb.hpp"
+
+#include "duckdb/parser/qualified_name.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "postgres_scanner.hpp"
+#include "postgres_binary_reader.hpp"
+#include "postgres_binary_decoder.hpp"
+#include "storage/postgres_catalog.hpp"
+#include "storage/postgres_table_entry.hpp"
+#include "storage/postgres_transaction.hpp"
+
+namespace duckdb {
+
+struct PostgresLookupGlobalState : public GlobalTableFunctionState {
+	mutex lock;
+	//! The connection of the transaction - shared by all threads (under the lock) unless parallel is set
+	PostgresConnection connection;
+	//! The snapshot of the transaction - imported by the connections of the other threads
+	string snapshot;
+	//! Whether or not the lookups of different threads run on separate connections
+	bool parallel = false;
+	bool used_main_connection = false;
+
+	idx_t MaxThreads() const override {
+		return parallel ? GlobalTableFunctionState::MAX_THREADS : 1;
+	}
+};
+
+struct PostgresLookupLocalState : public LocalTableFunctionState {
+	PostgresPoolConnection pool_connection;
+	PostgresConnection connection;
+	//! Whether or not the connection is the connection of the transaction that is shared with other threads
+	bool shared_connection = false;
+	vector<PostgresColumnDecoder> decoders;
+	vector<PostgresColumnFields> fields;
+	DataChunk key_chunk;
+	DataChunk varchar_chunk;
+	//! The rows that match the keys of the current input chunk - and the next row of those to emit
+	shared_ptr<PostgresResult> result;
+	idx_t result_row = 0;
+};
+
+static unique_ptr<FunctionData> PGLookupBind(ClientContext &context, TableFunctionBindInput &input,
+                                             vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<PostgresLookupBindData>();
+	for (idx_t i = 0; i < 3; i++) {
+		if (input.inputs[i].IsNull()) {
+			throw BinderException("Parameters to postgres_lookup cannot be NULL");
+		}
+	}
+	if (input.input_table_types.empty()) {
+		throw BinderException("postgres_lookup requires a table with the keys to look up as last parameter");
+	}
+
+	// look up the database to query
+	auto db_name = input.inputs[0].GetValue<string>();
+	auto &db_manager = DatabaseManager::Get(context);
+	auto db = db_manager.GetDatabase(context, db_name);
+	if (!db) {
+		throw BinderException("Failed to find attached database \"%s\" referenced in postgres_lookup", db_name);
+	}
+	auto &catalog = db->GetCatalog();
+	if (catalog.GetCatalogType() != "postgres") {
+		throw BinderException("Attached database \"%s\" does not refer to a Postgres database", db_name);
+	}
+	auto &pg_catalog = catalog.Cast<PostgresCatalog>();
+	auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
+
+	// look up the table and the key column
+	auto qualified_name = QualifiedName::Parse(input.inputs[1].GetValue<string>());
+	if (qualified_name.schema == INVALID_SCHEMA) {
+		qualified_name.schema = DEFAULT_SCHEMA;
+	}
+	auto &entry = catalog.GetEntry(context, CatalogType::TABLE_ENTRY, qualified_name.schema, qualified_name.name);
+	if (entry.type != CatalogType::TABLE_ENTRY) {
+		throw BinderException("postgres_lookup: \"%s\" is not a table", qualified_name.name);
+	}
+	auto &table = entry.Cast<PostgresTableEntry>();
+	auto key_name = input.inputs[2].GetValue<string>();
+	auto &columns = table.GetColumns();
+	if (!columns.ColumnExists(key_name)) {
+		throw BinderException("postgres_lookup: table \"%s\" does not have a column named \"%s\"", table.name,
+		                      key_name);
+	}
+	auto key_index = columns.GetColumn(key_name).Logical().index;
+
+	result->schema_name = table.schema.name;
+	result->table_name = table.name;
+	result->names = table.postgres_names;
+	result->postgres_types = table.postgres_types;
+	for (auto &col : columns.Logical()) {
+		result->types.push_back(col.GetType());
+		return_types.push_back(col.GetType());
+		names.push_back(col.GetName());
+	}
+	result->read_only = transaction.IsReadOnly();
+	result->SetCatalog(pg_catalog);
+
+	// the keys are sent as a textual array that is cast to an array of the type of the key column
+	auto table_name = KeywordHelper::WriteQuoted(result->schema_name, '"') + "." +
+	                  KeywordHelper::WriteQuoted(result->table_name, '"');
+	auto key_column = KeywordHelper::WriteQuoted(result->names[key_index], '"');
+	auto type_result =
+	    transaction.QueryWithParameters("SELECT format_type(atttypid, atttypmod) FROM pg_attribute WHERE "
+	                                    "attrelid=$1::text::regclass AND attname=$2::name",
+	                                    {Value(table_name), Value(result->names[key_index])});
+	if (type_result->Count() != 1) {
+		throw BinderException("postgres_lookup: failed to find the type of column \"%s\"", key_name);
+	}
+	vector<string> select_list;
+	for (auto &name : result->names) {
+		select_list.push_back(KeywordHelper::WriteQuoted(name, '"'));
+	}
+	result->sql = StringUtil::Format("SELECT %s FROM %s WHERE %s = ANY($1::%s[])", StringUtil::Join(select_list, ", "),
+	                                 table_name, key_column, type_result->GetString(0, 0));
+	return std::move(result);
+}
+
+static unique_ptr<GlobalTableFunctionState> PGLookupInitGlobalState(ClientContext &context,
+                                                                    TableFunctionInitInput &input) {
+	auto &bind_data = input.bind_data->Cast<PostgresLookupBindData>();
+	auto &pg_catalog = *bind_data.GetCatalog();
+	auto &transaction = Transaction::Get(context, pg_catalog).Cast<PostgresTransaction>();
+	auto result = make_uniq<PostgresLookupGlobalState>();
+	result->connection = PostgresConnection(transaction.GetConnection().GetConnection());
+	if (bind_data.read_only && pg_catalog.GetPostgresVersion().type_v != PostgresInstanceType::AURORA) {
+		// the other threads look up their keys over pooled connections that share the snapshot of the transaction
+		result->snapshot = transaction.GetScanSnapshot(pg_catalog.GetPostgresVersion());
+		result->parallel = !result->snapshot.empty();
+	}
+	return std::move(result);
+}
+
+static unique_ptr<LocalTableFunctionState> PGLookupInitLocalState(ExecutionContext &context,
+                                                                  TableFunctionInitInput &input,
+                                                                  GlobalTableFunctionState *global_state) {
+	auto &bind_data = input.bind_data->Cast<PostgresLookupBindData>();
+	auto &gstate = global_state->Cast<PostgresLookupGlobalState>();
+	auto result = make_uniq<PostgresLookupLocalState>();
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		if (!gstate.parallel || !gstate.used_main_connection) {
+			result->connection = PostgresConnection(gstate.connection.GetConnection());
+			result->shared_connection = !gstate.parallel;
+			gstate.used_main_connection = true;
+		}
+	}
+	if (!result->connection.IsOpen()) {
+		result->pool_connection = bind_data.GetCatalog()->GetConnectionPool().ForceGetConnection();
+		result->connection = PostgresConnection(result->pool_connection.GetConnection().GetConnection());
+		result->connection.ExecuteQueries(StringUtil::Format(
+		    "BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY;\nSET TRANSACTION SNAPSHOT '%s'",
+		    gstate.snapshot));
+	}
+	for (idx_t c = 0; c < bind_data.types.size(); c++) {
+		result->decoders.push_back(
+		    PostgresColumnDecoder::Create(bind_data.types[c], bind_data.postgres_types[c], false));
+	}
+	result->fields.resize(bind_data.types.size());
+	return std::move(result);
+}
+
+//! Render the keys of the input as a Postgres array literal - NULL keys never match and are skipped
+static string GetKeyArray(ClientContext &context, PostgresLookupLocalState &lstate, DataChunk &input) {
+	if (lstate.key_chunk.ColumnCount() == 0) {
+		lstate.key_chunk.InitializeEmpty({input.data[0].GetType()});
+	}
+	lstate.key_chunk.data[0].Reference(input.data[0]);
+	lstate.key_chunk.SetCardinality(input.size());
+	PostgresConnection::CastChunkToPostgresVarchar(context, lstate.key_chunk, lstate.varchar_chunk);
+
+	auto &keys = lstate.varchar_chunk.data[0];
+	UnifiedVectorFormat format;
+	keys.ToUnifiedFormat(input.size(), format);
+	auto data = UnifiedVectorFormat::GetData<string_t>(format);
+	string result;
+	for (idx_t i = 0; i < input.size(); i++) {
+		auto idx = format.sel->get_index(i);
+		if (!format.validity.RowIsValid(idx)) {
+			continue;
+		}
+		result += result.empty() ? "{\"" : ",\"";
+		auto key = data[idx].GetString();
+		for (auto c : key) {
+			if (c == '"' || c == '\\') {
+				result += '\\';
+			}
+			result += c;
+		}
+		result += "\"";
+	}
+	if (!result.empty()) {
+		result += "}";
+	}
+	return result;
+}
+
+static OperatorResultType PGLookupFunction(ExecutionContext &context, TableFunctionInput &data_p, DataChunk &input,
+                                           DataChunk &output) {
+	auto &bind_data = data_p.bind_data->Cast<PostgresLookupBindData>();
+	auto &gstate = data_p.global_state->Cast<PostgresLookupGlobalState>();
+	auto &lstate = data_p.local_state->Cast<PostgresLookupLocalState>();
+	if (!lstate.result) {
+		// look up the keys of a new input chunk
+		auto keys = GetKeyArray(context.client, lstate, input);
+		if (keys.empty()) {
+			return OperatorResultType::NEED_MORE_INPUT;
+		}
+		unique_lock<mutex> guard(gstate.lock, std::defer_lock);
+		if (lstate.shared_connection) {
+			guard.lock();
+		}
+		lstate.result = lstate.connection.QueryBinaryWithParameters(bind_data.sql, {Value(keys)});
+		lstate.result_row = 0;
+	}
+	// emit (at most a vector of) the matching rows
+	PostgresBinaryReader reader(lstate.connection);
+	idx_t output_offset = 0;
+	auto row_count = lstate.result->Count();
+	while (output_offset < STANDARD_VECTOR_SIZE && lstate.result_row < row_count) {
+		reader.ReadResultFields(lstate.result, lstate.result_row++, lstate.fields, output_offset);
+		output_offset++;
+	}
+	buffer_ptr<VectorBuffer> row_buffers;
+	for (idx_t c = 0; c < output.ColumnCount(); c++) {
+		auto &decoder = lstate.decoders[c];
+		decoder.Decode(reader, lstate.fields[c], output_offset, output.data[c]);
+		if (decoder.references_row_buffers) {
+			if (!row_buffers) {
+				row_buffers = reader.TakeRows();
+			}
+			StringVector::AddBuffer(output.data[c], row_buffers);
+		}
+	}
+	output.SetCardinality(output_offset);
+	if (lstate.result_row < row_count) {
+		return OperatorResultType::HAVE_MORE_OUTPUT;
+	}
+	lstate.result.reset();
+	return OperatorResultType::NEED_MORE_INPUT;
+}
+
+PostgresLookupFunction::PostgresLookupFunction()
+    : TableFunction("postgres_lookup", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR,
+                                        LogicalType::TABLE},
+                    nullptr, PGLookupBind, PGLookupInitGlobalState, PGLookupInitLocalState) {
+	in_out_function = PGLookupFunction;
+}
+
+} // namespace duckdb
@@ -0,0 +1,90 @@
+#include "postgres_memory_budget.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+shared_ptr<PostgresMemoryBudget> PostgresMemoryBudget::Get(ClientContext &context) {
+	Value memory_limit;
+	if (!context.TryGetCurrentSetting("pg_scan_memory_limit", memory_limit) || memory_limit.IsNull() ||
+	    UBigIntValue::Get(memory_limit) == 0) {
+		return nullptr;
+	}
+	auto budget = ObjectCache::GetObjectCache(context).GetOrCreate<PostgresMemoryBudget>(CACHE_KEY);
+	budget->limit = UBigIntValue::Get(memory_limit);
+	return budget;
+}
+
+void PostgresMemoryBudget::Throttle() {
+	std::unique_lock<mutex> guard(lock);
+	released.wait_for(guard, std::chrono::milliseconds(MAX_THROTTLE_MS), [&] { return used < limit; });
+}
+
+bool PostgresMemoryBudget::Exhausted() {
+	return used >= limit;
+}
+
+void PostgresMemoryBudget::Acquire(idx_t size) {
+	used += size;
+}
+
+void PostgresMemoryBudget::Release(idx_t size) {
+	{
+		// taking the lock ensures that a scan that just found the budget exhausted is waiting before it is woken up
+		lock_guard<mutex> guard(lock);
+		used -= size;
+	}
+	released.notify_all();
+}
+
+PostgresMemoryReservation::PostgresMemoryReservation(PostgresMemoryReservation &&other) noexcept
+    : budget(std::move(other.budget)), buffer_manager(other.buffer_manager), size(other.size) {
+	other.size = 0;
+}
+
+PostgresMemoryReservation &PostgresMemoryReservation::operator=(PostgresMemoryReservation &&other) noexcept {
+	if (this != &other) {
+		Reset();
+		budget = std::move(other.budget);
+		buffer_manager = other.buffer_manager;
+		size = other.size;
+		other.size = 0;
+	}
+	return *this;
+}
+
+void PostgresMemoryReservation::Grow(idx_t bytes) {
+	if (!buffer_manager || bytes == 0) {
+		return;
+	}
+	// reserving memory in the buffer manager evicts (or spills) other blocks if the memory_limit would be exceeded
+	buffer_manager->ReserveMemory(bytes);
+	if (budget) {
+		budget->Acquire(bytes);
+	}
+	size += bytes;
+}
+
+void PostgresMemoryReservation::Reset() {
+	if (size == 0) {
+		return;
+	}
+	buffer_manager->FreeReservedMemory(size);
+	if (budget) {
+		budget->Release(size);
+	}
+	size = 0;
+}
+
+PostgresMemoryReservation PostgresMemoryReservation::Split() {
+	PostgresMemoryReservation result;
+	result.budget = budget;
+	result.buffer_manager = buffer_manager;
+	result.size = size;
+	size = 0;
+	return result;
+}
+
+} // namespace duckdb
@@ -0,0 +1,735 @@
+#include "duckdb.hpp"
+
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/parser/qualified_name.hpp"
+#include "postgres_scanner.hpp"
+#include "postgres_binary_reader.hpp"
+#include "postgres_result.hpp"
+#include "storage/postgres_catalog.hpp"
+
+namespace duckdb {
+
+//! The maximum amount of changes that are applied in a single DuckDB transaction - the slot is advanced after each
+static constexpr const idx_t POSTGRES_MIRROR_CHANGES_PER_ROUND = 100000;
+
+struct PostgresMirrorBindData : public TableFunctionData {
+	string dsn;
+	string schema_name = "public";
+	string table_name;
+	//! The DuckDB table that (already) holds the copy of the Postgres table
+	string target_schema;
+	string target_table;
+	string slot_name;
+	string publication;
+	bool finished = false;
+};
+
+//! The name of a replication slot or publication derived from the name of the target - only lower case letters,
+//! digits and underscores are allowed in the name of a replication slot
+static string GetMirrorName(const string &target_schema, const string &target_table) {
+	auto name = StringUtil::Lower("duckdb_mirror_" + target_schema + "_" + target_table);
+	for (auto &c : name) {
+		if (!StringUtil::CharacterIsAlpha(c) && !StringUtil::CharacterIsDigit(c)) {
+			c = '_';
+		}
+	}
+	return name.substr(0, 63);
+}
+
+//! The table in the schema of the target that holds the end of the last Postgres transaction applied to each target
+static string GetMirrorProgressTable(const PostgresMirrorBindData &data) {
+	return KeywordHelper::WriteOptionallyQuoted(data.target_schema) + ".postgres_mirror_progress";
+}
+
+//! Whether or not changes can be applied to a column of the given type - the changes hold the text representation of
+//! the values, which is only converted to scalar types and (nested) lists
+static bool IsMirrorSupportedType(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::LIST:
+		return IsMirrorSupportedType(ListType::GetChildType(type));
+	case LogicalTypeId::ARRAY:
+		return IsMirrorSupportedType(ArrayType::GetChildType(type));
+	case LogicalTypeId::STRUCT:
+	case LogicalTypeId::MAP:
+	case LogicalTypeId::UNION:
+		return false;
+	default:
+		return true;
+	}
+}
+
+static unique_ptr<FunctionData> PostgresMirrorBind(ClientContext &context, TableFunctionBindInput &input,
+                                                   vector<LogicalType> &return_types, vector<string> &names) {
+	auto result = make_uniq<PostgresMirrorBindData>();
+	for (auto &input_value : input.inputs) {
+		if (input_value.IsNull()) {
+			throw BinderException("Parameters to postgres_mirror cannot be NULL");
+		}
+	}
+	// look up the database to mirror from
+	auto db_name = input.inputs[0].GetValue<string>();
+	auto &db_manager = DatabaseManager::Get(context);
+	auto db = db_manager.GetDatabase(context, db_name);
+	if (!db) {
+		throw BinderException("Failed to find attached database \"%s\" referenced in postgres_mirror", db_name);
+	}
+	auto &catalog = db->GetCatalog();
+	if (catalog.GetCatalogType() != "postgres") {
+		throw BinderException("Attached database \"%s\" does not refer to a Postgres database", db_name);
+	}
+	result->dsn = catalog.Cast<PostgresCatalog>().path;
+	result->table_name = input.inputs[1].GetValue<string>();
+
+	auto target = QualifiedName::Parse(input.inputs[2].GetValue<string>());
+	if (!target.catalog.empty()) {
+		throw BinderException("The target of postgres_mirror has to be a table in the default database");
+	}
+	result->target_schema = target.schema.empty() ? DEFAULT_SCHEMA : target.schema;
+	result->target_table = target.name;
+	if (!context.transaction.IsAutoCommit()) {
+		// the changes are applied to the target in transactions of their own
+		throw BinderException("postgres_mirror cannot be used inside a transaction");
+	}
+	auto target_entry = Catalog::GetEntry<TableCatalogEntry>(context, INVALID_CATALOG, result->target_schema,
+	                                                         result->target_table, OnEntryNotFound::RETURN_NULL);
+	if (target_entry) {
+		for (auto &column : target_entry->GetColumns().Logical()) {
+			if (!IsMirrorSupportedType(column.GetType())) {
+				throw BinderException("Cannot mirror into column \"%s\" of type %s: composite types are not supported "
+				                      "by postgres_mirror",
+				                      column.GetName(), column.GetType().ToString());
+			}
+		}
+	}
+	result->slot_name = GetMirrorName(result->target_schema, result->target_table);
+	result->publication = result->slot_name;
+	for (auto &kv : input.named_parameters) {
+		if (kv.second.IsNull()) {
+			throw BinderException("Parameters to postgres_mirror cannot be NULL");
+		}
+		if (kv.first == "schema") {
+			result->schema_name = StringValue::Get(kv.second);
+		} else if (kv.first == "slot") {
+			result->slot_name = StringValue::Get(kv.second);
+		} else if (kv.first == "publication") {
+			result->publication = StringValue::Get(kv.second);
+		}
+	}
+
+	names.emplace_back("initial_copy");
+	return_types.emplace_back(LogicalType::BOOLEAN);
+	names.emplace_back("inserted");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("updated");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("deleted");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	return std::move(result);
+}
+
+static void CheckResult(QueryResult &result) {
+	if (result.HasError()) {
+		result.ThrowError();
+	}
+}
+
+//! Open a replication connection - in which replication commands such as CREATE_REPLICATION_SLOT can be executed
+static PostgresConnection OpenReplicationConnection(const string &dsn) {
+	if (StringUtil::Contains(dsn, "://")) {
+		// a connection URI
+		auto separator = StringUtil::Contains(dsn, "?") ? "&" : "?";
+		return PostgresConnection::Open(dsn + separator + "replication=database");
+	}
+	return PostgresConnection::Open(dsn + " replication=database");
+}
+
+//! Copy the table into the target in the snapshot of a newly created replication slot - the changes the slot
+//! receives are exactly the changes that are not part of the copy. Returns the amount of copied rows
+static idx_t PostgresMirrorCopy(PostgresMirrorBindData &data, PostgresConnection &con, Connection &dcon) {
+	auto quoted_slot = KeywordHelper::WriteQuoted(data.slot_name);
+	auto slot = con.Query("SELECT 1 FROM pg_replication_slots WHERE slot_name = " + quoted_slot);
+	if (slot->Count() > 0) {
+		// the target has to be copied again - the changes the slot has received so far are part of the copy
+		con.Query("SELECT pg_drop_replication_slot(" + quoted_slot + ")");
+	}
+	auto publication = con.Query("SELECT 1 FROM pg_publication WHERE pubname = " +
+	                             KeywordHelper::WriteQuoted(data.publication));
+	if (publication->Count() == 0) {
+		con.Execute(StringUtil::Format("CREATE PUBLICATION %s FOR TABLE %s.%s",
+		                               KeywordHelper::WriteQuoted(data.publication, '"'),
+		                               KeywordHelper::WriteQuoted(data.schema_name, '"'),
+		                               KeywordHelper::WriteQuoted(data.table_name, '"')));
+	}
+	idx_t copied_rows;
+	{
+		// the exported snapshot remains valid for as long as the replication connection is open and idle
+		auto replication_con = OpenReplicationConnection(data.dsn);
+		auto create_slot = StringUtil::Format("CREATE_REPLICATION_SLOT %s LOGICAL pgoutput EXPORT_SNAPSHOT",
+		                                      KeywordHelper::WriteQuoted(data.slot_name, '"'));
+		auto result = replication_con.Query(create_slot);
+		auto snapshot = result->GetString(0, 2);
+		auto copy = dcon.Query(StringUtil::Format(
+		    "CREATE OR REPLACE TABLE %s.%s AS SELECT * FROM postgres_scan(%s, %s, %s, snapshot := %s)",
+		    KeywordHelper::WriteOptionallyQuoted(data.target_schema),
+		    KeywordHelper::WriteOptionallyQuoted(data.target_table), KeywordHelper::WriteQuoted(data.dsn),
+		    KeywordHelper::WriteQuoted(data.schema_name), KeywordHelper::WriteQuoted(data.table_name),
+		    KeywordHelper::WriteQuoted(snapshot)));
+		if (copy->HasError()) {
+			replication_con.Close();
+			// do not leave a slot behind that retains WAL for a copy that does not exist
+			con.TryQuery("SELECT pg_drop_replication_slot(" + quoted_slot + ")");
+			copy->ThrowError();
+		}
+		copied_rows = UBigIntValue::Get(copy->GetValue(0, 0).DefaultCastAs(LogicalType::UBIGINT));
+	}
+	// the progress of a previous copy does not apply to the changes of the new slot
+	auto progress_table = GetMirrorProgressTable(data);
+	if (dcon.TableInfo(data.target_schema, "postgres_mirror_progress")) {
+		CheckResult(*dcon.Query(StringUtil::Format("DELETE FROM %s WHERE target_table = %s", progress_table,
+		                                           KeywordHelper::WriteQuoted(data.target_table))));
+	}
+	return copied_rows;
+}
+
+//! Reads the messages of the pgoutput logical replication protocol (version 1)
+struct PgOutputReader {
+	PgOutputReader(const_data_ptr_t ptr_p, idx_t len) : ptr(ptr_p), end(ptr_p + len) {
+	}
+
+	const_data_ptr_t ptr;
+	const_data_ptr_t end;
+
+	template <class T>
+	T Read() {
+		if (ptr + sizeof(T) > end) {
+			throw IOException("Unable to read logical replication message from Postgres: message too short");
+		}
+		auto result = PostgresBinaryReader::LoadInteger<T>(ptr);
+		ptr += sizeof(T);
+		return result;
+	}
+	string ReadString() {
+		auto start = ptr;
+		while (ptr < end && *ptr) {
+			ptr++;
+		}
+		if (ptr >= end) {
+			throw IOException("Unable to read logical replication message from Postgres: unterminated string");
+		}
+		return string(const_char_ptr_cast(start), const_char_ptr_cast(ptr++));
+	}
+	//! Read the values of a row - unchanged (TOASTed) values are not sent, and are not set in the changed mask
+	void ReadTuple(vector<Value> &values, vector<bool> &changed) {
+		auto column_count = Read<int16_t>();
+		values.clear();
+		changed.clear();
+		for (int16_t col = 0; col < column_count; col++) {
+			auto kind = Read<uint8_t>();
+			switch (kind) {
+			case 'n':
+				values.emplace_back();
+				changed.push_back(true);
+				break;
+			case 'u':
+				values.emplace_back();
+				changed.push_back(false);
+				break;
+			case 't': {
+				auto len = Read<int32_t>();
+				if (len < 0 || ptr + len > end) {
+					throw IOException("Unable to read logical replication message from Postgres: value too long");
+				}
+				values.emplace_back(string(const_char_ptr_cast(ptr), idx_t(len)));
+				changed.push_back(true);
+				ptr += len;
+				break;
+			}
+			default:
+				throw IOException("Unable to read logical replication message from Postgres: unsupported value kind %c",
+				                  char(kind));
+			}
+		}
+	}
+};
+
+//! A column of the replicated relation - with the column of the target it is applied to
+struct PostgresMirrorColumn {
+	string name;
+	bool is_key = false;
+	//! The index of the column in the target - DConstants::INVALID_INDEX if the target does not have the column
+	idx_t target_idx = DConstants::INVALID_INDEX;
+};
+
+//! Applies the changes of the replicated table to the target
+class PostgresMirrorApplier {
+public:
+	PostgresMirrorApplier(Connection &dcon, PostgresMirrorBindData &data) : dcon(dcon), data(data) {
+		auto description = dcon.TableInfo(data.target_schema, data.target_table);
+		if (!description) {
+			throw CatalogException("Target table \"%s\" of postgres_mirror does not exist", data.target_table);
+		}
+		for (auto &column : description->columns) {
+			target_names.push_back(column.GetName());
+			target_types.push_back(column.GetType());
+		}
+		target = KeywordHelper::WriteOptionallyQuoted(data.target_schema) + "." +
+		         KeywordHelper::WriteOptionallyQuoted(data.target_table);
+	}
+
+	idx_t inserted = 0;
+	idx_t updated = 0;
+	idx_t deleted = 0;
+	//! The end of the last Postgres transaction that is part of the target - transactions that committed before it are
+	//! received again if the slot was not advanced after they were applied, and are skipped
+	uint64_t applied_lsn = 0;
+
+public:
+	void Apply(PgOutputReader &reader);
+	void Flush() {
+		if (appender) {
+			appender->Close();
+			appender.reset();
+		}
+	}
+
+private:
+	Connection &dcon;
+	PostgresMirrorBindData &data;
+	string target;
+	vector<string> target_names;
+	vector<LogicalType> target_types;
+	//! The oid of the replicated table and its columns - the relation is described before its first change
+	uint32_t relation_oid = 0;
+	bool has_relation = false;
+	vector<PostgresMirrorColumn> columns;
+	//! Appends the inserted rows - flushed before any other change is applied
+	unique_ptr<Appender> appender;
+	//! The prepared statements for the updates and deletes by their query
+	unordered_map<string, unique_ptr<PreparedStatement>> statements;
+	vector<Value> values;
+	vector<bool> changed;
+	vector<Value> old_values;
+	vector<bool> old_changed;
+	//! Whether or not the changes of the current transaction were applied already
+	bool skip_transaction = false;
+
+private:
+	void ReadRelation(PgOutputReader &reader);
+	//! Whether or not the change of the given relation has to be applied to the target
+	bool IsMirrored(uint32_t oid) {
+		return has_relation && oid == relation_oid && !skip_transaction;
+	}
+	Value ConvertValue(const Value &value, idx_t target_idx);
+	void Insert();
+	void Update(bool has_old_values, bool old_values_are_key);
+	void Delete(bool old_values_are_key);
+	//! Add the condition that selects the row identified by the given values to the where clause
+	void AddRowCondition(const vector<Value> &row, const vector<bool> &present, bool key_only, string &where_clause,
+	                     vector<Value> &parameters);
+	void Execute(const string &query, vector<Value> &parameters);
+};
+
+void PostgresMirrorApplier::ReadRelation(PgOutputReader &reader) {
+	auto oid = reader.Read<uint32_t>();
+	auto schema_name = reader.ReadString();
+	auto table_name = reader.ReadString();
+	reader.Read<uint8_t>(); // replica identity
+	if (schema_name != data.schema_name || table_name != data.table_name) {
+		// another table of the publication
+		return;
+	}
+	relation_oid = oid;
+	has_relation = true;
+	columns.clear();
+	auto column_count = reader.Read<int16_t>();
+	for (int16_t col = 0; col < column_count; col++) {
+		PostgresMirrorColumn column;
+		column.is_key = reader.Read<uint8_t>() & 1;
+		column.name = reader.ReadString();
+		reader.Read<uint32_t>(); // type oid
+		reader.Read<int32_t>();  // type modifier
+		for (idx_t target_idx = 0; target_idx < target_names.size(); target_idx++) {
+			if (StringUtil::CIEquals(target_names[target_idx], column.name)) {
+				column.target_idx = target_idx;
+				break;
+			}
+		}
+		columns.push_back(std::move(column));
+	}
+}
+
+static uint8_t GetHexValue(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	throw IOException("Unable to read logical replication message from Postgres: invalid bytea value");
+}
+
+static Value ConvertText(const string &text, const LogicalType &type);
+
+static void SkipWhitespace(const string &text, idx_t &pos) {
+	while (pos < text.size() && StringUtil::CharacterIsSpace(text[pos])) {
+		pos++;
+	}
+}
+
+//! Parse the text representation of a Postgres array - e.g. {1,NULL,"a b"} or {{1,2},{3,4}} - into a list
+static Value ParseArray(const string &text, idx_t &pos, const LogicalType &type) {
+	auto &child_type =
+	    type.id() == LogicalTypeId::ARRAY ? ArrayType::GetChildType(type) : ListType::GetChildType(type);
+	auto nested_child = child_type.id() == LogicalTypeId::LIST || child_type.id() == LogicalTypeId::ARRAY;
+	if (pos >= text.size() || text[pos] != '{') {
+		throw IOException("Unable to read logical replication message from Postgres: invalid array value");
+	}
+	pos++;
+	vector<Value> children;
+	SkipWhitespace(text, pos);
+	if (pos < text.size() && text[pos] == '}') {
+		pos++;
+		return Value::LIST(child_type, std::move(children)).DefaultCastAs(type);
+	}
+	while (true) {
+		SkipWhitespace(text, pos);
+		if (pos < text.size() && text[pos] == '{' && nested_child) {
+			children.push_back(ParseArray(text, pos, child_type));
+		} else {
+			// an element is either quoted, or ends at the next delimiter - either way backslashes escape a character
+			bool quoted = pos < text.size() && text[pos] == '"';
+			if (quoted) {
+				pos++;
+			}
+			string element;
+			while (pos < text.size()) {
+				auto c = text[pos];
+				if (quoted ? c == '"' : c == ',' || c == '}') {
+					break;
+				}
+				if (c == '\\' && pos + 1 < text.size()) {
+					c = text[++pos];
+				}
+				element += c;
+				pos++;
+			}
+			if (quoted) {
+				if (pos >= text.size()) {
+					throw IOException("Unable to read logical replication message from Postgres: invalid array value");
+				}
+				pos++;
+			} else {
+				StringUtil::RTrim(element);
+			}
+			if (!quoted && StringUtil::CIEquals(element, "NULL")) {
+				children.emplace_back(child_type);
+			} else {
+				children.push_back(ConvertText(element, child_type));
+			}
+		}
+		SkipWhitespace(text, pos);
+		if (pos >= text.size()) {
+			throw IOException("Unable to read logical replication message from Postgres: invalid array value");
+		}
+		if (text[pos++] == '}') {
+			break;
+		}
+	}
+	return Value::LIST(child_type, std::move(children)).DefaultCastAs(type);
+}
+
+static Value ConvertText(const string &text, const LogicalType &type) {
+	if (type.id() == LogicalTypeId::LIST || type.id() == LogicalTypeId::ARRAY) {
+		// arrays with other lower bounds than 1 are prefixed with their dimensions - e.g. [0:1]={1,2}
+		idx_t pos = 0;
+		if (StringUtil::StartsWith(text, "[")) {
+			auto separator = text.find('=');
+			pos = separator == string::npos ? text.size() : separator + 1;
+		}
+		return ParseArray(text, pos, type);
+	}
+	if (type.id() == LogicalTypeId::BLOB && StringUtil::StartsWith(text, "\\x")) {
+		// bytea values are sent in the hex format
+		string blob;
+		for (idx_t i = 2; i + 1 < text.size(); i += 2) {
+			blob += char(GetHexValue(text[i]) * 16 + GetHexValue(text[i + 1]));
+		}
+		return Value::BLOB_RAW(blob);
+	}
+	return Value(text).DefaultCastAs(type);
+}
+
+Value PostgresMirrorApplier::ConvertValue(const Value &value, idx_t target_idx) {
+	auto &type = target_types[target_idx];
+	if (value.IsNull()) {
+		return Value(type);
+	}
+	return ConvertText(StringValue::Get(value), type);
+}
+
+void PostgresMirrorApplier::Execute(const string &query, vector<Value> &parameters) {
+	Flush();
+	auto entry = statements.find(query);
+	if (entry == statements.end()) {
+		auto statement = dcon.Prepare(query);
+		if (statement->HasError()) {
+			statement->error.Throw();
+		}
+		entry = statements.emplace(query, std::move(statement)).first;
+	}
+	auto result = entry->second->Execute(parameters, false);
+	CheckResult(*result);
+}
+
+void PostgresMirrorApplier::Insert() {
+	if (!appender) {
+		appender = make_uniq<Appender>(dcon, data.target_schema, data.target_table);
+	}
+	vector<Value> row;
+	for (auto &type : target_types) {
+		row.emplace_back(type);
+	}
+	for (idx_t col = 0; col < columns.size() && col < values.size(); col++) {
+		auto target_idx = columns[col].target_idx;
+		if (target_idx != DConstants::INVALID_INDEX) {
+			row[target_idx] = ConvertValue(values[col], target_idx);
+		}
+	}
+	appender->BeginRow();
+	for (auto &value : row) {
+		appender->Append(value);
+	}
+	appender->EndRow();
+	inserted++;
+}
+
+void PostgresMirrorApplier::AddRowCondition(const vector<Value> &row, const vector<bool> &present, bool key_only,
+                                            string &where_clause, vector<Value> &parameters) {
+	for (idx_t col = 0; col < columns.size() && col < row.size(); col++) {
+		auto target_idx = columns[col].target_idx;
+		if (target_idx == DConstants::INVALID_INDEX || !present[col] || (key_only && !columns[col].is_key)) {
+			continue;
+		}
+		parameters.push_back(ConvertValue(row[col], target_idx));
+		where_clause += where_clause.empty() ? " WHERE " : " AND ";
+		where_clause += StringUtil::Format("%s IS NOT DISTINCT FROM $%llu",
+		                                   KeywordHelper::WriteOptionallyQuoted(target_names[target_idx]),
+		                                   parameters.size());
+	}
+	if (where_clause.empty()) {
+		throw InvalidInputException("Cannot apply a change of \"%s\" to the target of postgres_mirror: the table does "
+		                            "not have a replica identity",
+		                            data.table_name);
+	}
+}
+
+void PostgresMirrorApplier::Update(bool has_old_values, bool old_values_are_key) {
+	vector<Value> parameters;
+	string set_clause;
+	for (idx_t col = 0; col < columns.size() && col < values.size(); col++) {
+		auto target_idx = columns[col].target_idx;
+		if (target_idx == DConstants::INVALID_INDEX || !changed[col]) {
+			// unchanged TOASTed values keep their value
+			continue;
+		}
+		parameters.push_back(ConvertValue(values[col], target_idx));
+		set_clause += set_clause.empty() ? " SET " : ", ";
+		set_clause += StringUtil::Format("%s = $%llu", KeywordHelper::WriteOptionallyQuoted(target_names[target_idx]),
+		                                 parameters.size());
+	}
+	string where_clause;
+	if (has_old_values) {
+		AddRowCondition(old_values, old_changed, old_values_are_key, where_clause, parameters);
+	} else {
+		// the key did not change - the row is identified by the key columns of the new row
+		AddRowCondition(values, changed, true, where_clause, parameters);
+	}
+	if (!set_clause.empty()) {
+		Execute("UPDATE " + target + set_clause + where_clause, parameters);
+	}
+	updated++;
+}
+
+void PostgresMirrorApplier::Delete(bool old_values_are_key) {
+	vector<Value> parameters;
+	string where_clause;
+	AddRowCondition(old_values, old_changed, old_values_are_key, where_clause, parameters);
+	Execute("DELETE FROM " + target + where_clause, parameters);
+	deleted++;
+}
+
+void PostgresMirrorApplier::Apply(PgOutputReader &reader) {
+	auto message_type = reader.Read<uint8_t>();
+	switch (message_type) {
+	case 'R':
+		Flush();
+		ReadRelation(reader);
+		break;
+	case 'I': {
+		if (!IsMirrored(reader.Read<uint32_t>())) {
+			break;
+		}
+		reader.Read<uint8_t>(); // 'N'
+		reader.ReadTuple(values, changed);
+		Insert();
+		break;
+	}
+	case 'U': {
+		if (!IsMirrored(reader.Read<uint32_t>())) {
+			break;
+		}
+		bool has_old_values = false;
+		bool old_values_are_key = false;
+		auto tuple_type = reader.Read<uint8_t>();
+		if (tuple_type == 'K' || tuple_type == 'O') {
+			// the key changed (K) or the table has REPLICA IDENTITY FULL (O)
+			has_old_values = true;
+			old_values_are_key = tuple_type == 'K';
+			reader.ReadTuple(old_values, old_changed);
+			tuple_type = reader.Read<uint8_t>();
+		}
+		reader.ReadTuple(values, changed);
+		Update(has_old_values, old_values_are_key);
+		break;
+	}
+	case 'D': {
+		if (!IsMirrored(reader.Read<uint32_t>())) {
+			break;
+		}
+		auto tuple_type = reader.Read<uint8_t>();
+		reader.ReadTuple(old_values, old_changed);
+		Delete(tuple_type == 'K');
+		break;
+	}
+	case 'T': {
+		auto relation_count = reader.Read<int32_t>();
+		reader.Read<uint8_t>(); // options
+		for (int32_t i = 0; i < relation_count; i++) {
+			if (IsMirrored(reader.Read<uint32_t>())) {
+				vector<Value> parameters;
+				Execute("DELETE FROM " + target, parameters);
+			}
+		}
+		break;
+	}
+	case 'B': {
+		auto final_lsn = reader.Read<uint64_t>();
+		// a transaction that committed before the end of the last applied transaction is part of the target
+		skip_transaction = final_lsn < applied_lsn;
+		break;
+	}
+	case 'C': {
+		reader.Read<uint8_t>();  // flags
+		reader.Read<uint64_t>(); // commit lsn
+		auto end_lsn = reader.Read<uint64_t>();
+		if (!skip_transaction) {
+			applied_lsn = end_lsn;
+		}
+		skip_transaction = false;
+		break;
+	}
+	default:
+		// origin and type messages do not change the target
+		break;
+	}
+}
+
+//! Apply the changes the slot received since the previous call to the target - returns true if there were changes
+static bool PostgresMirrorApplyChanges(PostgresMirrorBindData &data, PostgresConnection &con, Connection &dcon,
+                                       PostgresMirrorApplier &applier) {
+	// the changes are peeked, and only consumed once they have been committed in DuckDB
+	auto quoted_slot = KeywordHelper::WriteQuoted(data.slot_name);
+	auto changes = con.QueryBinary(StringUtil::Format(
+	    "SELECT lsn::VARCHAR, data FROM pg_logical_slot_peek_binary_changes(%s, NULL, %llu, 'proto_version', '1', "
+	    "'publication_names', %s)",
+	    quoted_slot, POSTGRES_MIRROR_CHANGES_PER_ROUND, KeywordHelper::WriteQuoted(data.publication)));
+	auto change_count = changes->Count();
+	if (change_count == 0) {
+		return false;
+	}
+	// the changes are always made up of whole transactions - the position up to which they are applied is committed
+	// together with them
+	CheckResult(*dcon.Query("BEGIN TRANSACTION"));
+	try {
+		for (idx_t row = 0; row < change_count; row++) {
+			auto message = PQgetvalue(changes->res, row, 1);
+			PgOutputReader reader(const_data_ptr_cast(message), PQgetlength(changes->res, row, 1));
+			applier.Apply(reader);
+		}
+		applier.Flush();
+		CheckResult(*dcon.Query(StringUtil::Format("INSERT OR REPLACE INTO %s VALUES (%s, %llu)",
+		                                           GetMirrorProgressTable(data),
+		                                           KeywordHelper::WriteQuoted(data.target_table),
+		                                           applier.applied_lsn)));
+		CheckResult(*dcon.Query("COMMIT"));
+	} catch (...) {
+		dcon.Query("ROLLBACK");
+		throw;
+	}
+	// the changes are part of the target - consume them. If this fails the changes are received again by the next
+	// call, which skips them
+	auto last_lsn = changes->GetString(change_count - 1, 0);
+	auto advance = con.Query(StringUtil::Format(
+	    "SELECT end_lsn >= %s::pg_lsn FROM pg_replication_slot_advance(%s, %s)", KeywordHelper::WriteQuoted(last_lsn),
+	    quoted_slot, KeywordHelper::WriteQuoted(last_lsn)));
+	if (advance->Count() != 1 || !advance->GetBool(0, 0)) {
+		throw IOException("Failed to advance replication slot \"%s\" of postgres_mirror to %s", data.slot_name,
+		                  last_lsn);
+	}
+	return true;
+}
+
+static void PostgresMirrorFunc(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->CastNoConst<PostgresMirrorBindData>();
+	if (data.finished) {
+		return;
+	}
+	data.finished = true;
+	auto con = PostgresConnection::Open(data.dsn);
+	auto dcon = Connection(context.db->GetDatabase(context));
+
+	auto slot = con.Query("SELECT 1 FROM pg_replication_slots WHERE slot_name = " +
+	                      KeywordHelper::WriteQuoted(data.slot_name));
+	auto target_exists = dcon.TableInfo(data.target_schema, data.target_table) != nullptr;
+	if (slot->Count() == 0 || !target_exists) {
+		auto copied_rows = PostgresMirrorCopy(data, con, dcon);
+		output.SetValue(0, 0, Value::BOOLEAN(true));
+		output.SetValue(1, 0, Value::UBIGINT(copied_rows));
+		output.SetValue(2, 0, Value::UBIGINT(0));
+		output.SetValue(3, 0, Value::UBIGINT(0));
+		output.SetCardinality(1);
+		return;
+	}
+	PostgresMirrorApplier applier(dcon, data);
+	auto progress_table = GetMirrorProgressTable(data);
+	CheckResult(*dcon.Query(StringUtil::Format(
+	    "CREATE TABLE IF NOT EXISTS %s (target_table VARCHAR PRIMARY KEY, lsn UBIGINT)", progress_table)));
+	auto progress = dcon.Query(StringUtil::Format("SELECT lsn FROM %s WHERE target_table = %s", progress_table,
+	                                              KeywordHelper::WriteQuoted(data.target_table)));
+	CheckResult(*progress);
+	if (progress->RowCount() > 0) {
+		applier.applied_lsn = UBigIntValue::Get(progress->GetValue(0, 0));
+	}
+	while (PostgresMirrorApplyChanges(data, con, dcon, applier)) {
+	}
+	output.SetValue(0, 0, Value::BOOLEAN(false));
+	output.SetValue(1, 0, Value::UBIGINT(applier.inserted));
+	output.SetValue(2, 0, Value::UBIGINT(applier.updated));
+	output.SetValue(3, 0, Value::UBIGINT(applier.deleted));
+	output.SetCardinality(1);
+}
+
+PostgresMirrorFunction::PostgresMirrorFunction()
+    : TableFunction("postgres_mirror", {LogicalType::VARCHAR, LogicalType::VARCHAR, LogicalType::VARCHAR},
+                    PostgresMirrorFunc, PostgresMirrorBind) {
+	named_parameters["schema"] = LogicalType::VARCHAR;
+	named_parameters["slot"] = LogicalType::VARCHAR;
+	named_parameters["publication"] = LogicalType::VARCHAR;
+}
+
+} // namespace duckdb
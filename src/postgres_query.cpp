@@ -1,5 +1,6 @@
 #include "duckdb.hpp"
 
+#include "duckdb/common/unordered_set.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
 #include "postgres_scanner.hpp"
 #include "duckdb/main/database_manager.hpp"
@@ -9,6 +10,65 @@
 
 namespace duckdb {
 
+static vector<string> GetColumnPartitionFilters(const string &column_name, const LogicalType &type,
+                                                idx_t partitions) {
+	vector<string> result;
+	auto column = KeywordHelper::WriteQuoted(column_name, '"');
+	string partition_expression;
+	switch (type.id()) {
+	case LogicalTypeId::SMALLINT:
+	case LogicalTypeId::INTEGER:
+	case LogicalTypeId::BIGINT:
+		// integers can be partitioned on directly - note that the modulo of a negative number is negative
+		partition_expression = StringUtil::Format("((%s %% %llu) + %llu) %% %llu", column, partitions, partitions,
+		                                          partitions);
+		break;
+	default:
+		partition_expression = StringUtil::Format("(hashtext(%s::TEXT) & 2147483647) %% %llu", column, partitions);
+		break;
+	}
+	for (idx_t i = 0; i < partitions; i++) {
+		auto filter = StringUtil::Format("%s = %llu", partition_expression, i);
+		if (i == 0) {
+			// NULL values end up in the first partition
+			filter += StringUtil::Format(" OR %s IS NULL", column);
+		}
+		result.push_back(std::move(filter));
+	}
+	return result;
+}
+
+//! Whether or not the query is a plain read-only query - i.e. it can run in a separate read-only transaction that
+//! shares the snapshot of the current transaction. This is conservative: any of the keywords below (even as part of
+//! a string literal) marks the query as modifying
+static bool IsReadOnlyQuery(const string &sql) {
+	static const unordered_set<string> read_statements {"select", "values", "table", "with"};
+	static const unordered_set<string> modifying_keywords {"insert", "update", "delete", "merge", "into",
+	                                                       "share", "nextval", "setval", "lock"};
+	auto query = StringUtil::Lower(sql);
+	bool first_word = true;
+	idx_t pos = 0;
+	while (pos < query.size()) {
+		if (!StringUtil::CharacterIsAlphaNumeric(query[pos]) && query[pos] != '_') {
+			pos++;
+			continue;
+		}
+		auto start = pos;
+		while (pos < query.size() && (StringUtil::CharacterIsAlphaNumeric(query[pos]) || query[pos] == '_')) {
+			pos++;
+		}
+		auto word = query.substr(start, pos - start);
+		if (first_word && read_statements.find(word) == read_statements.end()) {
+			return false;
+		}
+		first_word = false;
+		if (modifying_keywords.find(word) != modifying_keywords.end()) {
+			return false;
+		}
+	}
+	return !first_word;
+}
+
 static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctionBindInput &input,
                                             vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_uniq<PostgresBindData>();
@@ -38,50 +98,106 @@ static unique_ptr<FunctionData> PGQueryBind(ClientContext &context, TableFunctio
 		StringUtil::RTrim(sql);
 	}
 
-	auto &con = transaction.GetConnection();
-	auto conn = con.GetConn();
-	// prepare execution of the query to figure out the result types and names
-	auto prepared = PQprepare(conn, "", sql.c_str(), 0, nullptr);
-	PostgresResult prepared_wrapper(prepared);
-	if (!prepared) {
-		throw BinderException("Failed to prepare query \"%s\" (no result returned): %s", sql, PQerrorMessage(conn));
-	}
-	if (PQresultStatus(prepared) != PGRES_COMMAND_OK) {
-		throw BinderException("Failed to prepare query \"%s\": %s", sql, PQresultErrorMessage(prepared));
+	// any further arguments are the parameters ($1, $2, ...) of the query
+	vector<Value> parameters;
+	string description_key = sql;
+	for (idx_t i = 2; i < input.inputs.size(); i++) {
+		parameters.push_back(input.inputs[i]);
+		description_key += "\n" + input.inputs[i].type().ToString();
 	}
-	// use describe_prepared
-	auto describe_prepared = PQdescribePrepared(conn, "");
-	PostgresResult describe_wrapper(describe_prepared);
-	if (!describe_prepared || PQresultStatus(describe_prepared) != PGRES_COMMAND_OK) {
-		auto extended_err = describe_prepared ? PQresultErrorMessage(describe_prepared) : PQerrorMessage(conn);
-		throw BinderException("Failed to describe prepared statement: %s", extended_err);
-	}
-	auto nfields = PQnfields(describe_prepared);
-	if (nfields <= 0) {
-		throw BinderException("No fields returned by query \"%s\" - the query must be a SELECT statement that returns "
-		                      "at least one column",
-		                      sql);
-	}
-	for (idx_t c = 0; c < nfields; c++) {
-		PostgresType postgres_type;
-		postgres_type.oid = PQftype(describe_prepared, c);
-		PostgresTypeData type_data;
-		type_data.type_name = PostgresUtils::PostgresOidToName(postgres_type.oid);
-		type_data.type_modifier = PQfmod(describe_prepared, c);
-		auto converted_type = PostgresUtils::TypeToLogicalType(nullptr, nullptr, type_data, postgres_type);
-		result->postgres_types.push_back(postgres_type);
-		return_types.emplace_back(converted_type);
-		names.emplace_back(PQfname(describe_prepared, c));
+
+	auto &con = transaction.GetConnection();
+	// prepare and describe the query to figure out the result types and names - unless we described it before
+	PostgresQueryDescription description;
+	if (!pg_catalog.TryGetQueryDescription(description_key, description)) {
+		string error;
+		auto describe_result = con.TryDescribeQuery(sql, parameters, error);
+		if (!describe_result) {
+			throw BinderException(error);
+		}
+		auto describe_prepared = describe_result->res;
+		auto nfields = PQnfields(describe_prepared);
+		if (nfields <= 0) {
+			throw BinderException("No fields returned by query \"%s\" - the query must be a SELECT statement that "
+			                      "returns at least one column",
+			                      sql);
+		}
+		for (idx_t c = 0; c < nfields; c++) {
+			PostgresType postgres_type;
+			postgres_type.oid = PQftype(describe_prepared, c);
+			PostgresTypeData type_data;
+			type_data.type_name = PostgresUtils::PostgresOidToName(postgres_type.oid);
+			type_data.type_modifier = PQfmod(describe_prepared, c);
+			auto converted_type = PostgresUtils::TypeToLogicalType(nullptr, nullptr, type_data, postgres_type);
+			description.postgres_types.push_back(postgres_type);
+			description.types.push_back(std::move(converted_type));
+			description.names.emplace_back(PQfname(describe_prepared, c));
+		}
+		pg_catalog.AddQueryDescription(description_key, description);
 	}
+	result->postgres_types = description.postgres_types;
+	return_types = description.types;
+	names = description.names;
 
 	// set up the bind data
 	result->SetCatalog(pg_catalog);
 	result->dsn = con.GetDSN();
 	result->types = return_types;
 	result->names = names;
-	result->read_only = false;
+	// a read-only query can be streamed over a separate connection when the query references the catalog more than
+	// once - other queries have to run on the connection of the transaction
+	result->read_only = transaction.IsReadOnly() && IsReadOnlyQuery(sql);
 	result->SetTablePages(0);
 	result->sql = std::move(sql);
+	result->parameters = std::move(parameters);
+
+	// check if the query should be split into partitions that are read in parallel
+	string partition_column;
+	idx_t partitions = 0;
+	vector<string> partition_filters;
+	for (auto &kv : input.named_parameters) {
+		if (kv.second.IsNull()) {
+			throw BinderException("Parameters to postgres_query cannot be NULL");
+		}
+		if (kv.first == "partition_column") {
+			partition_column = StringValue::Get(kv.second);
+		} else if (kv.first == "partitions") {
+			partitions = UBigIntValue::Get(kv.second.DefaultCastAs(LogicalType::UBIGINT));
+		} else if (kv.first == "partition_predicates") {
+			for (auto &predicate : ListValue::GetChildren(kv.second)) {
+				if (predicate.IsNull()) {
+					throw BinderException("partition_predicates of postgres_query cannot contain NULL");
+				}
+				partition_filters.push_back(StringValue::Get(predicate));
+			}
+		}
+	}
+	if (!partition_column.empty()) {
+		if (!partition_filters.empty()) {
+			throw BinderException("postgres_query: partition_column and partition_predicates cannot be combined");
+		}
+		if (partitions == 0) {
+			throw BinderException("postgres_query: partitions must be set to a value > 0 when using partition_column");
+		}
+		idx_t column_idx = DConstants::INVALID_INDEX;
+		for (idx_t c = 0; c < names.size(); c++) {
+			if (names[c] == partition_column) {
+				column_idx = c;
+			}
+		}
+		if (column_idx == DConstants::INVALID_INDEX) {
+			throw BinderException("postgres_query: partition_column \"%s\" is not a column of the query result",
+			                      partition_column);
+		}
+		partition_filters = GetColumnPartitionFilters(partition_column, return_types[column_idx], partitions);
+	} else if (partitions > 0 && partition_filters.empty()) {
+		throw BinderException("postgres_query: partitions requires partition_column to be set");
+	}
+	if (!partition_filters.empty()) {
+		// the partitions are read with separate connections that share a snapshot - this requires a read-only query
+		result->read_only = transaction.IsReadOnly();
+		result->SetPartitionFilters(std::move(partition_filters));
+	}
 	return std::move(result);
 }
 
@@ -91,6 +207,11 @@ PostgresQueryFunction::PostgresQueryFunction()
 	init_global = scan_function.init_global;
 	init_local = scan_function.init_local;
 	function = scan_function.function;
+	get_batch_index = scan_function.get_batch_index;
 	projection_pushdown = true;
+	varargs = LogicalType::ANY;
+	named_parameters["partition_column"] = LogicalType::VARCHAR;
+	named_parameters["partitions"] = LogicalType::UBIGINT;
+	named_parameters["partition_predicates"] = LogicalType::LIST(LogicalType::VARCHAR);
 }
 } // namespace duckdb
@@ -0,0 +1,108 @@
+#include "postgres_scan_statistics.hpp"
+#include "postgres_extension_state.hpp"
+#include "duckdb/common/types/value.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+void PostgresScanStatistics::AddDecodeTime(const string &type, idx_t time_ns) {
+	lock_guard<mutex> guard(lock);
+	decode_time_ns[type] += time_ns;
+}
+
+void PostgresScanStatistics::AddTask(idx_t time_ns) {
+	task_count++;
+	task_time_ns += time_ns;
+	auto current_max = max_task_time_ns.load();
+	while (time_ns > current_max && !max_task_time_ns.compare_exchange_weak(current_max, time_ns)) {
+	}
+}
+
+unordered_map<string, idx_t> PostgresScanStatistics::GetDecodeTimes() {
+	lock_guard<mutex> guard(lock);
+	return decode_time_ns;
+}
+
+struct PostgresScanStatsData : public TableFunctionData {
+	vector<shared_ptr<PostgresScanStatistics>> scans;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> PostgresScanStatsBind(ClientContext &context, TableFunctionBindInput &input,
+                                                      vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("scan_id");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("source");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("tasks");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("rows");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("bytes");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("wait_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("connection_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("decode_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	child_list_t<LogicalType> decode_time_children;
+	decode_time_children.push_back(make_pair("type", LogicalType::VARCHAR));
+	decode_time_children.push_back(make_pair("decode_time_ms", LogicalType::DOUBLE));
+	names.emplace_back("decode_time_per_type");
+	return_types.emplace_back(LogicalType::LIST(LogicalType::STRUCT(std::move(decode_time_children))));
+	names.emplace_back("avg_task_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+	names.emplace_back("max_task_time_ms");
+	return_types.emplace_back(LogicalType::DOUBLE);
+
+	auto result = make_uniq<PostgresScanStatsData>();
+	auto extension_state = PostgresExtensionState::Get(context);
+	if (extension_state) {
+		result->scans = extension_state->GetScanStatistics();
+	}
+	return std::move(result);
+}
+
+static Value ToMilliseconds(idx_t time_ns) {
+	return Value::DOUBLE(double(time_ns) / 1000000.0);
+}
+
+static void PostgresScanStatsExecute(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->CastNoConst<PostgresScanStatsData>();
+	idx_t count = 0;
+	while (data.offset < data.scans.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &scan = *data.scans[data.offset++];
+		idx_t decode_time = 0;
+		vector<Value> decode_times;
+		for (auto &entry : scan.GetDecodeTimes()) {
+			child_list_t<Value> decode_time_value;
+			decode_time_value.push_back(make_pair("type", Value(entry.first)));
+			decode_time_value.push_back(make_pair("decode_time_ms", ToMilliseconds(entry.second)));
+			decode_times.push_back(Value::STRUCT(std::move(decode_time_value)));
+			decode_time += entry.second;
+		}
+		idx_t task_count = scan.task_count;
+		idx_t col = 0;
+		output.SetValue(col++, count, Value::UBIGINT(scan.scan_id));
+		output.SetValue(col++, count, Value(scan.source));
+		output.SetValue(col++, count, Value::UBIGINT(task_count));
+		output.SetValue(col++, count, Value::UBIGINT(scan.rows));
+		output.SetValue(col++, count, Value::UBIGINT(scan.bytes));
+		output.SetValue(col++, count, ToMilliseconds(scan.wait_time_ns));
+		output.SetValue(col++, count, ToMilliseconds(scan.connection_time_ns));
+		output.SetValue(col++, count, ToMilliseconds(decode_time));
+		auto list_type = ListType::GetChildType(output.data[col].GetType());
+		output.SetValue(col++, count, Value::LIST(list_type, std::move(decode_times)));
+		output.SetValue(col++, count, ToMilliseconds(task_count == 0 ? 0 : scan.task_time_ns / task_count));
+		output.SetValue(col++, count, ToMilliseconds(scan.max_task_time_ns));
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+PostgresScanStatsFunction::PostgresScanStatsFunction()
+    : TableFunction("postgres_scan_stats", {}, PostgresScanStatsExecute, PostgresScanStatsBind) {
+}
+
+} // namespace duckdb
@@ -2,56 +2,234 @@
 
 #include <libpq-fe.h>
 
+#include "duckdb/common/atomic.hpp"
 #include "duckdb/main/extension_util.hpp"
+#include "duckdb/transaction/meta_transaction.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/parser/parsed_data/create_table_function_info.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
 #include "postgres_filter_pushdown.hpp"
 #include "postgres_scanner.hpp"
 #include "postgres_result.hpp"
 #include "postgres_binary_reader.hpp"
+#include "postgres_brin_pruning.hpp"
+#include "postgres_index_ranges.hpp"
+#include "postgres_memory_budget.hpp"
+#include "postgres_binary_decoder.hpp"
+#include "postgres_extension_state.hpp"
+#include "postgres_thread_affinity.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "storage/postgres_table_set.hpp"
+#include "storage/postgres_result_cache.hpp"
+#include "storage/postgres_runtime_filter.hpp"
 
 namespace duckdb {
 
 static constexpr uint32_t POSTGRES_TID_MAX = 4294967295;
+//! The minimum amount of pages a task is shrunk to near the end of a scan
+static constexpr idx_t POSTGRES_MIN_PAGES_PER_TASK = 16;
 
 struct PostgresGlobalState;
+struct PostgresScanPlan;
 
 struct PostgresLocalState : public LocalTableFunctionState {
+	//! The NUMA node the thread is pinned to while it works on the scan (if pg_scan_thread_affinity is enabled)
+	idx_t affinity_node = DConstants::INVALID_INDEX;
+	PostgresThreadAffinity affinity;
 	bool done = false;
 	bool exec = false;
 	bool no_connection = false;
 	string sql;
 	vector<column_t> column_ids;
 	TableFilterSet *filters;
-	string col_names;
+	//! The parts of the query that are the same for all tasks of the scan
+	shared_ptr<const PostgresScanPlan> plan;
 	PostgresConnection connection;
 	idx_t batch_idx = 0;
 	PostgresPoolConnection pool_connection;
+	//! The decoders for each of the projected columns
+	vector<PostgresColumnDecoder> decoders;
+	//! The location of the values of each of the projected columns in the current batch of rows
+	vector<PostgresColumnFields> fields;
+	//! The server-side function that returns the compressed COPY output (if pg_copy_compression_function is set)
+	string copy_compression_function;
+	unique_ptr<PostgresCopyDecompressor> decompressor;
+	//! Receives rows in the background (if pg_async_copy_prefetch is enabled) - uses the decompressor (if any)
+	unique_ptr<PostgresCopyPrefetcher> prefetcher;
+	//! Holds the received rows (if pg_copy_arena_buffers is enabled)
+	unique_ptr<PostgresRowArena> arena;
+	//! Accounts for the received rows held by this thread (if pg_scan_memory_limit is set)
+	unique_ptr<PostgresMemoryReservation> memory_reservation;
+	//! Whether or not the COPY of the next task is sent as soon as the current one is received (pg_copy_lookahead) -
+	//! and whether or not that COPY has been sent but not yet started
+	bool copy_lookahead = false;
+	bool copy_pending = false;
+	//! The scan state of this thread over the materialized result (if any)
+	ColumnDataLocalScanState collection_scan_state;
+	//! Whether or not the rows are fetched through a cursor instead of a binary COPY (pg_use_cursor_scan, or a query
+	//! with parameters)
+	bool use_cursor = false;
+	idx_t cursor_fetch_size = PostgresBindData::DEFAULT_CURSOR_FETCH_SIZE;
+	string cursor_name;
+	//! The rows most recently fetched from the cursor - and the next row of those to read
+	shared_ptr<PostgresResult> cursor_result;
+	idx_t cursor_row = 0;
+	//! The statistics of the scan (if pg_scan_statistics is enabled) - and the start of the current task
+	shared_ptr<PostgresScanStatistics> statistics;
+	idx_t task_start = 0;
+	bool task_active = false;
+	//! The pages of the current task and its start - if the task size is adaptive (pg_task_target_ms)
+	idx_t adaptive_task_pages = 0;
+	idx_t adaptive_task_start = 0;
+	//! The connection slot held by this thread if the scan shares the connection slots with other scans
+	//! (pg_scan_connection_sharing) - released when the scan state is destroyed
+	shared_ptr<PostgresScanConnectionShare> connection_share;
+	optional_ptr<PostgresConnectionPool> share_pool;
+	//! The transaction the connection of this thread is handed to when the scan is done (pg_reuse_scan_connections)
+	optional_ptr<PostgresTransaction> scan_transaction;
+	//! Whether or not this thread scans over the connection of the transaction (instead of a connection that runs a
+	//! transaction of its own)
+	bool uses_transaction_connection = false;
+	//! The worker node whose shards this thread reads - and the node the connection of the thread is connected to
+	//! (if the shards of a distributed table are read from the worker nodes directly)
+	idx_t worker_node = DConstants::INVALID_INDEX;
+	idx_t connected_worker_node = DConstants::INVALID_INDEX;
 
+	~PostgresLocalState() override {
+		// stop receiving rows in the background before the connection is used for anything else
+		prefetcher.reset();
+		bool aborted = false;
+		if (connection.IsOpen()) {
+			// a scan that stopped early (e.g. because of a LIMIT or an interrupt) leaves its COPY running - the COPY
+			// is cancelled, unless it runs on the connection of the transaction which cannot be cancelled without
+			// aborting the transaction. There the remaining rows are discarded instead
+			aborted = connection.AbortCopyFrom(!uses_transaction_connection);
+			if (aborted && !uses_transaction_connection) {
+				// end the aborted transaction so that the pool can hand out the connection again
+				connection.TryQuery("ROLLBACK");
+			}
+		}
+		if (connected_worker_node != DConstants::INVALID_INDEX) {
+			if (!aborted) {
+				ReleaseWorkerConnection();
+			}
+			return;
+		}
+		if (scan_transaction && !aborted && pool_connection.HasConnection()) {
+			// the connection is attached to the snapshot of the transaction - keep it for the later scans
+			connection = PostgresConnection();
+			scan_transaction->ReturnScanConnection(std::move(pool_connection));
+			return;
+		}
+		if (!connection_share) {
+			return;
+		}
+		// return the connection to the pool before freeing the slot, so the waiting scans find it available
+		connection = PostgresConnection();
+		pool_connection = PostgresPoolConnection();
+		share_pool->ReleaseScanConnection(*connection_share);
+	}
+
+	void InitializeDecoders(const PostgresBindData &bind_data, bool zero_copy, bool dictionary_strings);
+	//! Connect to the worker node of the next task of the thread - releasing the connection to the previous node
+	void ConnectWorker(const PostgresBindData &bind_data);
+	//! Commit the transaction on the worker node and return the connection to the pool of the node
+	void ReleaseWorkerConnection();
 	void ScanChunk(ClientContext &context, const PostgresBindData &bind_data, PostgresGlobalState &gstate,
 	               DataChunk &output);
+	string GetCopyQuery() const;
+};
+
+//! The progress of a scan over the shards that are stored on one worker node - the shards of a node are consecutive
+//! leaf partitions
+struct PostgresWorkerScanState {
+	PostgresWorkerScanState(idx_t leaf_start, idx_t leaf_end)
+	    : leaf_start(leaf_start), leaf_end(leaf_end), leaf_idx(leaf_start) {
+	}
+
+	idx_t leaf_start;
+	idx_t leaf_end;
+	//! The next shard to scan - and the next page to scan within that shard
+	idx_t leaf_idx;
+	idx_t page_idx = 0;
+	//! The amount of threads that read the shards of the node
+	idx_t threads = 0;
 };
 
 struct PostgresGlobalState : public GlobalTableFunctionState {
-	explicit PostgresGlobalState(idx_t max_threads) : page_idx(0), batch_idx(0), max_threads(max_threads) {
+	explicit PostgresGlobalState(idx_t max_threads)
+	    : page_idx(0), partition_idx(0), leaf_idx(0), batch_idx(0), max_threads(max_threads) {
 	}
 
 	mutable mutex lock;
+	//! The next page to scan (within the current leaf partition, if any)
 	idx_t page_idx;
+	idx_t partition_idx;
+	idx_t leaf_idx;
 	idx_t batch_idx;
 	idx_t max_threads;
-	unique_ptr<ColumnDataCollection> collection;
-	ColumnDataScanState scan_state;
+	//! The query of the scan without the selection of the rows of a task - built once for all tasks
+	shared_ptr<const PostgresScanPlan> plan;
+	//! The materialized result of the scan - possibly shared with the result cache
+	shared_ptr<ColumnDataCollection> collection;
+	//! The materialized result is scanned in parallel
+	ColumnDataParallelScanState scan_state;
 	bool used_main_thread = false;
 	string snapshot;
+	//! The statistics of the scan (if pg_scan_statistics is enabled)
+	shared_ptr<PostgresScanStatistics> statistics;
+	//! The NUMA node the next scan thread is pinned to (if pg_scan_thread_affinity is enabled)
+	atomic<idx_t> next_node {0};
+	//! The current amount of pages per task if the task size is adaptive (pg_task_target_ms) - and the pages and the
+	//! time of all tasks that have finished, from which the throughput of a task is derived
+	idx_t task_pages = 0;
+	idx_t finished_task_pages = 0;
+	idx_t finished_task_time_ns = 0;
+	//! The share of the connection slots of the scan (if pg_scan_connection_sharing is enabled)
+	shared_ptr<PostgresScanConnectionShare> connection_share;
+	//! The pool the threads of the scan get their connections from - the pool of the primary or of a read replica
+	optional_ptr<PostgresConnectionPool> pool;
+	//! The connection to the read replica the scan runs on (if any)
+	PostgresPoolConnection replica_connection;
+	//! The transaction the scan runs in (if the scan runs on the connection of the transaction) - and whether or not
+	//! the threads of the scan reuse the connections of earlier scans of the transaction (pg_reuse_scan_connections)
+	optional_ptr<PostgresTransaction> transaction;
+	bool reuse_scan_connections = false;
+	//! The page ranges that cannot contain rows matching the filters of the scan (pg_brin_pruning) - and the next of
+	//! those ranges that the handed out pages have not passed yet
+	vector<PostgresPageRange> pruned_ranges;
+	idx_t pruned_idx = 0;
+	//! If not empty, every task scans one range of the key of an index instead of a ctid range (pg_index_range_scan)
+	vector<string> key_ranges;
+	//! The progress of the scan on each of the worker nodes - if the shards of a distributed table are read from the
+	//! worker nodes directly (pg_citus_shard_scan)
+	vector<PostgresWorkerScanState> worker_scans;
+
+	//! The amount of pages of the next task (requires the lock to be held)
+	idx_t GetTaskPages(const PostgresBindData &bind_data);
+	//! The (approximate) amount of tasks that have not been handed out yet (requires the lock to be held)
+	idx_t RemainingTasks(const PostgresBindData &bind_data);
+	//! Start a task of the given amount of pages, or finish the previous task of the thread (requires the lock)
+	void StartAdaptiveTask(const PostgresBindData &bind_data, PostgresLocalState &lstate, idx_t pages);
+	void FinishAdaptiveTask(const PostgresBindData &bind_data, PostgresLocalState &lstate);
+	//! Move the thread to the worker node with the most remaining tasks per thread - returns false if all tasks of
+	//! all nodes have been handed out (requires the lock to be held)
+	bool AssignWorkerNode(const PostgresBindData &bind_data, PostgresLocalState &lstate);
 
 	PostgresConnection &GetConnection();
 	void SetConnection(PostgresConnection connection);
 	void SetConnection(shared_ptr<OwnedPostgresConnection> connection);
 
 	bool TryOpenNewConnection(ClientContext &context, PostgresLocalState &lstate, const PostgresBindData &bind_data);
+	//! Hand a connection of an earlier scan of the transaction to the thread (if pg_reuse_scan_connections is enabled)
+	bool TryReuseScanConnection(PostgresLocalState &lstate);
+	//! Start scanning the materialized result - the chunks of the result are distributed over all threads
+	void InitializeCollectionScan() {
+		collection->InitializeScan(scan_state);
+		max_threads = MaxValue<idx_t>(collection->ChunkCount(), 1);
+	}
 	idx_t MaxThreads() const override {
 		return max_threads;
 	}
@@ -62,43 +240,30 @@ private:
 
 static void PostgresGetSnapshot(PostgresVersion version, const PostgresBindData &bind_data,
                                 PostgresGlobalState &gstate) {
-	unique_ptr<PostgresResult> result;
+	if (!bind_data.snapshot.empty()) {
+		// the snapshot to use was given explicitly
+		gstate.snapshot = bind_data.snapshot;
+		return;
+	}
 	// by default disable snapshotting
 	gstate.snapshot = string();
-	if (gstate.max_threads <= 1) {
+	if (gstate.max_threads <= 1 && bind_data.can_use_main_thread) {
 		return;
 	}
 	if (version.type_v == PostgresInstanceType::AURORA) {
 		return;
 	}
 	// reader threads can use the same snapshot
-	auto &con = gstate.GetConnection();
-	// pg_stat_wal_receiver was introduced in PostgreSQL 9.6
-	if (version < PostgresVersion(9, 6, 0)) {
-		result = con.TryQuery("SELECT pg_is_in_recovery(), pg_export_snapshot()");
-		if (result) {
-			auto in_recovery = result->GetBool(0, 0);
-			if (!in_recovery) {
-				gstate.snapshot = result->GetString(0, 1);
-			}
-		}
-		return;
-	}
-
-	result =
-	    con.TryQuery("SELECT pg_is_in_recovery(), pg_export_snapshot(), (select count(*) from pg_stat_wal_receiver)");
-	if (result) {
-		auto in_recovery = result->GetBool(0, 0) || result->GetInt64(0, 2) > 0;
-		gstate.snapshot = "";
-		if (!in_recovery) {
-			gstate.snapshot = result->GetString(0, 1);
-		}
-		return;
+	if (gstate.transaction) {
+		// the snapshot is exported once and shared by all scans of the transaction
+		gstate.snapshot = gstate.transaction->GetScanSnapshot(version);
+	} else {
+		gstate.snapshot = gstate.GetConnection().TryExportSnapshot(version);
 	}
 }
 
 void PostgresScanFunction::PrepareBind(PostgresVersion version, ClientContext &context, PostgresBindData &bind_data,
-                                       idx_t approx_num_pages) {
+                                       idx_t approx_num_pages, optional_ptr<PostgresConnection> connection) {
 	Value pages_per_task;
 	if (context.TryGetCurrentSetting("pg_pages_per_task", pages_per_task)) {
 		bind_data.pages_per_task = UBigIntValue::Get(pages_per_task);
@@ -106,6 +271,22 @@ void PostgresScanFunction::PrepareBind(PostgresVersion version, ClientContext &c
 			bind_data.pages_per_task = PostgresBindData::DEFAULT_PAGES_PER_TASK;
 		}
 	}
+	Value task_target_ms;
+	if (context.TryGetCurrentSetting("pg_task_target_ms", task_target_ms)) {
+		bind_data.task_target_ms = UBigIntValue::Get(task_target_ms);
+	}
+	if (bind_data.task_target_ms > 0) {
+		// with adaptive tasks the amount of threads is not derived from pages_per_task - but capped at what the
+		// DuckDB threads and the connection pool can sustain
+		bind_data.adaptive_max_threads = idx_t(TaskScheduler::GetScheduler(context).NumberOfThreads());
+		Value connection_limit;
+		if (context.TryGetCurrentSetting("pg_connection_limit", connection_limit) &&
+		    UBigIntValue::Get(connection_limit) > 0) {
+			bind_data.adaptive_max_threads =
+			    MinValue<idx_t>(bind_data.adaptive_max_threads, UBigIntValue::Get(connection_limit));
+		}
+		bind_data.adaptive_max_threads = MaxValue<idx_t>(bind_data.adaptive_max_threads, 1);
+	}
 	bool use_ctid_scan = true;
 	Value pg_use_ctid_scan;
 	if (context.TryGetCurrentSetting("pg_use_ctid_scan", pg_use_ctid_scan)) {
@@ -116,22 +297,114 @@ void PostgresScanFunction::PrepareBind(PostgresVersion version, ClientContext &c
 		// see https://github.com/duckdb/postgres_scanner/issues/186
 		use_ctid_scan = false;
 	}
+	bind_data.version = version;
+	Value citus_shard_scan;
+	if (connection && bind_data.read_only && bind_data.relation_kind == 'r' && context.transaction.IsAutoCommit() &&
+	    context.TryGetCurrentSetting("pg_citus_shard_scan", citus_shard_scan) && BooleanValue::Get(citus_shard_scan)) {
+		// distributed table - read its shards from the worker nodes instead of through the coordinator
+		// the worker nodes do not see the snapshot of the coordinator, so this is not done in explicit transactions
+		vector<string> worker_nodes;
+		auto shards = PostgresTableSet::GetDistributedShards(*connection, bind_data.schema_name, bind_data.table_name,
+		                                                     bind_data.dsn, worker_nodes);
+		if (!shards.empty()) {
+			if (!use_ctid_scan) {
+				// one task per shard
+				for (auto &shard : shards) {
+					shard.pages_approx = 0;
+				}
+			}
+			bind_data.worker_nodes = std::move(worker_nodes);
+			bind_data.SetLeafPartitions(std::move(shards));
+			return;
+		}
+	}
+	if (connection && bind_data.read_only && bind_data.relation_kind == 'p') {
+		// partitioned table - scan the leaf partitions instead
+		auto partitions =
+		    PostgresTableSet::GetLeafPartitions(*connection, bind_data.schema_name, bind_data.table_name);
+		if (!partitions.empty()) {
+			if (!use_ctid_scan) {
+				// one task per partition
+				for (auto &partition : partitions) {
+					partition.pages_approx = 0;
+				}
+			}
+			bind_data.SetLeafPartitions(std::move(partitions));
+			return;
+		}
+	}
 	if (!use_ctid_scan) {
 		approx_num_pages = 0;
 	}
+	// views and foreign tables have no ctid - they are scanned in a single task, as splitting them on anything but
+	// their own columns would evaluate the view (or the remote scan) in its entirety for every part
 	bind_data.SetTablePages(approx_num_pages);
-	bind_data.version = version;
 }
 
 void PostgresBindData::SetTablePages(idx_t approx_num_pages) {
 	this->pages_approx = approx_num_pages;
 	if (!read_only) {
 		max_threads = 1;
+	} else if (task_target_ms > 0) {
+		max_threads = MinValue<idx_t>(MaxValue<idx_t>(pages_approx / POSTGRES_MIN_PAGES_PER_TASK, 1),
+		                              adaptive_max_threads);
 	} else {
 		max_threads = MaxValue<idx_t>(pages_approx / pages_per_task, 1);
 	}
 }
 
+void PostgresBindData::SetApproxNumRows(double approx_num_rows_p, idx_t analyzed_pages) {
+	approx_num_rows = approx_num_rows_p;
+	rows_per_page = approx_num_rows > 0 && analyzed_pages > 0 ? approx_num_rows / double(analyzed_pages) : 0;
+}
+
+void PostgresBindData::SetPartitionFilters(vector<string> filters) {
+	partition_filters = std::move(filters);
+	pages_approx = 0;
+	max_threads = read_only ? MaxValue<idx_t>(partition_filters.size(), 1) : 1;
+}
+
+void PostgresBindData::SetLeafPartitions(vector<PostgresLeafPartition> partitions) {
+	leaf_partitions = std::move(partitions);
+	// the total number of pages is used for the cardinality estimate
+	pages_approx = 0;
+	idx_t task_count = 0;
+	auto task_pages = task_target_ms > 0 ? POSTGRES_MIN_PAGES_PER_TASK : pages_per_task;
+	for (auto &partition : leaf_partitions) {
+		pages_approx += partition.pages_approx;
+		task_count += MaxValue<idx_t>(partition.pages_approx / task_pages, 1);
+	}
+	if (task_target_ms > 0) {
+		task_count = MinValue<idx_t>(task_count, adaptive_max_threads);
+	}
+	max_threads = read_only ? task_count : 1;
+}
+
+idx_t PostgresBindData::AddColumnExpression(string name, LogicalType type, string expression) {
+	column_expressions.resize(names.size());
+	names.push_back(std::move(name));
+	types.push_back(std::move(type));
+	postgres_types.emplace_back();
+	column_expressions.push_back(std::move(expression));
+	return names.size() - 1;
+}
+
+string PostgresBindData::GetColumnSQL(column_t column_id) const {
+	if (column_id < column_expressions.size() && !column_expressions[column_id].empty()) {
+		return column_expressions[column_id];
+	}
+	return KeywordHelper::WriteQuoted(names[column_id], '"');
+}
+
+void PostgresBindData::SetLimitClause(string clause) {
+	limit_clause = std::move(clause);
+	// the limit applies to the scan as a whole - so the scan cannot be split into multiple tasks
+	partition_filters.clear();
+	leaf_partitions.clear();
+	worker_nodes.clear();
+	SetTablePages(0);
+}
+
 PostgresConnection &PostgresGlobalState::GetConnection() {
 	return connection;
 }
@@ -155,6 +428,11 @@ static unique_ptr<FunctionData> PostgresBind(ClientContext &context, TableFuncti
 	bind_data->dsn = input.inputs[0].GetValue<string>();
 	bind_data->schema_name = input.inputs[1].GetValue<string>();
 	bind_data->table_name = input.inputs[2].GetValue<string>();
+	for (auto &kv : input.named_parameters) {
+		if (kv.first == "snapshot") {
+			bind_data->snapshot = StringValue::Get(kv.second);
+		}
+	}
 
 	auto con = PostgresConnection::Open(bind_data->dsn);
 	auto version = con.GetPostgresVersion();
@@ -168,81 +446,154 @@ static unique_ptr<FunctionData> PostgresBind(ClientContext &context, TableFuncti
 	}
 	bind_data->names = info->postgres_names;
 	bind_data->types = return_types;
+	bind_data->relation_kind = info->relation_kind;
+	bind_data->column_statistics = info->column_statistics;
+	bind_data->SetApproxNumRows(info->approx_num_rows, info->approx_num_pages);
 	bind_data->can_use_main_thread = true;
 	bind_data->requires_materialization = false;
 
-	PostgresScanFunction::PrepareBind(version, context, *bind_data, info->approx_num_pages);
+	PostgresScanFunction::PrepareBind(version, context, *bind_data, info->relation_pages, con);
 	return std::move(bind_data);
 }
 
-static void PostgresInitInternal(ClientContext &context, const PostgresBindData *bind_data_p,
-                                 PostgresLocalState &lstate, idx_t task_min, idx_t task_max) {
-	D_ASSERT(bind_data_p);
-	D_ASSERT(task_min <= task_max);
+//! A part of the scan that is read by a single COPY
+struct PostgresScanTask {
+	PostgresScanTask() {
+	}
+	PostgresScanTask(idx_t page_min, idx_t page_max) : use_ctid_range(true), page_min(page_min), page_max(page_max) {
+	}
 
-	auto bind_data = (const PostgresBindData *)bind_data_p;
+	//! Whether or not the task reads a ctid range of pages
+	bool use_ctid_range = false;
+	idx_t page_min = 0;
+	idx_t page_max = POSTGRES_TID_MAX;
+	//! An additional filter selecting the rows of the task
+	optional_ptr<const string> partition_filter;
+	//! The leaf partition that is scanned instead of the table
+	optional_ptr<const PostgresLeafPartition> leaf_partition;
+};
+
+//! The query of a scan is built once, when the scan is initialized - the projection, the filters and the source do
+//! not change between tasks. The tasks only add their own selection of rows (and the runtime filters, which are
+//! filled in while the scan runs)
+struct PostgresScanPlan {
+	//! The projected columns - cast to VARCHAR where DuckDB reads the text representation
+	string select_list;
+	//! The table or the subquery the scan reads from (unless a task reads a leaf partition instead)
+	string source;
+	//! The filters of the scan and the predicates pushed into it
+	string filter;
 
-	string col_names;
-	for (auto &column_id : lstate.column_ids) {
+	static shared_ptr<const PostgresScanPlan> Create(const PostgresBindData &bind_data,
+	                                                 const vector<column_t> &column_ids,
+	                                                 optional_ptr<TableFilterSet> filters);
+	//! The query of a task of the scan
+	string GetTaskSQL(const PostgresBindData &bind_data, const PostgresScanTask &task) const;
+};
+
+shared_ptr<const PostgresScanPlan> PostgresScanPlan::Create(const PostgresBindData &bind_data,
+                                                            const vector<column_t> &column_ids,
+                                                            optional_ptr<TableFilterSet> filters) {
+	auto result = make_shared<PostgresScanPlan>();
+	auto &col_names = result->select_list;
+	for (auto &column_id : column_ids) {
 		if (!col_names.empty()) {
 			col_names += ", ";
 		}
 		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
-			if (bind_data->table_name.empty() || !bind_data->emit_ctid) {
+			if (bind_data.table_name.empty() || !bind_data.emit_ctid) {
 				// count(*) over postgres_query
 				col_names += "NULL";
 			} else {
 				col_names += "ctid";
 			}
 		} else {
-			col_names += KeywordHelper::WriteQuoted(bind_data->names[column_id], '"');
-			if (bind_data->postgres_types[column_id].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+			col_names += bind_data.GetColumnSQL(column_id);
+			if (bind_data.postgres_types[column_id].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
 				col_names += "::VARCHAR";
 			}
-			if (bind_data->types[column_id].id() == LogicalTypeId::LIST) {
-				if (bind_data->postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			if (bind_data.types[column_id].id() == LogicalTypeId::LIST) {
+				if (bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
 					continue;
 				}
-				if (bind_data->postgres_types[column_id].children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+				if (bind_data.postgres_types[column_id].children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
 					col_names += "::VARCHAR[]";
 				}
 			}
 		}
 	}
 
-	string filter_string =
-	    PostgresFilterPushdown::TransformFilters(lstate.column_ids, lstate.filters, bind_data->names);
+	auto &filter_string = result->filter;
+	filter_string =
+	    PostgresFilterPushdown::TransformFilters(column_ids, filters, bind_data.names, bind_data.postgres_types);
+	for (auto &predicate : bind_data.pushdown_predicates) {
+		if (!filter_string.empty()) {
+			filter_string += " AND ";
+		}
+		filter_string += predicate;
+	}
 
-	string filter;
-	if (bind_data->pages_approx > 0) {
-		filter = StringUtil::Format("WHERE ctid BETWEEN '(%d,0)'::tid AND '(%d,0)'::tid", task_min, task_max);
+	if (bind_data.table_name.empty()) {
+		D_ASSERT(!bind_data.sql.empty());
+		result->source = "(" + bind_data.sql + ") AS __unnamed_subquery";
+	} else {
+		result->source = KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+		                 KeywordHelper::WriteQuoted(bind_data.table_name, '"');
 	}
-	if (!filter_string.empty()) {
-		if (filter.empty()) {
-			filter += "WHERE ";
-		} else {
-			filter += " AND ";
+	return std::move(result);
+}
+
+string PostgresScanPlan::GetTaskSQL(const PostgresBindData &bind_data, const PostgresScanTask &task) const {
+	string filter_string = filter;
+	for (auto &runtime_filter : bind_data.runtime_filters) {
+		auto predicate = runtime_filter->GetPredicate();
+		if (predicate.empty()) {
+			continue;
+		}
+		if (!filter_string.empty()) {
+			filter_string += " AND ";
 		}
-		filter += filter_string;
+		filter_string += predicate;
 	}
-	if (bind_data->table_name.empty()) {
-		D_ASSERT(!bind_data->sql.empty());
-		lstate.sql = StringUtil::Format(
-		    R"(
-	COPY (SELECT %s FROM (%s) AS __unnamed_subquery %s) TO STDOUT (FORMAT binary);
-	)",
-		    col_names, bind_data->sql, filter);
 
-	} else {
-		lstate.sql = StringUtil::Format(
-		    R"(
-	COPY (SELECT %s FROM %s.%s %s) TO STDOUT (FORMAT binary);
-	)",
-		    col_names, KeywordHelper::WriteQuoted(bind_data->schema_name, '"'),
-		    KeywordHelper::WriteQuoted(bind_data->table_name, '"'), filter);
+	string task_filter;
+	if (task.use_ctid_range) {
+		task_filter = StringUtil::Format("WHERE ctid BETWEEN '(%d,0)'::tid AND '(%d,0)'::tid", task.page_min,
+		                                 task.page_max);
+	}
+	if (task.partition_filter) {
+		task_filter += task_filter.empty() ? "WHERE " : " AND ";
+		task_filter += "(" + *task.partition_filter + ")";
+	}
+	if (!filter_string.empty()) {
+		task_filter += task_filter.empty() ? "WHERE " : " AND ";
+		task_filter += filter_string;
+	}
+	if (!bind_data.limit_clause.empty()) {
+		task_filter += " " + bind_data.limit_clause;
 	}
+	string task_source;
+	if (task.leaf_partition) {
+		task_source = KeywordHelper::WriteQuoted(task.leaf_partition->schema_name, '"') + "." +
+		              KeywordHelper::WriteQuoted(task.leaf_partition->table_name, '"');
+	}
+	return "SELECT " + select_list + " FROM " + (task_source.empty() ? source : task_source) + " " + task_filter;
+}
+
+static void PostgresInitInternal(ClientContext &context, const PostgresBindData *bind_data_p,
+                                 PostgresLocalState &lstate, const PostgresScanTask &task) {
+	D_ASSERT(bind_data_p);
+	D_ASSERT(task.page_min <= task.page_max);
+	D_ASSERT(lstate.plan);
+
+	// the query is either wrapped in a binary COPY or read through a cursor (see ScanChunk)
+	lstate.sql = lstate.plan->GetTaskSQL(*bind_data_p, task);
 	lstate.exec = false;
 	lstate.done = false;
+	if (lstate.statistics) {
+		lstate.task_start = PostgresScanStatistics::Now();
+		lstate.task_active = true;
+	}
 }
 
 static idx_t PostgresMaxThreads(ClientContext &context, const FunctionData *bind_data_p) {
@@ -258,72 +609,504 @@ static unique_ptr<LocalTableFunctionState> GetLocalState(ClientContext &context,
                                                          PostgresGlobalState &gstate);
 
 static void PostgresScanConnect(PostgresConnection &conn, string snapshot) {
-	conn.Execute("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY");
+	string query = "BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY";
 	if (!snapshot.empty()) {
-		conn.Query(StringUtil::Format("SET TRANSACTION SNAPSHOT '%s'", snapshot));
+		// import the snapshot in the same round trip
+		query += StringUtil::Format(";\nSET TRANSACTION SNAPSHOT '%s'", snapshot);
+	}
+	conn.ExecuteQueries(query);
+}
+
+//! Scan the table in its entirety and materialize the result
+static shared_ptr<ColumnDataCollection> PostgresMaterializeScan(ClientContext &context, TableFunctionInitInput &input,
+                                                               PostgresGlobalState &gstate) {
+	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
+	vector<LogicalType> types;
+	for (auto column_id : input.column_ids) {
+		types.push_back(column_id == COLUMN_IDENTIFIER_ROW_ID ? LogicalType::BIGINT : bind_data.types[column_id]);
 	}
+	// the collection is managed by the buffer manager so that large results can be spilled to disk
+	auto materialized = make_shared<ColumnDataCollection>(BufferManager::GetBufferManager(context), types);
+	DataChunk scan_chunk;
+	scan_chunk.Initialize(Allocator::Get(context), types);
+
+	auto local_state = GetLocalState(context, input, gstate);
+	auto &lstate = local_state->Cast<PostgresLocalState>();
+	ColumnDataAppendState append_state;
+	materialized->InitializeAppend(append_state);
+	while (true) {
+		scan_chunk.Reset();
+		lstate.ScanChunk(context, bind_data, gstate, scan_chunk);
+		if (scan_chunk.size() == 0) {
+			break;
+		}
+		materialized->Append(append_state, scan_chunk);
+	}
+	return materialized;
+}
+
+//! Whether or not the result of the scan can be served from (and stored in) the result cache of the catalog
+static bool UseResultCache(ClientContext &context, const PostgresBindData &bind_data, idx_t &capacity,
+                           idx_t &ttl_seconds) {
+	if (!bind_data.GetCatalog() || !bind_data.read_only || bind_data.table_name.empty()) {
+		return false;
+	}
+	// the result of a scan with runtime filters depends on the other side of the join
+	if (!bind_data.runtime_filters.empty()) {
+		return false;
+	}
+	// the rows of a distributed table are stored on the worker nodes - the freshness probe of the coordinator does
+	// not see their changes
+	if (!bind_data.worker_nodes.empty()) {
+		return false;
+	}
+	// within an explicit transaction the scan has to reflect the snapshot and the changes of that transaction
+	if (!context.transaction.IsAutoCommit()) {
+		return false;
+	}
+	Value cache_size;
+	if (!context.TryGetCurrentSetting("pg_result_cache_size", cache_size)) {
+		return false;
+	}
+	capacity = UBigIntValue::Get(cache_size);
+	if (capacity == 0) {
+		return false;
+	}
+	ttl_seconds = 0;
+	Value cache_ttl;
+	if (context.TryGetCurrentSetting("pg_result_cache_ttl", cache_ttl)) {
+		ttl_seconds = UBigIntValue::Get(cache_ttl);
+	}
+	// the freshness probe is best-effort (see GetFreshness) - results are only cached if they expire
+	return ttl_seconds > 0;
+}
+
+static string GetResultCacheKey(const PostgresBindData &bind_data, TableFunctionInitInput &input) {
+	string key = PostgresResultCache::GetTableKey(bind_data.schema_name, bind_data.table_name);
+	key += "(";
+	for (idx_t i = 0; i < input.column_ids.size(); i++) {
+		auto column_id = input.column_ids[i];
+		if (i > 0) {
+			key += ", ";
+		}
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID) {
+			key += "ctid";
+		} else {
+			key += bind_data.GetColumnSQL(column_id);
+		}
+	}
+	key += ")";
+	auto filters = PostgresFilterPushdown::TransformFilters(input.column_ids, input.filters, bind_data.names,
+	                                                        bind_data.postgres_types);
+	for (auto &predicate : bind_data.pushdown_predicates) {
+		if (!filters.empty()) {
+			filters += " AND ";
+		}
+		filters += predicate;
+	}
+	if (!filters.empty()) {
+		key += " WHERE " + filters;
+	}
+	if (!bind_data.limit_clause.empty()) {
+		key += " " + bind_data.limit_clause;
+	}
+	return key;
+}
+
+//! Whether or not the scan can run on a read replica - only table scans of queries that do not modify the attached
+//! database run on a replica, as the replica does not see the changes of the current transaction
+static bool UseReplica(ClientContext &context, const PostgresBindData &bind_data, PostgresCatalog &catalog,
+                       idx_t &max_lag_ms) {
+	if (catalog.GetReplicaPools().empty() || bind_data.table_name.empty() || bind_data.requires_materialization) {
+		return false;
+	}
+	if (!context.transaction.IsAutoCommit()) {
+		// in an explicit transaction all scans should see the snapshot of the transaction on the primary
+		return false;
+	}
+	auto modified_database = MetaTransaction::Get(context).ModifiedDatabase();
+	if (modified_database && modified_database.get() == &catalog.GetAttached()) {
+		return false;
+	}
+	max_lag_ms = 0;
+	Value replica_max_lag_ms;
+	if (context.TryGetCurrentSetting("pg_replica_max_lag_ms", replica_max_lag_ms)) {
+		max_lag_ms = UBigIntValue::Get(replica_max_lag_ms);
+	}
+	return true;
+}
+
+//! Split the scan on the key of an index if the filters of the scan are selective (pg_index_range_scan)
+static void PostgresSplitOnIndex(ClientContext &context, TableFunctionInitInput &input, PostgresGlobalState &gstate) {
+	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
+	if (!input.filters || input.filters->filters.empty() || bind_data.table_name.empty() ||
+	    bind_data.pages_approx == 0 || gstate.max_threads <= 1 || !bind_data.leaf_partitions.empty() ||
+	    !bind_data.partition_filters.empty() || !bind_data.runtime_filters.empty()) {
+		return;
+	}
+	Value index_range_scan;
+	if (!context.TryGetCurrentSetting("pg_index_range_scan", index_range_scan) ||
+	    !BooleanValue::Get(index_range_scan)) {
+		return;
+	}
+	// one range per thread - the ranges are not split further while the scan runs
+	auto max_ranges =
+	    MinValue<idx_t>(gstate.max_threads, idx_t(TaskScheduler::GetScheduler(context).NumberOfThreads()));
+	gstate.key_ranges = PostgresIndexRanges::GetKeyRanges(gstate.GetConnection(), bind_data, input.column_ids,
+	                                                      *input.filters, max_ranges);
+	if (!gstate.key_ranges.empty()) {
+		gstate.max_threads = gstate.key_ranges.size();
+	}
+}
+
+//! Skip the page ranges of the table that the BRIN indexes rule out for the filters of the scan (pg_brin_pruning)
+static void PostgresPruneRanges(ClientContext &context, TableFunctionInitInput &input, PostgresGlobalState &gstate) {
+	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
+	if (!input.filters || input.filters->filters.empty() || bind_data.table_name.empty() ||
+	    bind_data.pages_approx <= 1 || !bind_data.leaf_partitions.empty() || !bind_data.partition_filters.empty()) {
+		return;
+	}
+	Value brin_pruning;
+	if (!context.TryGetCurrentSetting("pg_brin_pruning", brin_pruning) || !BooleanValue::Get(brin_pruning)) {
+		return;
+	}
+	gstate.pruned_ranges = PostgresBrinPruning::GetPrunedRanges(gstate.GetConnection(), bind_data, input.column_ids,
+	                                                            *input.filters);
+	if (gstate.pruned_ranges.empty() || bind_data.task_target_ms > 0) {
+		return;
+	}
+	// fewer pages have to be scanned - so fewer threads are needed
+	idx_t pruned_pages = 0;
+	for (auto &range : gstate.pruned_ranges) {
+		pruned_pages += range.end - range.start;
+	}
+	auto remaining_pages = bind_data.pages_approx - pruned_pages;
+	gstate.max_threads =
+	    MinValue<idx_t>(gstate.max_threads, MaxValue<idx_t>(remaining_pages / bind_data.pages_per_task, 1));
 }
 
 static unique_ptr<GlobalTableFunctionState> PostgresInitGlobalState(ClientContext &context,
                                                                     TableFunctionInitInput &input) {
 	auto &bind_data = input.bind_data->Cast<PostgresBindData>();
 	auto result = make_uniq<PostgresGlobalState>(PostgresMaxThreads(context, input.bind_data.get()));
+	result->plan = PostgresScanPlan::Create(bind_data, input.column_ids, input.filters.get());
+	Value scan_statistics;
+	if (context.TryGetCurrentSetting("pg_scan_statistics", scan_statistics) && BooleanValue::Get(scan_statistics)) {
+		auto source = bind_data.table_name.empty() ? bind_data.sql
+		                                           : KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+		                                                 KeywordHelper::WriteQuoted(bind_data.table_name, '"');
+		result->statistics = make_shared<PostgresScanStatistics>(std::move(source));
+		auto extension_state = PostgresExtensionState::Get(context);
+		if (extension_state) {
+			extension_state->AddScanStatistics(result->statistics);
+		}
+	}
 	auto pg_catalog = bind_data.GetCatalog();
+	optional_ptr<PostgresTransaction> pg_transaction;
 	if (pg_catalog) {
-		auto &transaction = Transaction::Get(context, *pg_catalog).Cast<PostgresTransaction>();
-		auto &con = transaction.GetConnection();
+		pg_transaction = &Transaction::Get(context, *pg_catalog).Cast<PostgresTransaction>();
+	}
+	idx_t replica_max_lag_ms;
+	if (pg_catalog && UseReplica(context, bind_data, *pg_catalog, replica_max_lag_ms) &&
+	    pg_transaction->TryGetReplicaConnection(replica_max_lag_ms, result->replica_connection, result->pool)) {
+		// the scan runs on the replica of the transaction in its own (read-only) transaction
+		result->SetConnection(result->replica_connection.GetConnection().GetConnection());
+		PostgresScanConnect(result->GetConnection(), string());
+	} else if (pg_catalog) {
+		auto &con = pg_transaction->GetConnection();
 		result->SetConnection(con.GetConnection());
+		result->pool = &pg_catalog->GetConnectionPool();
+		result->transaction = pg_transaction;
 	} else {
 		auto con = PostgresConnection::Open(bind_data.dsn);
-		PostgresScanConnect(con, string());
+		PostgresScanConnect(con, bind_data.snapshot);
 		result->SetConnection(std::move(con));
 	}
-	if (bind_data.requires_materialization) {
-		// if requires_materialization is enabled we scan and materialize the table in its entirety up-front
-		vector<LogicalType> types;
-		for (auto column_id : input.column_ids) {
-			types.push_back(column_id == COLUMN_IDENTIFIER_ROW_ID ? LogicalType::BIGINT : bind_data.types[column_id]);
-		}
-		auto materialized = make_uniq<ColumnDataCollection>(Allocator::Get(context), types);
-		DataChunk scan_chunk;
-		scan_chunk.Initialize(Allocator::Get(context), types);
-
-		auto local_state = GetLocalState(context, input, *result);
-		auto &lstate = local_state->Cast<PostgresLocalState>();
-		ColumnDataAppendState append_state;
-		materialized->InitializeAppend(append_state);
-		while (true) {
-			scan_chunk.Reset();
-			lstate.ScanChunk(context, bind_data, *result, scan_chunk);
-			if (scan_chunk.size() == 0) {
-				break;
+	if (!bind_data.worker_nodes.empty() && !bind_data.requires_materialization) {
+		// the shards are read from the worker nodes - which cannot import a snapshot of the coordinator
+		// the shards are sorted by node, and every node stores at least one of them
+		for (idx_t leaf_start = 0; leaf_start < bind_data.leaf_partitions.size();) {
+			auto worker_node = bind_data.leaf_partitions[leaf_start].worker_node;
+			D_ASSERT(worker_node == result->worker_scans.size());
+			auto leaf_end = leaf_start;
+			while (leaf_end < bind_data.leaf_partitions.size() &&
+			       bind_data.leaf_partitions[leaf_end].worker_node == worker_node) {
+				leaf_end++;
 			}
-			materialized->Append(append_state, scan_chunk);
+			result->worker_scans.emplace_back(leaf_start, leaf_end);
+			leaf_start = leaf_end;
 		}
-		result->collection = std::move(materialized);
-		result->collection->InitializeScan(result->scan_state);
-	} else {
+	}
+	idx_t cache_capacity;
+	idx_t cache_ttl;
+	if (UseResultCache(context, bind_data, cache_capacity, cache_ttl)) {
+		auto freshness = PostgresResultCache::GetFreshness(result->GetConnection(), bind_data.schema_name,
+		                                                   bind_data.table_name, bind_data.relation_kind);
+		// on a miss the result is materialized up-front using a single connection
+		result->max_threads = 1;
+		auto &cache = pg_catalog->GetResultCache();
+		auto key = GetResultCacheKey(bind_data, input);
+		auto cached_result = cache.Lookup(key, freshness, cache_ttl);
+		if (!cached_result) {
+			cached_result = PostgresMaterializeScan(context, input, *result);
+			cache.Insert(key, PostgresResultCache::GetTableKey(bind_data.schema_name, bind_data.table_name),
+			             std::move(freshness), cached_result, cache_capacity);
+		}
+		result->collection = std::move(cached_result);
+		result->InitializeCollectionScan();
+		return std::move(result);
+	}
+	if (bind_data.requires_materialization) {
+		// if requires_materialization is enabled we scan and materialize the table in its entirety up-front
+		result->collection = PostgresMaterializeScan(context, input, *result);
+		result->InitializeCollectionScan();
+	} else if (result->worker_scans.empty()) {
 		// we create a transaction here, and get the snapshot id to enable transaction-safe parallelism
 		PostgresGetSnapshot(bind_data.version, bind_data, *result);
+		PostgresSplitOnIndex(context, input, *result);
+		if (result->key_ranges.empty()) {
+			PostgresPruneRanges(context, input, *result);
+		}
+	}
+	Value connection_sharing;
+	if (pg_catalog && !result->collection && result->max_threads > 1 && result->worker_scans.empty() &&
+	    context.TryGetCurrentSetting("pg_scan_connection_sharing", connection_sharing) &&
+	    BooleanValue::Get(connection_sharing)) {
+		result->connection_share = make_shared<PostgresScanConnectionShare>();
+		result->connection_share->remaining_tasks = result->RemainingTasks(bind_data);
+		result->pool->RegisterScan(result->connection_share);
+	}
+	Value reuse_scan_connections;
+	if (result->transaction && !result->connection_share && !result->snapshot.empty() && bind_data.snapshot.empty() &&
+	    context.TryGetCurrentSetting("pg_reuse_scan_connections", reuse_scan_connections) &&
+	    BooleanValue::Get(reuse_scan_connections)) {
+		// the connections of the threads are attached to the snapshot of the transaction - they can be handed to
+		// the later scans of the transaction instead of being closed
+		result->reuse_scan_connections = true;
 	}
 	return std::move(result);
 }
 
-static bool PostgresParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
-                                      PostgresLocalState &lstate, PostgresGlobalState &gstate) {
-	D_ASSERT(bind_data_p);
-	auto bind_data = (const PostgresBindData *)bind_data_p;
+idx_t PostgresGlobalState::GetTaskPages(const PostgresBindData &bind_data) {
+	if (bind_data.task_target_ms == 0) {
+		return bind_data.pages_per_task;
+	}
+	if (task_pages == 0) {
+		// until the first task finishes: split the table over the threads - but never exceed pages_per_task
+		auto share = bind_data.pages_approx / MaxValue<idx_t>(max_threads, 1);
+		task_pages = MinValue<idx_t>(bind_data.pages_per_task, MaxValue<idx_t>(share, POSTGRES_MIN_PAGES_PER_TASK));
+	}
+	return task_pages;
+}
 
-	lock_guard<mutex> parallel_lock(gstate.lock);
+void PostgresGlobalState::StartAdaptiveTask(const PostgresBindData &bind_data, PostgresLocalState &lstate,
+                                            idx_t pages) {
+	if (bind_data.task_target_ms == 0) {
+		return;
+	}
+	lstate.adaptive_task_pages = pages;
+	lstate.adaptive_task_start = PostgresScanStatistics::Now();
+}
+
+void PostgresGlobalState::FinishAdaptiveTask(const PostgresBindData &bind_data, PostgresLocalState &lstate) {
+	if (lstate.adaptive_task_pages == 0) {
+		return;
+	}
+	finished_task_pages += lstate.adaptive_task_pages;
+	finished_task_time_ns += MaxValue<idx_t>(PostgresScanStatistics::Now() - lstate.adaptive_task_start, 1);
+	lstate.adaptive_task_pages = 0;
+	// resize the tasks toward the target duration based on the throughput of a single task so far
+	// the size grows by at most 4x at a time so that a few unusually fast tasks (e.g. of empty pages) cannot blow up
+	// the task size
+	auto pages_per_ns = double(finished_task_pages) / double(finished_task_time_ns);
+	auto target_pages = idx_t(pages_per_ns * double(bind_data.task_target_ms) * 1000000.0);
+	auto current_pages = GetTaskPages(bind_data);
+	task_pages = MaxValue<idx_t>(MinValue<idx_t>(target_pages, current_pages * 4), POSTGRES_MIN_PAGES_PER_TASK);
+}
+
+//! The amount of tasks of the leaf partitions [leaf_idx, leaf_end) that have not been handed out yet - page_idx is the
+//! next page to scan within the leaf partition at leaf_idx
+static idx_t RemainingLeafTasks(const PostgresBindData &bind_data, idx_t pages_per_task, idx_t leaf_idx,
+                                idx_t leaf_end, idx_t page_idx) {
+	idx_t remaining_tasks = 0;
+	for (idx_t i = leaf_idx; i < leaf_end; i++) {
+		auto &leaf = bind_data.leaf_partitions[i];
+		if (leaf.pages_approx == 0) {
+			remaining_tasks++;
+			continue;
+		}
+		auto start_page = i == leaf_idx ? MinValue<idx_t>(page_idx, leaf.pages_approx) : 0;
+		remaining_tasks += (leaf.pages_approx - start_page + pages_per_task - 1) / pages_per_task;
+	}
+	return remaining_tasks;
+}
+
+idx_t PostgresGlobalState::RemainingTasks(const PostgresBindData &bind_data) {
+	if (!bind_data.partition_filters.empty()) {
+		return bind_data.partition_filters.size() - MinValue<idx_t>(partition_idx, bind_data.partition_filters.size());
+	}
+	if (!key_ranges.empty()) {
+		return key_ranges.size() - MinValue<idx_t>(partition_idx, key_ranges.size());
+	}
+	auto pages_per_task = MaxValue<idx_t>(GetTaskPages(bind_data), 1);
+	if (bind_data.leaf_partitions.empty()) {
+		auto remaining_pages = bind_data.pages_approx - MinValue<idx_t>(page_idx, bind_data.pages_approx);
+		return (remaining_pages + pages_per_task - 1) / pages_per_task;
+	}
+	if (worker_scans.empty()) {
+		return RemainingLeafTasks(bind_data, pages_per_task, leaf_idx, bind_data.leaf_partitions.size(), page_idx);
+	}
+	idx_t remaining_tasks = 0;
+	for (auto &worker : worker_scans) {
+		remaining_tasks +=
+		    RemainingLeafTasks(bind_data, pages_per_task, worker.leaf_idx, worker.leaf_end, worker.page_idx);
+	}
+	return remaining_tasks;
+}
+
+bool PostgresGlobalState::AssignWorkerNode(const PostgresBindData &bind_data, PostgresLocalState &lstate) {
+	if (lstate.worker_node != DConstants::INVALID_INDEX) {
+		worker_scans[lstate.worker_node].threads--;
+	}
+	auto pages_per_task = MaxValue<idx_t>(GetTaskPages(bind_data), 1);
+	auto best_node = DConstants::INVALID_INDEX;
+	double best_share = 0;
+	for (idx_t node = 0; node < worker_scans.size(); node++) {
+		auto &worker = worker_scans[node];
+		auto remaining_tasks =
+		    RemainingLeafTasks(bind_data, pages_per_task, worker.leaf_idx, worker.leaf_end, worker.page_idx);
+		if (remaining_tasks == 0) {
+			continue;
+		}
+		auto share = double(remaining_tasks) / double(worker.threads + 1);
+		if (best_node == DConstants::INVALID_INDEX || share > best_share) {
+			best_node = node;
+			best_share = share;
+		}
+	}
+	lstate.worker_node = best_node;
+	if (best_node == DConstants::INVALID_INDEX) {
+		return false;
+	}
+	worker_scans[best_node].threads++;
+	return true;
+}
+
+//! Hand out the next task of the leaf partitions [leaf_idx, leaf_end) - advances leaf_idx and page_idx (the next page
+//! within the leaf partition). Returns false if all tasks of those leaf partitions have been handed out
+static bool PostgresNextLeafTask(ClientContext &context, const PostgresBindData &bind_data,
+                                 PostgresLocalState &lstate, PostgresGlobalState &gstate, idx_t leaf_end,
+                                 idx_t &leaf_idx, idx_t &page_idx) {
+	// hand out ctid ranges for each of the leaf partitions in turn
+	while (leaf_idx < leaf_end) {
+		auto &leaf = bind_data.leaf_partitions[leaf_idx];
+		if (leaf.pages_approx == 0) {
+			// no (usable) pages - scan the partition in one go
+			PostgresScanTask task;
+			task.leaf_partition = leaf;
+			PostgresInitInternal(context, &bind_data, lstate, task);
+			leaf_idx++;
+			page_idx = 0;
+			return true;
+		}
+		if (page_idx < leaf.pages_approx) {
+			auto task_pages = gstate.GetTaskPages(bind_data);
+			auto page_max = page_idx + task_pages;
+			if (page_max >= leaf.pages_approx) {
+				page_max = POSTGRES_TID_MAX;
+			}
+			PostgresScanTask task(page_idx, page_max);
+			task.leaf_partition = leaf;
+			PostgresInitInternal(context, &bind_data, lstate, task);
+			auto scanned_pages = MinValue<idx_t>(task_pages, leaf.pages_approx - page_idx);
+			gstate.StartAdaptiveTask(bind_data, lstate, scanned_pages);
+			page_idx = page_max;
+			return true;
+		}
+		leaf_idx++;
+		page_idx = 0;
+	}
+	return false;
+}
+
+static bool PostgresParallelStateNextInternal(ClientContext &context, const PostgresBindData *bind_data,
+                                              PostgresLocalState &lstate, PostgresGlobalState &gstate) {
+	gstate.FinishAdaptiveTask(*bind_data, lstate);
 	lstate.batch_idx = gstate.batch_idx++;
+	if (!bind_data->partition_filters.empty()) {
+		// every task scans one of the partitions
+		if (gstate.partition_idx < bind_data->partition_filters.size()) {
+			PostgresScanTask task;
+			task.partition_filter = bind_data->partition_filters[gstate.partition_idx++];
+			PostgresInitInternal(context, bind_data, lstate, task);
+			return true;
+		}
+		lstate.done = true;
+		return false;
+	}
+	if (!gstate.key_ranges.empty()) {
+		// every task scans one range of the key of an index
+		if (gstate.partition_idx < gstate.key_ranges.size()) {
+			PostgresScanTask task;
+			task.partition_filter = gstate.key_ranges[gstate.partition_idx++];
+			PostgresInitInternal(context, bind_data, lstate, task);
+			return true;
+		}
+		lstate.done = true;
+		return false;
+	}
+	if (!gstate.worker_scans.empty()) {
+		// the thread reads the shards of its worker node - and moves to another node once those are handed out
+		if (lstate.worker_node != DConstants::INVALID_INDEX || gstate.AssignWorkerNode(*bind_data, lstate)) {
+			do {
+				auto &worker = gstate.worker_scans[lstate.worker_node];
+				if (PostgresNextLeafTask(context, *bind_data, lstate, gstate, worker.leaf_end, worker.leaf_idx,
+				                         worker.page_idx)) {
+					return true;
+				}
+			} while (gstate.AssignWorkerNode(*bind_data, lstate));
+		}
+		lstate.done = true;
+		return false;
+	}
+	if (!bind_data->leaf_partitions.empty()) {
+		if (PostgresNextLeafTask(context, *bind_data, lstate, gstate, bind_data->leaf_partitions.size(),
+		                         gstate.leaf_idx, gstate.page_idx)) {
+			return true;
+		}
+		lstate.done = true;
+		return false;
+	}
+	// skip the pages that cannot contain matching rows
+	while (gstate.pruned_idx < gstate.pruned_ranges.size() &&
+	       gstate.pruned_ranges[gstate.pruned_idx].start <= gstate.page_idx) {
+		gstate.page_idx = MaxValue<idx_t>(gstate.page_idx, gstate.pruned_ranges[gstate.pruned_idx].end);
+		gstate.pruned_idx++;
+	}
 	if (gstate.page_idx < bind_data->pages_approx) {
-		auto page_max = gstate.page_idx + bind_data->pages_per_task;
+		// hand out pages_per_task pages at a time - but once the remaining pages no longer make up a full task for
+		// every running thread, split the remaining range so that every thread keeps on getting work until the scan
+		// finishes. max_threads is the amount of tasks of the scan - the scan runs on at most the scheduler threads
+		auto remaining_pages = bind_data->pages_approx - gstate.page_idx;
+		auto task_pages = gstate.GetTaskPages(*bind_data);
+		auto threads = MinValue<idx_t>(MaxValue<idx_t>(gstate.max_threads, 1),
+		                               idx_t(TaskScheduler::GetScheduler(context).NumberOfThreads()));
+		if (threads > 1 && remaining_pages < task_pages * threads) {
+			auto fair_share = remaining_pages / (2 * threads);
+			task_pages = MinValue<idx_t>(task_pages, MaxValue<idx_t>(fair_share, POSTGRES_MIN_PAGES_PER_TASK));
+		}
+		if (gstate.pruned_idx < gstate.pruned_ranges.size()) {
+			// the task ends where the next pruned range starts
+			task_pages = MinValue<idx_t>(task_pages, gstate.pruned_ranges[gstate.pruned_idx].start - gstate.page_idx);
+		}
+		auto page_max = gstate.page_idx + task_pages;
 		if (page_max >= bind_data->pages_approx) {
-			// the relpages entry is not the real max, so make the last task bigger
+			// the table might have grown since we determined its size, so make the last task open-ended
 			page_max = POSTGRES_TID_MAX;
 		}
 
-		PostgresInitInternal(context, bind_data, lstate, gstate.page_idx, page_max);
+		PostgresInitInternal(context, bind_data, lstate, PostgresScanTask(gstate.page_idx, page_max));
+		gstate.StartAdaptiveTask(*bind_data, lstate, MinValue<idx_t>(task_pages, remaining_pages));
 		gstate.page_idx = page_max;
 		return true;
 	}
@@ -331,30 +1114,89 @@ static bool PostgresParallelStateNext(ClientContext &context, const FunctionData
 	return false;
 }
 
+static bool PostgresParallelStateNext(ClientContext &context, const FunctionData *bind_data_p,
+                                      PostgresLocalState &lstate, PostgresGlobalState &gstate) {
+	D_ASSERT(bind_data_p);
+	auto bind_data = (const PostgresBindData *)bind_data_p;
+
+	lock_guard<mutex> parallel_lock(gstate.lock);
+	if (!lstate.connection_share) {
+		return PostgresParallelStateNextInternal(context, bind_data, lstate, gstate);
+	}
+	if (lstate.exec && lstate.share_pool->ShouldYieldConnection(*lstate.connection_share)) {
+		// another scan that is further behind is waiting for a connection - this thread finishes so that its
+		// connection slot is handed over when the scan state is destroyed
+		gstate.FinishAdaptiveTask(*bind_data, lstate);
+		lstate.done = true;
+		return false;
+	}
+	auto result = PostgresParallelStateNextInternal(context, bind_data, lstate, gstate);
+	lstate.connection_share->remaining_tasks = gstate.RemainingTasks(*bind_data);
+	return result;
+}
+
+bool PostgresGlobalState::TryReuseScanConnection(PostgresLocalState &lstate) {
+	if (!reuse_scan_connections || !transaction->TryGetScanConnection(lstate.pool_connection)) {
+		return false;
+	}
+	// the connection is already in a transaction that is attached to the snapshot
+	lstate.connection = PostgresConnection(lstate.pool_connection.GetConnection().GetConnection());
+	lstate.scan_transaction = transaction;
+	return true;
+}
+
 bool PostgresGlobalState::TryOpenNewConnection(ClientContext &context, PostgresLocalState &lstate,
                                                const PostgresBindData &bind_data) {
 	auto pg_catalog = bind_data.GetCatalog();
+	if (!worker_scans.empty()) {
+		// the thread connects to a worker node once it is handed a task there (see ConnectWorker)
+		return true;
+	}
 	{
 		lock_guard<mutex> parallel_lock(lock);
 		if (!used_main_thread) {
 			if (bind_data.can_use_main_thread) {
 				lstate.connection = PostgresConnection(GetConnection().GetConnection());
+				lstate.uses_transaction_connection = transaction != nullptr;
 			} else {
 				// we cannot use the main thread but we haven't initiated ANY scan yet
 				// we HAVE to open a new connection
-				lstate.pool_connection = pg_catalog->GetConnectionPool().ForceGetConnection();
+				if (TryReuseScanConnection(lstate)) {
+					used_main_thread = true;
+					return true;
+				}
+				lstate.pool_connection = pool->ForceGetConnection();
 				lstate.connection = PostgresConnection(lstate.pool_connection.GetConnection().GetConnection());
+				PostgresScanConnect(lstate.connection, snapshot);
+				if (reuse_scan_connections) {
+					lstate.scan_transaction = transaction;
+				}
 			}
 			used_main_thread = true;
 			return true;
 		}
 	}
 
-	if (pg_catalog) {
-		if (!pg_catalog->GetConnectionPool().TryGetConnection(lstate.pool_connection)) {
+	if (pg_catalog && connection_share) {
+		// wait for a slot to be handed over by another scan if all slots are in use
+		if (!pool->TryGetScanConnection(*connection_share, lstate.pool_connection,
+		                                PostgresConnectionPool::DEFAULT_SCAN_CONNECTION_WAIT_MS)) {
+			return false;
+		}
+		lstate.connection_share = connection_share;
+		lstate.share_pool = pool;
+		lstate.connection = PostgresConnection(lstate.pool_connection.GetConnection().GetConnection());
+	} else if (pg_catalog) {
+		if (TryReuseScanConnection(lstate)) {
+			return true;
+		}
+		if (!pool->TryGetConnection(lstate.pool_connection)) {
 			return false;
 		}
 		lstate.connection = PostgresConnection(lstate.pool_connection.GetConnection().GetConnection());
+		if (reuse_scan_connections) {
+			lstate.scan_transaction = transaction;
+		}
 	} else {
 		lstate.connection = PostgresConnection::Open(bind_data.dsn);
 	}
@@ -371,16 +1213,91 @@ static unique_ptr<LocalTableFunctionState> GetLocalState(ClientContext &context,
 		return std::move(local_state);
 	}
 	local_state->column_ids = input.column_ids;
+	local_state->plan = gstate.plan;
+	Value scan_thread_affinity;
+	if (context.TryGetCurrentSetting("pg_scan_thread_affinity", scan_thread_affinity) &&
+	    BooleanValue::Get(scan_thread_affinity) && PostgresThreadAffinity::NodeCount() > 1) {
+		local_state->affinity_node = gstate.next_node++;
+	}
+	// pin the thread before anything is allocated - the connection and the buffers of the scan are then placed on
+	// the node it is read on
+	local_state->affinity.Pin(local_state->affinity_node);
+	bool zero_copy = false;
+	Value zero_copy_strings;
+	if (context.TryGetCurrentSetting("pg_zero_copy_strings", zero_copy_strings)) {
+		zero_copy = BooleanValue::Get(zero_copy_strings);
+	}
+	bool dictionary_strings = false;
+	Value pg_dictionary_strings;
+	if (context.TryGetCurrentSetting("pg_dictionary_strings", pg_dictionary_strings)) {
+		dictionary_strings = BooleanValue::Get(pg_dictionary_strings);
+	}
+	local_state->InitializeDecoders(bind_data, zero_copy, dictionary_strings);
 
 	local_state->filters = input.filters.get();
+	local_state->statistics = gstate.statistics;
+	auto connection_start = local_state->statistics ? PostgresScanStatistics::Now() : 0;
 	if (!gstate.TryOpenNewConnection(context, *local_state, bind_data)) {
 		// if the connection pool is exhausted we bail-out
 		local_state->no_connection = true;
 		return std::move(local_state);
 	}
-	if (bind_data.pages_approx == 0 || bind_data.requires_materialization) {
-		PostgresInitInternal(context, &bind_data, *local_state, 0, POSTGRES_TID_MAX);
+	if (local_state->statistics) {
+		local_state->statistics->connection_time_ns += PostgresScanStatistics::Now() - connection_start;
+	}
+	Value use_cursor_scan;
+	if (!bind_data.parameters.empty() ||
+	    (context.TryGetCurrentSetting("pg_use_cursor_scan", use_cursor_scan) && BooleanValue::Get(use_cursor_scan))) {
+		static atomic<idx_t> cursor_id {0};
+		local_state->use_cursor = true;
+		local_state->cursor_name = "duckdb_scan_cursor_" + to_string(cursor_id++);
+		Value cursor_fetch_size;
+		if (context.TryGetCurrentSetting("pg_cursor_fetch_size", cursor_fetch_size) &&
+		    UBigIntValue::Get(cursor_fetch_size) > 0) {
+			local_state->cursor_fetch_size = UBigIntValue::Get(cursor_fetch_size);
+		}
+	}
+	Value copy_compression_function;
+	if (!local_state->use_cursor &&
+	    context.TryGetCurrentSetting("pg_copy_compression_function", copy_compression_function) &&
+	    !copy_compression_function.IsNull() && !StringValue::Get(copy_compression_function).empty()) {
+		local_state->copy_compression_function = StringValue::Get(copy_compression_function);
+		local_state->decompressor = make_uniq<PostgresCopyDecompressor>();
+	}
+	// the threads that read the shards of a distributed table switch between the worker nodes - the COPY is not
+	// prefetched or sent ahead, as that would run on the connection to the previous node
+	auto worker_scan = !gstate.worker_scans.empty();
+	Value async_copy_prefetch;
+	if (!local_state->use_cursor && !worker_scan &&
+	    context.TryGetCurrentSetting("pg_async_copy_prefetch", async_copy_prefetch) &&
+	    BooleanValue::Get(async_copy_prefetch)) {
+		auto capacity = PostgresCopyPrefetcher::DEFAULT_CAPACITY;
+		local_state->prefetcher = make_uniq<PostgresCopyPrefetcher>(local_state->connection.GetConn(), capacity,
+		                                                            local_state->decompressor.get());
+	}
+	Value copy_arena_buffers;
+	if (!local_state->use_cursor && !local_state->prefetcher && !local_state->decompressor &&
+	    context.TryGetCurrentSetting("pg_copy_arena_buffers", copy_arena_buffers) &&
+	    BooleanValue::Get(copy_arena_buffers)) {
+		local_state->arena = make_uniq<PostgresRowArena>();
+	}
+	auto memory_budget = PostgresMemoryBudget::Get(context);
+	if (memory_budget) {
+		local_state->memory_reservation =
+		    make_uniq<PostgresMemoryReservation>(std::move(memory_budget), BufferManager::GetBufferManager(context));
+	}
+	Value copy_lookahead;
+	if (!local_state->use_cursor && !local_state->prefetcher && !worker_scan &&
+	    context.TryGetCurrentSetting("pg_copy_lookahead", copy_lookahead) && BooleanValue::Get(copy_lookahead)) {
+		local_state->copy_lookahead = true;
+	}
+	bool single_task =
+	    bind_data.pages_approx == 0 && bind_data.partition_filters.empty() && bind_data.leaf_partitions.empty();
+	if (single_task || bind_data.requires_materialization) {
+		PostgresInitInternal(context, &bind_data, *local_state, PostgresScanTask());
 		gstate.page_idx = POSTGRES_TID_MAX;
+		gstate.partition_idx = bind_data.partition_filters.size();
+		gstate.leaf_idx = bind_data.leaf_partitions.size();
 	} else if (!PostgresParallelStateNext(context, input.bind_data.get(), *local_state, gstate)) {
 		local_state->done = true;
 	}
@@ -394,58 +1311,251 @@ static unique_ptr<LocalTableFunctionState> PostgresInitLocalState(ExecutionConte
 	return GetLocalState(context.client, input, gstate);
 }
 
+void PostgresLocalState::ConnectWorker(const PostgresBindData &bind_data) {
+	ReleaseWorkerConnection();
+	auto connection_start = statistics ? PostgresScanStatistics::Now() : 0;
+	auto &dsn = bind_data.worker_nodes[worker_node];
+	auto pg_catalog = bind_data.GetCatalog();
+	if (pg_catalog) {
+		// the amount of threads of the scan is bounded already - every thread holds a single connection
+		pool_connection = pg_catalog->GetWorkerPool(dsn).ForceGetConnection();
+		connection = PostgresConnection(pool_connection.GetConnection().GetConnection());
+	} else {
+		connection = PostgresConnection::Open(dsn);
+	}
+	PostgresScanConnect(connection, string());
+	connected_worker_node = worker_node;
+	if (statistics) {
+		statistics->connection_time_ns += PostgresScanStatistics::Now() - connection_start;
+	}
+}
+
+void PostgresLocalState::ReleaseWorkerConnection() {
+	if (connected_worker_node == DConstants::INVALID_INDEX) {
+		return;
+	}
+	// end the (read-only) transaction so that the pool can hand out the connection again
+	connection.TryQuery("COMMIT");
+	connection = PostgresConnection();
+	pool_connection = PostgresPoolConnection();
+	connected_worker_node = DConstants::INVALID_INDEX;
+}
+
+//! Whether or not the Postgres statistics of the column indicate few enough distinct values for a dictionary
+//! Columns without statistics are assumed to qualify - every batch falls back to a flat vector if it has too many
+//! distinct values
+static bool HasLowCardinality(const PostgresBindData &bind_data, column_t col_idx) {
+	static constexpr const double MAX_DICTIONARY_DISTINCT = 1000;
+	if (col_idx >= bind_data.column_statistics.size() || !bind_data.column_statistics[col_idx].has_statistics) {
+		return true;
+	}
+	double distinct_count = bind_data.column_statistics[col_idx].distinct_count;
+	if (distinct_count < 0) {
+		// a negative distinct count is a fraction of the amount of rows
+		if (bind_data.approx_num_rows < 0) {
+			return true;
+		}
+		distinct_count = -distinct_count * bind_data.approx_num_rows;
+	}
+	return distinct_count <= MAX_DICTIONARY_DISTINCT;
+}
+
+void PostgresLocalState::InitializeDecoders(const PostgresBindData &bind_data, bool zero_copy,
+                                            bool dictionary_strings) {
+	decoders.clear();
+	for (auto &col_idx : column_ids) {
+		if (col_idx == COLUMN_IDENTIFIER_ROW_ID) {
+			decoders.push_back(PostgresColumnDecoder::CreateCTID());
+		} else {
+			auto dictionary = dictionary_strings && HasLowCardinality(bind_data, col_idx);
+			decoders.push_back(PostgresColumnDecoder::Create(bind_data.types[col_idx],
+			                                                 bind_data.postgres_types[col_idx], zero_copy, dictionary));
+		}
+	}
+	fields.resize(column_ids.size());
+}
+
+//! The size of the values in a (binary) result as received from Postgres
+static idx_t GetResultSize(PostgresResult &result) {
+	idx_t size = 0;
+	auto row_count = int(result.Count());
+	auto column_count = PQnfields(result.res);
+	for (int row = 0; row < row_count; row++) {
+		for (int col = 0; col < column_count; col++) {
+			size += PQgetlength(result.res, row, col);
+		}
+	}
+	return size;
+}
+
+string PostgresLocalState::GetCopyQuery() const {
+	auto copy_query = sql;
+	if (decompressor) {
+		// the function runs the query and returns its binary COPY output compressed as a set of bytea
+		copy_query = StringUtil::Format("SELECT * FROM %s(%s)", copy_compression_function,
+		                                KeywordHelper::WriteQuoted(sql, '\''));
+	}
+	return StringUtil::Format("COPY (%s) TO STDOUT (FORMAT binary);", copy_query);
+}
+
 void PostgresLocalState::ScanChunk(ClientContext &context, const PostgresBindData &bind_data,
                                    PostgresGlobalState &gstate, DataChunk &output) {
+	// only pins the thread if the scan continues on another thread than before - the prefetch thread is started from
+	// here and inherits the affinity
+	affinity.Pin(affinity_node);
 	idx_t output_offset = 0;
-	PostgresBinaryReader reader(connection);
-	while (true) {
+	// when prefetching the received data is decompressed by the prefetcher
+	PostgresBinaryReader reader(connection, prefetcher.get(), prefetcher ? nullptr : decompressor.get());
+	reader.arena = arena.get();
+	reader.reservation = memory_reservation.get();
+	reader.collect_statistics = statistics != nullptr;
+	if (memory_reservation) {
+		// the rows of the previous chunk have been released - pause for the other scans to release theirs if the
+		// budget is exhausted, which stops this thread from reading from the connection in the meantime
+		memory_reservation->Throttle();
+	}
+	idx_t cursor_start = 0;
+	// first locate the values of a batch of rows - the row buffers are retained by the reader
+	while (output_offset < STANDARD_VECTOR_SIZE) {
+		if (output_offset > 0 && !reader.Ready() && memory_reservation && memory_reservation->BudgetExhausted()) {
+			// emit the rows read so far - so that they are processed and released before more rows are read
+			break;
+		}
+		if (done && task_active) {
+			statistics->AddTask(PostgresScanStatistics::Now() - task_start);
+			task_active = false;
+		}
 		if (done && !PostgresParallelStateNext(context, &bind_data, *this, gstate)) {
-			return;
+			break;
 		}
 		if (!exec) {
-			connection.BeginCopyFrom(reader, sql);
+			if (worker_node != connected_worker_node) {
+				// the task reads a shard that is stored on another node than the previous task of the thread
+				ConnectWorker(bind_data);
+			}
+			if (statistics) {
+				cursor_start = PostgresScanStatistics::Now();
+			}
+			if (use_cursor) {
+				// declare the cursor and fetch the first rows in a single round trip
+				vector<PostgresPipelineStatement> statements;
+				statements.emplace_back(StringUtil::Format("DECLARE %s NO SCROLL CURSOR FOR %s", cursor_name, sql),
+				                        bind_data.parameters);
+				statements.emplace_back(
+				    StringUtil::Format("FETCH FORWARD %llu FROM %s", cursor_fetch_size, cursor_name), vector<Value>(),
+				    true);
+				auto results = connection.ExecutePipeline(statements);
+				cursor_result = std::move(results[1]);
+				cursor_row = 0;
+			} else {
+				auto copy_sql = GetCopyQuery();
+				if (copy_pending) {
+					// the COPY was already sent while the rows of the previous task were being read
+					copy_pending = false;
+					connection.FinishCopyFrom(reader, copy_sql);
+				} else {
+					connection.BeginCopyFrom(reader, copy_sql);
+				}
+			}
 			exec = true;
+			if (statistics) {
+				reader.wait_time_ns += PostgresScanStatistics::Now() - cursor_start;
+				if (cursor_result) {
+					reader.bytes_received += GetResultSize(*cursor_result);
+				}
+			}
 		}
-
-		output.SetCardinality(output_offset);
-		if (output_offset == STANDARD_VECTOR_SIZE) {
-			return;
+		if (use_cursor) {
+			if (!cursor_result || cursor_row >= cursor_result->Count()) {
+				if (cursor_result && cursor_result->Count() < cursor_fetch_size) {
+					// the last fetch returned less rows than requested - the cursor is exhausted
+					connection.Execute("CLOSE " + cursor_name);
+					cursor_result.reset();
+					done = true;
+					continue;
+				}
+				if (statistics) {
+					cursor_start = PostgresScanStatistics::Now();
+				}
+				cursor_result = connection.QueryBinary(
+				    StringUtil::Format("FETCH FORWARD %llu FROM %s", cursor_fetch_size, cursor_name));
+				cursor_row = 0;
+				if (statistics) {
+					reader.wait_time_ns += PostgresScanStatistics::Now() - cursor_start;
+					reader.bytes_received += GetResultSize(*cursor_result);
+				}
+				continue;
+			}
+			reader.ReadResultFields(cursor_result, cursor_row++, fields, output_offset);
+			output_offset++;
+			continue;
 		}
 
-		while (!reader.Ready()) {
+		if (!reader.Ready()) {
 			if (!reader.Next()) {
 				// finished this batch
 				reader.CheckResult();
 				done = true;
-				continue;
 			}
+			continue;
 		}
 
 		auto tuple_count = reader.ReadInteger<int16_t>();
 		if (tuple_count <= 0) { // done here, lets try to get more
+			if (copy_lookahead && output_offset > 0) {
+				// claim the next task and send its COPY right away - the server plans and starts executing it while
+				// the rows of this batch are decoded and processed
+				reader.FinishCopy();
+				if (task_active) {
+					statistics->AddTask(PostgresScanStatistics::Now() - task_start);
+					task_active = false;
+				}
+				if (!PostgresParallelStateNext(context, &bind_data, *this, gstate)) {
+					done = true;
+					break;
+				}
+				connection.SendCopyFrom(GetCopyQuery());
+				copy_pending = true;
+				break;
+			}
 			reader.Reset();
 			done = true;
 			continue;
 		}
 
 		D_ASSERT(tuple_count == column_ids.size());
-
-		for (idx_t output_idx = 0; output_idx < output.ColumnCount(); output_idx++) {
-			auto col_idx = column_ids[output_idx];
-			auto &out_vec = output.data[output_idx];
-			if (col_idx == COLUMN_IDENTIFIER_ROW_ID) {
-				// row id
-				// ctid in postgres are a composite type of (page_index, tuple_in_page)
-				// the page index is a 4-byte integer, the tuple_in_page a 2-byte integer
-				PostgresType ctid_type;
-				ctid_type.info = PostgresTypeAnnotation::CTID;
-				reader.ReadValue(LogicalType::BIGINT, ctid_type, out_vec, output_offset);
-			} else {
-				reader.ReadValue(bind_data.types[col_idx], bind_data.postgres_types[col_idx], out_vec, output_offset);
+		reader.ReadRowFields(fields, output_offset);
+		output_offset++;
+	}
+	// now decode the batch column-by-column
+	buffer_ptr<VectorBuffer> row_buffers;
+	for (idx_t output_idx = 0; output_idx < output.ColumnCount(); output_idx++) {
+		auto &decoder = decoders[output_idx];
+		auto &out_vec = output.data[output_idx];
+		auto decode_start = statistics ? PostgresScanStatistics::Now() : 0;
+		decoder.Decode(reader, fields[output_idx], output_offset, out_vec);
+		if (statistics) {
+			auto column_id = column_ids[output_idx];
+			auto type_name = column_id == COLUMN_IDENTIFIER_ROW_ID ? "ctid" : bind_data.types[column_id].ToString();
+			statistics->AddDecodeTime(type_name, PostgresScanStatistics::Now() - decode_start);
+		}
+		if (decoder.references_row_buffers) {
+			// the strings point into the row buffers - keep them alive for as long as the vector is
+			if (!row_buffers) {
+				row_buffers = reader.TakeRows();
 			}
+			StringVector::AddBuffer(out_vec, row_buffers);
 		}
-		reader.Reset();
-		output_offset++;
+	}
+	output.SetCardinality(output_offset);
+	if (output_offset == 0) {
+		// the scan of this thread is finished - the thread goes back to the other tasks of the scheduler
+		affinity.Release();
+	}
+	if (statistics) {
+		statistics->rows += output_offset;
+		statistics->bytes += reader.bytes_received;
+		statistics->wait_time_ns += reader.wait_time_ns;
 	}
 }
 
@@ -453,11 +1563,13 @@ static void PostgresScan(ClientContext &context, TableFunctionInput &data, DataC
 	auto &bind_data = data.bind_data->Cast<PostgresBindData>();
 	auto &gstate = data.global_state->Cast<PostgresGlobalState>();
 
+	auto &local_state = data.local_state->Cast<PostgresLocalState>();
 	if (gstate.collection) {
-		gstate.collection->Scan(gstate.scan_state, output);
+		gstate.collection->Scan(gstate.scan_state, local_state.collection_scan_state, output);
+		// chunks of the materialized result are handed out in order - their position serves as batch index
+		local_state.batch_idx = local_state.collection_scan_state.current_row_index;
 		return;
 	}
-	auto &local_state = data.local_state->Cast<PostgresLocalState>();
 	if (local_state.no_connection) {
 		return;
 	}
@@ -479,6 +1591,14 @@ static string PostgresScanToString(const FunctionData *bind_data_p) {
 
 unique_ptr<NodeStatistics> PostgresScanCardinality(ClientContext &context, const FunctionData *bind_data_p) {
 	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	if (bind_data.rows_per_page > 0 && bind_data.pages_approx > 0) {
+		// scale the density of the table when it was last analyzed to the current size of the table
+		// this is the same estimate the Postgres planner makes
+		return make_uniq<NodeStatistics>(idx_t(bind_data.rows_per_page * double(bind_data.pages_approx) + 0.5));
+	}
+	if (bind_data.approx_num_rows > 0 && bind_data.pages_approx == 0) {
+		return make_uniq<NodeStatistics>(idx_t(bind_data.approx_num_rows));
+	}
 	// see https://www.postgresql.org/docs/current/storage-page-layout.html
 	// pages are 8KB
 	// every page has ~24 bytes of overhead
@@ -486,21 +1606,70 @@ unique_ptr<NodeStatistics> PostgresScanCardinality(ClientContext &context, const
 	constexpr static idx_t POSTGRES_PAGE_SIZE = 8192 - PAGE_METADATA_SIZE;
 	// every row has ~23 bytes of overhead in the header
 	constexpr static idx_t ROW_META_DATA_SIZE = 23;
-	// for simplicity we assume every column is 8 bytes on average
-	auto row_size = ROW_META_DATA_SIZE + bind_data.types.size() * 8;
+	// we use the average width of the columns if Postgres has statistics - otherwise we assume 8 bytes per column
+	idx_t row_size = ROW_META_DATA_SIZE;
+	for (idx_t i = 0; i < bind_data.types.size(); i++) {
+		bool has_width = i < bind_data.column_statistics.size() && bind_data.column_statistics[i].has_statistics;
+		row_size += has_width ? bind_data.column_statistics[i].average_width : 8;
+	}
 	auto rows_per_page = MaxValue<idx_t>(1, POSTGRES_PAGE_SIZE / row_size);
 	auto estimated_cardinality = bind_data.pages_approx * rows_per_page;
 	return make_uniq<NodeStatistics>(estimated_cardinality);
 }
 
+unique_ptr<BaseStatistics> PostgresScanFunction::GetColumnStatistics(const LogicalType &type,
+                                                                     const PostgresColumnStatistics &statistics,
+                                                                     double approx_num_rows) {
+	if (!statistics.has_statistics) {
+		return nullptr;
+	}
+	// the statistics of Postgres are estimates that can be outdated - so we only provide the number of distinct values
+	// which is used for estimating join cardinalities, and not e.g. min/max values which are used to prune filters
+	double distinct_count = statistics.distinct_count;
+	if (distinct_count < 0) {
+		distinct_count = approx_num_rows > 0 ? -distinct_count * approx_num_rows : 0;
+	}
+	if (distinct_count < 1) {
+		return nullptr;
+	}
+	auto result = BaseStatistics::CreateUnknown(type);
+	result.SetDistinctCount(idx_t(distinct_count));
+	return result.ToUnique();
+}
+
+static unique_ptr<BaseStatistics> PostgresScanStatistics(ClientContext &context, const FunctionData *bind_data_p,
+                                                         column_t column_index) {
+	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
+	if (column_index >= bind_data.column_statistics.size()) {
+		return nullptr;
+	}
+	return PostgresScanFunction::GetColumnStatistics(bind_data.types[column_index],
+	                                                 bind_data.column_statistics[column_index],
+	                                                 bind_data.approx_num_rows);
+}
+
 double PostgresScanProgress(ClientContext &context, const FunctionData *bind_data_p,
                             const GlobalTableFunctionState *global_state) {
 	auto &bind_data = bind_data_p->Cast<PostgresBindData>();
 	auto &gstate = global_state->Cast<PostgresGlobalState>();
 
 	lock_guard<mutex> parallel_lock(gstate.lock);
-	double progress = 100 * double(gstate.page_idx) / double(bind_data.pages_approx);
-	;
+	double progress;
+	if (!bind_data.partition_filters.empty()) {
+		progress = 100 * double(gstate.partition_idx) / double(bind_data.partition_filters.size());
+	} else if (!gstate.key_ranges.empty()) {
+		progress = 100 * double(gstate.partition_idx) / double(gstate.key_ranges.size());
+	} else if (!gstate.worker_scans.empty()) {
+		idx_t scanned_leaves = 0;
+		for (auto &worker : gstate.worker_scans) {
+			scanned_leaves += worker.leaf_idx - worker.leaf_start;
+		}
+		progress = 100 * double(scanned_leaves) / double(bind_data.leaf_partitions.size());
+	} else if (!bind_data.leaf_partitions.empty()) {
+		progress = 100 * double(gstate.leaf_idx) / double(bind_data.leaf_partitions.size());
+	} else {
+		progress = 100 * double(gstate.page_idx) / double(bind_data.pages_approx);
+	}
 	return MinValue<double>(100, progress);
 }
 
@@ -521,8 +1690,10 @@ PostgresScanFunction::PostgresScanFunction()
 	deserialize = PostgresScanDeserialize;
 	get_batch_index = PostgresScanBatchIndex;
 	cardinality = PostgresScanCardinality;
+	statistics = PostgresScanStatistics;
 	table_scan_progress = PostgresScanProgress;
 	projection_pushdown = true;
+	named_parameters["snapshot"] = LogicalType::VARCHAR;
 }
 
 PostgresScanFunctionFilterPushdown::PostgresScanFunctionFilterPushdown()
@@ -533,8 +1704,10 @@ PostgresScanFunctionFilterPushdown::PostgresScanFunctionFilterPushdown()
 	deserialize = PostgresScanDeserialize;
 	get_batch_index = PostgresScanBatchIndex;
 	cardinality = PostgresScanCardinality;
+	statistics = PostgresScanStatistics;
 	table_scan_progress = PostgresScanProgress;
 	projection_pushdown = true;
+	named_parameters["snapshot"] = LogicalType::VARCHAR;
 	filter_pushdown = true;
 }
 
@@ -7,10 +7,39 @@
 
 namespace duckdb {
 
+//! The REPLICAS option is either a list of DSNs, or a single string with the DSNs separated by semicolons
+static vector<string> GetReplicaPaths(const Value &replicas) {
+	vector<string> result;
+	if (replicas.IsNull()) {
+		return result;
+	}
+	vector<string> paths;
+	if (replicas.type().id() == LogicalTypeId::LIST) {
+		for (auto &child : ListValue::GetChildren(replicas)) {
+			paths.push_back(child.ToString());
+		}
+	} else {
+		paths = StringUtil::Split(replicas.ToString(), ';');
+	}
+	for (auto &path : paths) {
+		StringUtil::Trim(path);
+		if (!path.empty()) {
+			result.push_back(std::move(path));
+		}
+	}
+	return result;
+}
+
 static unique_ptr<Catalog> PostgresAttach(StorageExtensionInfo *storage_info, ClientContext &context,
                                           AttachedDatabase &db, const string &name, AttachInfo &info,
                                           AccessMode access_mode) {
-	return make_uniq<PostgresCatalog>(db, info.path, access_mode);
+	vector<string> replica_paths;
+	for (auto &entry : info.options) {
+		if (StringUtil::CIEquals(entry.first, "replicas")) {
+			replica_paths = GetReplicaPaths(entry.second);
+		}
+	}
+	return make_uniq<PostgresCatalog>(db, info.path, access_mode, std::move(replica_paths));
 }
 
 static unique_ptr<TransactionManager> PostgresCreateTransactionManager(StorageExtensionInfo *storage_info,
@@ -0,0 +1,154 @@
+#include "postgres_thread_affinity.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/string_util.hpp"
+
+#include <fstream>
+
+namespace duckdb {
+
+#ifdef __linux__
+//! Parse a CPU list of the form "0-31,64-95"
+static vector<idx_t> ParseCPUList(const string &cpu_list) {
+	vector<idx_t> result;
+	for (auto &range : StringUtil::Split(StringUtil::Replace(cpu_list, "\n", ""), ",")) {
+		auto bounds = StringUtil::Split(range, "-");
+		if (bounds.empty() || bounds.size() > 2) {
+			continue;
+		}
+		auto start = std::stoull(bounds[0]);
+		auto end = bounds.size() == 2 ? std::stoull(bounds[1]) : start;
+		for (auto cpu = start; cpu <= end; cpu++) {
+			result.push_back(cpu);
+		}
+	}
+	return result;
+}
+
+//! The CPUs of every NUMA node that has CPUs - read once from sysfs
+static const vector<vector<idx_t>> &GetNodeCPUs() {
+	static vector<vector<idx_t>> node_cpus;
+	static std::once_flag loaded;
+	std::call_once(loaded, [&]() {
+		for (idx_t node = 0;; node++) {
+			std::ifstream file("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+			if (!file.is_open()) {
+				break;
+			}
+			string cpu_list;
+			std::getline(file, cpu_list);
+			try {
+				auto cpus = ParseCPUList(cpu_list);
+				if (!cpus.empty()) {
+					node_cpus.push_back(std::move(cpus));
+				}
+			} catch (std::exception &) {
+				// unexpected format - treat the system as a single node
+				node_cpus.clear();
+				break;
+			}
+		}
+	});
+	return node_cpus;
+}
+#endif
+
+#ifdef __linux__
+//! A thread that is pinned by a scan - and the affinity it had before any scan pinned it
+struct PinnedThread {
+	pthread_t thread;
+	cpu_set_t original_cpus;
+	const PostgresThreadAffinity *owner;
+};
+
+static mutex pinned_lock;
+static vector<PinnedThread> pinned_threads;
+//! The scan that most recently pinned the current thread
+static thread_local const PostgresThreadAffinity *thread_owner = nullptr;
+
+static vector<PinnedThread>::iterator FindPinnedThread(pthread_t thread) {
+	for (auto it = pinned_threads.begin(); it != pinned_threads.end(); it++) {
+		if (pthread_equal(it->thread, thread)) {
+			return it;
+		}
+	}
+	return pinned_threads.end();
+}
+#endif
+
+PostgresThreadAffinity::~PostgresThreadAffinity() {
+	Release();
+}
+
+void PostgresThreadAffinity::Pin(idx_t node) {
+#ifdef __linux__
+	if (node == DConstants::INVALID_INDEX) {
+		return;
+	}
+	auto current = pthread_self();
+	if (pinned && thread_owner == this && pthread_equal(thread, current)) {
+		// the thread is still pinned by this scan
+		return;
+	}
+	// the scan continues on another thread - release the thread it ran on before
+	Release();
+	auto &node_cpus = GetNodeCPUs();
+	if (node_cpus.size() <= 1) {
+		return;
+	}
+	lock_guard<mutex> guard(pinned_lock);
+	auto entry = FindPinnedThread(current);
+	cpu_set_t original_cpus;
+	if (entry != pinned_threads.end()) {
+		// another scan pinned the thread - its original affinity is kept
+		original_cpus = entry->original_cpus;
+	} else if (pthread_getaffinity_np(current, sizeof(cpu_set_t), &original_cpus) != 0) {
+		return;
+	}
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	for (auto cpu : node_cpus[node % node_cpus.size()]) {
+		if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &original_cpus)) {
+			CPU_SET(cpu, &cpus);
+		}
+	}
+	// never pin the thread to CPUs it was not allowed to run on
+	if (CPU_COUNT(&cpus) == 0 || pthread_setaffinity_np(current, sizeof(cpu_set_t), &cpus) != 0) {
+		return;
+	}
+	if (entry != pinned_threads.end()) {
+		entry->owner = this;
+	} else {
+		pinned_threads.push_back(PinnedThread {current, original_cpus, this});
+	}
+	thread = current;
+	thread_owner = this;
+	pinned = true;
+#endif
+}
+
+void PostgresThreadAffinity::Release() {
+#ifdef __linux__
+	if (!pinned) {
+		return;
+	}
+	pinned = false;
+	lock_guard<mutex> guard(pinned_lock);
+	auto entry = FindPinnedThread(thread);
+	if (entry == pinned_threads.end() || entry->owner != this) {
+		// another scan has pinned the thread since - it restores the original affinity when it is done
+		return;
+	}
+	pthread_setaffinity_np(thread, sizeof(cpu_set_t), &entry->original_cpus);
+	pinned_threads.erase(entry);
+#endif
+}
+
+idx_t PostgresThreadAffinity::NodeCount() {
+#ifdef __linux__
+	return MaxValue<idx_t>(GetNodeCPUs().size(), 1);
+#else
+	return 1;
+#endif
+}
+
+} // namespace duckdb
@@ -19,6 +19,39 @@ PGconn *PostgresUtils::PGConnect(const string &dsn) {
 	return conn;
 }
 
+//! Quote a value of a DSN in the key/value format
+static string QuoteDSNValue(const string &value) {
+	string result = "'";
+	for (auto c : value) {
+		if (c == '\'' || c == '\\') {
+			result += '\\';
+		}
+		result += c;
+	}
+	return result + "'";
+}
+
+string PostgresUtils::GetNodeDSN(const string &dsn, const string &host, int32_t port) {
+	// the DSN is either in the key/value or in the URI format - parsing it handles both
+	auto options = PQconninfoParse(dsn.c_str(), nullptr);
+	if (!options) {
+		return string();
+	}
+	string result;
+	for (auto option = options; option->keyword; option++) {
+		if (!option->val || !*option->val) {
+			continue;
+		}
+		string keyword = option->keyword;
+		if (keyword == "host" || keyword == "hostaddr" || keyword == "port") {
+			continue;
+		}
+		result += keyword + "=" + QuoteDSNValue(option->val) + " ";
+	}
+	PQconninfoFree(options);
+	return result + "host=" + QuoteDSNValue(host) + " port=" + to_string(port);
+}
+
 string PostgresUtils::TypeToString(const LogicalType &input) {
 	if (input.HasAlias()) {
 		return input.GetAlias();
@@ -75,6 +108,10 @@ LogicalType PostgresUtils::TypeToLogicalType(optional_ptr<PostgresTransaction> t
                                              const PostgresTypeData &type_info, PostgresType &postgres_type) {
 	auto &pgtypename = type_info.type_name;
 
+	// record the oid of built-in types - this is required to write them as array elements or composite fields
+	if (postgres_type.oid == 0) {
+		postgres_type.oid = PostgresNameToOid(pgtypename);
+	}
 	// postgres array types start with an _
 	if (StringUtil::StartsWith(pgtypename, "_")) {
 		if (transaction) {
@@ -144,6 +181,15 @@ LogicalType PostgresUtils::TypeToLogicalType(optional_ptr<PostgresTransaction> t
 	} else if (pgtypename == "jsonb") {
 		postgres_type.info = PostgresTypeAnnotation::JSONB;
 		return LogicalType::VARCHAR;
+	} else if (pgtypename == "macaddr") {
+		postgres_type.info = PostgresTypeAnnotation::MACADDR;
+		return LogicalType::VARCHAR;
+	} else if (pgtypename == "macaddr8") {
+		postgres_type.info = PostgresTypeAnnotation::MACADDR8;
+		return LogicalType::VARCHAR;
+	} else if (pgtypename == "inet" || pgtypename == "cidr") {
+		postgres_type.info = PostgresTypeAnnotation::INET;
+		return LogicalType::VARCHAR;
 	} else if (pgtypename == "date") {
 		return LogicalType::DATE;
 	} else if (pgtypename == "bytea") {
@@ -184,6 +230,13 @@ LogicalType PostgresUtils::TypeToLogicalType(optional_ptr<PostgresTransaction> t
 	} else if (pgtypename == "circle") {
 		postgres_type.info = PostgresTypeAnnotation::GEOM_CIRCLE;
 		return LogicalType::LIST(LogicalType::DOUBLE);
+	} else if (pgtypename == "vector") {
+		// pgvector - the type modifier is the number of dimensions
+		postgres_type.info = PostgresTypeAnnotation::PGVECTOR;
+		if (type_info.type_modifier > 0) {
+			return LogicalType::ARRAY(LogicalType::FLOAT, idx_t(type_info.type_modifier));
+		}
+		return LogicalType::LIST(LogicalType::FLOAT);
 	} else {
 		if (!transaction) {
 			// unsupported so fallback to varchar
@@ -301,6 +354,69 @@ bool PostgresUtils::SupportedPostgresOid(const LogicalType &input) {
 	}
 }
 
+uint32_t PostgresUtils::PostgresNameToOid(const string &type_name) {
+	static const std::pair<const char *, uint32_t> BUILTIN_TYPES[] = {
+	    {"bool", BOOLOID},
+	    {"int2", INT2OID},
+	    {"int4", INT4OID},
+	    {"int8", INT8OID},
+	    {"oid", OIDOID},
+	    {"float4", FLOAT4OID},
+	    {"float8", FLOAT8OID},
+	    {"numeric", NUMERICOID},
+	    {"char", CHAROID},
+	    {"bpchar", BPCHAROID},
+	    {"varchar", VARCHAROID},
+	    {"text", TEXTOID},
+	    {"json", JSONOID},
+	    {"jsonb", JSONBOID},
+	    {"macaddr", MACADDROID},
+	    {"macaddr8", MACADDR8OID},
+	    {"inet", INETOID},
+	    {"cidr", CIDROID},
+	    {"date", DATEOID},
+	    {"bytea", BYTEAOID},
+	    {"time", TIMEOID},
+	    {"timetz", TIMETZOID},
+	    {"timestamp", TIMESTAMPOID},
+	    {"timestamptz", TIMESTAMPTZOID},
+	    {"interval", INTERVALOID},
+	    {"uuid", UUIDOID},
+	    {"point", POINTOID},
+	    {"line", LINEOID},
+	    {"lseg", LSEGOID},
+	    {"box", BOXOID},
+	    {"path", PATHOID},
+	    {"polygon", POLYGONOID},
+	    {"circle", CIRCLEOID},
+	    {"_bool", BOOLARRAYOID},
+	    {"_int2", INT2ARRAYOID},
+	    {"_int4", INT4ARRAYOID},
+	    {"_int8", INT8ARRAYOID},
+	    {"_float4", FLOAT4ARRAYOID},
+	    {"_float8", FLOAT8ARRAYOID},
+	    {"_numeric", NUMERICARRAYOID},
+	    {"_bpchar", BPCHARARRAYOID},
+	    {"_varchar", VARCHARARRAYOID},
+	    {"_text", TEXTARRAYOID},
+	    {"_json", JSONARRAYOID},
+	    {"_jsonb", JSONBARRAYOID},
+	    {"_date", DATEARRAYOID},
+	    {"_bytea", BYTEAARRAYOID},
+	    {"_time", TIMEARRAYOID},
+	    {"_timetz", TIMETZARRAYOID},
+	    {"_timestamp", TIMESTAMPARRAYOID},
+	    {"_timestamptz", TIMESTAMPTZARRAYOID},
+	    {"_interval", INTERVALARRAYOID},
+	    {"_uuid", UUIDARRAYOID}};
+	for (auto &entry : BUILTIN_TYPES) {
+		if (type_name == entry.first) {
+			return entry.second;
+		}
+	}
+	return 0;
+}
+
 string PostgresUtils::PostgresOidToName(uint32_t oid) {
 	switch (oid) {
 	case BOOLOID:
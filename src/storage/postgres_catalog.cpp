@@ -9,8 +9,25 @@
 
 namespace duckdb {
 
-PostgresCatalog::PostgresCatalog(AttachedDatabase &db_p, const string &path, AccessMode access_mode)
-    : Catalog(db_p), path(path), access_mode(access_mode), schemas(*this), connection_pool(*this) {
+static void ConfigureConnectionPool(DatabaseInstance &db_instance, PostgresConnectionPool &pool) {
+	Value minimum_idle_connections;
+	if (db_instance.TryGetCurrentSetting("pg_pool_min_idle_connections", minimum_idle_connections)) {
+		pool.SetMinimumIdleConnections(UBigIntValue::Get(minimum_idle_connections));
+	}
+	Value idle_timeout;
+	if (db_instance.TryGetCurrentSetting("pg_pool_idle_timeout", idle_timeout)) {
+		pool.SetIdleTimeout(UBigIntValue::Get(idle_timeout));
+	}
+	Value maximum_lifetime;
+	if (db_instance.TryGetCurrentSetting("pg_pool_max_lifetime", maximum_lifetime)) {
+		pool.SetMaximumLifetime(UBigIntValue::Get(maximum_lifetime));
+	}
+}
+
+PostgresCatalog::PostgresCatalog(AttachedDatabase &db_p, const string &path, AccessMode access_mode,
+                                 vector<string> replica_paths_p)
+    : Catalog(db_p), path(path), access_mode(access_mode), replica_paths(std::move(replica_paths_p)), schemas(*this),
+      connection_pool(*this), next_replica(0) {
 	Value connection_limit;
 	auto &db_instance = db_p.GetDatabase();
 	if (db_instance.TryGetCurrentSetting("pg_connection_limit", connection_limit)) {
@@ -19,6 +36,16 @@ PostgresCatalog::PostgresCatalog(AttachedDatabase &db_p, const string &path, Acc
 
 	auto connection = connection_pool.GetConnection();
 	this->version = connection.GetConnection().GetPostgresVersion();
+
+	ConfigureConnectionPool(db_instance, connection_pool);
+	// connections to the replicas are only opened once they are used by a scan
+	for (auto &replica_path : replica_paths) {
+		auto max_connections = connection_limit.IsNull() ? PostgresConnectionPool::DEFAULT_MAX_CONNECTIONS
+		                                                 : UBigIntValue::Get(connection_limit);
+		auto replica_pool = make_uniq<PostgresConnectionPool>(*this, max_connections, replica_path);
+		ConfigureConnectionPool(db_instance, *replica_pool);
+		replica_pools.push_back(std::move(replica_pool));
+	}
 }
 
 PostgresCatalog::~PostgresCatalog() = default;
@@ -26,6 +53,56 @@ PostgresCatalog::~PostgresCatalog() = default;
 void PostgresCatalog::Initialize(bool load_builtin) {
 }
 
+//! The replication lag of the server in milliseconds - a server that is not in recovery (or that has not replayed
+//! any transaction yet) does not lag behind
+static idx_t GetReplicationLag(PostgresConnection &connection) {
+	auto result = connection.Query("SELECT CASE WHEN pg_is_in_recovery() THEN COALESCE(EXTRACT(EPOCH FROM now() - "
+	                               "pg_last_xact_replay_timestamp()) * 1000, 0) ELSE 0 END::BIGINT");
+	return idx_t(MaxValue<int64_t>(result->GetInt64(0, 0), 0));
+}
+
+bool PostgresCatalog::TryGetReplicaConnection(idx_t max_lag_ms, PostgresPoolConnection &result,
+                                              optional_ptr<PostgresConnectionPool> &pool) {
+	for (idx_t attempt = 0; attempt < replica_pools.size(); attempt++) {
+		auto &replica_pool = *replica_pools[next_replica++ % replica_pools.size()];
+		PostgresPoolConnection connection;
+		try {
+			if (!replica_pool.TryGetConnection(connection)) {
+				continue;
+			}
+			if (max_lag_ms > 0 && GetReplicationLag(connection.GetConnection()) > max_lag_ms) {
+				continue;
+			}
+		} catch (std::exception &) {
+			// the replica is unreachable - try the next one
+			continue;
+		}
+		result = std::move(connection);
+		pool = &replica_pool;
+		return true;
+	}
+	return false;
+}
+
+PostgresConnectionPool &PostgresCatalog::GetWorkerPool(const string &dsn) {
+	lock_guard<mutex> l(worker_pool_lock);
+	auto entry = worker_pools.find(dsn);
+	if (entry != worker_pools.end()) {
+		return *entry->second;
+	}
+	auto &db_instance = GetAttached().GetDatabase();
+	Value connection_limit;
+	auto max_connections = PostgresConnectionPool::DEFAULT_MAX_CONNECTIONS;
+	if (db_instance.TryGetCurrentSetting("pg_connection_limit", connection_limit)) {
+		max_connections = UBigIntValue::Get(connection_limit);
+	}
+	auto worker_pool = make_uniq<PostgresConnectionPool>(*this, max_connections, dsn);
+	ConfigureConnectionPool(db_instance, *worker_pool);
+	auto &result = *worker_pool;
+	worker_pools.emplace(dsn, std::move(worker_pool));
+	return result;
+}
+
 optional_ptr<CatalogEntry> PostgresCatalog::CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) {
 	auto &postgres_transaction = PostgresTransaction::Get(transaction.GetContext(), *this);
 	auto entry = schemas.GetEntry(transaction.GetContext(), info.schema);
@@ -95,6 +172,39 @@ DatabaseSize PostgresCatalog::GetDatabaseSize(ClientContext &context) {
 
 void PostgresCatalog::ClearCache() {
 	schemas.ClearEntries();
+	result_cache.Clear();
+	ClearQueryDescriptions();
+}
+
+void PostgresCatalog::ClearTableCache(ClientContext &context, const string &schema_name, const string &table_name) {
+	auto schema = schemas.GetEntry(context, schema_name);
+	if (schema) {
+		schema->Cast<PostgresSchemaEntry>().InvalidateTable(table_name);
+	}
+	result_cache.Invalidate(PostgresResultCache::GetTableKey(schema_name, table_name));
+}
+
+bool PostgresCatalog::TryGetQueryDescription(const string &key, PostgresQueryDescription &result) {
+	lock_guard<mutex> guard(query_description_lock);
+	auto entry = query_descriptions.find(key);
+	if (entry == query_descriptions.end()) {
+		return false;
+	}
+	result = entry->second;
+	return true;
+}
+
+void PostgresCatalog::AddQueryDescription(const string &key, PostgresQueryDescription description) {
+	lock_guard<mutex> guard(query_description_lock);
+	if (query_descriptions.size() >= MAX_QUERY_DESCRIPTIONS) {
+		query_descriptions.clear();
+	}
+	query_descriptions[key] = std::move(description);
+}
+
+void PostgresCatalog::ClearQueryDescriptions() {
+	lock_guard<mutex> guard(query_description_lock);
+	query_descriptions.clear();
 }
 
 } // namespace duckdb
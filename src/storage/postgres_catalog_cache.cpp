@@ -0,0 +1,172 @@
+#include "storage/postgres_catalog_cache.hpp"
+#include "duckdb/common/serializer/buffered_file_reader.hpp"
+#include "duckdb/common/serializer/buffered_file_writer.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+static constexpr const uint32_t CATALOG_CACHE_MAGIC = 0x43434750; // "PGCC"
+static constexpr const uint32_t CATALOG_CACHE_VERSION = 1;
+
+static hash_t GetCacheKey(const string &dsn, const string &catalog_query) {
+	auto key = dsn + "\n" + catalog_query;
+	return Hash(key.c_str(), key.size());
+}
+
+string PostgresCatalogCache::GetCachePath(ClientContext &context, const string &dsn, const string &catalog_query) {
+	Value cache_directory;
+	if (!context.TryGetCurrentSetting("pg_catalog_cache_directory", cache_directory) || cache_directory.IsNull()) {
+		return string();
+	}
+	auto directory = StringValue::Get(cache_directory);
+	if (directory.empty()) {
+		return string();
+	}
+	auto &fs = FileSystem::GetFileSystem(context);
+	if (!fs.DirectoryExists(directory)) {
+		fs.CreateDirectory(directory);
+	}
+	// the connection string can contain a password - only the hash of the key ends up on disk
+	auto file_name = "postgres_catalog_" + to_string(GetCacheKey(dsn, catalog_query)) + ".cache";
+	return fs.JoinPath(directory, file_name);
+}
+
+string PostgresCatalogCache::GetFingerprintQuery() {
+	// every DDL statement writes new versions of the catalog rows it changes - so the xmin of every row is hashed
+	// transaction ids are not assigned in commit order, and wrap around - so neither the maximum xmin nor the row
+	// counts identify the state of a catalog
+	return R"(
+SELECT concat_ws(':', version(), current_database(),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY oid)) FROM pg_namespace),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY oid)) FROM pg_class),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY attrelid, attnum)) FROM pg_attribute),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY oid)) FROM pg_type),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY oid)) FROM pg_enum),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY oid)) FROM pg_constraint),
+	(SELECT md5(string_agg(xmin::text, ',' ORDER BY indexrelid)) FROM pg_index));
+)";
+}
+
+static void WriteString(WriteStream &writer, const char *data, idx_t len) {
+	writer.Write<uint64_t>(len);
+	writer.WriteData(const_data_ptr_cast(data), len);
+}
+
+static string ReadString(ReadStream &reader) {
+	auto len = reader.Read<uint64_t>();
+	string result(len, '\0');
+	reader.ReadData(data_ptr_cast(&result[0]), len);
+	return result;
+}
+
+static unique_ptr<PostgresResult> ReadResult(ReadStream &reader) {
+	auto column_count = reader.Read<uint64_t>();
+	vector<string> names;
+	vector<PGresAttDesc> attributes;
+	names.reserve(column_count);
+	for (idx_t col = 0; col < column_count; col++) {
+		names.push_back(ReadString(reader));
+		PGresAttDesc attribute;
+		attribute.tableid = 0;
+		attribute.columnid = 0;
+		attribute.format = 0;
+		attribute.typid = reader.Read<uint32_t>();
+		attribute.typlen = -1;
+		attribute.atttypmod = -1;
+		attributes.push_back(attribute);
+	}
+	for (idx_t col = 0; col < column_count; col++) {
+		attributes[col].name = &names[col][0];
+	}
+	// rebuild a text-mode result as returned by libpq - so the results go through the regular catalog loading code
+	auto result = make_uniq<PostgresResult>(PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK));
+	if (!result->res || !PQsetResultAttrs(result->res, int(column_count), attributes.data())) {
+		throw IOException("Failed to create Postgres result from catalog cache");
+	}
+	auto row_count = reader.Read<uint64_t>();
+	for (idx_t row = 0; row < row_count; row++) {
+		for (idx_t col = 0; col < column_count; col++) {
+			auto is_null = reader.Read<bool>();
+			string value = is_null ? string() : ReadString(reader);
+			if (!PQsetvalue(result->res, int(row), int(col), is_null ? nullptr : &value[0],
+			                is_null ? -1 : int(value.size()))) {
+				throw IOException("Failed to create Postgres result from catalog cache");
+			}
+		}
+	}
+	return result;
+}
+
+vector<unique_ptr<PostgresResult>> PostgresCatalogCache::Read(FileSystem &fs, const string &path,
+                                                              const string &fingerprint) {
+	vector<unique_ptr<PostgresResult>> results;
+	try {
+		if (!fs.FileExists(path)) {
+			return results;
+		}
+		BufferedFileReader reader(fs, path.c_str());
+		if (reader.Read<uint32_t>() != CATALOG_CACHE_MAGIC || reader.Read<uint32_t>() != CATALOG_CACHE_VERSION) {
+			return results;
+		}
+		if (ReadString(reader) != fingerprint) {
+			// the catalog has changed since the cache was written
+			return results;
+		}
+		auto result_count = reader.Read<uint64_t>();
+		for (idx_t i = 0; i < result_count; i++) {
+			results.push_back(ReadResult(reader));
+		}
+	} catch (std::exception &ex) {
+		// a truncated or otherwise unreadable cache file is treated as a cache miss
+		results.clear();
+	}
+	return results;
+}
+
+void PostgresCatalogCache::Write(FileSystem &fs, const string &path, const string &fingerprint,
+                                 const vector<unique_ptr<PostgresResult>> &results) {
+	// write to a temporary file first so that readers never observe a partially written cache
+	auto temp_path = path + ".tmp";
+	try {
+		{
+			BufferedFileWriter writer(fs, temp_path);
+			writer.Write<uint32_t>(CATALOG_CACHE_MAGIC);
+			writer.Write<uint32_t>(CATALOG_CACHE_VERSION);
+			WriteString(writer, fingerprint.c_str(), fingerprint.size());
+			writer.Write<uint64_t>(results.size());
+			for (auto &result : results) {
+				auto res = result->res;
+				idx_t column_count = PQnfields(res);
+				writer.Write<uint64_t>(column_count);
+				for (idx_t col = 0; col < column_count; col++) {
+					auto name = PQfname(res, int(col));
+					WriteString(writer, name, strlen(name));
+					writer.Write<uint32_t>(PQftype(res, int(col)));
+				}
+				idx_t row_count = result->Count();
+				writer.Write<uint64_t>(row_count);
+				for (idx_t row = 0; row < row_count; row++) {
+					for (idx_t col = 0; col < column_count; col++) {
+						auto is_null = result->IsNull(row, col);
+						writer.Write<bool>(is_null);
+						if (!is_null) {
+							WriteString(writer, PQgetvalue(res, int(row), int(col)),
+							            PQgetlength(res, int(row), int(col)));
+						}
+					}
+				}
+			}
+			writer.Sync();
+		}
+		fs.MoveFile(temp_path, path);
+	} catch (std::exception &ex) {
+		// the cache is an optimization only - failing to write it does not fail loading the catalog
+		try {
+			fs.RemoveFile(temp_path);
+		} catch (...) {
+		}
+	}
+}
+
+} // namespace duckdb
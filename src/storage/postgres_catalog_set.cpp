@@ -82,6 +82,7 @@ void PostgresCatalogSet::DropEntry(ClientContext &context, DropInfo &info) {
 
 void PostgresCatalogSet::Scan(ClientContext &context, const std::function<void(CatalogEntry &)> &callback) {
 	TryLoadEntries(context);
+	LoadAllEntries(context);
 	lock_guard<mutex> l(entry_lock);
 	for (auto &entry : entries) {
 		callback(*entry.second);
@@ -105,6 +106,15 @@ void PostgresCatalogSet::ClearEntries() {
 	is_loaded = false;
 }
 
+void PostgresCatalogSet::ClearEntry(const string &name) {
+	lock_guard<mutex> l(entry_lock);
+	auto name_entry = entry_map.find(name);
+	if (name_entry != entry_map.end() && name_entry->second == name) {
+		entry_map.erase(name_entry);
+	}
+	entries.erase(name);
+}
+
 PostgresInSchemaSet::PostgresInSchemaSet(PostgresSchemaEntry &schema, bool is_loaded)
     : PostgresCatalogSet(schema.ParentCatalog(), is_loaded), schema(schema) {
 }
@@ -1,5 +1,7 @@
 #include "storage/postgres_connection_pool.hpp"
 #include "storage/postgres_catalog.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/common/types/timestamp.hpp"
 
 namespace duckdb {
 static bool pg_use_connection_cache = true;
@@ -40,34 +42,92 @@ PostgresConnection &PostgresPoolConnection::GetConnection() {
 	return connection;
 }
 
-PostgresConnectionPool::PostgresConnectionPool(PostgresCatalog &postgres_catalog, idx_t maximum_connections_p)
-    : postgres_catalog(postgres_catalog), active_connections(0), maximum_connections(maximum_connections_p) {
+PostgresConnectionPool::PostgresConnectionPool(PostgresCatalog &postgres_catalog, idx_t maximum_connections_p,
+                                               string dsn_p)
+    : postgres_catalog(postgres_catalog), dsn(std::move(dsn_p)), active_connections(0),
+      maximum_connections(maximum_connections_p), minimum_idle_connections(0), opening_connections(0), idle_timeout(0),
+      maximum_lifetime(0), shutdown(false), total_opens(0), total_reuses(0), total_resets(0), exhausted_count(0) {
 }
 
-PostgresPoolConnection PostgresConnectionPool::GetConnectionInternal() {
+PostgresConnectionPool::~PostgresConnectionPool() {
+	{
+		lock_guard<mutex> l(connection_lock);
+		shutdown = true;
+	}
+	background_signal.notify_all();
+	if (background_thread.joinable()) {
+		background_thread.join();
+	}
+}
+
+bool PostgresConnectionPool::ReserveConnection(PostgresConnection &result) {
 	active_connections++;
 	// check if we have any cached connections left
 	if (!connection_cache.empty()) {
-		auto connection = PostgresPoolConnection(this, std::move(connection_cache.back()));
+		// the most recently returned connection is re-used first so that unused connections can time out
+		result = std::move(connection_cache.back().connection);
 		connection_cache.pop_back();
-		return connection;
+		total_reuses++;
+		if (BackgroundThreadActive() && connection_cache.size() < minimum_idle_connections) {
+			// replenish the idle connections in the background
+			background_signal.notify_one();
+		}
+		return true;
 	}
+	return false;
+}
 
+const string &PostgresConnectionPool::GetDSN() const {
+	return dsn.empty() ? postgres_catalog.path : dsn;
+}
+
+PostgresPoolConnection PostgresConnectionPool::OpenConnection() {
 	// no cached connections left but there is space to open a new one - open it
-	return PostgresPoolConnection(this, PostgresConnection::Open(postgres_catalog.path));
+	// note that the connection is opened outside of the lock, so other threads are not blocked by the handshake
+	try {
+		auto connection = PostgresConnection::Open(GetDSN());
+		{
+			lock_guard<mutex> l(connection_lock);
+			total_opens++;
+		}
+		return PostgresPoolConnection(this, std::move(connection));
+	} catch (...) {
+		lock_guard<mutex> l(connection_lock);
+		active_connections--;
+		throw;
+	}
 }
 
 PostgresPoolConnection PostgresConnectionPool::ForceGetConnection() {
-	lock_guard<mutex> l(connection_lock);
-	return GetConnectionInternal();
+	PostgresConnection connection;
+	{
+		lock_guard<mutex> l(connection_lock);
+		if (ReserveConnection(connection)) {
+			return PostgresPoolConnection(this, std::move(connection));
+		}
+	}
+	return OpenConnection();
 }
 
-bool PostgresConnectionPool::TryGetConnection(PostgresPoolConnection &connection) {
-	lock_guard<mutex> l(connection_lock);
-	if (active_connections >= maximum_connections) {
-		return false;
+bool PostgresConnectionPool::TryGetConnection(PostgresPoolConnection &result, idx_t wait_ms) {
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+	PostgresConnection connection;
+	{
+		std::unique_lock<mutex> l(connection_lock);
+		while (active_connections >= maximum_connections) {
+			if (shutdown || std::chrono::steady_clock::now() >= deadline) {
+				exhausted_count++;
+				return false;
+			}
+			// woken up whenever a connection is returned
+			scan_signal.wait_until(l, deadline);
+		}
+		if (ReserveConnection(connection)) {
+			result = PostgresPoolConnection(this, std::move(connection));
+			return true;
+		}
 	}
-	connection = GetConnectionInternal();
+	result = OpenConnection();
 	return true;
 }
 
@@ -89,6 +149,12 @@ PostgresPoolConnection PostgresConnectionPool::GetConnection() {
 }
 
 void PostgresConnectionPool::ReturnConnection(PostgresConnection connection) {
+	ReturnConnectionInternal(std::move(connection));
+	// a connection slot was freed - wake up the scans that are waiting for one
+	scan_signal.notify_all();
+}
+
+void PostgresConnectionPool::ReturnConnectionInternal(PostgresConnection connection) {
 	lock_guard<mutex> l(connection_lock);
 	if (active_connections <= 0) {
 		throw InternalException("PostgresConnectionPool::ReturnConnection called but active_connections is 0");
@@ -105,8 +171,15 @@ void PostgresConnectionPool::ReturnConnection(PostgresConnection connection) {
 	// check if the underlying connection is still usable
 	auto pg_con = connection.GetConn();
 	if (PQstatus(connection.GetConn()) != CONNECTION_OK) {
+		if (BackgroundThreadActive()) {
+			// let the background thread try to reset the connection
+			reset_queue.push_back(std::move(connection));
+			background_signal.notify_one();
+			return;
+		}
 		// CONNECTION_BAD! try to reset it
-		PQreset(pg_con);
+		connection.Reset();
+		total_resets++;
 		if (PQstatus(connection.GetConn()) != CONNECTION_OK) {
 			// still bad - just abandon this one
 			return;
@@ -115,7 +188,111 @@ void PostgresConnectionPool::ReturnConnection(PostgresConnection connection) {
 	if (PQtransactionStatus(pg_con) != PQTRANS_IDLE) {
 		return;
 	}
-	connection_cache.push_back(std::move(connection));
+	auto now = Timestamp::GetCurrentTimestamp();
+	if (ExceedsLifetime(connection, now)) {
+		return;
+	}
+	connection_cache.push_back(PostgresCachedConnection {std::move(connection), now});
+}
+
+static double ScanConnectionNeed(const PostgresScanConnectionShare &scan, idx_t connections) {
+	return double(scan.remaining_tasks.load()) / double(connections + 1);
+}
+
+void PostgresConnectionPool::RegisterScan(const shared_ptr<PostgresScanConnectionShare> &scan) {
+	lock_guard<mutex> l(connection_lock);
+	scans.push_back(scan);
+}
+
+optional_ptr<PostgresScanConnectionShare>
+PostgresConnectionPool::GetNeediestScan(optional_ptr<PostgresScanConnectionShare> exclude) {
+	optional_ptr<PostgresScanConnectionShare> result;
+	double result_need = 0;
+	for (idx_t i = 0; i < scans.size(); i++) {
+		auto scan = scans[i].lock();
+		if (!scan) {
+			// the scan has finished - remove it
+			scans.erase(scans.begin() + i);
+			i--;
+			continue;
+		}
+		if (scan.get() == exclude.get() || scan->waiting_threads == 0 || scan->remaining_tasks == 0) {
+			continue;
+		}
+		auto need = ScanConnectionNeed(*scan, scan->active_connections);
+		if (!result || need > result_need) {
+			result = scan.get();
+			result_need = need;
+		}
+	}
+	return result;
+}
+
+bool PostgresConnectionPool::TryGetScanConnection(PostgresScanConnectionShare &scan, PostgresPoolConnection &result,
+                                                  idx_t wait_ms) {
+	// threads wait in short slices so they notice when there is nothing left to scan
+	static constexpr const idx_t WAIT_SLICE_MS = 10;
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
+	PostgresConnection connection;
+	{
+		std::unique_lock<mutex> l(connection_lock);
+		scan.waiting_threads++;
+		while (true) {
+			if (active_connections < maximum_connections) {
+				auto neediest = GetNeediestScan(nullptr);
+				if (!neediest || neediest.get() == &scan) {
+					break;
+				}
+			}
+			auto now = std::chrono::steady_clock::now();
+			if (shutdown || scan.remaining_tasks == 0 || now >= deadline) {
+				scan.waiting_threads--;
+				exhausted_count++;
+				return false;
+			}
+			scan_signal.wait_until(l, MinValue(deadline, now + std::chrono::milliseconds(WAIT_SLICE_MS)));
+		}
+		scan.waiting_threads--;
+		scan.active_connections++;
+		if (ReserveConnection(connection)) {
+			result = PostgresPoolConnection(this, std::move(connection));
+			return true;
+		}
+	}
+	try {
+		result = OpenConnection();
+	} catch (...) {
+		ReleaseScanConnection(scan);
+		throw;
+	}
+	return true;
+}
+
+void PostgresConnectionPool::ReleaseScanConnection(PostgresScanConnectionShare &scan) {
+	{
+		lock_guard<mutex> l(connection_lock);
+		if (scan.active_connections == 0) {
+			throw InternalException(
+			    "PostgresConnectionPool::ReleaseScanConnection called but the scan has no connections");
+		}
+		scan.active_connections--;
+	}
+	scan_signal.notify_all();
+}
+
+bool PostgresConnectionPool::ShouldYieldConnection(PostgresScanConnectionShare &scan) {
+	lock_guard<mutex> l(connection_lock);
+	if (scan.active_connections <= 1 || active_connections < maximum_connections) {
+		// never starve a scan completely - and if there are free slots the waiting scans can use those
+		return false;
+	}
+	auto neediest = GetNeediestScan(&scan);
+	if (!neediest) {
+		return false;
+	}
+	// yield if the waiting scan would still need the connection more than this scan after handing it over
+	return ScanConnectionNeed(*neediest, neediest->active_connections) >
+	       ScanConnectionNeed(scan, scan.active_connections - 1);
 }
 
 void PostgresConnectionPool::SetMaximumConnections(idx_t new_max) {
@@ -127,10 +304,154 @@ void PostgresConnectionPool::SetMaximumConnections(idx_t new_max) {
 		auto total_open_connections = active_connections + connection_cache.size();
 		while (!connection_cache.empty() && total_open_connections > new_max) {
 			total_open_connections--;
-			connection_cache.pop_back();
+			connection_cache.erase(connection_cache.begin());
 		}
 	}
 	maximum_connections = new_max;
 }
 
+void PostgresConnectionPool::SetMinimumIdleConnections(idx_t new_min) {
+	lock_guard<mutex> l(connection_lock);
+	minimum_idle_connections = new_min;
+	if (minimum_idle_connections > 0) {
+		StartBackgroundThread();
+	}
+	background_signal.notify_one();
+}
+
+void PostgresConnectionPool::SetIdleTimeout(idx_t seconds) {
+	lock_guard<mutex> l(connection_lock);
+	idle_timeout = seconds;
+	if (idle_timeout > 0) {
+		StartBackgroundThread();
+	}
+	background_signal.notify_one();
+}
+
+void PostgresConnectionPool::SetMaximumLifetime(idx_t seconds) {
+	lock_guard<mutex> l(connection_lock);
+	maximum_lifetime = seconds;
+	if (maximum_lifetime > 0) {
+		StartBackgroundThread();
+	}
+	background_signal.notify_one();
+}
+
+PostgresConnectionPoolInfo PostgresConnectionPool::GetInfo() {
+	lock_guard<mutex> l(connection_lock);
+	PostgresConnectionPoolInfo result;
+	result.active_connections = active_connections;
+	result.idle_connections = connection_cache.size();
+	result.maximum_connections = maximum_connections;
+	result.total_opens = total_opens;
+	result.total_reuses = total_reuses;
+	result.total_resets = total_resets;
+	result.exhausted_count = exhausted_count;
+	return result;
+}
+
+static bool ExceedsSeconds(timestamp_t start, timestamp_t now, idx_t seconds) {
+	return now.value - start.value >= int64_t(seconds) * Interval::MICROS_PER_SEC;
+}
+
+bool PostgresConnectionPool::ExceedsLifetime(PostgresConnection &connection, timestamp_t now) const {
+	if (maximum_lifetime == 0) {
+		return false;
+	}
+	return ExceedsSeconds(connection.GetConnection()->creation_time, now, maximum_lifetime);
+}
+
+void PostgresConnectionPool::EvictConnections(vector<PostgresConnection> &evicted) {
+	if (idle_timeout == 0 && maximum_lifetime == 0) {
+		return;
+	}
+	auto now = Timestamp::GetCurrentTimestamp();
+	// the cache is ordered by the time the connections were returned - the front has been idle the longest
+	idx_t idle_count = connection_cache.size();
+	vector<PostgresCachedConnection> remaining_connections;
+	for (auto &entry : connection_cache) {
+		bool evict = ExceedsLifetime(entry.connection, now);
+		if (!evict && idle_timeout > 0 && idle_count > minimum_idle_connections) {
+			evict = ExceedsSeconds(entry.idle_since, now, idle_timeout);
+		}
+		if (evict) {
+			idle_count--;
+			evicted.push_back(std::move(entry.connection));
+		} else {
+			remaining_connections.push_back(std::move(entry));
+		}
+	}
+	connection_cache = std::move(remaining_connections);
+}
+
+bool PostgresConnectionPool::BackgroundThreadActive() const {
+	return background_thread.joinable();
+}
+
+void PostgresConnectionPool::StartBackgroundThread() {
+	if (BackgroundThreadActive()) {
+		return;
+	}
+	background_thread = std::thread(&PostgresConnectionPool::BackgroundThreadMain, this);
+}
+
+void PostgresConnectionPool::BackgroundThreadMain() {
+	std::unique_lock<mutex> l(connection_lock);
+	while (!shutdown) {
+		// reset any broken connections that were returned
+		if (!reset_queue.empty()) {
+			auto connection = std::move(reset_queue.back());
+			reset_queue.pop_back();
+			l.unlock();
+			connection.Reset();
+			auto pg_con = connection.GetConn();
+			bool usable = PQstatus(pg_con) == CONNECTION_OK && PQtransactionStatus(pg_con) == PQTRANS_IDLE;
+			l.lock();
+			total_resets++;
+			if (usable && pg_use_connection_cache &&
+			    active_connections + connection_cache.size() < maximum_connections) {
+				connection_cache.push_back(
+				    PostgresCachedConnection {std::move(connection), Timestamp::GetCurrentTimestamp()});
+			}
+			continue;
+		}
+		// close connections that have been idle or open for too long - outside of the lock
+		vector<PostgresConnection> evicted;
+		EvictConnections(evicted);
+		if (!evicted.empty()) {
+			l.unlock();
+			evicted.clear();
+			l.lock();
+			continue;
+		}
+		// open connections until we have the desired amount of idle connections
+		auto idle_connections = connection_cache.size() + opening_connections;
+		auto open_connections = active_connections + idle_connections;
+		if (pg_use_connection_cache && idle_connections < minimum_idle_connections &&
+		    open_connections < maximum_connections) {
+			opening_connections++;
+			l.unlock();
+			PostgresConnection connection;
+			bool success = true;
+			try {
+				connection = PostgresConnection::Open(GetDSN());
+			} catch (...) {
+				success = false;
+			}
+			l.lock();
+			opening_connections--;
+			if (!success) {
+				// back off before trying again
+				background_signal.wait_for(l, std::chrono::seconds(1));
+				continue;
+			}
+			total_opens++;
+			connection_cache.push_back(
+			    PostgresCachedConnection {std::move(connection), Timestamp::GetCurrentTimestamp()});
+			continue;
+		}
+		background_signal.wait_for(l, std::chrono::seconds(1));
+	}
+}
+
 } // namespace duckdb
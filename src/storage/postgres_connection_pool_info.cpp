@@ -0,0 +1,87 @@
+#include "duckdb.hpp"
+
+#include "postgres_scanner.hpp"
+#include "duckdb/main/database_manager.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "storage/postgres_catalog.hpp"
+
+namespace duckdb {
+
+struct ConnectionPoolInfoEntry {
+	string database_name;
+	//! The index of the read replica of the pool (NULL for the primary)
+	Value replica;
+	PostgresConnectionPoolInfo info;
+};
+
+struct ConnectionPoolInfoData : public TableFunctionData {
+	vector<ConnectionPoolInfoEntry> pools;
+	idx_t offset = 0;
+};
+
+static unique_ptr<FunctionData> ConnectionPoolInfoBind(ClientContext &context, TableFunctionBindInput &input,
+                                                       vector<LogicalType> &return_types, vector<string> &names) {
+	names.emplace_back("database_name");
+	return_types.emplace_back(LogicalType::VARCHAR);
+	names.emplace_back("active_connections");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("idle_connections");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("max_connections");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("total_opens");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("total_reuses");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("total_resets");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("exhausted_count");
+	return_types.emplace_back(LogicalType::UBIGINT);
+	names.emplace_back("replica");
+	return_types.emplace_back(LogicalType::UBIGINT);
+
+	auto result = make_uniq<ConnectionPoolInfoData>();
+	auto databases = DatabaseManager::Get(context).GetDatabases(context);
+	for (auto &db_ref : databases) {
+		auto &db = db_ref.get();
+		auto &catalog = db.GetCatalog();
+		if (catalog.GetCatalogType() != "postgres") {
+			continue;
+		}
+		auto &postgres_catalog = catalog.Cast<PostgresCatalog>();
+		auto primary_info = postgres_catalog.GetConnectionPool().GetInfo();
+		result->pools.push_back(ConnectionPoolInfoEntry {db.GetName(), Value(LogicalType::UBIGINT), primary_info});
+		auto &replica_pools = postgres_catalog.GetReplicaPools();
+		for (idx_t i = 0; i < replica_pools.size(); i++) {
+			auto info = replica_pools[i]->GetInfo();
+			result->pools.push_back(ConnectionPoolInfoEntry {db.GetName(), Value::UBIGINT(i), info});
+		}
+	}
+	return std::move(result);
+}
+
+static void ConnectionPoolInfoFunction(ClientContext &context, TableFunctionInput &data_p, DataChunk &output) {
+	auto &data = data_p.bind_data->CastNoConst<ConnectionPoolInfoData>();
+	idx_t count = 0;
+	while (data.offset < data.pools.size() && count < STANDARD_VECTOR_SIZE) {
+		auto &entry = data.pools[data.offset++];
+		auto &info = entry.info;
+		idx_t col = 0;
+		output.SetValue(col++, count, Value(entry.database_name));
+		output.SetValue(col++, count, Value::UBIGINT(info.active_connections));
+		output.SetValue(col++, count, Value::UBIGINT(info.idle_connections));
+		output.SetValue(col++, count, Value::UBIGINT(info.maximum_connections));
+		output.SetValue(col++, count, Value::UBIGINT(info.total_opens));
+		output.SetValue(col++, count, Value::UBIGINT(info.total_reuses));
+		output.SetValue(col++, count, Value::UBIGINT(info.total_resets));
+		output.SetValue(col++, count, Value::UBIGINT(info.exhausted_count));
+		output.SetValue(col++, count, entry.replica);
+		count++;
+	}
+	output.SetCardinality(count);
+}
+
+PostgresConnectionPoolInfoFunction::PostgresConnectionPoolInfoFunction()
+    : TableFunction("postgres_connection_pool_info", {}, ConnectionPoolInfoFunction, ConnectionPoolInfoBind) {
+}
+} // namespace duckdb
@@ -4,6 +4,7 @@
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "postgres_connection.hpp"
+#include "postgres_binary_writer.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 
 namespace duckdb {
@@ -15,12 +16,21 @@ PostgresDelete::PostgresDelete(LogicalOperator &op, TableCatalogEntry &table, id
 //===--------------------------------------------------------------------===//
 // States
 //===--------------------------------------------------------------------===//
-string GetDeleteSQL(const PostgresTableEntry &table, const string &ctid_list) {
+string GetDeleteSQL(const PostgresTableEntry &table, const string &name, const PostgresVersion &version) {
 	string result;
 	result = "DELETE FROM ";
 	result += KeywordHelper::WriteQuoted(table.schema.name, '"') + ".";
 	result += KeywordHelper::WriteOptionallyQuoted(table.name);
-	result += " WHERE ctid IN (" + ctid_list + ")";
+	if (version < PostgresVersion(14, 0)) {
+		// tid values can only be hashed from Postgres 14 onwards - before that a join on the ctid can end up
+		// scanning the whole table for every row to delete. Look the rows up through a TID scan instead.
+		result += " WHERE ctid = ANY(ARRAY(SELECT __page_id FROM " + KeywordHelper::WriteOptionallyQuoted(name) + "))";
+		return result;
+	}
+	result += " USING " + KeywordHelper::WriteOptionallyQuoted(name);
+	result += " WHERE ";
+	result += KeywordHelper::WriteOptionallyQuoted(table.name);
+	result += ".ctid=__page_id";
 	return result;
 }
 
@@ -30,17 +40,9 @@ public:
 	}
 
 	PostgresTableEntry &table;
-	string ctid_list;
+	PostgresCopyState copy_state;
+	string delete_sql;
 	idx_t delete_count;
-
-	void Flush(ClientContext &context) {
-		if (ctid_list.empty()) {
-			return;
-		}
-		auto &transaction = PostgresTransaction::Get(context, table.catalog);
-		transaction.Query(GetDeleteSQL(table, ctid_list));
-		ctid_list = "";
-	}
 };
 
 unique_ptr<GlobalSinkState> PostgresDelete::GetGlobalSinkState(ClientContext &context) const {
@@ -48,6 +50,18 @@ unique_ptr<GlobalSinkState> PostgresDelete::GetGlobalSinkState(ClientContext &co
 
 	auto &transaction = PostgresTransaction::Get(context, postgres_table.catalog);
 	auto result = make_uniq<PostgresDeleteGlobalState>(postgres_table);
+	// create a temporary table to stream the ctids of the rows to delete into
+	auto table_name = transaction.CreateTemporaryTable("delete_data", "SELECT NULL::TID AS __page_id");
+	auto &connection = transaction.GetConnection();
+	// generate the final DELETE sql
+	auto &postgres_catalog = postgres_table.catalog.Cast<PostgresCatalog>();
+	result->delete_sql = GetDeleteSQL(postgres_table, table_name, postgres_catalog.GetPostgresVersion());
+
+	// begin the COPY TO - ctids are always sent in the binary format
+	string schema_name;
+	vector<string> column_names;
+	connection.BeginCopyTo(context, result->copy_state, PostgresCopyFormat::BINARY, schema_name, table_name,
+	                       column_names);
 	return std::move(result);
 }
 
@@ -60,23 +74,15 @@ SinkResultType PostgresDelete::Sink(ExecutionContext &context, DataChunk &chunk,
 	chunk.Flatten();
 	auto &row_identifiers = chunk.data[row_id_index];
 	auto row_data = FlatVector::GetData<row_t>(row_identifiers);
+	PostgresBinaryWriter writer;
 	for (idx_t i = 0; i < chunk.size(); i++) {
-		if (!gstate.ctid_list.empty()) {
-			gstate.ctid_list += ",";
-		}
-		// extract the ctid from the row id
-		auto row_in_page = row_data[i] & 0xFFFF;
-		auto page_index = row_data[i] >> 16;
-		gstate.ctid_list += "'(";
-		gstate.ctid_list += to_string(page_index);
-		gstate.ctid_list += ",";
-		gstate.ctid_list += to_string(row_in_page);
-		gstate.ctid_list += ")'";
-		if (gstate.ctid_list.size() > 3000) {
-			// avoid making too long SQL statements
-			gstate.Flush(context.client);
-		}
+		writer.BeginRow(1);
+		writer.WriteCTID(row_data[i]);
+		writer.FinishRow();
 	}
+	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
+	auto &connection = transaction.GetConnection();
+	connection.CopyData(writer);
 	gstate.delete_count += chunk.size();
 	return SinkResultType::NEED_MORE_INPUT;
 }
@@ -87,7 +93,13 @@ SinkResultType PostgresDelete::Sink(ExecutionContext &context, DataChunk &chunk,
 SinkFinalizeType PostgresDelete::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
                                           OperatorSinkFinalizeInput &input) const {
 	auto &gstate = input.global_state.Cast<PostgresDeleteGlobalState>();
-	gstate.Flush(context);
+	auto &transaction = PostgresTransaction::Get(context, gstate.table.catalog);
+	auto &connection = transaction.GetConnection();
+	// flush the copy to state
+	connection.FinishCopyTo(gstate.copy_state);
+	// delete all rows with a ctid in the temporary table in a single statement
+	connection.Execute(gstate.delete_sql);
+	gstate.table.InvalidateCachedResults();
 	return SinkFinalizeType::READY;
 }
 
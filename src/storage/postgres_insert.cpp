@@ -4,13 +4,23 @@
 #include "duckdb/planner/operator/logical_insert.hpp"
 #include "duckdb/planner/operator/logical_create_table.hpp"
 #include "storage/postgres_table_entry.hpp"
+#include "storage/postgres_schema_entry.hpp"
+#include "storage/postgres_table_set.hpp"
 #include "duckdb/planner/parsed_data/bound_create_table_info.hpp"
 #include "duckdb/execution/operator/projection/physical_projection.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/planner/expression/bound_cast_expression.hpp"
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+#include "duckdb/common/types/uuid.hpp"
 #include "postgres_connection.hpp"
 #include "postgres_scanner.hpp"
+#include "postgres_binary_writer.hpp"
+#include "postgres_text_writer.hpp"
+#include "postgres_filter_pushdown.hpp"
 
 namespace duckdb {
 
@@ -33,11 +43,51 @@ public:
 	explicit PostgresInsertGlobalState(ClientContext &context, PostgresTableEntry *table)
 	    : table(table), insert_count(0) {
 	}
+	~PostgresInsertGlobalState() override {
+		if (!staging_table || swap_started) {
+			return;
+		}
+		// the bulk load did not finish - drop the staging table again
+		try {
+			auto &postgres_catalog = staging_table->catalog.Cast<PostgresCatalog>();
+			auto connection = postgres_catalog.GetConnectionPool().ForceGetConnection();
+			connection.GetConnection().TryQuery("DROP TABLE IF EXISTS " + GetStagingName());
+		} catch (...) {
+		}
+	}
+
+	string GetStagingName() const {
+		return KeywordHelper::WriteQuoted(staging_table->schema.name, '"') + "." +
+		       KeywordHelper::WriteQuoted(staging_table->name, '"');
+	}
 
 	PostgresTableEntry *table;
+	//! Bulk load only - the UNLOGGED staging table the data is loaded into (not part of the catalog)
+	unique_ptr<PostgresTableEntry> staging_table;
+	//! Bulk load only - whether or not the swap has started - from then on the staging table is locked by the
+	//! transaction, and dropped by the transaction after a rollback (see PostgresTransaction::DropTableOnRollback)
+	bool swap_started = false;
+	//! Upsert only - the statement that merges the temporary table the rows are copied into into the table
+	string merge_sql;
+	//! Lock protecting the COPY on the transaction connection and the insert count
+	mutex lock;
 	PostgresCopyState copy_state;
-	DataChunk varchar_chunk;
 	idx_t insert_count;
+	//! The COPY parameters - used to start the COPY on the connections of the local states
+	PostgresCopyFormat format;
+	vector<string> insert_column_names;
+};
+
+class PostgresInsertLocalState : public LocalSinkState {
+public:
+	//! The connection of this thread - if there is none, data is written to the transaction connection
+	PostgresPoolConnection connection;
+	PostgresCopyState copy_state;
+	DataChunk varchar_chunk;
+	idx_t insert_count = 0;
+	//! Chunks are encoded into thread-local buffers - only sending the encoded data to Postgres is serialized
+	PostgresBinaryWriter binary_writer;
+	PostgresTextWriter text_writer;
 };
 
 vector<string> GetInsertColumns(const PostgresInsert &insert, PostgresTableEntry &entry) {
@@ -66,9 +116,63 @@ vector<string> GetInsertColumns(const PostgresInsert &insert, PostgresTableEntry
 	return column_names;
 }
 
+//! Create the UNLOGGED staging table of a bulk load - the table is created on a separate connection so that it is
+//! committed immediately, and can be loaded by the connections of all threads
+static unique_ptr<PostgresTableEntry> CreateStagingTable(ClientContext &context, SchemaCatalogEntry &schema,
+                                                         CreateTableInfo &info) {
+	auto &postgres_catalog = schema.catalog.Cast<PostgresCatalog>();
+	if (info.on_conflict == OnCreateConflict::ERROR_ON_CONFLICT &&
+	    schema.GetEntry(schema.GetCatalogTransaction(context), CatalogType::TABLE_ENTRY, info.table)) {
+		throw CatalogException("Table with name \"%s\" already exists!", info.table);
+	}
+	auto staging_info = unique_ptr_cast<CreateInfo, CreateTableInfo>(info.Copy());
+	staging_info->on_conflict = OnCreateConflict::ERROR_ON_CONFLICT;
+	staging_info->schema = schema.name;
+	staging_info->table = "__duckdb_bulk_" + StringUtil::Replace(UUID::ToString(UUID::GenerateRandomUUID()), "-", "");
+	auto create_sql = PostgresTableSet::GetCreateTableSQL(*staging_info, true);
+	auto connection = postgres_catalog.GetConnectionPool().ForceGetConnection();
+	connection.GetConnection().Execute(create_sql);
+	return make_uniq<PostgresTableEntry>(postgres_catalog, schema, *staging_info);
+}
+
+static string GetUpsertColumnList(PostgresTableEntry &table, const vector<string> &insert_column_names) {
+	string result;
+	for (auto &column_name : insert_column_names.empty() ? table.postgres_names : insert_column_names) {
+		if (!result.empty()) {
+			result += ", ";
+		}
+		result += KeywordHelper::WriteQuoted(column_name, '"');
+	}
+	return result;
+}
+
+//! Create the temporary table the rows of an upsert are copied into - it has the exact same Postgres types as the
+//! inserted columns of the table. Returns the name of the temporary table
+static string CreateUpsertTable(PostgresTransaction &transaction, PostgresTableEntry &table,
+                                const vector<string> &insert_column_names) {
+	string query = "SELECT " + GetUpsertColumnList(table, insert_column_names) + " FROM ";
+	query += KeywordHelper::WriteQuoted(table.schema.name, '"') + "." + KeywordHelper::WriteQuoted(table.name, '"');
+	return transaction.CreateTemporaryTable("upsert_data", query);
+}
+
+//! The statement that merges the rows of the temporary table of an upsert into the table
+static string GetUpsertSQL(PostgresTableEntry &table, const string &upsert_table,
+                           const vector<string> &insert_column_names, const string &on_conflict_clause) {
+	auto column_list = GetUpsertColumnList(table, insert_column_names);
+	string result = "INSERT INTO ";
+	result += KeywordHelper::WriteQuoted(table.schema.name, '"') + "." + KeywordHelper::WriteQuoted(table.name, '"');
+	result += " (" + column_list + ") SELECT " + column_list + " FROM " + KeywordHelper::WriteQuoted(upsert_table, '"');
+	result += on_conflict_clause;
+	return result;
+}
+
 unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkState(ClientContext &context) const {
 	PostgresTableEntry *insert_table;
-	if (!table) {
+	unique_ptr<PostgresTableEntry> staging_table;
+	if (bulk_load) {
+		staging_table = CreateStagingTable(context, *schema.get_mutable(), info->Base());
+		insert_table = staging_table.get();
+	} else if (!table) {
 		auto &schema_ref = *schema.get_mutable();
 		insert_table =
 		    &schema_ref.CreateTable(schema_ref.GetCatalogTransaction(context), *info)->Cast<PostgresTableEntry>();
@@ -79,20 +183,55 @@ unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkState(ClientContext &co
 	auto &connection = transaction.GetConnection();
 	auto insert_columns = GetInsertColumns(*this, *insert_table);
 	auto result = make_uniq<PostgresInsertGlobalState>(context, insert_table);
+	result->staging_table = std::move(staging_table);
 	auto format = insert_table->GetCopyFormat(context);
 	vector<string> insert_column_names;
+	// the Postgres types of the inserted columns - used by the binary writer
+	vector<PostgresType> insert_column_types;
 	if (!insert_columns.empty()) {
 		for (auto &str : insert_columns) {
 			auto index = insert_table->GetColumnIndex(str, true);
 			if (!index.IsValid()) {
 				insert_column_names.push_back(str);
+				insert_column_types.emplace_back();
 			} else {
 				insert_column_names.push_back(insert_table->postgres_names[index.index]);
+				insert_column_types.push_back(insert_table->postgres_types[index.index]);
 			}
 		}
+	} else {
+		insert_column_types = insert_table->postgres_types;
+	}
+	if (!on_conflict_clause.empty()) {
+		// upsert - copy the rows into a temporary table first
+		auto upsert_table = CreateUpsertTable(transaction, *insert_table, insert_column_names);
+		result->merge_sql = GetUpsertSQL(*insert_table, upsert_table, insert_column_names, on_conflict_clause);
+		connection.BeginCopyTo(context, result->copy_state, format, string(), upsert_table, insert_column_names);
+	} else {
+		connection.BeginCopyTo(context, result->copy_state, format, insert_table->schema.name, insert_table->name,
+		                       insert_column_names);
+	}
+	result->copy_state.postgres_types = std::move(insert_column_types);
+	result->format = format;
+	result->insert_column_names = std::move(insert_column_names);
+	return std::move(result);
+}
+
+unique_ptr<LocalSinkState> PostgresInsert::GetLocalSinkState(ExecutionContext &context) const {
+	auto &gstate = sink_state->Cast<PostgresInsertGlobalState>();
+	auto result = make_uniq<PostgresInsertLocalState>();
+	if (!parallel_insert) {
+		return std::move(result);
+	}
+	// parallel insert - try to get a separate connection for this thread
+	// if all connections are in use we write to the transaction connection instead
+	auto &postgres_catalog = gstate.table->catalog.Cast<PostgresCatalog>();
+	if (postgres_catalog.GetConnectionPool().TryGetConnection(result->connection)) {
+		auto &table = *gstate.table;
+		result->connection.GetConnection().BeginCopyTo(context.client, result->copy_state, gstate.format,
+		                                               table.schema.name, table.name, gstate.insert_column_names);
+		result->copy_state.postgres_types = gstate.copy_state.postgres_types;
 	}
-	connection.BeginCopyTo(context, result->copy_state, format, insert_table->schema.name, insert_table->name,
-	                       insert_column_names);
 	return std::move(result);
 }
 
@@ -101,13 +240,53 @@ unique_ptr<GlobalSinkState> PostgresInsert::GetGlobalSinkState(ClientContext &co
 //===--------------------------------------------------------------------===//
 SinkResultType PostgresInsert::Sink(ExecutionContext &context, DataChunk &chunk, OperatorSinkInput &input) const {
 	auto &gstate = sink_state->Cast<PostgresInsertGlobalState>();
-	auto &transaction = PostgresTransaction::Get(context.client, gstate.table->catalog);
-	auto &connection = transaction.GetConnection();
-	connection.CopyChunk(context.client, gstate.copy_state, chunk, gstate.varchar_chunk);
-	gstate.insert_count += chunk.size();
+	auto &lstate = input.local_state.Cast<PostgresInsertLocalState>();
+	if (lstate.connection.HasConnection()) {
+		// this thread has its own connection - write to it directly
+		lstate.connection.GetConnection().CopyChunk(context.client, lstate.copy_state, chunk, lstate.varchar_chunk);
+		lstate.insert_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
+	// encode the chunk into the thread-local buffer
+	chunk.Flatten();
+	MemoryStream *stream;
+	if (gstate.copy_state.format == PostgresCopyFormat::BINARY) {
+		lstate.binary_writer.WriteChunk(chunk, &gstate.copy_state.postgres_types);
+		stream = &lstate.binary_writer.stream;
+	} else {
+		PostgresConnection::CastChunkToPostgresVarchar(context.client, chunk, lstate.varchar_chunk,
+		                                               &gstate.copy_state.postgres_types);
+		lstate.text_writer.WriteChunk(lstate.varchar_chunk);
+		stream = &lstate.text_writer.stream;
+	}
+	// send the encoded data over the transaction connection
+	{
+		lock_guard<mutex> guard(gstate.lock);
+		auto &transaction = PostgresTransaction::Get(context.client, gstate.table->catalog);
+		auto &connection = transaction.GetConnection();
+		connection.CopyData(stream->GetData(), stream->GetPosition());
+		gstate.insert_count += chunk.size();
+	}
+	stream->Rewind();
 	return SinkResultType::NEED_MORE_INPUT;
 }
 
+//===--------------------------------------------------------------------===//
+// Combine
+//===--------------------------------------------------------------------===//
+SinkCombineResultType PostgresInsert::Combine(ExecutionContext &context, OperatorSinkCombineInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresInsertGlobalState>();
+	auto &lstate = input.local_state.Cast<PostgresInsertLocalState>();
+	if (!lstate.connection.HasConnection()) {
+		return SinkCombineResultType::FINISHED;
+	}
+	// finish the COPY of this thread - the data is committed when the COPY finishes
+	lstate.connection.GetConnection().FinishCopyTo(lstate.copy_state);
+	lock_guard<mutex> guard(gstate.lock);
+	gstate.insert_count += lstate.insert_count;
+	return SinkCombineResultType::FINISHED;
+}
+
 //===--------------------------------------------------------------------===//
 // Finalize
 //===--------------------------------------------------------------------===//
@@ -117,11 +296,38 @@ SinkFinalizeType PostgresInsert::Finalize(Pipeline &pipeline, Event &event, Clie
 	auto &transaction = PostgresTransaction::Get(context, gstate.table->catalog);
 	auto &connection = transaction.GetConnection();
 	connection.FinishCopyTo(gstate.copy_state);
+	if (!gstate.merge_sql.empty()) {
+		// upsert - merge the copied rows into the table, the count is the amount of inserted or updated rows
+		auto result = connection.Query(gstate.merge_sql);
+		gstate.insert_count = result->AffectedRows();
+	}
+	if (gstate.staging_table) {
+		// bulk load - swap the staging table in for the target table as part of the transaction
+		// SET LOGGED makes the loaded table crash-safe again - the table is written to the WAL once in its entirety
+		auto &target_name = info->Base().table;
+		auto target_name_quoted = KeywordHelper::WriteQuoted(target_name, '"');
+		auto target = KeywordHelper::WriteQuoted(schema->name, '"') + "." + target_name_quoted;
+		string swap_sql = "ALTER TABLE " + gstate.GetStagingName() + " SET LOGGED;";
+		if (info->Base().on_conflict == OnCreateConflict::REPLACE_ON_CONFLICT) {
+			swap_sql += "DROP TABLE IF EXISTS " + target + ";";
+		}
+		swap_sql += "ALTER TABLE " + gstate.GetStagingName() + " RENAME TO " + target_name_quoted + ";";
+		// the swap locks the staging table in the transaction - from here on the staging table is dropped once the
+		// transaction is rolled back (if it is), which also covers a failing swap
+		transaction.DropTableOnRollback(gstate.GetStagingName());
+		gstate.swap_started = true;
+		transaction.ExecuteQueries(swap_sql);
+		// the catalog entry of the target table is loaded from Postgres on its next use
+		gstate.table->catalog.Cast<PostgresCatalog>().ClearTableCache(context, schema->name, target_name);
+		return SinkFinalizeType::READY;
+	}
+	gstate.table->InvalidateCachedResults();
 	// update the approx_num_pages - approximately 8 bytes per column per row
 	idx_t bytes_per_page = 8192;
 	idx_t bytes_per_row = gstate.table->GetColumns().LogicalColumnCount() * 8;
 	idx_t rows_per_page = MaxValue<idx_t>(1, bytes_per_page / bytes_per_row);
 	gstate.table->approx_num_pages += gstate.insert_count / rows_per_page;
+	gstate.table->relation_pages += gstate.insert_count / rows_per_page;
 	return SinkFinalizeType::READY;
 }
 
@@ -141,7 +347,10 @@ SourceResultType PostgresInsert::GetData(ExecutionContext &context, DataChunk &c
 // Helpers
 //===--------------------------------------------------------------------===//
 string PostgresInsert::GetName() const {
-	return table ? "PG_INSERT" : "PG_CREATE_TABLE_AS";
+	if (table) {
+		return "PG_INSERT";
+	}
+	return bulk_load ? "PG_CREATE_TABLE_AS_BULK_LOAD" : "PG_CREATE_TABLE_AS";
 }
 
 string PostgresInsert::ParamsToString() const {
@@ -208,19 +417,135 @@ void PostgresCatalog::MaterializePostgresScans(PhysicalOperator &op) {
 	}
 }
 
+//! Replace the references to the columns of the rows of an ON CONFLICT DO UPDATE with column references - the first
+//! columns are those of the row proposed for insertion (EXCLUDED), followed by the fetched columns of the table
+static void ReplaceConflictReferences(unique_ptr<Expression> &expr) {
+	if (expr->GetExpressionClass() == ExpressionClass::BOUND_REF) {
+		auto &ref = expr->Cast<BoundReferenceExpression>();
+		expr = make_uniq<BoundColumnRefExpression>(ref.return_type, ColumnBinding(0, ref.index));
+		return;
+	}
+	ExpressionIterator::EnumerateChildren(*expr,
+	                                      [&](unique_ptr<Expression> &child) { ReplaceConflictReferences(child); });
+}
+
+//! Translate an expression of ON CONFLICT DO UPDATE (a SET expression or the condition) into Postgres SQL
+static string TransformConflictExpression(const Expression &expr, LogicalInsert &op, PostgresTableEntry &table) {
+	vector<string> names = table.postgres_names;
+	vector<PostgresType> postgres_types = table.postgres_types;
+	vector<string> aliases(names.size(), "EXCLUDED");
+	for (auto &column_id : op.columns_to_fetch) {
+		names.push_back(table.postgres_names[column_id]);
+		postgres_types.push_back(table.postgres_types[column_id]);
+		aliases.push_back(KeywordHelper::WriteQuoted(table.name, '"'));
+	}
+	if (expr.GetExpressionClass() == ExpressionClass::BOUND_REF) {
+		// a column - e.g. SET x = EXCLUDED.x
+		auto index = expr.Cast<BoundReferenceExpression>().index;
+		return aliases[index] + "." + KeywordHelper::WriteQuoted(names[index], '"');
+	}
+	vector<column_t> column_ids;
+	for (idx_t i = 0; i < names.size(); i++) {
+		column_ids.push_back(i);
+	}
+	PostgresPushdownColumns columns(0, column_ids, names, postgres_types);
+	columns.column_aliases = std::move(aliases);
+	auto copy = expr.Copy();
+	ReplaceConflictReferences(copy);
+	string result;
+	if (!PostgresFilterPushdown::TryTransformExpression(*copy, columns, result)) {
+		throw BinderException("ON CONFLICT DO UPDATE expression \"%s\" is not supported for insertion into Postgres "
+		                      "table",
+		                      expr.ToString());
+	}
+	return result;
+}
+
+//! The ON CONFLICT clause of the statement that merges the rows of an upsert into the table
+static string GetOnConflictClause(ClientContext &context, LogicalInsert &op, PostgresTableEntry &table) {
+	if (op.on_conflict_condition) {
+		throw BinderException("ON CONFLICT with a WHERE clause in the conflict target is not yet supported for "
+		                      "insertion into Postgres table");
+	}
+	vector<column_t> conflict_columns(op.on_conflict_filter.begin(), op.on_conflict_filter.end());
+	if (conflict_columns.empty() && op.action_type != OnConflictAction::NOTHING) {
+		// Postgres requires the conflict target of DO UPDATE - use the primary key (or the only unique index)
+		auto storage_info = table.GetStorageInfo(context);
+		for (auto &index : storage_info.index_info) {
+			if (index.is_primary || (conflict_columns.empty() && storage_info.index_info.size() == 1)) {
+				conflict_columns.assign(index.column_set.begin(), index.column_set.end());
+			}
+		}
+		if (conflict_columns.empty()) {
+			throw BinderException("ON CONFLICT DO UPDATE into Postgres table \"%s\" requires a conflict target",
+			                      table.name);
+		}
+	}
+	std::sort(conflict_columns.begin(), conflict_columns.end());
+	string result = " ON CONFLICT";
+	if (!conflict_columns.empty()) {
+		result += " (";
+		for (idx_t i = 0; i < conflict_columns.size(); i++) {
+			result += i > 0 ? ", " : "";
+			result += KeywordHelper::WriteQuoted(table.postgres_names[conflict_columns[i]], '"');
+		}
+		result += ")";
+	}
+	if (op.action_type == OnConflictAction::NOTHING || op.set_columns.empty()) {
+		return result + " DO NOTHING";
+	}
+	result += " DO UPDATE SET ";
+	for (idx_t i = 0; i < op.set_columns.size(); i++) {
+		result += i > 0 ? ", " : "";
+		result += KeywordHelper::WriteQuoted(table.postgres_names[op.set_columns[i].index], '"');
+		result += " = " + TransformConflictExpression(*op.expressions[i], op, table);
+	}
+	if (op.do_update_condition) {
+		result += " WHERE " + TransformConflictExpression(*op.do_update_condition, op, table);
+	}
+	return result;
+}
+
+static bool UseParallelEncoding(ClientContext &context) {
+	Value parallel_encoding;
+	return context.TryGetCurrentSetting("pg_parallel_encoding", parallel_encoding) &&
+	       BooleanValue::Get(parallel_encoding);
+}
+
 unique_ptr<PhysicalOperator> PostgresCatalog::PlanInsert(ClientContext &context, LogicalInsert &op,
                                                          unique_ptr<PhysicalOperator> plan) {
 	if (op.return_chunk) {
 		throw BinderException("RETURNING clause not yet supported for insertion into Postgres table");
 	}
+	string on_conflict_clause;
 	if (op.action_type != OnConflictAction::THROW) {
-		throw BinderException("ON CONFLICT clause not yet supported for insertion into Postgres table");
+		on_conflict_clause = GetOnConflictClause(context, op, op.table.Cast<PostgresTableEntry>());
 	}
 	MaterializePostgresScans(*plan);
 
 	plan = AddCastToPostgresTypes(context, std::move(plan));
 
 	auto insert = make_uniq<PostgresInsert>(op, op.table, op.column_index_map);
+	insert->preserve_insertion_order = PhysicalPlanGenerator::PreserveInsertionOrder(context, *plan);
+	insert->parallel_encoding = UseParallelEncoding(context);
+	Value parallel_insert;
+	if (context.TryGetCurrentSetting("pg_parallel_insert", parallel_insert)) {
+		insert->parallel_insert = BooleanValue::Get(parallel_insert);
+	}
+	if (!on_conflict_clause.empty()) {
+		// the rows are copied into a temporary table - which is only visible to the transaction connection
+		insert->on_conflict_clause = std::move(on_conflict_clause);
+		insert->parallel_insert = false;
+	}
+	if (!context.transaction.IsAutoCommit()) {
+		// the other connections do not see the changes of an explicit transaction (e.g. a table created in it), and
+		// the rows they write would be committed even if the transaction is rolled back
+		insert->parallel_insert = false;
+	}
+	if (insert->preserve_insertion_order) {
+		// the threads insert their rows in arbitrary order
+		insert->parallel_insert = false;
+	}
 	insert->children.push_back(std::move(plan));
 	return std::move(insert);
 }
@@ -232,6 +557,18 @@ unique_ptr<PhysicalOperator> PostgresCatalog::PlanCreateTableAs(ClientContext &c
 	MaterializePostgresScans(*plan);
 
 	auto insert = make_uniq<PostgresInsert>(op, op.schema, std::move(op.info));
+	insert->preserve_insertion_order = PhysicalPlanGenerator::PreserveInsertionOrder(context, *plan);
+	insert->parallel_encoding = UseParallelEncoding(context);
+	Value bulk_load;
+	if (context.TryGetCurrentSetting("pg_bulk_load", bulk_load) && BooleanValue::Get(bulk_load) &&
+	    insert->info->Base().on_conflict != OnCreateConflict::IGNORE_ON_CONFLICT &&
+	    context.transaction.IsAutoCommit()) {
+		// the staging table is created and committed on a separate connection - within an explicit transaction that
+		// connection does not see the changes of the transaction, and a rollback would leave the staging table behind
+		// bulk load - every thread loads the staging table over its own connection, the insertion order is not kept
+		insert->bulk_load = true;
+		insert->parallel_insert = true;
+	}
 	insert->children.push_back(std::move(plan));
 	return std::move(insert);
 }
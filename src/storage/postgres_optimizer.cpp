@@ -2,40 +2,961 @@
 #include "storage/postgres_schema_entry.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "storage/postgres_optimizer.hpp"
+#include "storage/postgres_runtime_filter.hpp"
 #include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/planner/operator/logical_filter.hpp"
+#include "duckdb/planner/operator/logical_aggregate.hpp"
+#include "duckdb/planner/operator/logical_projection.hpp"
+#include "duckdb/planner/operator/logical_limit.hpp"
+#include "duckdb/planner/operator/logical_top_n.hpp"
+#include "duckdb/planner/operator/logical_comparison_join.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_cast_expression.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/logical_operator_visitor.hpp"
+#include "duckdb/planner/column_binding_map.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/common/map.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
 #include "storage/postgres_catalog.hpp"
 #include "postgres_scanner.hpp"
+#include "postgres_result.hpp"
+#include "postgres_filter_pushdown.hpp"
+#include "postgres_type_oids.hpp"
 
 namespace duckdb {
 
 struct PostgresOperators {
 	reference_map_t<PostgresCatalog, vector<reference<LogicalGet>>> scans;
+	//! The number of postgres_lookup calls per catalog - they run queries next to the scans of the catalog
+	reference_map_t<PostgresCatalog, idx_t> lookups;
 };
 
 void GatherPostgresScans(LogicalOperator &op, PostgresOperators &result) {
 	if (op.type == LogicalOperatorType::LOGICAL_GET) {
 		auto &get = op.Cast<LogicalGet>();
 		auto &table_scan = get.function;
-		if (!PostgresCatalog::IsPostgresScan(table_scan.name)) {
-			// not a postgres scan - skip
+		if (table_scan.name == "postgres_lookup") {
+			// the keys of the lookup can come from a scan of the same catalog - keep on gathering its children
+			auto &catalog = *get.bind_data->Cast<PostgresLookupBindData>().GetCatalog();
+			result.lookups[catalog]++;
+		} else {
+			if (!PostgresCatalog::IsPostgresScan(table_scan.name)) {
+				// not a postgres scan - skip
+				return;
+			}
+			auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+			auto catalog = bind_data.GetCatalog();
+			if (!catalog) {
+				// "postgres_scan" functions are fully independent - we can always stream them
+				return;
+			}
+			result.scans[*catalog].push_back(get);
+		}
+	}
+	// recurse into children
+	for (auto &child : op.children) {
+		GatherPostgresScans(*child, result);
+	}
+}
+
+//! Push the predicates of filters that sit directly on top of a Postgres scan into the SQL sent to Postgres
+//! This handles the expressions that cannot be represented as a TableFilter (e.g. LIKE, IN or OR across columns)
+void PushdownPostgresPredicates(unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		PushdownPostgresPredicates(child);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_FILTER ||
+	    op->children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &get = op->children[0]->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name) || !get.function.filter_pushdown) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	PostgresPushdownColumns columns(get.table_index, get.column_ids, bind_data.names, bind_data.postgres_types);
+	auto &filter = op->Cast<LogicalFilter>();
+	vector<unique_ptr<Expression>> remaining_expressions;
+	for (auto &expr : filter.expressions) {
+		string predicate;
+		if (PostgresFilterPushdown::TryTransformExpression(*expr, columns, predicate)) {
+			bind_data.pushdown_predicates.push_back(std::move(predicate));
+		} else {
+			remaining_expressions.push_back(std::move(expr));
+		}
+	}
+	filter.expressions = std::move(remaining_expressions);
+	if (filter.expressions.empty() && filter.projection_map.empty()) {
+		// the filter has been pushed down entirely - remove it
+		op = std::move(op->children[0]);
+	}
+}
+
+//! Replaces references to the columns of a rewritten operator with references to the columns of its replacement
+class PostgresColumnBindingReplacer : public LogicalOperatorVisitor {
+public:
+	column_binding_map_t<ColumnBinding> replacements;
+
+protected:
+	unique_ptr<Expression> VisitReplace(BoundColumnRefExpression &expr, unique_ptr<Expression> *expr_ptr) override {
+		auto entry = replacements.find(expr.binding);
+		if (entry != replacements.end()) {
+			expr.binding = entry->second;
+		}
+		return nullptr;
+	}
+};
+
+static void GetMaxTableIndex(LogicalOperator &op, idx_t &max_index) {
+	for (auto index : op.GetTableIndex()) {
+		if (index != DConstants::INVALID_INDEX) {
+			max_index = MaxValue<idx_t>(max_index, index);
+		}
+	}
+	for (auto &child : op.children) {
+		GetMaxTableIndex(*child, max_index);
+	}
+}
+
+//! The FROM and WHERE clause of the query that a Postgres scan sends to Postgres
+static string GetScanSource(LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	string result;
+	if (bind_data.table_name.empty()) {
+		result = "(" + bind_data.sql + ") AS __unnamed_subquery";
+	} else {
+		result = KeywordHelper::WriteQuoted(bind_data.schema_name, '"') + "." +
+		         KeywordHelper::WriteQuoted(bind_data.table_name, '"');
+	}
+	auto filters = PostgresFilterPushdown::TransformFilters(get.column_ids, &get.table_filters, bind_data.names,
+	                                                        bind_data.postgres_types);
+	for (auto &predicate : bind_data.pushdown_predicates) {
+		if (!filters.empty()) {
+			filters += " AND ";
+		}
+		filters += predicate;
+	}
+	if (!filters.empty()) {
+		result += " WHERE " + filters;
+	}
+	return result;
+}
+
+//! Create a scan that runs the given query in Postgres (like postgres_query) - using the connection of the source scan
+static unique_ptr<LogicalGet> CreateQueryScan(const PostgresBindData &source, idx_t table_index, string sql,
+                                              vector<string> names, vector<LogicalType> types,
+                                              vector<PostgresType> postgres_types = vector<PostgresType>()) {
+	auto bind_data = make_uniq<PostgresBindData>();
+	bind_data->version = source.version;
+	bind_data->dsn = source.dsn;
+	if (source.GetCatalog()) {
+		bind_data->SetCatalog(*source.GetCatalog());
+	}
+	bind_data->sql = std::move(sql);
+	bind_data->parameters = source.parameters;
+	bind_data->names = names;
+	bind_data->types = types;
+	bind_data->postgres_types = std::move(postgres_types);
+	bind_data->postgres_types.resize(types.size());
+	bind_data->read_only = source.read_only;
+	bind_data->SetTablePages(0);
+	if (!source.GetCatalog()) {
+		// scans without a catalog are not visited by the materialization check below
+		bind_data->requires_materialization = false;
+	}
+
+	auto get = make_uniq<LogicalGet>(table_index, PostgresQueryFunction(), std::move(bind_data), std::move(types),
+	                                 std::move(names));
+	for (idx_t i = 0; i < get->returned_types.size(); i++) {
+		get->column_ids.push_back(i);
+	}
+	return get;
+}
+
+static bool UseAggregatePushdown(ClientContext &context, LogicalGet &get) {
+	Value aggregate_pushdown;
+	if (context.TryGetCurrentSetting("pg_aggregate_pushdown", aggregate_pushdown) &&
+	    !BooleanValue::Get(aggregate_pushdown)) {
+		return false;
+	}
+	// only push down aggregates over tables that are large enough for the transfer of the rows to matter
+	idx_t min_rows = 0;
+	Value min_rows_val;
+	if (context.TryGetCurrentSetting("pg_aggregate_pushdown_min_rows", min_rows_val)) {
+		min_rows = UBigIntValue::Get(min_rows_val);
+	}
+	if (min_rows == 0) {
+		return true;
+	}
+	if (!get.function.cardinality) {
+		// e.g. a join that was pushed into Postgres - use the estimate of Postgres
+		return get.has_estimated_cardinality && get.estimated_cardinality >= min_rows;
+	}
+	auto statistics = get.function.cardinality(context, get.bind_data.get());
+	return statistics && statistics->has_estimated_cardinality && statistics->estimated_cardinality >= min_rows;
+}
+
+//! Run GROUP BY queries over a single Postgres scan in Postgres
+//! The aggregate is replaced by a scan of the aggregated result, with a projection on top that casts the result to
+//! the types DuckDB expects
+static void PushdownPostgresAggregates(ClientContext &context, unique_ptr<LogicalOperator> &op,
+                                       PostgresColumnBindingReplacer &replacer, idx_t &next_table_index) {
+	for (auto &child : op->children) {
+		PushdownPostgresAggregates(context, child, replacer, next_table_index);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_AGGREGATE_AND_GROUP_BY ||
+	    op->children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &aggr = op->Cast<LogicalAggregate>();
+	auto &get = op->children[0]->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name) || aggr.grouping_sets.size() > 1 ||
+	    !aggr.grouping_functions.empty()) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.limit_clause.empty() || !UseAggregatePushdown(context, get)) {
+		return;
+	}
+	PostgresPushdownColumns columns(get.table_index, get.column_ids, bind_data.names, bind_data.postgres_types);
+	vector<string> select_list;
+	vector<string> groups;
+	// the types of the result as read from Postgres, and the types of the result of the aggregate in DuckDB
+	vector<LogicalType> result_types;
+	vector<LogicalType> aggregate_types;
+	for (auto &group : aggr.groups) {
+		string group_str;
+		if (!PostgresFilterPushdown::TryTransformExpression(*group, columns, group_str)) {
 			return;
 		}
-		auto &bind_data = get.bind_data->Cast<PostgresBindData>();
-		auto catalog = bind_data.GetCatalog();
-		if (!catalog) {
-			// "postgres_scan" functions are fully independent - we can always stream them
+		select_list.push_back(group_str);
+		groups.push_back(std::move(group_str));
+		result_types.push_back(group->return_type);
+		aggregate_types.push_back(group->return_type);
+	}
+	for (auto &expr : aggr.expressions) {
+		string aggregate_str;
+		LogicalType result_type;
+		if (!PostgresFilterPushdown::TryTransformAggregate(*expr, columns, aggregate_str, result_type)) {
 			return;
 		}
-		result.scans[*catalog].push_back(get);
+		select_list.push_back(std::move(aggregate_str));
+		result_types.push_back(std::move(result_type));
+		aggregate_types.push_back(expr->return_type);
 	}
-	// recurse into children
+	if (select_list.empty()) {
+		return;
+	}
+	// generate the query
+	vector<string> names;
+	string sql = "SELECT ";
+	for (idx_t i = 0; i < select_list.size(); i++) {
+		names.push_back("__aggregate_" + std::to_string(i));
+		sql += i > 0 ? ", " : "";
+		sql += select_list[i] + " AS " + KeywordHelper::WriteQuoted(names.back(), '"');
+	}
+	sql += " FROM " + GetScanSource(get);
+	if (!groups.empty()) {
+		sql += " GROUP BY " + StringUtil::Join(groups, ", ");
+	}
+
+	auto get_index = next_table_index++;
+	auto projection_index = next_table_index++;
+	auto query_scan = CreateQueryScan(bind_data, get_index, std::move(sql), std::move(names), result_types);
+	vector<unique_ptr<Expression>> projections;
+	auto aggregate_bindings = aggr.GetColumnBindings();
+	for (idx_t i = 0; i < result_types.size(); i++) {
+		unique_ptr<Expression> expr = make_uniq<BoundColumnRefExpression>(result_types[i], ColumnBinding(get_index, i));
+		if (result_types[i] != aggregate_types[i]) {
+			expr = BoundCastExpression::AddCastToType(context, std::move(expr), aggregate_types[i]);
+		}
+		projections.push_back(std::move(expr));
+		replacer.replacements[aggregate_bindings[i]] = ColumnBinding(projection_index, i);
+	}
+	auto projection = make_uniq<LogicalProjection>(projection_index, std::move(projections));
+	projection->children.push_back(std::move(query_scan));
+	projection->estimated_cardinality = aggr.estimated_cardinality;
+	projection->ResolveOperatorTypes();
+	op = std::move(projection);
+}
+
+//! Whether or not a column can be read as-is from the result of a query (i.e. without the conversions that are
+//! added to the select list of a scan of the table)
+static bool CanReadFromQuery(const PostgresType &postgres_type, const LogicalType &type) {
+	if (postgres_type.info == PostgresTypeAnnotation::CAST_TO_VARCHAR ||
+	    postgres_type.info == PostgresTypeAnnotation::CTID) {
+		return false;
+	}
+	if (type.id() == LogicalTypeId::LIST && !postgres_type.children.empty() &&
+	    postgres_type.children[0].info == PostgresTypeAnnotation::CAST_TO_VARCHAR) {
+		return false;
+	}
+	return true;
+}
+
+//! The select list of the columns that are read by a Postgres scan
+static string GetScanColumns(LogicalGet &get) {
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	vector<string> columns;
+	for (auto column_id : get.column_ids) {
+		if (column_id != COLUMN_IDENTIFIER_ROW_ID) {
+			columns.push_back(bind_data.GetColumnSQL(column_id));
+		}
+	}
+	return columns.empty() ? "1" : StringUtil::Join(columns, ", ");
+}
+
+//! Run inner joins and semi-joins between two Postgres tables of the same attached database in Postgres
+//! The join is replaced by a scan of the joined result - if Postgres estimates that the amount of data that is
+//! transferred is smaller than when scanning both tables
+static void PushdownPostgresJoins(ClientContext &context, unique_ptr<LogicalOperator> &op,
+                                  PostgresColumnBindingReplacer &replacer, idx_t &next_table_index) {
+	for (auto &child : op->children) {
+		PushdownPostgresJoins(context, child, replacer, next_table_index);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+		return;
+	}
+	auto &join = op->Cast<LogicalComparisonJoin>();
+	if (join.join_type != JoinType::INNER && join.join_type != JoinType::SEMI) {
+		return;
+	}
+	if (join.children[0]->type != LogicalOperatorType::LOGICAL_GET ||
+	    join.children[1]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &left = join.children[0]->Cast<LogicalGet>();
+	auto &right = join.children[1]->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(left.function.name) || !PostgresCatalog::IsPostgresScan(right.function.name)) {
+		return;
+	}
+	auto &left_data = left.bind_data->Cast<PostgresBindData>();
+	auto &right_data = right.bind_data->Cast<PostgresBindData>();
+	if (!left_data.parameters.empty() || !right_data.parameters.empty()) {
+		// the parameters of both queries would be numbered from $1
+		return;
+	}
+	auto catalog = left_data.GetCatalog();
+	if (!catalog || catalog.get() != right_data.GetCatalog().get()) {
+		// both tables have to be in the same attached database
+		return;
+	}
+	if (!left_data.limit_clause.empty() || !right_data.limit_clause.empty()) {
+		return;
+	}
+	PostgresPushdownColumns left_columns(left.table_index, left.column_ids, left_data.names, left_data.postgres_types);
+	left_columns.alias = "__left";
+	PostgresPushdownColumns right_columns(right.table_index, right.column_ids, right_data.names,
+	                                      right_data.postgres_types);
+	right_columns.alias = "__right";
+	vector<string> conditions;
+	for (auto &condition : join.conditions) {
+		string left_str, right_str, condition_str;
+		if (!PostgresFilterPushdown::TryTransformExpression(*condition.left, left_columns, left_str) ||
+		    !PostgresFilterPushdown::TryTransformExpression(*condition.right, right_columns, right_str) ||
+		    !PostgresFilterPushdown::TryTransformComparison(condition.comparison, condition.left->return_type,
+		                                                    left_str, right_str, condition_str)) {
+			return;
+		}
+		conditions.push_back(std::move(condition_str));
+	}
+	if (conditions.empty()) {
+		return;
+	}
+	// the result of the join consists of the columns of the scans that are referenced by the join bindings
+	auto bindings = join.GetColumnBindings();
+	if (bindings.empty()) {
+		return;
+	}
+	vector<string> select_list;
+	vector<string> names;
+	vector<LogicalType> types;
+	vector<PostgresType> postgres_types;
+	for (auto &binding : bindings) {
+		auto is_left = binding.table_index == left.table_index;
+		auto &get = is_left ? left : right;
+		auto &bind_data = is_left ? left_data : right_data;
+		if (binding.table_index != get.table_index || binding.column_index >= get.column_ids.size()) {
+			return;
+		}
+		auto column_id = get.column_ids[binding.column_index];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID ||
+		    !CanReadFromQuery(bind_data.postgres_types[column_id], bind_data.types[column_id])) {
+			return;
+		}
+		names.push_back("__join_" + std::to_string(names.size()));
+		select_list.push_back(StringUtil::Format("%s.%s AS %s", is_left ? "__left" : "__right",
+		                                         KeywordHelper::WriteQuoted(bind_data.names[column_id], '"'),
+		                                         KeywordHelper::WriteQuoted(names.back(), '"')));
+		types.push_back(bind_data.types[column_id]);
+		postgres_types.push_back(bind_data.postgres_types[column_id]);
+	}
+	auto left_source = "(SELECT * FROM " + GetScanSource(left) + ") AS __left";
+	auto right_source = "(SELECT * FROM " + GetScanSource(right) + ") AS __right";
+	string sql = "SELECT " + StringUtil::Join(select_list, ", ") + " FROM " + left_source;
+	if (join.join_type == JoinType::INNER) {
+		sql += " JOIN " + right_source + " ON " + StringUtil::Join(conditions, " AND ");
+	} else {
+		sql += " WHERE EXISTS (SELECT 1 FROM " + right_source + " WHERE " + StringUtil::Join(conditions, " AND ") + ")";
+	}
+
+	// compare the estimated amount of data that is transferred with and without pushing down the join
+	auto &con = PostgresTransaction::Get(context, *catalog).GetConnection();
+	double join_rows, join_width, left_rows, left_width, right_rows, right_width;
+	if (!con.TryGetQueryEstimate(sql, join_rows, join_width) ||
+	    !con.TryGetQueryEstimate("SELECT " + GetScanColumns(left) + " FROM " + GetScanSource(left), left_rows,
+	                             left_width) ||
+	    !con.TryGetQueryEstimate("SELECT " + GetScanColumns(right) + " FROM " + GetScanSource(right), right_rows,
+	                             right_width)) {
+		return;
+	}
+	if (join_rows * join_width >= left_rows * left_width + right_rows * right_width) {
+		return;
+	}
+
+	auto get_index = next_table_index++;
+	auto query_scan = CreateQueryScan(left_data, get_index, std::move(sql), std::move(names), std::move(types),
+	                                  std::move(postgres_types));
+	query_scan->estimated_cardinality = idx_t(join_rows);
+	query_scan->has_estimated_cardinality = true;
+	for (idx_t i = 0; i < bindings.size(); i++) {
+		replacer.replacements[bindings[i]] = ColumnBinding(get_index, i);
+	}
+	op = std::move(query_scan);
+}
+
+//! Find the Postgres scan below a LIMIT or TOP N - looking through a projection
+static optional_ptr<LogicalGet> GetLimitedScan(LogicalOperator &op, optional_ptr<LogicalProjection> &projection) {
+	auto child = op.children[0].get();
+	if (child->type == LogicalOperatorType::LOGICAL_PROJECTION) {
+		projection = &child->Cast<LogicalProjection>();
+		child = child->children[0].get();
+	}
+	if (child->type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = child->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name)) {
+		return nullptr;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (!bind_data.limit_clause.empty()) {
+		return nullptr;
+	}
+	return &get;
+}
+
+static bool TryTransformOrders(const vector<BoundOrderByNode> &orders, optional_ptr<LogicalProjection> projection,
+                               const PostgresPushdownColumns &columns, string &result) {
+	vector<string> order_list;
+	for (auto &order : orders) {
+		// resolve references to the projection between the LIMIT and the scan
+		reference<Expression> expr = *order.expression;
+		if (projection && expr.get().GetExpressionClass() == ExpressionClass::BOUND_COLUMN_REF) {
+			auto &colref = expr.get().Cast<BoundColumnRefExpression>();
+			if (colref.binding.table_index == projection->table_index) {
+				expr = *projection->expressions[colref.binding.column_index];
+			}
+		}
+		string order_str;
+		if (!PostgresFilterPushdown::TryTransformExpression(expr.get(), columns, order_str)) {
+			return false;
+		}
+		if (expr.get().return_type.id() == LogicalTypeId::VARCHAR) {
+			// DuckDB sorts strings byte-wise
+			order_str += " COLLATE \"C\"";
+		}
+		switch (order.null_order) {
+		case OrderByNullType::NULLS_FIRST:
+			order_str += order.type == OrderType::DESCENDING ? " DESC NULLS FIRST" : " ASC NULLS FIRST";
+			break;
+		case OrderByNullType::NULLS_LAST:
+			order_str += order.type == OrderType::DESCENDING ? " DESC NULLS LAST" : " ASC NULLS LAST";
+			break;
+		default:
+			return false;
+		}
+		order_list.push_back(std::move(order_str));
+	}
+	result = "ORDER BY " + StringUtil::Join(order_list, ", ");
+	return true;
+}
+
+//! Push LIMIT and TOP N directly on top of a Postgres scan into the generated SQL, so that Postgres can stop early
+//! (or use an index to produce the top rows). The LIMIT and TOP N are still performed by DuckDB afterwards
+static void PushdownPostgresLimits(ClientContext &context, LogicalOperator &op) {
 	for (auto &child : op.children) {
-		GatherPostgresScans(*child, result);
+		PushdownPostgresLimits(context, *child);
+	}
+	optional_ptr<LogicalProjection> projection;
+	if (op.type == LogicalOperatorType::LOGICAL_LIMIT) {
+		auto &limit = op.Cast<LogicalLimit>();
+		if (limit.limit_val.Type() != LimitNodeType::CONSTANT_VALUE) {
+			return;
+		}
+		if (limit.offset_val.Type() != LimitNodeType::UNSET &&
+		    limit.offset_val.Type() != LimitNodeType::CONSTANT_VALUE) {
+			return;
+		}
+		auto get = GetLimitedScan(op, projection);
+		if (!get) {
+			return;
+		}
+		auto limit_count = limit.limit_val.GetConstantValue();
+		if (limit.offset_val.Type() == LimitNodeType::CONSTANT_VALUE) {
+			limit_count += limit.offset_val.GetConstantValue();
+		}
+		auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+		bind_data.SetLimitClause(StringUtil::Format("LIMIT %llu", limit_count));
+	} else if (op.type == LogicalOperatorType::LOGICAL_TOP_N) {
+		auto &top_n = op.Cast<LogicalTopN>();
+		auto get = GetLimitedScan(op, projection);
+		if (!get) {
+			return;
+		}
+		auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+		PostgresPushdownColumns columns(get->table_index, get->column_ids, bind_data.names,
+		                                bind_data.postgres_types);
+		string order_by;
+		if (!TryTransformOrders(top_n.orders, projection, columns, order_by)) {
+			return;
+		}
+		bind_data.SetLimitClause(StringUtil::Format("%s LIMIT %llu", order_by, top_n.limit + top_n.offset));
+	}
+}
+
+//! Whether or not a column is wide enough for fetching it only for the rows that pass a filter to pay off
+static bool IsWideColumn(const LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::VARCHAR:
+	case LogicalTypeId::BLOB:
+	case LogicalTypeId::LIST:
+	case LogicalTypeId::STRUCT:
+	case LogicalTypeId::MAP:
+		return true;
+	default:
+		return false;
+	}
+}
+
+static void GetReferencedColumns(Expression &expr, idx_t table_index, unordered_set<idx_t> &result) {
+	if (expr.type == ExpressionType::BOUND_COLUMN_REF) {
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		if (colref.binding.table_index == table_index) {
+			result.insert(colref.binding.column_index);
+		}
+	}
+	ExpressionIterator::EnumerateChildren(expr,
+	                                      [&](Expression &child) { GetReferencedColumns(child, table_index, result); });
+}
+
+//! Split a scan of a Postgres table below a filter that is evaluated in DuckDB into two scans: the first scan reads
+//! the ctid and the columns that are needed by the filter, the second scan reads the remaining (wide) columns for the
+//! ctids of the rows that pass the filter only
+static void PushdownPostgresLateMaterialization(ClientContext &context, unique_ptr<LogicalOperator> &op,
+                                                PostgresColumnBindingReplacer &replacer, idx_t &next_table_index,
+                                                idx_t max_rows) {
+	for (auto &child : op->children) {
+		PushdownPostgresLateMaterialization(context, child, replacer, next_table_index, max_rows);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_FILTER ||
+	    op->children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &filter = op->Cast<LogicalFilter>();
+	auto &get = op->children[0]->Cast<LogicalGet>();
+	if (filter.expressions.empty() || !filter.projection_map.empty() ||
+	    !PostgresCatalog::IsPostgresScan(get.function.name)) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	// only regular tables have a ctid that identifies a row
+	if (!bind_data.GetCatalog() || !bind_data.read_only || bind_data.table_name.empty() ||
+	    bind_data.relation_kind != 'r' || !bind_data.limit_clause.empty() || !bind_data.leaf_partitions.empty()) {
+		return;
+	}
+	unordered_set<idx_t> filter_columns;
+	for (auto &expr : filter.expressions) {
+		GetReferencedColumns(*expr, get.table_index, filter_columns);
+	}
+	// the wide output columns that are not needed to evaluate the filter are fetched in the second scan
+	vector<idx_t> output_columns;
+	if (get.projection_ids.empty()) {
+		for (idx_t i = 0; i < get.column_ids.size(); i++) {
+			output_columns.push_back(i);
+		}
+	} else {
+		output_columns = get.projection_ids;
+	}
+	unordered_set<idx_t> fetched_columns;
+	for (auto &col_idx : output_columns) {
+		auto column_id = get.column_ids[col_idx];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID || filter_columns.count(col_idx) > 0 ||
+		    get.table_filters.filters.count(col_idx) > 0 || !IsWideColumn(bind_data.types[column_id])) {
+			continue;
+		}
+		fetched_columns.insert(col_idx);
+	}
+	if (fetched_columns.empty()) {
+		return;
+	}
+	auto scan_index = next_table_index++;
+	auto fetch_index = next_table_index++;
+
+	// the first scan reads the remaining columns and the ctid
+	vector<column_t> scan_column_ids;
+	vector<column_t> fetch_column_ids {COLUMN_IDENTIFIER_ROW_ID};
+	unordered_map<idx_t, idx_t> scan_positions;
+	for (idx_t i = 0; i < get.column_ids.size(); i++) {
+		if (fetched_columns.count(i) > 0) {
+			replacer.replacements[ColumnBinding(get.table_index, i)] =
+			    ColumnBinding(fetch_index, fetch_column_ids.size());
+			fetch_column_ids.push_back(get.column_ids[i]);
+		} else {
+			replacer.replacements[ColumnBinding(get.table_index, i)] =
+			    ColumnBinding(scan_index, scan_column_ids.size());
+			scan_positions[i] = scan_column_ids.size();
+			scan_column_ids.push_back(get.column_ids[i]);
+		}
+	}
+	auto ctid_index = scan_column_ids.size();
+	scan_column_ids.push_back(COLUMN_IDENTIFIER_ROW_ID);
+	TableFilterSet scan_filters;
+	for (auto &entry : get.table_filters.filters) {
+		scan_filters.filters[scan_positions[entry.first]] = std::move(entry.second);
+	}
+	vector<idx_t> scan_projection_ids;
+	if (!get.projection_ids.empty()) {
+		for (auto &col_idx : get.projection_ids) {
+			if (fetched_columns.count(col_idx) == 0) {
+				scan_projection_ids.push_back(scan_positions[col_idx]);
+			}
+		}
+		scan_projection_ids.push_back(ctid_index);
+	}
+
+	// the second scan reads the wide columns of the rows that pass the filter
+	auto fetch_filter = PostgresRuntimeFilter::CreateCTIDFilter(max_rows);
+	auto fetch_data = make_uniq<PostgresBindData>(bind_data);
+	fetch_data->pushdown_predicates.clear();
+	fetch_data->runtime_filters.clear();
+	fetch_data->runtime_filters.push_back(fetch_filter);
+	fetch_data->emit_ctid = true;
+	fetch_data->SetTablePages(0);
+	auto fetch = make_uniq<LogicalGet>(fetch_index, get.function, std::move(fetch_data), get.returned_types, get.names);
+	fetch->column_ids = std::move(fetch_column_ids);
+
+	bind_data.emit_ctid = true;
+	get.table_index = scan_index;
+	get.column_ids = std::move(scan_column_ids);
+	get.table_filters = std::move(scan_filters);
+	get.projection_ids = std::move(scan_projection_ids);
+	idx_t ctid_output_index = get.projection_ids.empty() ? ctid_index : get.projection_ids.size() - 1;
+
+	// join the rows that pass the filter with the fetched columns on the ctid
+	auto estimated_cardinality = filter.EstimateCardinality(context);
+	auto join = make_uniq<LogicalComparisonJoin>(JoinType::INNER);
+	JoinCondition condition;
+	condition.left = make_uniq<BoundColumnRefExpression>(LogicalType::BIGINT, ColumnBinding(fetch_index, 0));
+	condition.right = make_uniq<BoundColumnRefExpression>(LogicalType::BIGINT, ColumnBinding(scan_index, ctid_index));
+	condition.comparison = ExpressionType::COMPARE_EQUAL;
+	join->conditions.push_back(std::move(condition));
+	join->children.push_back(std::move(fetch));
+	join->children.push_back(
+	    make_uniq<LogicalPostgresRuntimeFilter>(std::move(fetch_filter), ctid_output_index, std::move(op)));
+	join->SetEstimatedCardinality(estimated_cardinality);
+	op = std::move(join);
+}
+
+//! Find the Postgres scan on the probe side of a join - looking through a filter
+static optional_ptr<LogicalGet> GetProbeScan(LogicalOperator &op) {
+	reference<LogicalOperator> child(op);
+	if (child.get().type == LogicalOperatorType::LOGICAL_FILTER) {
+		child = *child.get().children[0];
+	}
+	if (child.get().type != LogicalOperatorType::LOGICAL_GET) {
+		return nullptr;
+	}
+	auto &get = child.get().Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name)) {
+		return nullptr;
+	}
+	return &get;
+}
+
+//! Collect the join keys of the build side of joins with a Postgres scan on the probe side, so that the scan only
+//! has to fetch the rows that can find a match
+static void PushdownPostgresRuntimeFilters(ClientContext &context, LogicalOperator &op, idx_t max_keys) {
+	for (auto &child : op.children) {
+		PushdownPostgresRuntimeFilters(context, *child, max_keys);
+	}
+	if (op.type != LogicalOperatorType::LOGICAL_COMPARISON_JOIN) {
+		return;
+	}
+	auto &join = op.Cast<LogicalComparisonJoin>();
+	if (join.join_type != JoinType::INNER && join.join_type != JoinType::SEMI) {
+		return;
+	}
+	auto get = GetProbeScan(*join.children[0]);
+	if (!get) {
+		return;
+	}
+	auto &bind_data = get->bind_data->Cast<PostgresBindData>();
+	if (!bind_data.limit_clause.empty()) {
+		// filtering the rows changes which rows the LIMIT selects
+		return;
+	}
+	auto &build = *join.children[1];
+	if (build.EstimateCardinality(context) > PostgresRuntimeFilter::MAX_BUILD_ROWS) {
+		return;
+	}
+	for (auto &condition : join.conditions) {
+		if (condition.comparison != ExpressionType::COMPARE_EQUAL ||
+		    condition.left->type != ExpressionType::BOUND_COLUMN_REF ||
+		    condition.right->type != ExpressionType::BOUND_COLUMN_REF) {
+			continue;
+		}
+		auto &type = condition.left->return_type;
+		if (type.id() != LogicalTypeId::SMALLINT && type.id() != LogicalTypeId::INTEGER &&
+		    type.id() != LogicalTypeId::BIGINT) {
+			continue;
+		}
+		auto &probe_ref = condition.left->Cast<BoundColumnRefExpression>();
+		auto &probe_binding = probe_ref.binding;
+		if (probe_ref.depth > 0 || probe_binding.table_index != get->table_index) {
+			continue;
+		}
+		auto column_id = get->column_ids[probe_binding.column_index];
+		if (column_id == COLUMN_IDENTIFIER_ROW_ID ||
+		    bind_data.postgres_types[column_id].info != PostgresTypeAnnotation::STANDARD) {
+			continue;
+		}
+		// find the join keys in the output of the build side
+		auto &build_binding = condition.right->Cast<BoundColumnRefExpression>().binding;
+		auto build_bindings = build.GetColumnBindings();
+		idx_t key_index;
+		for (key_index = 0; key_index < build_bindings.size(); key_index++) {
+			if (build_bindings[key_index] == build_binding) {
+				break;
+			}
+		}
+		if (key_index >= build_bindings.size()) {
+			continue;
+		}
+		auto filter = make_shared<PostgresRuntimeFilter>(
+		    KeywordHelper::WriteQuoted(bind_data.names[column_id], '"'), max_keys);
+		bind_data.runtime_filters.push_back(filter);
+		join.children[1] =
+		    make_uniq<LogicalPostgresRuntimeFilter>(std::move(filter), key_index, std::move(join.children[1]));
+		return;
+	}
+}
+
+static bool IsSimpleJsonKey(const string &key) {
+	if (key.empty()) {
+		return false;
+	}
+	for (auto c : key) {
+		if (!StringUtil::CharacterIsAlpha(c) && !StringUtil::CharacterIsDigit(c) && c != '_') {
+			return false;
+		}
+	}
+	return true;
+}
+
+//! The Postgres operand of ->> for the path of json_extract_string - only single keys ('key' or '$.key') and array
+//! indexes have the same meaning in Postgres
+static bool TryGetJsonExtractKey(Expression &path, string &result) {
+	if (path.type != ExpressionType::VALUE_CONSTANT) {
+		return false;
+	}
+	auto &value = path.Cast<BoundConstantExpression>().value;
+	if (value.IsNull()) {
+		return false;
+	}
+	if (value.type().IsIntegral()) {
+		auto index = value.GetValue<int64_t>();
+		if (index < 0) {
+			return false;
+		}
+		result = to_string(index);
+		return true;
+	}
+	if (value.type().id() != LogicalTypeId::VARCHAR) {
+		return false;
+	}
+	auto key = StringValue::Get(value);
+	if (StringUtil::StartsWith(key, "$.")) {
+		key = key.substr(2);
+	}
+	if (!IsSimpleJsonKey(key)) {
+		return false;
+	}
+	result = KeywordHelper::WriteQuoted(key, '\'');
+	return true;
+}
+
+//! Whether or not the binding refers to a JSON column of the scan that is selected as-is
+static bool TryGetJsonColumn(const ColumnBinding &binding, LogicalGet &get, column_t &column_id) {
+	if (binding.table_index != get.table_index) {
+		return false;
+	}
+	auto column_idx = get.projection_ids.empty() ? binding.column_index : get.projection_ids[binding.column_index];
+	column_id = get.column_ids[column_idx];
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (column_id == COLUMN_IDENTIFIER_ROW_ID || column_id >= bind_data.postgres_types.size()) {
+		return false;
+	}
+	if (column_id < bind_data.column_expressions.size() && !bind_data.column_expressions[column_id].empty()) {
+		return false;
+	}
+	auto oid = bind_data.postgres_types[column_id].oid;
+	return oid == JSONOID || oid == JSONBOID;
+}
+
+struct PostgresJsonExtracts {
+	//! The scan columns that select the extracted keys - by JSON column and key
+	map<pair<column_t, string>, ColumnBinding> columns;
+	//! The JSON columns of which keys were extracted
+	unordered_set<idx_t> json_bindings;
+};
+
+//! Replace json_extract_string (->>) of a key of a JSON column of the scan with a column that extracts the key in
+//! Postgres
+static void ReplaceJsonExtracts(unique_ptr<Expression> &expr, LogicalGet &get, PostgresJsonExtracts &extracts) {
+	if (expr->type == ExpressionType::BOUND_FUNCTION) {
+		auto &function = expr->Cast<BoundFunctionExpression>();
+		string key;
+		if ((function.function.name == "json_extract_string" || function.function.name == "->>") &&
+		    function.children.size() == 2 && function.return_type.id() == LogicalTypeId::VARCHAR &&
+		    function.children[0]->type == ExpressionType::BOUND_COLUMN_REF &&
+		    TryGetJsonExtractKey(*function.children[1], key)) {
+			auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+			auto binding = function.children[0]->Cast<BoundColumnRefExpression>().binding;
+			column_t column_id;
+			if (TryGetJsonColumn(binding, get, column_id)) {
+				auto entry = extracts.columns.find(make_pair(column_id, key));
+				if (entry == extracts.columns.end()) {
+					auto name = bind_data.names[column_id] + "->>" + key;
+					auto expression = "(" + bind_data.GetColumnSQL(column_id) + " ->> " + key + ")";
+					auto new_column_id = bind_data.AddColumnExpression(name, function.return_type, expression);
+					get.names.push_back(name);
+					get.returned_types.push_back(function.return_type);
+					get.column_ids.push_back(new_column_id);
+					ColumnBinding new_binding(get.table_index, get.column_ids.size() - 1);
+					if (!get.projection_ids.empty()) {
+						get.projection_ids.push_back(get.column_ids.size() - 1);
+						new_binding.column_index = get.projection_ids.size() - 1;
+					}
+					entry = extracts.columns.insert(make_pair(make_pair(column_id, key), new_binding)).first;
+				}
+				extracts.json_bindings.insert(binding.column_index);
+				expr = make_uniq<BoundColumnRefExpression>(function.return_type, entry->second);
+				return;
+			}
+		}
+	}
+	ExpressionIterator::EnumerateChildren(
+	    *expr, [&](unique_ptr<Expression> &child) { ReplaceJsonExtracts(child, get, extracts); });
+}
+
+//! Extract the keys of JSON columns that are projected with ->> in Postgres - if the JSON column is not needed
+//! otherwise only the extracted keys are transferred instead of the whole documents
+static void PushdownPostgresJsonExtracts(unique_ptr<LogicalOperator> &op) {
+	for (auto &child : op->children) {
+		PushdownPostgresJsonExtracts(child);
+	}
+	if (op->type != LogicalOperatorType::LOGICAL_PROJECTION ||
+	    op->children[0]->type != LogicalOperatorType::LOGICAL_GET) {
+		return;
+	}
+	auto &get = op->children[0]->Cast<LogicalGet>();
+	if (!PostgresCatalog::IsPostgresScan(get.function.name)) {
+		return;
+	}
+	auto &bind_data = get.bind_data->Cast<PostgresBindData>();
+	if (get.names.size() != bind_data.names.size() || get.returned_types.size() != bind_data.types.size()) {
+		return;
+	}
+	PostgresJsonExtracts extracts;
+	for (auto &expr : op->expressions) {
+		ReplaceJsonExtracts(expr, get, extracts);
+	}
+	if (extracts.json_bindings.empty()) {
+		return;
+	}
+	// JSON columns that are no longer referenced are not transferred - they cannot be removed from the scan without
+	// renumbering its columns, so NULL is selected instead
+	unordered_set<idx_t> referenced_columns;
+	for (auto &expr : op->expressions) {
+		GetReferencedColumns(*expr, get.table_index, referenced_columns);
+	}
+	for (auto &json_binding : extracts.json_bindings) {
+		if (referenced_columns.count(json_binding) > 0) {
+			continue;
+		}
+		auto column_idx = get.projection_ids.empty() ? json_binding : get.projection_ids[json_binding];
+		bind_data.column_expressions[get.column_ids[column_idx]] = "NULL";
 	}
 }
 
 void PostgresOptimizer::Optimize(ClientContext &context, OptimizerExtensionInfo *info,
                                  unique_ptr<LogicalOperator> &plan) {
+	PushdownPostgresPredicates(plan);
+	idx_t max_table_index = 0;
+	GetMaxTableIndex(*plan, max_table_index);
+	auto next_table_index = max_table_index + 1;
+	Value join_pushdown;
+	if (context.TryGetCurrentSetting("pg_join_pushdown", join_pushdown) && BooleanValue::Get(join_pushdown)) {
+		PostgresColumnBindingReplacer replacer;
+		PushdownPostgresJoins(context, plan, replacer, next_table_index);
+		if (!replacer.replacements.empty()) {
+			replacer.VisitOperator(*plan);
+		}
+	}
+	PostgresColumnBindingReplacer replacer;
+	PushdownPostgresAggregates(context, plan, replacer, next_table_index);
+	if (!replacer.replacements.empty()) {
+		replacer.VisitOperator(*plan);
+	}
+	Value limit_pushdown;
+	if (!context.TryGetCurrentSetting("pg_limit_pushdown", limit_pushdown) || BooleanValue::Get(limit_pushdown)) {
+		PushdownPostgresLimits(context, *plan);
+	}
+	Value late_materialization;
+	if (context.TryGetCurrentSetting("pg_late_materialization", late_materialization) &&
+	    BooleanValue::Get(late_materialization)) {
+		Value max_rows;
+		idx_t max_rows_val = PostgresOptimizer::DEFAULT_LATE_MATERIALIZATION_ROWS;
+		if (context.TryGetCurrentSetting("pg_late_materialization_max_rows", max_rows)) {
+			max_rows_val = UBigIntValue::Get(max_rows);
+		}
+		PostgresColumnBindingReplacer replacer;
+		PushdownPostgresLateMaterialization(context, plan, replacer, next_table_index, max_rows_val);
+		if (!replacer.replacements.empty()) {
+			replacer.VisitOperator(*plan);
+		}
+	}
+	Value json_extract_pushdown;
+	if (context.TryGetCurrentSetting("pg_json_extract_pushdown", json_extract_pushdown) &&
+	    BooleanValue::Get(json_extract_pushdown)) {
+		PushdownPostgresJsonExtracts(plan);
+	}
+	Value runtime_filters;
+	if (context.TryGetCurrentSetting("pg_runtime_filter_pushdown", runtime_filters) &&
+	    BooleanValue::Get(runtime_filters)) {
+		Value max_keys;
+		idx_t max_keys_val = PostgresRuntimeFilter::DEFAULT_MAX_KEYS;
+		if (context.TryGetCurrentSetting("pg_runtime_filter_max_keys", max_keys)) {
+			max_keys_val = UBigIntValue::Get(max_keys);
+		}
+		PushdownPostgresRuntimeFilters(context, *plan, max_keys_val);
+	}
 	// look at the query plan and check if we can enable streaming query scans
 	PostgresOperators operators;
 	GatherPostgresScans(*plan, operators);
@@ -45,18 +966,28 @@ void PostgresOptimizer::Optimize(ClientContext &context, OptimizerExtensionInfo
 	}
 	for (auto &entry : operators.scans) {
 		auto &catalog = entry.first;
-		auto multiple_scans = entry.second.size() > 1;
+		auto lookup_entry = operators.lookups.find(catalog);
+		auto lookup_count = lookup_entry == operators.lookups.end() ? 0 : lookup_entry->second;
+		auto multiple_scans = entry.second.size() + lookup_count > 1;
 		for (auto &scan : entry.second) {
 			auto &bind_data = scan.get().bind_data->Cast<PostgresBindData>();
 			// if there is a single scan in the plan we can always stream using the main thread
 			// if there is more than one scan we either (1) need to materialize, or (2) cannot use the main thread
 			if (multiple_scans) {
-				if (bind_data.max_threads > 1 && bind_data.read_only) {
+				// Aurora does not support exporting snapshots - single-threaded scans are materialized there to
+				// keep them consistent with the other scans of the transaction
+				bool can_share_snapshot =
+				    bind_data.max_threads > 1 || bind_data.version.type_v != PostgresInstanceType::AURORA;
+				if (bind_data.read_only && can_share_snapshot) {
+					// stream the scan over a separate (pooled) connection that imports the snapshot of the
+					// transaction - this also lets scans with runtime filters run after the build side of their join
 					bind_data.requires_materialization = false;
 					bind_data.can_use_main_thread = false;
 				} else {
 					bind_data.requires_materialization = true;
 					bind_data.can_use_main_thread = true;
+					// materialized scans run up-front - before the build side of the join has finished
+					bind_data.runtime_filters.clear();
 				}
 			} else {
 				bind_data.requires_materialization = false;
@@ -0,0 +1,114 @@
+#include "storage/postgres_result_cache.hpp"
+#include "duckdb/common/types/interval.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "postgres_result.hpp"
+
+namespace duckdb {
+
+shared_ptr<ColumnDataCollection> PostgresResultCache::Lookup(const string &key, const string &freshness,
+                                                             idx_t ttl_seconds) {
+	lock_guard<mutex> guard(lock);
+	auto entry = entries.find(key);
+	if (entry == entries.end()) {
+		return nullptr;
+	}
+	auto &cache_entry = entry->second;
+	if (ttl_seconds > 0) {
+		auto age = Timestamp::GetCurrentTimestamp().value - cache_entry.created.value;
+		if (age > int64_t(ttl_seconds * Interval::MICROS_PER_SEC)) {
+			EraseEntry(entry);
+			return nullptr;
+		}
+	}
+	if (cache_entry.freshness != freshness) {
+		// the table has been modified since the result was cached
+		EraseEntry(entry);
+		return nullptr;
+	}
+	lru.splice(lru.begin(), lru, cache_entry.lru_position);
+	return cache_entry.result;
+}
+
+void PostgresResultCache::Insert(const string &key, string table_key, string freshness,
+                                 shared_ptr<ColumnDataCollection> result, idx_t capacity) {
+	auto size = result->AllocationSize();
+	lock_guard<mutex> guard(lock);
+	auto existing = entries.find(key);
+	if (existing != entries.end()) {
+		EraseEntry(existing);
+	}
+	if (size > capacity) {
+		// the result does not fit in the cache
+		return;
+	}
+	while (total_size + size > capacity && !lru.empty()) {
+		EraseEntry(entries.find(lru.back()));
+	}
+	lru.push_front(key);
+	CacheEntry cache_entry;
+	cache_entry.table_key = std::move(table_key);
+	cache_entry.freshness = std::move(freshness);
+	cache_entry.created = Timestamp::GetCurrentTimestamp();
+	cache_entry.result = std::move(result);
+	cache_entry.size = size;
+	cache_entry.lru_position = lru.begin();
+	entries.insert(make_pair(key, std::move(cache_entry)));
+	total_size += size;
+}
+
+void PostgresResultCache::Invalidate(const string &table_key) {
+	lock_guard<mutex> guard(lock);
+	for (auto entry = entries.begin(); entry != entries.end();) {
+		auto current = entry++;
+		if (current->second.table_key == table_key) {
+			EraseEntry(current);
+		}
+	}
+}
+
+void PostgresResultCache::Clear() {
+	lock_guard<mutex> guard(lock);
+	entries.clear();
+	lru.clear();
+	total_size = 0;
+}
+
+void PostgresResultCache::EraseEntry(unordered_map<string, CacheEntry>::iterator entry) {
+	D_ASSERT(entry != entries.end());
+	total_size -= entry->second.size;
+	lru.erase(entry->second.lru_position);
+	entries.erase(entry);
+}
+
+string PostgresResultCache::GetTableKey(const string &schema_name, const string &table_name) {
+	return KeywordHelper::WriteQuoted(schema_name, '"') + "." + KeywordHelper::WriteQuoted(table_name, '"');
+}
+
+string PostgresResultCache::GetFreshness(PostgresConnection &connection, const string &schema_name,
+                                         const string &table_name, char relation_kind) {
+	if (relation_kind != 'r' && relation_kind != 'm') {
+		// the statistics of views, foreign tables and partitioned tables do not reflect modifications of the data
+		return string();
+	}
+	// the modification counters change on every INSERT, UPDATE and DELETE - the filenode changes on TRUNCATE
+	// the counters are flushed asynchronously (and kept for the rest of a transaction) - so they can lag behind
+	auto query = R"(
+SELECT n_tup_ins, n_tup_upd, n_tup_del, n_live_tup, pg_relation_filenode(relid)
+FROM pg_stat_all_tables
+WHERE relid=to_regclass($1::text)
+)";
+	auto result = connection.TryQueryWithParameters(query, {Value(GetTableKey(schema_name, table_name))});
+	if (!result || result->Count() != 1) {
+		return string();
+	}
+	string freshness;
+	for (idx_t c = 0; c < 5; c++) {
+		if (!freshness.empty()) {
+			freshness += ":";
+		}
+		freshness += result->IsNull(0, c) ? "NULL" : result->GetString(0, c);
+	}
+	return freshness;
+}
+
+} // namespace duckdb
@@ -0,0 +1,263 @@
+#include "storage/postgres_runtime_filter.hpp"
+#include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/types/column/column_data_collection.hpp"
+#include "duckdb/execution/physical_plan_generator.hpp"
+
+namespace duckdb {
+
+PostgresRuntimeFilter::PostgresRuntimeFilter(string column_name_p, idx_t max_keys_p)
+    : column_name(std::move(column_name_p)), max_keys(max_keys_p) {
+}
+
+shared_ptr<PostgresRuntimeFilter> PostgresRuntimeFilter::CreateCTIDFilter(idx_t max_keys) {
+	auto result = make_shared<PostgresRuntimeFilter>("ctid", max_keys);
+	result->ctid = true;
+	return result;
+}
+
+string PostgresRuntimeFilter::FormatKey(int64_t key) const {
+	if (!ctid) {
+		return to_string(key);
+	}
+	// the row id of a scan is (page_index << 16) + tuple_in_page
+	return StringUtil::Format("(%lld,%lld)", key >> 16LL, key & 0xFFFF);
+}
+
+template <class T>
+void PostgresRuntimeFilter::AddKeysInternal(Vector &keys, idx_t count) {
+	UnifiedVectorFormat format;
+	keys.ToUnifiedFormat(count, format);
+	auto data = UnifiedVectorFormat::GetData<T>(format);
+	lock_guard<mutex> guard(lock);
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = format.sel->get_index(i);
+		if (!format.validity.RowIsValid(idx)) {
+			// NULL never matches a join key
+			continue;
+		}
+		auto key = int64_t(data[idx]);
+		if (!has_keys) {
+			min_key = key;
+			max_key = key;
+			has_keys = true;
+		} else {
+			min_key = MinValue<int64_t>(min_key, key);
+			max_key = MaxValue<int64_t>(max_key, key);
+		}
+		if (too_many_keys) {
+			continue;
+		}
+		distinct_keys.insert(key);
+		if (distinct_keys.size() > max_keys) {
+			too_many_keys = true;
+			distinct_keys.clear();
+		}
+	}
+}
+
+void PostgresRuntimeFilter::AddKeys(Vector &keys, idx_t count) {
+	switch (keys.GetType().InternalType()) {
+	case PhysicalType::INT16:
+		AddKeysInternal<int16_t>(keys, count);
+		break;
+	case PhysicalType::INT32:
+		AddKeysInternal<int32_t>(keys, count);
+		break;
+	case PhysicalType::INT64:
+		AddKeysInternal<int64_t>(keys, count);
+		break;
+	default:
+		throw InternalException("Unsupported key type %s for Postgres runtime filter", keys.GetType().ToString());
+	}
+}
+
+void PostgresRuntimeFilter::Reset() {
+	lock_guard<mutex> guard(lock);
+	finished = false;
+	has_keys = false;
+	too_many_keys = false;
+	distinct_keys.clear();
+}
+
+void PostgresRuntimeFilter::Finish() {
+	lock_guard<mutex> guard(lock);
+	finished = true;
+}
+
+string PostgresRuntimeFilter::GetPredicate() const {
+	lock_guard<mutex> guard(lock);
+	if (!finished) {
+		return string();
+	}
+	if (!has_keys) {
+		// the build side is empty (or only has NULL keys) - nothing can match
+		return "FALSE";
+	}
+	if (too_many_keys) {
+		if (ctid) {
+			return StringUtil::Format("%s BETWEEN '%s'::tid AND '%s'::tid", column_name, FormatKey(min_key),
+			                          FormatKey(max_key));
+		}
+		return StringUtil::Format("%s BETWEEN %lld AND %lld", column_name, min_key, max_key);
+	}
+	vector<int64_t> keys(distinct_keys.begin(), distinct_keys.end());
+	std::sort(keys.begin(), keys.end());
+	string result = column_name + " = ANY('{";
+	for (idx_t i = 0; i < keys.size(); i++) {
+		if (i > 0) {
+			result += ",";
+		}
+		if (ctid) {
+			result += "\"" + FormatKey(keys[i]) + "\"";
+		} else {
+			result += FormatKey(keys[i]);
+		}
+	}
+	result += ctid ? "}'::tid[])" : "}'::BIGINT[])";
+	return result;
+}
+
+//===--------------------------------------------------------------------===//
+// Logical Operator
+//===--------------------------------------------------------------------===//
+LogicalPostgresRuntimeFilter::LogicalPostgresRuntimeFilter(shared_ptr<PostgresRuntimeFilter> filter_p,
+                                                           idx_t key_index_p, unique_ptr<LogicalOperator> child)
+    : filter(std::move(filter_p)), key_index(key_index_p) {
+	if (child->has_estimated_cardinality) {
+		SetEstimatedCardinality(child->estimated_cardinality);
+	}
+	children.push_back(std::move(child));
+}
+
+unique_ptr<PhysicalOperator> LogicalPostgresRuntimeFilter::CreatePlan(ClientContext &context,
+                                                                      PhysicalPlanGenerator &generator) {
+	auto child = generator.CreatePlan(std::move(children[0]));
+	auto result = make_uniq<PhysicalPostgresRuntimeFilter>(types, filter, key_index, estimated_cardinality);
+	result->children.push_back(std::move(child));
+	return std::move(result);
+}
+
+vector<ColumnBinding> LogicalPostgresRuntimeFilter::GetColumnBindings() {
+	return children[0]->GetColumnBindings();
+}
+
+void LogicalPostgresRuntimeFilter::ResolveTypes() {
+	types = children[0]->types;
+}
+
+string LogicalPostgresRuntimeFilter::GetName() const {
+	return "PG_RUNTIME_FILTER";
+}
+
+string LogicalPostgresRuntimeFilter::GetExtensionName() const {
+	return "postgres_scanner";
+}
+
+//===--------------------------------------------------------------------===//
+// States
+//===--------------------------------------------------------------------===//
+class PostgresRuntimeFilterGlobalState : public GlobalSinkState {
+public:
+	PostgresRuntimeFilterGlobalState(ClientContext &context, const vector<LogicalType> &types)
+	    : collection(context, types) {
+	}
+
+	mutex lock;
+	ColumnDataCollection collection;
+};
+
+class PostgresRuntimeFilterLocalState : public LocalSinkState {
+public:
+	PostgresRuntimeFilterLocalState(ClientContext &context, const vector<LogicalType> &types)
+	    : collection(context, types) {
+	}
+
+	ColumnDataCollection collection;
+};
+
+class PostgresRuntimeFilterSourceState : public GlobalSourceState {
+public:
+	ColumnDataScanState scan_state;
+};
+
+PhysicalPostgresRuntimeFilter::PhysicalPostgresRuntimeFilter(vector<LogicalType> types,
+                                                             shared_ptr<PostgresRuntimeFilter> filter_p,
+                                                             idx_t key_index_p, idx_t estimated_cardinality)
+    : PhysicalOperator(PhysicalOperatorType::EXTENSION, std::move(types), estimated_cardinality),
+      filter(std::move(filter_p)), key_index(key_index_p) {
+}
+
+unique_ptr<GlobalSinkState> PhysicalPostgresRuntimeFilter::GetGlobalSinkState(ClientContext &context) const {
+	// a (prepared) plan can be executed multiple times - start from an empty set of keys every time
+	filter->Reset();
+	return make_uniq<PostgresRuntimeFilterGlobalState>(context, types);
+}
+
+unique_ptr<LocalSinkState> PhysicalPostgresRuntimeFilter::GetLocalSinkState(ExecutionContext &context) const {
+	return make_uniq<PostgresRuntimeFilterLocalState>(context.client, types);
+}
+
+//===--------------------------------------------------------------------===//
+// Sink
+//===--------------------------------------------------------------------===//
+SinkResultType PhysicalPostgresRuntimeFilter::Sink(ExecutionContext &context, DataChunk &chunk,
+                                                   OperatorSinkInput &input) const {
+	auto &lstate = input.local_state.Cast<PostgresRuntimeFilterLocalState>();
+	filter->AddKeys(chunk.data[key_index], chunk.size());
+	lstate.collection.Append(chunk);
+	return SinkResultType::NEED_MORE_INPUT;
+}
+
+//===--------------------------------------------------------------------===//
+// Combine
+//===--------------------------------------------------------------------===//
+SinkCombineResultType PhysicalPostgresRuntimeFilter::Combine(ExecutionContext &context,
+                                                             OperatorSinkCombineInput &input) const {
+	auto &gstate = input.global_state.Cast<PostgresRuntimeFilterGlobalState>();
+	auto &lstate = input.local_state.Cast<PostgresRuntimeFilterLocalState>();
+	lock_guard<mutex> guard(gstate.lock);
+	gstate.collection.Combine(lstate.collection);
+	return SinkCombineResultType::FINISHED;
+}
+
+//===--------------------------------------------------------------------===//
+// Finalize
+//===--------------------------------------------------------------------===//
+SinkFinalizeType PhysicalPostgresRuntimeFilter::Finalize(Pipeline &pipeline, Event &event, ClientContext &context,
+                                                         OperatorSinkFinalizeInput &input) const {
+	// the probe side of the join only starts scanning after the build side has finished
+	// from here on the keys are added to the queries of the Postgres scan
+	filter->Finish();
+	return SinkFinalizeType::READY;
+}
+
+//===--------------------------------------------------------------------===//
+// GetData
+//===--------------------------------------------------------------------===//
+unique_ptr<GlobalSourceState> PhysicalPostgresRuntimeFilter::GetGlobalSourceState(ClientContext &context) const {
+	auto &gstate = sink_state->Cast<PostgresRuntimeFilterGlobalState>();
+	auto result = make_uniq<PostgresRuntimeFilterSourceState>();
+	gstate.collection.InitializeScan(result->scan_state);
+	return std::move(result);
+}
+
+SourceResultType PhysicalPostgresRuntimeFilter::GetData(ExecutionContext &context, DataChunk &chunk,
+                                                        OperatorSourceInput &input) const {
+	auto &gstate = sink_state->Cast<PostgresRuntimeFilterGlobalState>();
+	auto &source_state = input.global_state.Cast<PostgresRuntimeFilterSourceState>();
+	gstate.collection.Scan(source_state.scan_state, chunk);
+	return chunk.size() == 0 ? SourceResultType::FINISHED : SourceResultType::HAVE_MORE_OUTPUT;
+}
+
+//===--------------------------------------------------------------------===//
+// Helpers
+//===--------------------------------------------------------------------===//
+string PhysicalPostgresRuntimeFilter::GetName() const {
+	return "PG_RUNTIME_FILTER";
+}
+
+string PhysicalPostgresRuntimeFilter::ParamsToString() const {
+	return "#" + to_string(key_index);
+}
+
+} // namespace duckdb
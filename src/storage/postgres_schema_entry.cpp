@@ -20,8 +20,9 @@ PostgresSchemaEntry::PostgresSchemaEntry(Catalog &catalog, CreateSchemaInfo &inf
 PostgresSchemaEntry::PostgresSchemaEntry(Catalog &catalog, CreateSchemaInfo &info,
                                          unique_ptr<PostgresResultSlice> tables, unique_ptr<PostgresResultSlice> enums,
                                          unique_ptr<PostgresResultSlice> composite_types,
-                                         unique_ptr<PostgresResultSlice> indexes)
-    : SchemaCatalogEntry(catalog, info), tables(*this, std::move(tables)), indexes(*this, std::move(indexes)),
+                                         unique_ptr<PostgresResultSlice> indexes, bool lazy_tables)
+    : SchemaCatalogEntry(catalog, info), tables(*this, std::move(tables), lazy_tables),
+      indexes(*this, std::move(indexes)),
       types(*this, std::move(enums), std::move(composite_types)) {
 }
 
@@ -32,6 +33,14 @@ bool PostgresSchemaEntry::SchemaIsInternal(const string &name) {
 	return false;
 }
 
+void PostgresSchemaEntry::InvalidateTable(const string &table_name) {
+	tables.ClearEntry(table_name);
+}
+
+void PostgresSchemaEntry::LoadTables(ClientContext &context) {
+	tables.TryLoadEntries(context);
+}
+
 PostgresTransaction &GetPostgresTransaction(CatalogTransaction transaction) {
 	if (!transaction.transaction) {
 		throw InternalException("No transaction!?");
@@ -6,6 +6,10 @@
 #include "duckdb/parser/parsed_data/create_schema_info.hpp"
 #include "storage/postgres_table_set.hpp"
 #include "storage/postgres_catalog.hpp"
+#include "storage/postgres_catalog_cache.hpp"
+#include "duckdb/common/error_data.hpp"
+
+#include <thread>
 
 namespace duckdb {
 
@@ -40,36 +44,173 @@ ORDER BY oid;
 )";
 }
 
+//! Run the tasks over (at most) thread_count threads - the calling thread is thread 0
+//! The first error of any of the threads is thrown once all threads have finished
+static void RunInParallel(idx_t task_count, idx_t thread_count, const std::function<void(idx_t, idx_t)> &run_task) {
+	atomic<idx_t> next_task {0};
+	mutex error_lock;
+	ErrorData error;
+	auto run_tasks = [&](idx_t thread_idx) {
+		try {
+			for (idx_t task_idx = next_task++; task_idx < task_count; task_idx = next_task++) {
+				run_task(thread_idx, task_idx);
+			}
+		} catch (std::exception &ex) {
+			lock_guard<mutex> guard(error_lock);
+			if (!error.HasError()) {
+				error = ErrorData(ex);
+			}
+			next_task = task_count;
+		}
+	};
+	vector<std::thread> threads;
+	for (idx_t thread_idx = 1; thread_idx < MinValue<idx_t>(thread_count, task_count); thread_idx++) {
+		threads.emplace_back(run_tasks, thread_idx);
+	}
+	run_tasks(0);
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	if (error.HasError()) {
+		error.Throw();
+	}
+}
+
+//! Run the catalog queries concurrently - over the connection of the transaction and over pooled connections that
+//! are attached to the (exported) snapshot of the transaction, so that all queries see the same catalog
+static vector<unique_ptr<PostgresResult>> QueryInParallel(PostgresTransaction &transaction, PostgresCatalog &pg_catalog,
+                                                          const string &snapshot, const vector<string> &queries,
+                                                          idx_t thread_count) {
+	// use as many connections as the pool can spare without waiting
+	vector<PostgresPoolConnection> connections;
+	while (connections.size() + 1 < MinValue<idx_t>(thread_count, queries.size())) {
+		PostgresPoolConnection connection;
+		if (!transaction.TryGetScanConnection(connection)) {
+			if (!pg_catalog.GetConnectionPool().TryGetConnection(connection)) {
+				break;
+			}
+			connection.GetConnection().ExecuteQueries(
+			    StringUtil::Format("BEGIN TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY;\n"
+			                       "SET TRANSACTION SNAPSHOT '%s'",
+			                       snapshot));
+		}
+		connections.push_back(std::move(connection));
+	}
+	auto &main_connection = transaction.GetConnection();
+	vector<unique_ptr<PostgresResult>> results(queries.size());
+	RunInParallel(queries.size(), connections.size() + 1, [&](idx_t thread_idx, idx_t query_idx) {
+		auto &connection = thread_idx == 0 ? main_connection : connections[thread_idx - 1].GetConnection();
+		results[query_idx] = connection.Query(queries[query_idx]);
+	});
+	// the connections remain attached to the snapshot - later scans of the transaction can use them
+	for (auto &connection : connections) {
+		transaction.ReturnScanConnection(std::move(connection));
+	}
+	return results;
+}
+
 void PostgresSchemaSet::LoadEntries(ClientContext &context) {
 	auto &pg_catalog = catalog.Cast<PostgresCatalog>();
 	auto pg_version = pg_catalog.GetPostgresVersion();
 	string schema_query = PostgresSchemaSet::GetInitializeQuery();
-	string tables_query = PostgresTableSet::GetInitializeQuery();
+	// in lazy mode only the names of the tables are loaded up-front
+	bool lazy_tables = false;
+	Value lazy_catalog_loading;
+	if (context.TryGetCurrentSetting("pg_lazy_catalog_loading", lazy_catalog_loading)) {
+		lazy_tables = BooleanValue::Get(lazy_catalog_loading);
+	}
+	string tables_query =
+	    lazy_tables ? PostgresTableSet::GetTableNamesQuery() : PostgresTableSet::GetInitializeQuery();
 	string enum_types_query = PostgresTypeSet::GetInitializeEnumsQuery(pg_version);
 	string composite_types_query = PostgresTypeSet::GetInitializeCompositesQuery();
 	string index_query = PostgresIndexSet::GetInitializeQuery();
 
 	auto full_query = schema_query + tables_query + enum_types_query + composite_types_query + index_query;
 
+	idx_t thread_count = 1;
+	Value load_threads;
+	if (context.TryGetCurrentSetting("pg_catalog_load_threads", load_threads) && !load_threads.IsNull()) {
+		thread_count = MaxValue<idx_t>(UBigIntValue::Get(load_threads), 1);
+	}
+
 	auto &transaction = PostgresTransaction::Get(context, catalog);
-	auto results = transaction.ExecuteQueries(full_query);
+	vector<unique_ptr<PostgresResult>> results;
+	// the tables of a schema are in table partition (schema oid % table_partitions)
+	idx_t table_partitions = 1;
+	bool from_cache = false;
+	auto cache_path = PostgresCatalogCache::GetCachePath(context, pg_catalog.path, full_query);
+	// the pooled connections only see the snapshot of the transaction - not the changes made by the transaction
+	string snapshot;
+	if (cache_path.empty() && thread_count > 1 && transaction.IsReadOnly() &&
+	    pg_version.type_v != PostgresInstanceType::AURORA) {
+		snapshot = transaction.GetScanSnapshot(pg_version);
+	}
+	if (!snapshot.empty()) {
+		vector<string> queries {schema_query, enum_types_query, composite_types_query, index_query};
+		if (lazy_tables) {
+			queries.push_back(tables_query);
+		} else {
+			// the columns of the tables make up most of the catalog - split them over the threads by schema
+			table_partitions = thread_count;
+			for (idx_t partition = 0; partition < table_partitions; partition++) {
+				queries.push_back(PostgresTableSet::GetPartitionQuery(partition, table_partitions));
+			}
+		}
+		results = QueryInParallel(transaction, pg_catalog, snapshot, queries, thread_count);
+		// restore the order of the sequential queries: schemas, tables, enums, composite types, indexes
+		std::rotate(results.begin() + 1, results.begin() + 4, results.end());
+	} else if (cache_path.empty()) {
+		results = transaction.ExecuteQueries(full_query);
+	} else {
+		// the fingerprint is computed in the same transaction (and snapshot) as the catalog queries
+		auto &fs = FileSystem::GetFileSystem(context);
+		string fingerprint;
+		if (fs.FileExists(cache_path)) {
+			fingerprint = transaction.Query(PostgresCatalogCache::GetFingerprintQuery())->GetString(0, 0);
+			results = PostgresCatalogCache::Read(fs, cache_path, fingerprint);
+			from_cache = !results.empty();
+			if (results.empty()) {
+				results = transaction.ExecuteQueries(full_query);
+				PostgresCatalogCache::Write(fs, cache_path, fingerprint, results);
+			}
+		} else {
+			results = transaction.ExecuteQueries(PostgresCatalogCache::GetFingerprintQuery() + full_query);
+			fingerprint = results[0]->GetString(0, 0);
+			results.erase(results.begin());
+			PostgresCatalogCache::Write(fs, cache_path, fingerprint, results);
+		}
+	}
 	auto result = std::move(results[0]);
 	results.erase(results.begin());
 	auto rows = result->Count();
 
-	auto tables = SliceResult(*result, std::move(results[0]));
-	auto enums = SliceResult(*result, std::move(results[1]));
-	auto composite_types = SliceResult(*result, std::move(results[2]));
-	auto indexes = SliceResult(*result, std::move(results[3]));
+	vector<vector<unique_ptr<PostgresResultSlice>>> tables;
+	for (idx_t partition = 0; partition < table_partitions; partition++) {
+		tables.push_back(SliceResult(*result, std::move(results[partition])));
+		for (auto &slice : tables.back()) {
+			slice->from_cache = from_cache;
+		}
+	}
+	auto enums = SliceResult(*result, std::move(results[table_partitions]));
+	auto composite_types = SliceResult(*result, std::move(results[table_partitions + 1]));
+	auto indexes = SliceResult(*result, std::move(results[table_partitions + 2]));
+	vector<reference<PostgresSchemaEntry>> schemas;
 	for (idx_t row = 0; row < rows; row++) {
 		auto oid = result->GetInt64(row, 0);
 		auto schema_name = result->GetString(row, 1);
 		CreateSchemaInfo info;
 		info.schema = schema_name;
 		info.internal = PostgresSchemaEntry::SchemaIsInternal(schema_name);
-		auto schema = make_uniq<PostgresSchemaEntry>(catalog, info, std::move(tables[row]), std::move(enums[row]),
-		                                             std::move(composite_types[row]), std::move(indexes[row]));
-		CreateEntry(std::move(schema));
+		auto &schema_tables = tables[idx_t(oid) % table_partitions][row];
+		auto schema = make_uniq<PostgresSchemaEntry>(catalog, info, std::move(schema_tables), std::move(enums[row]),
+		                                             std::move(composite_types[row]), std::move(indexes[row]),
+		                                             lazy_tables);
+		schemas.push_back(CreateEntry(std::move(schema))->Cast<PostgresSchemaEntry>());
+	}
+	if (thread_count > 1 && !lazy_tables) {
+		// build the table entries of the schemas concurrently - the rows have already been received
+		RunInParallel(schemas.size(), thread_count,
+		              [&](idx_t thread_idx, idx_t schema_idx) { schemas[schema_idx].get().LoadTables(context); });
 	}
 }
 
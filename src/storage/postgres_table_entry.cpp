@@ -1,9 +1,12 @@
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_table_entry.hpp"
 #include "storage/postgres_transaction.hpp"
+#include "storage/postgres_schema_entry.hpp"
+#include "storage/postgres_table_set.hpp"
 #include "duckdb/storage/statistics/base_statistics.hpp"
 #include "duckdb/storage/table_storage_info.hpp"
 #include "postgres_scanner.hpp"
+#include "postgres_extension_state.hpp"
 
 namespace duckdb {
 
@@ -18,17 +21,30 @@ PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &sch
 		postgres_names.push_back(col.GetName());
 	}
 	approx_num_pages = 0;
+	relation_pages = 0;
+	approx_num_rows = -1;
+	relation_kind = 'r';
+	refresh_statistics = false;
 }
 
 PostgresTableEntry::PostgresTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, PostgresTableInfo &info)
     : TableCatalogEntry(catalog, schema, *info.create_info), postgres_types(std::move(info.postgres_types)),
-      postgres_names(std::move(info.postgres_names)) {
+      postgres_names(std::move(info.postgres_names)), column_statistics(std::move(info.column_statistics)) {
 	D_ASSERT(postgres_types.size() == columns.LogicalColumnCount());
 	approx_num_pages = info.approx_num_pages;
+	relation_pages = info.relation_pages;
+	approx_num_rows = info.approx_num_rows;
+	relation_kind = info.relation_kind;
+	refresh_statistics = info.refresh_statistics;
 }
 
 unique_ptr<BaseStatistics> PostgresTableEntry::GetStatistics(ClientContext &context, column_t column_id) {
-	return nullptr;
+	RefreshStatistics(context);
+	if (column_id >= column_statistics.size()) {
+		return nullptr;
+	}
+	auto &type = columns.GetColumn(LogicalIndex(column_id)).GetType();
+	return PostgresScanFunction::GetColumnStatistics(type, column_statistics[column_id], approx_num_rows);
 }
 
 void PostgresTableEntry::BindUpdateConstraints(LogicalGet &, LogicalProjection &, LogicalUpdate &, ClientContext &) {
@@ -38,7 +54,13 @@ TableFunction PostgresTableEntry::GetScanFunction(ClientContext &context, unique
 	auto &pg_catalog = catalog.Cast<PostgresCatalog>();
 	auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
 
+	RefreshStatistics(context);
 	auto result = make_uniq<PostgresBindData>();
+	// remember the table so that only its entry is reloaded if binding the query fails because of a missing column
+	auto extension_state = PostgresExtensionState::Get(context);
+	if (extension_state) {
+		extension_state->AddBoundTable(catalog.GetName(), schema.name, name);
+	}
 
 	result->schema_name = schema.name;
 	result->table_name = name;
@@ -50,7 +72,11 @@ TableFunction PostgresTableEntry::GetScanFunction(ClientContext &context, unique
 	result->names = postgres_names;
 	result->postgres_types = postgres_types;
 	result->read_only = transaction.IsReadOnly();
-	PostgresScanFunction::PrepareBind(pg_catalog.GetPostgresVersion(), context, *result, approx_num_pages);
+	result->relation_kind = relation_kind;
+	result->column_statistics = column_statistics;
+	result->SetApproxNumRows(approx_num_rows, approx_num_pages);
+	PostgresScanFunction::PrepareBind(pg_catalog.GetPostgresVersion(), context, *result, relation_pages,
+	                                  transaction.GetConnection());
 
 	bind_data = std::move(result);
 	auto function = PostgresScanFunction();
@@ -61,30 +87,78 @@ TableFunction PostgresTableEntry::GetScanFunction(ClientContext &context, unique
 	return function;
 }
 
+void PostgresTableEntry::RefreshStatistics(ClientContext &context) {
+	if (!refresh_statistics) {
+		return;
+	}
+	lock_guard<mutex> guard(refresh_lock);
+	if (!refresh_statistics) {
+		return;
+	}
+	auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
+	auto info = PostgresTableSet::GetTableInfo(transaction, schema.Cast<PostgresSchemaEntry>(), name);
+	if (info) {
+		approx_num_pages = info->approx_num_pages;
+		relation_pages = info->relation_pages;
+		approx_num_rows = info->approx_num_rows;
+		if (info->postgres_names == postgres_names) {
+			column_statistics = std::move(info->column_statistics);
+		}
+	}
+	refresh_statistics = false;
+}
+
+void PostgresTableEntry::InvalidateCachedResults() {
+	auto &pg_catalog = catalog.Cast<PostgresCatalog>();
+	pg_catalog.GetResultCache().Invalidate(PostgresResultCache::GetTableKey(schema.name, name));
+}
+
 TableStorageInfo PostgresTableEntry::GetStorageInfo(ClientContext &context) {
 	auto &transaction = Transaction::Get(context, catalog).Cast<PostgresTransaction>();
 	auto &db = transaction.GetConnection();
 	TableStorageInfo result;
 	result.cardinality = 0;
-	result.index_info = db.GetIndexInfo(name);
+	result.index_info = db.GetIndexInfo(schema.name, name, postgres_names);
 	return result;
 }
 
+//! Whether or not we know which oid to write for an array element or composite field of the given type
+static bool HasElementOid(const LogicalType &type, const PostgresType &pg_type) {
+	switch (type.id()) {
+	case LogicalTypeId::DECIMAL:
+	case LogicalTypeId::ENUM:
+	case LogicalTypeId::LIST:
+	case LogicalTypeId::STRUCT:
+		// there is no fixed oid for these types - we can only write them if we know the type of the Postgres column
+		return pg_type.oid != 0;
+	default:
+		return PostgresUtils::SupportedPostgresOid(type);
+	}
+}
+
 static bool CopyRequiresText(const LogicalType &type, const PostgresType &pg_type) {
-	if (pg_type.info != PostgresTypeAnnotation::STANDARD) {
+	switch (pg_type.info) {
+	case PostgresTypeAnnotation::STANDARD:
+		break;
+	case PostgresTypeAnnotation::JSONB:
+	case PostgresTypeAnnotation::MACADDR:
+	case PostgresTypeAnnotation::MACADDR8:
+	case PostgresTypeAnnotation::INET:
+		// the binary writer can write these types when it knows the Postgres types of the columns
+		return type.id() != LogicalTypeId::VARCHAR;
+	case PostgresTypeAnnotation::PGVECTOR:
+		return false;
+	default:
 		return true;
 	}
 	switch (type.id()) {
 	case LogicalTypeId::LIST: {
-		D_ASSERT(pg_type.children.size() == 1);
+		if (pg_type.children.size() != 1) {
+			return true;
+		}
 		auto &child_type = ListType::GetChildType(type);
-		if (child_type.id() != LogicalTypeId::LIST) {
-			if (!PostgresUtils::SupportedPostgresOid(child_type)) {
-				return true;
-			}
-			if (pg_type.children[0].oid != PostgresUtils::ToPostgresOid(child_type)) {
-				return true;
-			}
+		if (child_type.id() != LogicalTypeId::LIST && !HasElementOid(child_type, pg_type.children[0])) {
+			return true;
 		}
 		if (CopyRequiresText(child_type, pg_type.children[0])) {
 			return true;
@@ -93,9 +167,11 @@ static bool CopyRequiresText(const LogicalType &type, const PostgresType &pg_typ
 	}
 	case LogicalTypeId::STRUCT: {
 		auto &children = StructType::GetChildTypes(type);
-		D_ASSERT(children.size() == pg_type.children.size());
+		if (children.size() != pg_type.children.size()) {
+			return true;
+		}
 		for (idx_t c = 0; c < pg_type.children.size(); c++) {
-			if (!PostgresUtils::SupportedPostgresOid(children[c].second)) {
+			if (!HasElementOid(children[c].second, pg_type.children[c])) {
 				return true;
 			}
 			if (CopyRequiresText(children[c].second, pg_type.children[c])) {
@@ -110,6 +186,15 @@ static bool CopyRequiresText(const LogicalType &type, const PostgresType &pg_typ
 }
 
 PostgresCopyFormat PostgresTableEntry::GetCopyFormat(ClientContext &context) {
+	vector<PhysicalIndex> column_indexes;
+	for (idx_t c = 0; c < postgres_types.size(); c++) {
+		column_indexes.emplace_back(c);
+	}
+	return GetCopyFormat(context, column_indexes);
+}
+
+PostgresCopyFormat PostgresTableEntry::GetCopyFormat(ClientContext &context,
+                                                     const vector<PhysicalIndex> &column_indexes) {
 	Value use_binary_copy;
 	if (context.TryGetCurrentSetting("pg_use_binary_copy", use_binary_copy)) {
 		if (!BooleanValue::Get(use_binary_copy)) {
@@ -117,7 +202,8 @@ PostgresCopyFormat PostgresTableEntry::GetCopyFormat(ClientContext &context) {
 		}
 	}
 	D_ASSERT(postgres_types.size() == columns.LogicalColumnCount());
-	for (idx_t c = 0; c < postgres_types.size(); c++) {
+	for (auto &index : column_indexes) {
+		auto c = index.index;
 		if (CopyRequiresText(columns.GetColumn(LogicalIndex(c)).GetType(), postgres_types[c])) {
 			return PostgresCopyFormat::TEXT;
 		}
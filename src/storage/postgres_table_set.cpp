@@ -15,32 +15,69 @@
 
 namespace duckdb {
 
-PostgresTableSet::PostgresTableSet(PostgresSchemaEntry &schema, unique_ptr<PostgresResultSlice> table_result_p)
-    : PostgresInSchemaSet(schema, !table_result_p), table_result(std::move(table_result_p)) {
+PostgresTableSet::PostgresTableSet(PostgresSchemaEntry &schema, unique_ptr<PostgresResultSlice> table_result_p,
+                                   bool lazy)
+    : PostgresInSchemaSet(schema, !table_result_p && !lazy), table_result(std::move(table_result_p)), lazy(lazy) {
 }
 
-string PostgresTableSet::GetInitializeQuery(const string &schema, const string &table) {
+string PostgresTableSet::GetTableNamesQuery(const string &schema) {
+	string base_query = R"(
+SELECT pg_namespace.oid AS namespace_id, relname
+FROM pg_class
+JOIN pg_namespace ON relnamespace = pg_namespace.oid
+WHERE relkind IN ('r', 'v', 'm', 'f', 'p') ${CONDITION}
+ORDER BY namespace_id, relname;
+)";
+	string condition;
+	if (!schema.empty()) {
+		condition += "AND pg_namespace.nspname=" + KeywordHelper::WriteQuoted(schema);
+	}
+	return StringUtil::Replace(base_query, "${CONDITION}", condition);
+}
+
+static string GetTableQuery(const string &condition) {
+	// the size of every relation is computed once in the CTE - which is not inlined as pg_relation_size is volatile
 	string base_query = R"(
-SELECT pg_namespace.oid AS namespace_id, relname, relpages, attname,
+WITH relation_sizes AS (
+    SELECT pg_class.oid AS relation_id,
+        pg_relation_size(pg_class.oid) / current_setting('block_size')::BIGINT AS relation_pages
+    FROM pg_class
+    JOIN pg_namespace ON relnamespace = pg_namespace.oid
+    WHERE relkind IN ('r', 'm') ${CONDITION}
+)
+SELECT pg_namespace.oid AS namespace_id, relname, relpages, pg_attribute.attname,
     pg_type.typname type_name, atttypmod type_modifier, pg_attribute.attndims ndim,
     attnum, pg_attribute.attnotnull AS notnull, NULL constraint_id,
-    NULL constraint_type, NULL constraint_key
+    NULL constraint_type, NULL constraint_key, relkind,
+    reltuples, null_frac, n_distinct, avg_width, relation_sizes.relation_pages,
+    attcollation IN (950, 951) OR (attcollation = 100 AND (
+        SELECT datcollate IN ('C', 'POSIX') AND COALESCE(to_jsonb(pg_database)->>'datlocprovider', 'c') = 'c'
+        FROM pg_database WHERE datname = current_database())) AS byte_order_collation
 FROM pg_class
 JOIN pg_namespace ON relnamespace = pg_namespace.oid
 JOIN pg_attribute ON pg_class.oid=pg_attribute.attrelid
+LEFT JOIN relation_sizes ON relation_sizes.relation_id = pg_class.oid
 JOIN pg_type ON atttypid=pg_type.oid
+LEFT JOIN pg_stats ON pg_stats.schemaname = pg_namespace.nspname AND pg_stats.tablename = relname
+    AND pg_stats.attname = pg_attribute.attname AND pg_stats.inherited = (relkind = 'p')
 WHERE attnum > 0 AND relkind IN ('r', 'v', 'm', 'f', 'p') ${CONDITION}
 UNION ALL
 SELECT pg_namespace.oid AS namespace_id, relname, NULL relpages, NULL attname, NULL type_name,
     NULL type_modifier, NULL ndim, NULL attnum, NULL AS notnull,
     pg_constraint.oid AS constraint_id, contype AS constraint_type,
-    conkey AS constraint_key
+    conkey AS constraint_key, relkind,
+    NULL reltuples, NULL null_frac, NULL n_distinct, NULL avg_width, NULL relation_pages,
+    NULL byte_order_collation
 FROM pg_class
 JOIN pg_namespace ON relnamespace = pg_namespace.oid
 JOIN pg_constraint ON (pg_class.oid=pg_constraint.conrelid)
 WHERE relkind IN ('r', 'v', 'm', 'f', 'p') AND contype IN ('p', 'u') ${CONDITION}
 ORDER BY namespace_id, relname, attnum, constraint_id;
 )";
+	return StringUtil::Replace(base_query, "${CONDITION}", condition);
+}
+
+string PostgresTableSet::GetInitializeQuery(const string &schema, const string &table) {
 	string condition;
 	if (!schema.empty()) {
 		condition += "AND pg_namespace.nspname=" + KeywordHelper::WriteQuoted(schema);
@@ -48,7 +85,16 @@ ORDER BY namespace_id, relname, attnum, constraint_id;
 	if (!table.empty()) {
 		condition += "AND relname=" + KeywordHelper::WriteQuoted(table);
 	}
-	return StringUtil::Replace(base_query, "${CONDITION}", condition);
+	return GetTableQuery(condition);
+}
+
+string PostgresTableSet::GetPartitionQuery(idx_t partition, idx_t partition_count) {
+	return GetTableQuery(StringUtil::Format("AND pg_namespace.oid::BIGINT %% %llu = %llu", partition_count, partition));
+}
+
+string PostgresTableSet::GetTableInfoQuery() {
+	// the schema and table name are passed as parameters - so the statement can be prepared once and reused
+	return GetTableQuery("AND pg_namespace.nspname=$1::name AND relname=$2::name");
 }
 
 void PostgresTableSet::AddColumn(optional_ptr<PostgresTransaction> transaction,
@@ -63,8 +109,21 @@ void PostgresTableSet::AddColumn(optional_ptr<PostgresTransaction> transaction,
 	bool is_not_null = result.GetBool(row, column_index + 5);
 	string default_value;
 
+	PostgresColumnStatistics statistics;
+	if (!result.IsNull(row, 14)) {
+		statistics.has_statistics = true;
+		statistics.null_fraction = result.GetDouble(row, 14);
+		statistics.distinct_count = result.GetDouble(row, 15);
+		statistics.average_width = idx_t(MaxValue<int64_t>(result.GetInt64(row, 16), 0));
+	}
+	table_info.column_statistics.push_back(statistics);
+
 	PostgresType postgres_type;
 	auto column_type = PostgresUtils::TypeToLogicalType(transaction, schema, type_info, postgres_type);
+	if (!result.IsNull(row, 18)) {
+		// the C collation (oid 950), the POSIX collation (oid 951) or the default collation of a C database
+		postgres_type.byte_order_collation = result.GetBool(row, 18);
+	}
 	table_info.postgres_types.push_back(std::move(postgres_type));
 	table_info.postgres_names.push_back(column_name);
 	ColumnDefinition column(std::move(column_name), std::move(column_type));
@@ -107,6 +166,21 @@ void PostgresTableSet::AddConstraint(PostgresResult &result, idx_t row, Postgres
 	create_info.constraints.push_back(make_uniq<UniqueConstraint>(std::move(columns), constraint_type == "p"));
 }
 
+double PostgresTableSet::GetApproxNumRows(PostgresResult &result, idx_t row) {
+	// reltuples is -1 (or 0 before Postgres 14) if the table has never been vacuumed or analyzed
+	return result.IsNull(row, 13) ? -1 : result.GetDouble(row, 13);
+}
+
+idx_t PostgresTableSet::GetRelationPages(PostgresResult &result, idx_t row, idx_t approx_num_pages) {
+	// relpages is only updated by VACUUM and ANALYZE - use the actual size of the relation where it is known
+	return result.IsNull(row, 17) ? approx_num_pages : idx_t(result.GetInt64(row, 17));
+}
+
+char PostgresTableSet::GetRelationKind(PostgresResult &result, idx_t row) {
+	auto relation_kind = result.GetString(row, 12);
+	return relation_kind.empty() ? 'r' : relation_kind[0];
+}
+
 void PostgresTableSet::AddColumnOrConstraint(optional_ptr<PostgresTransaction> transaction,
                                              optional_ptr<PostgresSchemaEntry> schema, PostgresResult &result,
                                              idx_t row, PostgresTableInfo &table_info) {
@@ -118,7 +192,8 @@ void PostgresTableSet::AddColumnOrConstraint(optional_ptr<PostgresTransaction> t
 	}
 }
 
-void PostgresTableSet::CreateEntries(PostgresTransaction &transaction, PostgresResult &result, idx_t start, idx_t end) {
+void PostgresTableSet::CreateEntries(PostgresTransaction &transaction, PostgresResult &result, idx_t start, idx_t end,
+                                     bool from_cache) {
 	vector<unique_ptr<PostgresTableInfo>> tables;
 	unique_ptr<PostgresTableInfo> info;
 
@@ -131,6 +206,10 @@ void PostgresTableSet::CreateEntries(PostgresTransaction &transaction, PostgresR
 			auto approx_num_pages = result.IsNull(row, 2) ? 0 : result.GetInt64(row, 2);
 			info = make_uniq<PostgresTableInfo>(schema, table_name);
 			info->approx_num_pages = approx_num_pages;
+			info->relation_pages = GetRelationPages(result, row, approx_num_pages);
+			info->relation_kind = GetRelationKind(result, row);
+			info->approx_num_rows = GetApproxNumRows(result, row);
+			info->refresh_statistics = from_cache;
 		}
 		AddColumnOrConstraint(&transaction, &schema, result, row, *info);
 	}
@@ -145,8 +224,36 @@ void PostgresTableSet::CreateEntries(PostgresTransaction &transaction, PostgresR
 
 void PostgresTableSet::LoadEntries(ClientContext &context) {
 	auto &transaction = PostgresTransaction::Get(context, catalog);
+	if (lazy) {
+		// only load the names of the tables - the tables themselves are loaded in ReloadEntry
+		unique_ptr<PostgresResult> query_result;
+		optional_ptr<PostgresResult> names;
+		idx_t start, end;
+		if (table_result) {
+			names = &table_result->GetResult();
+			start = table_result->start;
+			end = table_result->end;
+		} else {
+			query_result = transaction.Query(GetTableNamesQuery(schema.name));
+			names = query_result.get();
+			start = 0;
+			end = query_result->Count();
+		}
+		lock_guard<mutex> guard(lazy_lock);
+		table_names.clear();
+		table_name_map.clear();
+		for (idx_t row = start; row < end; row++) {
+			auto table_name = names->GetString(row, 1);
+			table_name_map.insert(make_pair(table_name, table_name));
+			table_names.insert(std::move(table_name));
+		}
+		all_loaded = false;
+		table_result.reset();
+		return;
+	}
 	if (table_result) {
-		CreateEntries(transaction, table_result->GetResult(), table_result->start, table_result->end);
+		CreateEntries(transaction, table_result->GetResult(), table_result->start, table_result->end,
+		              table_result->from_cache);
 		table_result.reset();
 	} else {
 		auto query = GetInitializeQuery(schema.name);
@@ -160,8 +267,7 @@ void PostgresTableSet::LoadEntries(ClientContext &context) {
 
 unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresTransaction &transaction,
                                                              PostgresSchemaEntry &schema, const string &table_name) {
-	auto query = PostgresTableSet::GetInitializeQuery(schema.name, table_name);
-	auto result = transaction.Query(query);
+	auto result = transaction.QueryWithParameters(GetTableInfoQuery(), {Value(schema.name), Value(table_name)});
 	auto rows = result->Count();
 	if (rows == 0) {
 		return nullptr;
@@ -170,14 +276,16 @@ unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresTransaction
 	for (idx_t row = 0; row < rows; row++) {
 		AddColumnOrConstraint(&transaction, &schema, *result, row, *table_info);
 	}
-	table_info->approx_num_pages = result->GetInt64(0, 2);
+	table_info->approx_num_pages = result->IsNull(0, 2) ? 0 : result->GetInt64(0, 2);
+	table_info->relation_pages = GetRelationPages(*result, 0, table_info->approx_num_pages);
+	table_info->relation_kind = GetRelationKind(*result, 0);
+	table_info->approx_num_rows = GetApproxNumRows(*result, 0);
 	return table_info;
 }
 
 unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresConnection &connection, const string &schema_name,
                                                              const string &table_name) {
-	auto query = PostgresTableSet::GetInitializeQuery(schema_name, table_name);
-	auto result = connection.Query(query);
+	auto result = connection.QueryWithParameters(GetTableInfoQuery(), {Value(schema_name), Value(table_name)});
 	auto rows = result->Count();
 	if (rows == 0) {
 		throw InvalidInputException("Table %s does not contain any columns.", table_name);
@@ -186,12 +294,154 @@ unique_ptr<PostgresTableInfo> PostgresTableSet::GetTableInfo(PostgresConnection
 	for (idx_t row = 0; row < rows; row++) {
 		AddColumnOrConstraint(nullptr, nullptr, *result, row, *table_info);
 	}
-	table_info->approx_num_pages = result->GetInt64(0, 2);
+	table_info->approx_num_pages = result->IsNull(0, 2) ? 0 : result->GetInt64(0, 2);
+	table_info->relation_pages = GetRelationPages(*result, 0, table_info->approx_num_pages);
+	table_info->relation_kind = GetRelationKind(*result, 0);
+	table_info->approx_num_rows = GetApproxNumRows(*result, 0);
 	return table_info;
 }
 
-optional_ptr<CatalogEntry> PostgresTableSet::ReloadEntry(ClientContext &context, const string &table_name) {
+vector<PostgresLeafPartition> PostgresTableSet::GetLeafPartitions(PostgresConnection &connection,
+                                                                const string &schema_name,
+                                                                const string &table_name) {
+	auto relation_name =
+	    KeywordHelper::WriteQuoted(schema_name, '"') + "." + KeywordHelper::WriteQuoted(table_name, '"');
+	auto query = StringUtil::Replace(R"(
+WITH RECURSIVE partitions(oid) AS (
+    SELECT inhrelid FROM pg_inherits WHERE inhparent = ${RELATION}::regclass
+    UNION ALL
+    SELECT inhrelid FROM pg_inherits JOIN partitions ON inhparent = partitions.oid
+)
+SELECT nspname, relname,
+    CASE WHEN relkind IN ('r', 'm') THEN pg_relation_size(pg_class.oid) / current_setting('block_size')::BIGINT ELSE 0 END
+FROM partitions
+JOIN pg_class ON pg_class.oid = partitions.oid
+JOIN pg_namespace ON relnamespace = pg_namespace.oid
+WHERE relkind <> 'p'
+ORDER BY 3 DESC, 1, 2;
+)",
+	                                 "${RELATION}", KeywordHelper::WriteQuoted(relation_name, '\''));
+	vector<PostgresLeafPartition> result;
+	auto query_result = connection.TryQuery(query);
+	if (!query_result) {
+		return result;
+	}
+	for (idx_t row = 0; row < query_result->Count(); row++) {
+		PostgresLeafPartition partition;
+		partition.schema_name = query_result->GetString(row, 0);
+		partition.table_name = query_result->GetString(row, 1);
+		partition.pages_approx = idx_t(query_result->GetInt64(row, 2));
+		result.push_back(std::move(partition));
+	}
+	return result;
+}
+
+vector<PostgresLeafPartition> PostgresTableSet::GetDistributedShards(PostgresConnection &connection,
+                                                                   const string &schema_name,
+                                                                   const string &table_name, const string &dsn,
+                                                                   vector<string> &worker_nodes) {
+	vector<PostgresLeafPartition> result;
+	auto citus = connection.TryQuery("SELECT EXISTS (SELECT 1 FROM pg_extension WHERE extname = 'citus')");
+	if (!citus || citus->Count() != 1 || !citus->GetBool(0, 0)) {
+		return result;
+	}
+	auto relation_name =
+	    KeywordHelper::WriteQuoted(schema_name, '"') + "." + KeywordHelper::WriteQuoted(table_name, '"');
+	// the name and the size of every placement of every shard - as reported by the node that stores the placement
+	// reference tables are replicated to every node, they are read through the coordinator
+	auto query = StringUtil::Replace(R"(
+SELECT p.shardid, p.nodename, p.nodeport, p.result,
+    (SELECT count(*) FROM pg_dist_shard s WHERE s.logicalrelid = d.logicalrelid)
+FROM pg_dist_partition d,
+LATERAL run_command_on_placements(d.logicalrelid,
+    'SELECT relname || '' '' || pg_relation_size(oid) / current_setting(''block_size'')::BIGINT
+     FROM pg_class WHERE oid = ''%s''::regclass') p
+WHERE d.logicalrelid = ${RELATION}::regclass AND d.repmodel <> 't' AND p.success
+ORDER BY p.shardid, p.nodename, p.nodeport;
+)",
+	                                 "${RELATION}", KeywordHelper::WriteQuoted(relation_name, '\''));
+	auto query_result = connection.TryQuery(query);
+	if (!query_result || query_result->Count() == 0) {
+		return result;
+	}
+	vector<string> nodes;
+	unordered_map<string, idx_t> node_indexes;
+	for (idx_t row = 0; row < query_result->Count();) {
+		// a shard that is replicated is read from one of its placements - spread over the nodes by the shard id
+		auto shard_id = query_result->GetInt64(row, 0);
+		idx_t placement_count = 0;
+		while (row + placement_count < query_result->Count() &&
+		       query_result->GetInt64(row + placement_count, 0) == shard_id) {
+			placement_count++;
+		}
+		auto placement = row + idx_t(shard_id) % placement_count;
+		row += placement_count;
+
+		auto node_name = query_result->GetString(placement, 1);
+		auto node_port = int32_t(query_result->GetInt64(placement, 2));
+		auto node_key = node_name + ":" + to_string(node_port);
+		auto entry = node_indexes.find(node_key);
+		if (entry == node_indexes.end()) {
+			auto node_dsn = PostgresUtils::GetNodeDSN(dsn, node_name, node_port);
+			if (node_dsn.empty()) {
+				return vector<PostgresLeafPartition>();
+			}
+			entry = node_indexes.emplace(node_key, nodes.size()).first;
+			nodes.push_back(std::move(node_dsn));
+		}
+		// the result is the name of the shard followed by its amount of pages
+		auto shard_info = query_result->GetString(placement, 3);
+		auto separator = shard_info.rfind(' ');
+		if (separator == string::npos) {
+			return vector<PostgresLeafPartition>();
+		}
+		PostgresLeafPartition shard;
+		shard.schema_name = schema_name;
+		shard.table_name = shard_info.substr(0, separator);
+		shard.pages_approx = std::stoull(shard_info.substr(separator + 1));
+		shard.worker_node = entry->second;
+		result.push_back(std::move(shard));
+	}
+	if (result.size() != idx_t(query_result->GetInt64(0, 4))) {
+		// a shard without a reachable placement would be missing from the scan
+		return vector<PostgresLeafPartition>();
+	}
+	std::sort(result.begin(), result.end(), [](const PostgresLeafPartition &a, const PostgresLeafPartition &b) {
+		if (a.worker_node != b.worker_node) {
+			return a.worker_node < b.worker_node;
+		}
+		return a.pages_approx > b.pages_approx;
+	});
+	worker_nodes = std::move(nodes);
+	return result;
+}
+
+void PostgresTableSet::LoadAllEntries(ClientContext &context) {
+	if (!lazy) {
+		return;
+	}
+	lock_guard<mutex> guard(lazy_lock);
+	if (all_loaded) {
+		return;
+	}
+	// load the columns of all tables - tables that have been loaded already are kept
 	auto &transaction = PostgresTransaction::Get(context, catalog);
+	auto result = transaction.Query(GetInitializeQuery(schema.name));
+	CreateEntries(transaction, *result, 0, result->Count());
+	all_loaded = true;
+}
+
+optional_ptr<CatalogEntry> PostgresTableSet::ReloadEntry(ClientContext &context, const string &table_name_p) {
+	auto &transaction = PostgresTransaction::Get(context, catalog);
+	auto table_name = table_name_p;
+	if (lazy) {
+		// resolve the name case insensitively
+		lock_guard<mutex> guard(lazy_lock);
+		auto entry = table_name_map.find(table_name);
+		if (table_names.find(table_name) == table_names.end() && entry != table_name_map.end()) {
+			table_name = entry->second;
+		}
+	}
 	auto table_info = GetTableInfo(transaction, schema, table_name);
 	if (!table_info) {
 		return nullptr;
@@ -289,14 +539,14 @@ string PostgresColumnsToSQL(const ColumnList &columns, const vector<unique_ptr<C
 	return ss.str();
 }
 
-string GetPostgresCreateTable(CreateTableInfo &info) {
+string PostgresTableSet::GetCreateTableSQL(CreateTableInfo &info, bool unlogged) {
 	for (idx_t i = 0; i < info.columns.LogicalColumnCount(); i++) {
 		auto &col = info.columns.GetColumnMutable(LogicalIndex(i));
 		col.SetType(PostgresUtils::ToPostgresType(col.GetType()));
 	}
 
 	std::stringstream ss;
-	ss << "CREATE TABLE ";
+	ss << (unlogged ? "CREATE UNLOGGED TABLE " : "CREATE TABLE ");
 	if (info.on_conflict == OnCreateConflict::IGNORE_ON_CONFLICT) {
 		ss << "IF NOT EXISTS ";
 	}
@@ -312,7 +562,7 @@ string GetPostgresCreateTable(CreateTableInfo &info) {
 
 optional_ptr<CatalogEntry> PostgresTableSet::CreateTable(ClientContext &context, BoundCreateTableInfo &info) {
 	auto &transaction = PostgresTransaction::Get(context, catalog);
-	auto create_sql = GetPostgresCreateTable(info.Base());
+	auto create_sql = GetCreateTableSQL(info.Base());
 	transaction.Query(create_sql);
 	auto tbl_entry = make_uniq<PostgresTableEntry>(catalog, schema, info.Base());
 	return CreateEntry(std::move(tbl_entry));
@@ -3,13 +3,14 @@
 #include "duckdb/parser/parsed_data/create_view_info.hpp"
 #include "duckdb/catalog/catalog_entry/index_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
+#include "duckdb/common/types/uuid.hpp"
 #include "postgres_result.hpp"
 
 namespace duckdb {
 
 PostgresTransaction::PostgresTransaction(PostgresCatalog &postgres_catalog, TransactionManager &manager,
                                          ClientContext &context)
-    : Transaction(manager, context), access_mode(postgres_catalog.access_mode) {
+    : Transaction(manager, context), postgres_catalog(postgres_catalog), access_mode(postgres_catalog.access_mode) {
 	connection = postgres_catalog.GetConnectionPool().GetConnection();
 }
 
@@ -19,16 +20,27 @@ void PostgresTransaction::Start() {
 	transaction_state = PostgresTransactionState::TRANSACTION_NOT_YET_STARTED;
 }
 void PostgresTransaction::Commit() {
+	ReleaseScanConnections();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_FINISHED;
 		GetConnectionRaw().Execute("COMMIT");
 	}
 }
 void PostgresTransaction::Rollback() {
+	ReleaseScanConnections();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_STARTED) {
 		transaction_state = PostgresTransactionState::TRANSACTION_FINISHED;
 		GetConnectionRaw().Execute("ROLLBACK");
 	}
+	// the rollback released the locks on the tables - drop them outside of a transaction
+	for (auto &table : rollback_drops) {
+		GetConnectionRaw().TryQuery("DROP TABLE IF EXISTS " + table);
+	}
+	rollback_drops.clear();
+}
+
+void PostgresTransaction::DropTableOnRollback(string qualified_name) {
+	rollback_drops.push_back(std::move(qualified_name));
 }
 
 static string GetBeginTransactionQuery(AccessMode access_mode) {
@@ -53,6 +65,34 @@ PostgresConnection &PostgresTransaction::GetConnectionRaw() {
 	return connection.GetConnection();
 }
 
+bool PostgresTransaction::TryGetReplicaConnection(idx_t max_lag_ms, PostgresPoolConnection &result,
+                                                  optional_ptr<PostgresConnectionPool> &pool) {
+	optional_ptr<PostgresConnectionPool> chosen_pool;
+	{
+		lock_guard<mutex> guard(replica_lock);
+		if (!replica_chosen) {
+			replica_chosen = true;
+			if (!postgres_catalog.TryGetReplicaConnection(max_lag_ms, result, replica_pool)) {
+				replica_pool = nullptr;
+				return false;
+			}
+			pool = replica_pool;
+			return true;
+		}
+		chosen_pool = replica_pool;
+	}
+	if (!chosen_pool) {
+		return false;
+	}
+	// the later scans stay on the same replica - they wait for a connection slot like the scans of the primary, and
+	// fall back to the primary if none is freed in time
+	if (!chosen_pool->TryGetConnection(result, PostgresConnectionPool::DEFAULT_SCAN_CONNECTION_WAIT_MS)) {
+		return false;
+	}
+	pool = chosen_pool;
+	return true;
+}
+
 string PostgresTransaction::GetDSN() {
 	return GetConnectionRaw().GetDSN();
 }
@@ -68,6 +108,30 @@ unique_ptr<PostgresResult> PostgresTransaction::Query(const string &query) {
 	return con.Query(query);
 }
 
+string PostgresTransaction::CreateTemporaryTable(const string &prefix, const string &query) {
+	auto table_name = prefix + "_" + UUID::ToString(UUID::GenerateRandomUUID());
+	string create_query = "CREATE LOCAL TEMPORARY TABLE " + KeywordHelper::WriteQuoted(table_name, '"');
+	create_query += " ON COMMIT DROP AS " + query + " WITH NO DATA";
+	// this is sent together with the start of the transaction (if any) to save a round trip
+	Query(create_query);
+	return table_name;
+}
+
+unique_ptr<PostgresResult> PostgresTransaction::QueryWithParameters(const string &query,
+                                                                    const vector<Value> &parameters) {
+	auto &con = GetConnectionRaw();
+	if (transaction_state == PostgresTransactionState::TRANSACTION_NOT_YET_STARTED) {
+		// a parameterized query has to be sent on its own - pipeline it with the start of the transaction
+		transaction_state = PostgresTransactionState::TRANSACTION_STARTED;
+		vector<PostgresPipelineStatement> statements;
+		statements.emplace_back(GetBeginTransactionQuery(access_mode));
+		statements.emplace_back(query, parameters);
+		auto results = con.ExecutePipeline(statements);
+		return std::move(results.back());
+	}
+	return con.QueryWithParameters(query, parameters);
+}
+
 vector<unique_ptr<PostgresResult>> PostgresTransaction::ExecuteQueries(const string &queries) {
 	auto &con = GetConnectionRaw();
 	if (transaction_state == PostgresTransactionState::TRANSACTION_NOT_YET_STARTED) {
@@ -79,6 +143,51 @@ vector<unique_ptr<PostgresResult>> PostgresTransaction::ExecuteQueries(const str
 	return con.ExecuteQueries(queries);
 }
 
+string PostgresTransaction::GetScanSnapshot(PostgresVersion version) {
+	lock_guard<mutex> guard(scan_lock);
+	if (!scan_snapshot_exported) {
+		// the exported snapshot remains valid for as long as the transaction is open
+		scan_snapshot = GetConnection().TryExportSnapshot(version);
+		scan_snapshot_exported = true;
+	}
+	return scan_snapshot;
+}
+
+bool PostgresTransaction::TryGetScanConnection(PostgresPoolConnection &result) {
+	lock_guard<mutex> guard(scan_lock);
+	if (scan_connections.empty()) {
+		return false;
+	}
+	result = std::move(scan_connections.back());
+	scan_connections.pop_back();
+	return true;
+}
+
+void PostgresTransaction::ReturnScanConnection(PostgresPoolConnection scan_connection) {
+	auto pg_con = scan_connection.GetConnection().GetConn();
+	if (PQstatus(pg_con) != CONNECTION_OK || PQtransactionStatus(pg_con) != PQTRANS_INTRANS) {
+		// the connection is broken or still busy with the query of the scan (e.g. a scan that stopped early)
+		return;
+	}
+	lock_guard<mutex> guard(scan_lock);
+	scan_connections.push_back(std::move(scan_connection));
+}
+
+void PostgresTransaction::ReleaseScanConnections() {
+	vector<PostgresPoolConnection> released;
+	{
+		lock_guard<mutex> guard(scan_lock);
+		released = std::move(scan_connections);
+		scan_connections.clear();
+		scan_snapshot_exported = false;
+		scan_snapshot = string();
+	}
+	for (auto &scan_connection : released) {
+		// connections that are idle outside of a transaction are kept by the pool
+		scan_connection.GetConnection().TryQuery("ROLLBACK");
+	}
+}
+
 PostgresTransaction &PostgresTransaction::Get(ClientContext &context, Catalog &catalog) {
 	return Transaction::Get(context, catalog).Cast<PostgresTransaction>();
 }
@@ -77,7 +77,7 @@ void PostgresTypeSet::InitializeEnums(PostgresResultSlice &enums) {
 
 string PostgresTypeSet::GetInitializeCompositesQuery() {
 	return R"(
-SELECT n.oid, t.typrelid AS id, t.typname as type, pg_attribute.attname, sub_type.typname
+SELECT n.oid, t.typrelid AS id, t.typname as type, pg_attribute.attname, sub_type.typname, t.oid AS type_oid
 FROM pg_type t
 JOIN pg_catalog.pg_namespace n ON n.oid = t.typnamespace
 JOIN pg_class ON pg_class.oid = t.typrelid
@@ -93,7 +93,7 @@ void PostgresTypeSet::CreateCompositeType(PostgresTransaction &transaction, Post
                                           idx_t end_row) {
 	PostgresType postgres_type;
 	CreateTypeInfo info;
-	postgres_type.oid = result.GetInt64(start_row, 1);
+	postgres_type.oid = result.GetInt64(start_row, 5);
 	info.name = result.GetString(start_row, 2);
 
 	child_list_t<LogicalType> child_types;
@@ -4,7 +4,7 @@
 #include "storage/postgres_catalog.hpp"
 #include "storage/postgres_transaction.hpp"
 #include "postgres_connection.hpp"
-#include "duckdb/common/types/uuid.hpp"
+#include "postgres_binary_writer.hpp"
 
 namespace duckdb {
 
@@ -28,21 +28,17 @@ public:
 	idx_t update_count;
 };
 
-string CreateUpdateTable(const string &name, PostgresTableEntry &table, const vector<PhysicalIndex> &index) {
-	string result;
-	result = "CREATE LOCAL TEMPORARY TABLE " + KeywordHelper::WriteOptionallyQuoted(name);
-	result += "(";
+string GetUpdateTableQuery(PostgresTableEntry &table, const vector<PhysicalIndex> &index) {
+	// create the temporary table from the updated table, so that its columns have the exact same Postgres types
+	string result = "SELECT ";
 	for (idx_t i = 0; i < index.size(); i++) {
-		if (i > 0) {
-			result += ", ";
-		}
 		auto &column_name = table.postgres_names[index[i].index];
-		auto &col = table.GetColumn(LogicalIndex(index[i].index));
 		result += KeywordHelper::WriteQuoted(column_name, '"');
-		result += " ";
-		result += PostgresUtils::TypeToString(col.GetType());
+		result += ", ";
 	}
-	result += ", __page_id_string VARCHAR) ON COMMIT DROP;";
+	result += "ctid AS __page_id FROM ";
+	result += KeywordHelper::WriteQuoted(table.schema.name, '"') + ".";
+	result += KeywordHelper::WriteQuoted(table.name, '"');
 	return result;
 }
 
@@ -66,7 +62,7 @@ string GetUpdateSQL(const string &name, PostgresTableEntry &table, const vector<
 	result += " FROM " + KeywordHelper::WriteOptionallyQuoted(name);
 	result += " WHERE ";
 	result += KeywordHelper::WriteQuoted(table.name, '"');
-	result += ".ctid=__page_id_string::TID";
+	result += ".ctid=__page_id";
 	return result;
 }
 
@@ -75,26 +71,28 @@ unique_ptr<GlobalSinkState> PostgresUpdate::GetGlobalSinkState(ClientContext &co
 
 	auto &transaction = PostgresTransaction::Get(context, postgres_table.catalog);
 	auto result = make_uniq<PostgresUpdateGlobalState>(postgres_table);
-	auto &connection = transaction.GetConnection();
 	// create a temporary table to stream the update data into
-	auto table_name = "update_data_" + UUID::ToString(UUID::GenerateRandomUUID());
-	connection.Execute(CreateUpdateTable(table_name, postgres_table, columns));
+	auto table_name = transaction.CreateTemporaryTable("update_data", GetUpdateTableQuery(postgres_table, columns));
+	auto &connection = transaction.GetConnection();
 	// generate the final UPDATE sql
 	result->update_sql = GetUpdateSQL(table_name, postgres_table, columns);
-	// initialize the insertion chunk
-	vector<LogicalType> insert_types;
-	for (idx_t i = 0; i < columns.size(); i++) {
-		auto &col = table.GetColumn(LogicalIndex(columns[i].index));
-		insert_types.push_back(col.GetType());
+	// use the binary format to stream the update data if the updated columns allow it
+	auto format = postgres_table.GetCopyFormat(context, columns);
+	if (format == PostgresCopyFormat::TEXT) {
+		// initialize the insertion chunk - in text mode the ctids are converted to strings
+		vector<LogicalType> insert_types;
+		for (idx_t i = 0; i < columns.size(); i++) {
+			auto &col = table.GetColumn(LogicalIndex(columns[i].index));
+			insert_types.push_back(col.GetType());
+		}
+		insert_types.push_back(LogicalType::VARCHAR);
+		result->insert_chunk.Initialize(context, insert_types);
 	}
-	insert_types.push_back(LogicalType::VARCHAR);
-	result->insert_chunk.Initialize(context, insert_types);
 
 	// begin the COPY TO
 	string schema_name;
 	vector<string> column_names;
-	connection.BeginCopyTo(context, result->copy_state, PostgresCopyFormat::TEXT, schema_name, table_name,
-	                       column_names);
+	connection.BeginCopyTo(context, result->copy_state, format, schema_name, table_name, column_names);
 	return std::move(result);
 }
 
@@ -105,14 +103,31 @@ SinkResultType PostgresUpdate::Sink(ExecutionContext &context, DataChunk &chunk,
 	auto &gstate = input.global_state.Cast<PostgresUpdateGlobalState>();
 
 	chunk.Flatten();
+	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
+	auto &connection = transaction.GetConnection();
+	auto &row_identifiers = chunk.data[chunk.ColumnCount() - 1];
+	auto row_data = FlatVector::GetData<row_t>(row_identifiers);
+	if (gstate.copy_state.format == PostgresCopyFormat::BINARY) {
+		// write the data columns directly, followed by the row ids as binary ctids
+		PostgresBinaryWriter writer;
+		for (idx_t r = 0; r < chunk.size(); r++) {
+			writer.BeginRow(columns.size() + 1);
+			for (idx_t c = 0; c < columns.size(); c++) {
+				writer.WriteValue(chunk.data[c], r, gstate.table.postgres_types[columns[c].index]);
+			}
+			writer.WriteCTID(row_data[r]);
+			writer.FinishRow();
+		}
+		connection.CopyData(writer);
+		gstate.update_count += chunk.size();
+		return SinkResultType::NEED_MORE_INPUT;
+	}
 	// reference the data columns directly
 	for (idx_t c = 0; c < columns.size(); c++) {
 		gstate.insert_chunk.data[c].Reference(chunk.data[c]);
 	}
 	// convert our row ids back into ctids
-	auto &row_identifiers = chunk.data[chunk.ColumnCount() - 1];
 	auto &ctid_vector = gstate.insert_chunk.data[gstate.insert_chunk.ColumnCount() - 1];
-	auto row_data = FlatVector::GetData<row_t>(row_identifiers);
 	auto varchar_data = FlatVector::GetData<string_t>(ctid_vector);
 
 	for (idx_t r = 0; r < chunk.size(); r++) {
@@ -121,17 +136,15 @@ SinkResultType PostgresUpdate::Sink(ExecutionContext &context, DataChunk &chunk,
 		auto page_index = row_data[r] >> 16;
 
 		string ctid_string;
-		ctid_string += "'(";
+		ctid_string += "(";
 		ctid_string += to_string(page_index);
 		ctid_string += ",";
 		ctid_string += to_string(row_in_page);
-		ctid_string += ")'";
+		ctid_string += ")";
 		varchar_data[r] = StringVector::AddString(ctid_vector, ctid_string);
 	}
 	gstate.insert_chunk.SetCardinality(chunk);
 
-	auto &transaction = PostgresTransaction::Get(context.client, gstate.table.catalog);
-	auto &connection = transaction.GetConnection();
 	connection.CopyChunk(context.client, gstate.copy_state, gstate.insert_chunk, gstate.varchar_chunk);
 	gstate.update_count += chunk.size();
 	return SinkResultType::NEED_MORE_INPUT;
@@ -149,6 +162,7 @@ SinkFinalizeType PostgresUpdate::Finalize(Pipeline &pipeline, Event &event, Clie
 	connection.FinishCopyTo(gstate.copy_state);
 	// merge the update_info table into the actual table (i.e. perform the actual update)
 	connection.Execute(gstate.update_sql);
+	gstate.table.InvalidateCachedResults();
 	return SinkFinalizeType::READY;
 }
 